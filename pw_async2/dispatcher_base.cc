@@ -14,6 +14,7 @@
 
 #include "pw_async2/dispatcher_base.h"
 
+#include <atomic>
 #include <iterator>
 #include <mutex>
 
@@ -28,15 +29,59 @@
 #include "pw_log/log.h"
 
 namespace pw::async2 {
+namespace {
+
+// Acquires the dispatcher lock that a ``Task::lock_`` or ``Waker::lock_``
+// refers to. Returns the held lock, or null without acquiring a lock if the
+// reference is null.
+//
+// These references are only changed with the lock they refer to held, so once
+// the lock is held and the reference still refers to it, it cannot change.
+// Dispatcher locks are never destroyed, so a stale reference is safe to lock.
+// The lock orders all other accesses, so the reference is read relaxed here.
+// References are stored with release ordering, so that ``IsRegistered`` and
+// ``IsEmpty`` may read them without the lock.
+pw::sync::InterruptSpinLock* LockReference(
+    const std::atomic<pw::sync::InterruptSpinLock*>& reference)
+    PW_NO_LOCK_SAFETY_ANALYSIS {
+  while (true) {
+    pw::sync::InterruptSpinLock* lock =
+        reference.load(std::memory_order_relaxed);
+    if (lock == nullptr) {
+      return nullptr;
+    }
+    lock->lock();
+    if (reference.load(std::memory_order_relaxed) == lock) {
+      return lock;
+    }
+    lock->unlock();
+  }
+}
+
+}  // namespace
+
 namespace internal {
 
 bool CloneWaker(Waker& waker_in, Waker& waker_out, log::Token wait_reason) {
-  std::lock_guard lock(impl::dispatcher_lock());
-  if (waker_out.task_ != nullptr && waker_out.task_ != waker_in.task_) {
-    return false;
+  pw::sync::InterruptSpinLock* lock = waker_in.LockDispatcher();
+  if (lock == nullptr) {
+    // Cloning an empty waker only succeeds if the output is empty.
+    return waker_out.IsEmpty();
   }
-  waker_in.InternalCloneIntoLocked(waker_out, wait_reason);
-  return true;
+  // Wakers which refer to another lock wake a task on another dispatcher.
+  // Otherwise, the output waker is empty or guarded by the held lock.
+  bool cloned = false;
+  pw::sync::InterruptSpinLock* out_lock =
+      waker_out.lock_.load(std::memory_order_relaxed);
+  if (out_lock == nullptr || out_lock == lock) {
+    waker_out.AssertSameLockAs(waker_in);
+    if (waker_out.task_ == nullptr || waker_out.task_ == waker_in.task_) {
+      waker_in.InternalCloneIntoLocked(waker_out, wait_reason);
+      cloned = true;
+    }
+  }
+  waker_in.UnlockDispatcher(*lock);
+  return cloned;
 }
 
 bool StoreWaker(Context& cx, Waker& waker_out, log::Token wait_reason) {
@@ -53,55 +98,114 @@ void Context::ReEnqueue() {
   std::move(waker).Wake();
 }
 
+pw::sync::InterruptSpinLock* Task::LockDispatcher() const
+    PW_NO_LOCK_SAFETY_ANALYSIS {
+  return LockReference(lock_);
+}
+
+void Task::UnlockDispatcher(pw::sync::InterruptSpinLock& lock) const
+    PW_NO_LOCK_SAFETY_ANALYSIS {
+  lock.unlock();
+}
+
+void Task::AssertLockedByWaker([[maybe_unused]] const Waker& waker) const {
+  PW_DASSERT(lock_.load(std::memory_order_relaxed) ==
+             waker.lock_.load(std::memory_order_relaxed));
+}
+
+void Task::AssertWakerLocked([[maybe_unused]] const Waker& waker) const {
+  PW_DASSERT(lock_.load(std::memory_order_relaxed) ==
+             waker.lock_.load(std::memory_order_relaxed));
+}
+
+// The task is unposted, so no other thread accesses it until ``lock_`` is set.
+void Task::SetDispatcherLocked(NativeDispatcherBase& dispatcher)
+    PW_NO_LOCK_SAFETY_ANALYSIS {
+  dispatcher_ = &dispatcher;
+  lock_.store(&dispatcher.lock_, std::memory_order_release);
+}
+
+void Task::ClearDispatcherLocked() {
+  dispatcher_ = nullptr;
+  lock_.store(nullptr, std::memory_order_release);
+}
+
 void Task::RemoveAllWakersLocked() {
   while (!wakers_.empty()) {
     Waker& waker = wakers_.front();
+    AssertWakerLocked(waker);
     wakers_.pop_front();
     waker.task_ = nullptr;
+    waker.lock_.store(nullptr, std::memory_order_release);
   }
 }
 
 void Task::AddWakerLocked(Waker& waker) {
+  // The waker is empty, so it takes on this task's lock.
+  waker.lock_.store(lock_.load(std::memory_order_relaxed),
+                    std::memory_order_release);
+  AssertWakerLocked(waker);
   waker.task_ = this;
   wakers_.push_front(waker);
 }
 
 void Task::RemoveWakerLocked(Waker& waker) {
+  AssertWakerLocked(waker);
   wakers_.remove(waker);
   waker.task_ = nullptr;
+  waker.lock_.store(nullptr, std::memory_order_release);
 #if PW_ASYNC2_DEBUG_WAIT_REASON
   waker.wait_reason_ = log::kDefaultToken;
 #endif  // PW_ASYNC2_DEBUG_WAIT_REASON
 }
 
 bool Task::IsRegistered() const {
-  std::lock_guard lock(impl::dispatcher_lock());
-  return state_ != Task::State::kUnposted;
+  // The lock is set whenever the task is posted.
+  return lock_.load(std::memory_order_acquire) != nullptr;
 }
 
 void Task::Deregister() {
-  pw::sync::Mutex* task_execution_lock;
-  {
-    // Fast path: the task is not running.
-    std::lock_guard lock(impl::dispatcher_lock());
-    if (TryDeregister()) {
+  while (true) {
+    pw::sync::Mutex* task_execution_lock;
+    {
+      // Fast path: the task is not running.
+      pw::sync::InterruptSpinLock* lock = LockDispatcher();
+      if (lock == nullptr) {
+        return;
+      }
+      if (TryDeregisterLocked()) {
+        UnlockDispatcher(*lock);
+        return;
+      }
+      // The task was running, so we have to wait for the task to stop being
+      // run by acquiring the `task_lock`.
+      dispatcher_->AssertLockedByTask(*this);
+      task_execution_lock = &dispatcher_->DoTaskExecutionLock(*this);
+      UnlockDispatcher(*lock);
+    }
+
+    // NOTE: there is a race here where `task_execution_lock_` may be
+    // invalidated by concurrent destruction of the dispatcher.
+    //
+    // This restriction is documented above, but is still fairly footgun-y.
+    std::lock_guard task_lock(*task_execution_lock);
+    pw::sync::InterruptSpinLock* lock = LockDispatcher();
+    if (lock == nullptr) {
+      return;
+    }
+    const bool deregistered = TryDeregisterLocked();
+    UnlockDispatcher(*lock);
+    if (deregistered) {
       return;
     }
-    // The task was running, so we have to wait for the task to stop being
-    // run by acquiring the `task_lock`.
-    task_execution_lock = &dispatcher_->task_execution_lock_;
+    // With multiple threads running tasks, another thread may have started
+    // running the task again. Wait for that thread instead.
   }
-
-  // NOTE: there is a race here where `task_execution_lock_` may be
-  // invalidated by concurrent destruction of the dispatcher.
-  //
-  // This restriction is documented above, but is still fairly footgun-y.
-  std::lock_guard task_lock(*task_execution_lock);
-  std::lock_guard lock(impl::dispatcher_lock());
-  PW_CHECK(TryDeregister());
 }
 
-bool Task::TryDeregister() {
+bool Task::TryDeregisterLocked() {
+  // The dispatcher lock is only held while the task is posted.
+  dispatcher_->AssertLockedByTask(*this);
   switch (state_) {
     case Task::State::kUnposted:
       return true;
@@ -109,9 +213,10 @@ bool Task::TryDeregister() {
       dispatcher_->RemoveSleepingTaskLocked(*this);
       break;
     case Task::State::kRunning:
+    case Task::State::kWokenWhileRunning:
       return false;
     case Task::State::kWoken:
-      dispatcher_->RemoveWokenTaskLocked(*this);
+      dispatcher_->DoRemoveWokenTask(*this);
       break;
   }
   state_ = Task::State::kUnposted;
@@ -119,53 +224,79 @@ bool Task::TryDeregister() {
 
   // Wake the dispatcher up if this was the last task so that it can see that
   // all tasks have completed.
-  if (dispatcher_->woken_.empty() && dispatcher_->sleeping_.empty() &&
-      dispatcher_->wants_wake_) {
+  if (dispatcher_->AllTasksCompleteLocked() && dispatcher_->wants_wake_) {
     dispatcher_->Wake();
   }
-  dispatcher_ = nullptr;
+  ClearDispatcherLocked();
   return true;
 }
 
 Waker::Waker(Waker&& other) noexcept {
-  std::lock_guard lock(impl::dispatcher_lock());
-  if (other.task_ == nullptr) {
+  pw::sync::InterruptSpinLock* lock = other.LockDispatcher();
+  if (lock == nullptr) {
     return;
   }
   Task& task = *other.task_;
+  task.AssertLockedByWaker(other);
   task.RemoveWakerLocked(other);
   task.AddWakerLocked(*this);
+  other.UnlockDispatcher(*lock);
 }
 
 Waker& Waker::operator=(Waker&& other) noexcept {
-  std::lock_guard lock(impl::dispatcher_lock());
-  RemoveFromTaskWakerListLocked();
-  if (other.task_ == nullptr) {
+  // The wakers may wake tasks on different dispatchers, so they are not
+  // locked at once.
+  RemoveFromTaskWakerList();
+  pw::sync::InterruptSpinLock* lock = other.LockDispatcher();
+  if (lock == nullptr) {
     return *this;
   }
   Task& task = *other.task_;
+  task.AssertLockedByWaker(other);
   task.RemoveWakerLocked(other);
   task.AddWakerLocked(*this);
+  other.UnlockDispatcher(*lock);
   return *this;
 }
 
 void Waker::Wake() && {
-  std::lock_guard lock(impl::dispatcher_lock());
-  if (task_ != nullptr) {
-    task_->dispatcher_->WakeTask(*task_);
-    RemoveFromTaskWakerListLocked();
+  pw::sync::InterruptSpinLock* lock = LockDispatcher();
+  if (lock == nullptr) {
+    return;
   }
+  Task& task = *task_;
+  task.AssertLockedByWaker(*this);
+  task.dispatcher_->AssertLockedByTask(task);
+  task.dispatcher_->WakeTask(task);
+  RemoveFromTaskWakerListLocked();
+  UnlockDispatcher(*lock);
+}
+
+pw::sync::InterruptSpinLock* Waker::LockDispatcher() const
+    PW_NO_LOCK_SAFETY_ANALYSIS {
+  return LockReference(lock_);
+}
+
+void Waker::UnlockDispatcher(pw::sync::InterruptSpinLock& lock) const
+    PW_NO_LOCK_SAFETY_ANALYSIS {
+  lock.unlock();
+}
+
+void Waker::AssertSameLockAs([[maybe_unused]] const Waker& other) const {
+  PW_DASSERT(lock_.load(std::memory_order_relaxed) == nullptr ||
+             lock_.load(std::memory_order_relaxed) ==
+                 other.lock_.load(std::memory_order_relaxed));
 }
 
 void Waker::InternalCloneIntoLocked(Waker& out,
                                     [[maybe_unused]] log::Token wait_reason) & {
+  out.AssertSameLockAs(*this);
   // The `out` waker already points to this task, so no work is necessary.
   if (out.task_ == task_) {
     return;
   }
   // Remove the output waker from its existing task's list.
   out.RemoveFromTaskWakerListLocked();
-  out.task_ = task_;
 
 #if PW_ASYNC2_DEBUG_WAIT_REASON
   out.wait_reason_ = wait_reason;
@@ -173,39 +304,41 @@ void Waker::InternalCloneIntoLocked(Waker& out,
 
   // Only add if the waker being cloned is actually associated with a task.
   if (task_ != nullptr) {
+    task_->AssertLockedByWaker(*this);
     task_->AddWakerLocked(out);
   }
 }
 
 bool Waker::IsEmpty() const {
-  std::lock_guard lock(impl::dispatcher_lock());
-  return task_ == nullptr;
+  // The lock is set whenever the waker has a task.
+  return lock_.load(std::memory_order_acquire) == nullptr;
 }
 
-void Waker::InsertIntoTaskWakerList() {
-  std::lock_guard lock(impl::dispatcher_lock());
-  InsertIntoTaskWakerListLocked();
-}
-
-void Waker::InsertIntoTaskWakerListLocked() {
-  if (task_ != nullptr) {
-    task_->AddWakerLocked(*this);
-  }
+void Waker::InsertIntoTaskWakerList(Task& task) {
+  pw::sync::InterruptSpinLock* lock = task.LockDispatcher();
+  PW_DASSERT(lock != nullptr);
+  task.AddWakerLocked(*this);
+  task.UnlockDispatcher(*lock);
 }
 
 void Waker::RemoveFromTaskWakerList() {
-  std::lock_guard lock(impl::dispatcher_lock());
+  pw::sync::InterruptSpinLock* lock = LockDispatcher();
+  if (lock == nullptr) {
+    return;
+  }
   RemoveFromTaskWakerListLocked();
+  UnlockDispatcher(*lock);
 }
 
 void Waker::RemoveFromTaskWakerListLocked() {
   if (task_ != nullptr) {
+    task_->AssertLockedByWaker(*this);
     task_->RemoveWakerLocked(*this);
   }
 }
 
 void NativeDispatcherBase::Deregister() {
-  std::lock_guard lock(impl::dispatcher_lock());
+  std::lock_guard lock(lock_);
   UnpostTaskList(woken_);
   UnpostTaskList(sleeping_);
 }
@@ -213,12 +346,12 @@ void NativeDispatcherBase::Deregister() {
 void NativeDispatcherBase::Post(Task& task) {
   bool wake_dispatcher = false;
   {
-    std::lock_guard lock(impl::dispatcher_lock());
+    std::lock_guard lock(lock_);
+    PW_DASSERT(!task.IsRegistered());
+    task.SetDispatcherLocked(*this);
     PW_DASSERT(task.state_ == Task::State::kUnposted);
-    PW_DASSERT(task.dispatcher_ == nullptr);
     task.state_ = Task::State::kWoken;
-    task.dispatcher_ = this;
-    woken_.push_back(task);
+    DoPushWokenTask(task);
     if (wants_wake_) {
       wake_dispatcher = true;
       wants_wake_ = false;
@@ -234,13 +367,13 @@ void NativeDispatcherBase::Post(Task& task) {
 
 NativeDispatcherBase::SleepInfo NativeDispatcherBase::AttemptRequestWake(
     bool allow_empty) {
-  std::lock_guard lock(impl::dispatcher_lock());
+  std::lock_guard lock(lock_);
   // Don't allow sleeping if there are already tasks waiting to be run.
-  if (!woken_.empty()) {
+  if (DoHasWokenTasks()) {
     PW_LOG_DEBUG("Dispatcher will not sleep due to nonempty task queue");
     return SleepInfo::DontSleep();
   }
-  if (!allow_empty && sleeping_.empty()) {
+  if (!allow_empty && sleeping_.empty() && running_tasks_ == 0) {
     PW_LOG_DEBUG("Dispatcher will not sleep due to empty sleep queue");
     return SleepInfo::DontSleep();
   }
@@ -253,21 +386,24 @@ NativeDispatcherBase::SleepInfo NativeDispatcherBase::AttemptRequestWake(
 }
 
 NativeDispatcherBase::RunOneTaskResult NativeDispatcherBase::RunOneTask(
-    Dispatcher& dispatcher, Task* task_to_look_for) {
-  std::lock_guard task_lock(task_execution_lock_);
+    Dispatcher& dispatcher,
+    Task* task_to_look_for,
+    pw::sync::Mutex& execution_lock) {
+  std::lock_guard task_lock(execution_lock);
   Task* task;
   {
-    std::lock_guard lock(impl::dispatcher_lock());
-    task = PopWokenTask();
+    std::lock_guard lock(lock_);
+    task = DoPopWokenTask();
     if (task == nullptr) {
       PW_LOG_DEBUG("Dispatcher has no woken tasks to run");
-      bool all_complete = woken_.empty() && sleeping_.empty();
       return RunOneTaskResult(
-          /*completed_all_tasks=*/all_complete,
+          /*completed_all_tasks=*/AllTasksCompleteLocked(),
           /*completed_main_task=*/false,
           /*ran_a_task=*/false);
     }
+    AssertTaskLocked(*task);
     task->state_ = Task::State::kRunning;
+    running_tasks_ += 1;
   }
 
   bool complete;
@@ -284,22 +420,23 @@ NativeDispatcherBase::RunOneTaskResult NativeDispatcherBase::RunOneTask(
     tasks_completed_.Increment();
     bool all_complete;
     {
-      std::lock_guard lock(impl::dispatcher_lock());
+      std::lock_guard lock(lock_);
+      AssertTaskLocked(*task);
       switch (task->state_) {
         case Task::State::kUnposted:
         case Task::State::kSleeping:
+        case Task::State::kWoken:
           PW_DASSERT(false);
           PW_UNREACHABLE;
         case Task::State::kRunning:
-          break;
-        case Task::State::kWoken:
-          RemoveWokenTaskLocked(*task);
+        case Task::State::kWokenWhileRunning:
           break;
       }
+      running_tasks_ -= 1;
       task->state_ = Task::State::kUnposted;
-      task->dispatcher_ = nullptr;
       task->RemoveAllWakersLocked();
-      all_complete = woken_.empty() && sleeping_.empty();
+      task->ClearDispatcherLocked();
+      all_complete = AllTasksCompleteLocked();
     }
     task->DoDestroy();
     return RunOneTaskResult(
@@ -308,8 +445,14 @@ NativeDispatcherBase::RunOneTaskResult NativeDispatcherBase::RunOneTask(
         /*ran_a_task=*/true);
   }
 
-  std::lock_guard lock(impl::dispatcher_lock());
-  if (task->state_ == Task::State::kRunning) {
+  std::lock_guard lock(lock_);
+  AssertTaskLocked(*task);
+  running_tasks_ -= 1;
+  if (task->state_ == Task::State::kWokenWhileRunning) {
+    // The task was woken while it was running, so run it again.
+    task->state_ = Task::State::kWoken;
+    DoPushWokenTask(*task);
+  } else if (task->state_ == Task::State::kRunning) {
     if (task->name_ != log::kDefaultToken) {
       PW_LOG_DEBUG(
           "Dispatcher adding task " PW_LOG_TOKEN_FMT() ":%p to sleep queue",
@@ -329,7 +472,7 @@ NativeDispatcherBase::RunOneTaskResult NativeDispatcherBase::RunOneTask(
     } else {
       // Require the task to be manually re-posted.
       task->state_ = Task::State::kUnposted;
-      task->dispatcher_ = nullptr;
+      task->ClearDispatcherLocked();
     }
   }
   return RunOneTaskResult(
@@ -341,22 +484,20 @@ NativeDispatcherBase::RunOneTaskResult NativeDispatcherBase::RunOneTask(
 void NativeDispatcherBase::UnpostTaskList(IntrusiveList<Task>& list) {
   while (!list.empty()) {
     Task& task = list.front();
+    AssertTaskLocked(task);
     task.state_ = Task::State::kUnposted;
-    task.dispatcher_ = nullptr;
     task.RemoveAllWakersLocked();
+    task.ClearDispatcherLocked();
     list.pop_front();
   }
 }
 
-void NativeDispatcherBase::RemoveWokenTaskLocked(Task& task) {
-  woken_.remove(task);
-}
-
 void NativeDispatcherBase::RemoveSleepingTaskLocked(Task& task) {
   sleeping_.remove(task);
 }
 
 void NativeDispatcherBase::WakeTask(Task& task) {
+  AssertTaskLocked(task);
   if (task.name_ != log::kDefaultToken) {
     PW_LOG_DEBUG("Dispatcher waking task " PW_LOG_TOKEN_FMT() ":%p",
                  task.name_,
@@ -368,23 +509,25 @@ void NativeDispatcherBase::WakeTask(Task& task) {
 
   switch (task.state_) {
     case Task::State::kWoken:
+    case Task::State::kWokenWhileRunning:
       // Do nothing-- this has already been woken.
       return;
     case Task::State::kUnposted:
       // This should be unreachable.
       PW_CHECK(false);
     case Task::State::kRunning:
-      // Wake again to indicate that this task should be run once more,
-      // as the state of the world may have changed since the task
-      // started running.
-      break;
+      // Mark the task to be run once more after it finishes running, as the
+      // state of the world may have changed since the task started running.
+      // It is not queued until then, so that it is not run concurrently.
+      task.state_ = Task::State::kWokenWhileRunning;
+      return;
     case Task::State::kSleeping:
       RemoveSleepingTaskLocked(task);
       // Wake away!
       break;
   }
   task.state_ = Task::State::kWoken;
-  woken_.push_back(task);
+  DoPushWokenTask(task);
   if (wants_wake_) {
     // Note: it's quite annoying to make this call under the lock, as it can
     // result in extra thread wakeup/sleep cycles.
@@ -395,7 +538,7 @@ void NativeDispatcherBase::WakeTask(Task& task) {
   }
 }
 
-Task* NativeDispatcherBase::PopWokenTask() {
+Task* NativeDispatcherBase::DoPopWokenTask() {
   if (woken_.empty()) {
     return nullptr;
   }
@@ -406,7 +549,7 @@ Task* NativeDispatcherBase::PopWokenTask() {
 
 void NativeDispatcherBase::LogRegisteredTasks() {
   PW_LOG_INFO("pw::async2::Dispatcher");
-  std::lock_guard lock(impl::dispatcher_lock());
+  std::lock_guard lock(lock_);
 
   PW_LOG_INFO("Woken tasks:");
   for (const Task& task : woken_) {
@@ -420,6 +563,7 @@ void NativeDispatcherBase::LogRegisteredTasks() {
   }
   PW_LOG_INFO("Sleeping tasks:");
   for (const Task& task : sleeping_) {
+    AssertTaskLocked(task);
     int waker_count = static_cast<int>(
         std::distance(task.wakers_.begin(), task.wakers_.end()));
 
@@ -442,6 +586,7 @@ void NativeDispatcherBase::LogRegisteredTasks() {
 
 #if PW_ASYNC2_DEBUG_WAIT_REASON
 void NativeDispatcherBase::LogTaskWakers(const Task& task) {
+  AssertTaskLocked(task);
   int i = 0;
   for (const Waker& waker : task.wakers_) {
     i++;
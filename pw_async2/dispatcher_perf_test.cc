@@ -0,0 +1,94 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures wakeup throughput with several independent dispatchers, each run on
+// its own thread.
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_async2/dispatcher.h"
+#include "pw_log/log.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_thread/thread.h"
+#include "pw_thread_stl/options.h"
+
+namespace pw::async2 {
+namespace {
+
+constexpr size_t kMaxDispatchers = 4;
+constexpr size_t kTasksPerDispatcher = 16;
+constexpr uint32_t kWakeupsPerTask = 1000;
+
+class SelfWakingTask : public Task {
+ public:
+  void Reset() { wakeups_ = 0; }
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    if (wakeups_ == kWakeupsPerTask) {
+      return Ready();
+    }
+    wakeups_ += 1;
+    cx.ReEnqueue();
+    return Pending();
+  }
+
+  uint32_t wakeups_ = 0;
+};
+
+using TaskSet = std::array<SelfWakingTask, kTasksPerDispatcher>;
+
+std::array<TaskSet, kMaxDispatchers> task_sets;
+
+void RunDispatcher(TaskSet& tasks) {
+  Dispatcher dispatcher;
+  for (SelfWakingTask& task : tasks) {
+    task.Reset();
+    dispatcher.Post(task);
+  }
+  dispatcher.RunToCompletion();
+}
+
+void WakeupTest(perf_test::State& state, size_t dispatchers) {
+  size_t iterations = 0;
+  const auto start = std::chrono::steady_clock::now();
+  while (state.KeepRunning()) {
+    std::array<Thread, kMaxDispatchers> threads;
+    for (size_t i = 0; i < dispatchers; ++i) {
+      threads[i] = Thread(thread::stl::Options(),
+                          [i] { RunDispatcher(task_sets[i]); });
+    }
+    for (size_t i = 0; i < dispatchers; ++i) {
+      threads[i].join();
+    }
+    iterations += 1;
+  }
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  PW_LOG_INFO("dispatchers: %u, wakeups/s: %.0f",
+              static_cast<unsigned>(dispatchers),
+              static_cast<double>(iterations * dispatchers *
+                                  kTasksPerDispatcher * kWakeupsPerTask) /
+                  elapsed.count());
+}
+
+PW_PERF_TEST(Wakeups_1Dispatcher, WakeupTest, 1);
+PW_PERF_TEST(Wakeups_4Dispatchers, WakeupTest, 4);
+
+}  // namespace
+}  // namespace pw::async2
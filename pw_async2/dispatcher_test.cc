@@ -270,5 +270,55 @@ TEST(Dispatcher, UnscheduleAllowsRepost) {
   EXPECT_EQ(dispatcher.tasks_polled(), 2u);
 }
 
+TEST(Dispatcher, WakerMovedBetweenDispatchersWakesItsTask) {
+  Dispatcher dispatcher_a;
+  Dispatcher dispatcher_b;
+  MockTask task_a;
+  MockTask task_b;
+  dispatcher_a.Post(task_a);
+  dispatcher_b.Post(task_b);
+  EXPECT_EQ(dispatcher_a.RunUntilStalled(), Pending());
+  EXPECT_EQ(dispatcher_b.RunUntilStalled(), Pending());
+
+  // Replace task_b's waker with task_a's.
+  task_b.last_waker = std::move(task_a.last_waker);
+  EXPECT_TRUE(task_a.last_waker.IsEmpty());
+  EXPECT_FALSE(task_b.last_waker.IsEmpty());
+
+  task_a.should_complete = true;
+  std::move(task_b.last_waker).Wake();
+  EXPECT_EQ(dispatcher_b.RunUntilStalled(), Pending());
+  EXPECT_EQ(task_b.polled, 1);
+  EXPECT_EQ(dispatcher_a.RunUntilStalled(), Ready());
+  EXPECT_EQ(task_a.polled, 2);
+
+  task_b.Deregister();
+}
+
+TEST(Dispatcher, CloneWakerForTaskOnOtherDispatcherFails) {
+  Dispatcher dispatcher_a;
+  Dispatcher dispatcher_b;
+  MockTask task_a;
+  MockTask task_b;
+  dispatcher_a.Post(task_a);
+  dispatcher_b.Post(task_b);
+  EXPECT_EQ(dispatcher_a.RunUntilStalled(), Pending());
+  EXPECT_EQ(dispatcher_b.RunUntilStalled(), Pending());
+
+  EXPECT_FALSE(PW_ASYNC_TRY_CLONE_WAKER(
+      task_a.last_waker, task_b.last_waker, "Clone to other dispatcher"));
+
+  Waker waker;
+  EXPECT_TRUE(PW_ASYNC_TRY_CLONE_WAKER(
+      task_a.last_waker, waker, "Clone to empty waker"));
+  EXPECT_FALSE(waker.IsEmpty());
+
+  // Deregistering the task clears its wakers.
+  task_a.Deregister();
+  EXPECT_TRUE(waker.IsEmpty());
+  EXPECT_TRUE(task_a.last_waker.IsEmpty());
+  task_b.Deregister();
+}
+
 }  // namespace
 }  // namespace pw::async2
@@ -15,9 +15,9 @@
 
 #include "pw_async2/context.h"
 #include "pw_async2/dispatcher_native.h"
-#include "pw_async2/lock.h"
 #include "pw_async2/task.h"
 #include "pw_async2/waker.h"
+#include "pw_sync/lock_annotations.h"
 
 namespace pw::async2 {
 namespace internal {
@@ -61,12 +61,12 @@ class Dispatcher {
   /// again until the ``Task`` completes.
   ///
   /// This method is thread-safe and interrupt-safe.
-  void Post(Task& task) PW_LOCKS_EXCLUDED(impl::dispatcher_lock()) {
+  void Post(Task& task) PW_LOCKS_EXCLUDED(native_.dispatcher_lock()) {
     native_.Post(task);
   }
 
   /// Runs tasks until none are able to make immediate progress.
-  Poll<> RunUntilStalled() PW_LOCKS_EXCLUDED(impl::dispatcher_lock()) {
+  Poll<> RunUntilStalled() PW_LOCKS_EXCLUDED(native_.dispatcher_lock()) {
     return native_.DoRunUntilStalled(*this, nullptr);
   }
 
@@ -75,7 +75,7 @@ class Dispatcher {
   ///
   /// Returns whether ``task`` completed.
   Poll<> RunUntilStalled(Task& task)
-      PW_LOCKS_EXCLUDED(impl::dispatcher_lock()) {
+      PW_LOCKS_EXCLUDED(native_.dispatcher_lock()) {
     return native_.DoRunUntilStalled(*this, &task);
   }
 
@@ -85,7 +85,7 @@ class Dispatcher {
   /// Returns a ``Poll`` containing the possible output of ``pendable``.
   template <typename Pendable>
   Poll<PendOutputOf<Pendable>> RunPendableUntilStalled(Pendable& pendable)
-      PW_LOCKS_EXCLUDED(impl::dispatcher_lock()) {
+      PW_LOCKS_EXCLUDED(native_.dispatcher_lock()) {
     internal::PendableAsTaskWithOutput<Pendable> task(pendable);
     Post(task);
     if (RunUntilStalled(task).IsReady()) {
@@ -101,19 +101,20 @@ class Dispatcher {
   }
 
   /// Runs until all tasks complete.
-  void RunToCompletion() PW_LOCKS_EXCLUDED(impl::dispatcher_lock()) {
+  void RunToCompletion() PW_LOCKS_EXCLUDED(native_.dispatcher_lock()) {
     native_.DoRunToCompletion(*this, nullptr);
   }
 
   /// Runs until ``task`` completes.
-  void RunToCompletion(Task& task) PW_LOCKS_EXCLUDED(impl::dispatcher_lock()) {
+  void RunToCompletion(Task& task)
+      PW_LOCKS_EXCLUDED(native_.dispatcher_lock()) {
     native_.DoRunToCompletion(*this, &task);
   }
 
   /// Runs until ``pendable`` completes, returning the output of ``pendable``.
   template <typename Pendable>
   PendOutputOf<Pendable> RunPendableToCompletion(Pendable& pendable)
-      PW_LOCKS_EXCLUDED(impl::dispatcher_lock()) {
+      PW_LOCKS_EXCLUDED(native_.dispatcher_lock()) {
     internal::PendableAsTaskWithOutput<Pendable> task(pendable);
     Post(task);
     native_.DoRunToCompletion(*this, &task);
@@ -13,6 +13,10 @@
 // the License.
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+
+#include "pw_assert/assert.h"
 #include "pw_async2/context.h"
 #include "pw_async2/internal/config.h"
 #include "pw_async2/lock.h"
@@ -56,8 +60,13 @@ class NativeDispatcherBase {
   ~NativeDispatcherBase() = default;
 
   /// Check that a task is posted on this ``Dispatcher``.
-  bool HasPostedTask(Task& task)
-      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock()) {
+  bool HasPostedTask(Task& task) PW_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    // A task posted elsewhere may be guarded by another lock, so check the
+    // lock before reading the task's dispatcher.
+    if (task.lock_.load(std::memory_order_relaxed) != &lock_) {
+      return false;
+    }
+    AssertTaskLocked(task);
     return task.dispatcher_ == this;
   }
 
@@ -68,9 +77,9 @@ class NativeDispatcherBase {
   /// destructors. It is not called by the ``NativeDispatcherBase`` destructor,
   /// as doing so would allow the ``Dispatcher`` to be referenced between the
   /// calls to ``~Dispatcher`` and ``~NativeDispatcherBase``.
-  void Deregister() PW_LOCKS_EXCLUDED(impl::dispatcher_lock());
+  void Deregister() PW_LOCKS_EXCLUDED(lock_);
 
-  void Post(Task& task) PW_LOCKS_EXCLUDED(impl::dispatcher_lock());
+  void Post(Task& task) PW_LOCKS_EXCLUDED(lock_);
 
   /// Information about whether and when to sleep until as returned by
   /// ``NativeDispatcherBase::AttemptRequestWake``.
@@ -105,8 +114,7 @@ class NativeDispatcherBase {
   ///
   /// @param  allow_empty Whether or not to allow sleeping when no tasks are
   ///                     registered.
-  SleepInfo AttemptRequestWake(bool allow_empty)
-      PW_LOCKS_EXCLUDED(impl::dispatcher_lock());
+  SleepInfo AttemptRequestWake(bool allow_empty) PW_LOCKS_EXCLUDED(lock_);
 
   /// Information about the result of a call to ``RunOneTask``.
   ///
@@ -132,7 +140,58 @@ class NativeDispatcherBase {
   /// Attempts to run a single task, returning whether any tasks were
   /// run, and whether `task_to_look_for` was run.
   [[nodiscard]] RunOneTaskResult RunOneTask(Dispatcher& dispatcher,
-                                            Task* task_to_look_for);
+                                            Task* task_to_look_for) {
+    return RunOneTask(dispatcher, task_to_look_for, task_execution_lock_);
+  }
+
+  /// Like ``RunOneTask``, but holds ``execution_lock`` while taking and
+  /// running a task.
+  ///
+  /// Backends which run tasks on multiple threads call this concurrently,
+  /// with a separate lock for each thread, and return the lock of the thread
+  /// running a task from ``DoTaskExecutionLock``. A task is never run by more
+  /// than one thread at a time.
+  [[nodiscard]] RunOneTaskResult RunOneTask(Dispatcher& dispatcher,
+                                            Task* task_to_look_for,
+                                            pw::sync::Mutex& execution_lock);
+
+  /// Run queue hooks, for backends which keep woken tasks in their own
+  /// queues, such as a queue for each thread. By default, woken tasks are run
+  /// in FIFO order from a single queue. Overrides may call these defaults to
+  /// use the default queue as well as their own.
+  ///
+  /// These are called with ``dispatcher_lock()`` held, and must not release
+  /// it. Tasks are never pushed while they are running.
+  virtual void DoPushWokenTask(Task& task) PW_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    woken_.push_back(task);
+  }
+  virtual Task* DoPopWokenTask() PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  virtual void DoRemoveWokenTask(Task& task)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    woken_.remove(task);
+  }
+  virtual bool DoHasWokenTasks() const PW_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    return !woken_.empty();
+  }
+
+  /// Returns the execution lock held by the thread running ``task``, which
+  /// ``Task::Deregister`` acquires to wait for the task to finish running.
+  /// Called with ``dispatcher_lock()`` held while ``task`` is running.
+  virtual pw::sync::Mutex& DoTaskExecutionLock([[maybe_unused]] Task& task)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    return task_execution_lock_;
+  }
+
+  /// Unposts all tasks in a list, such as a backend's run queue.
+  void UnpostTaskList(IntrusiveList<Task>& list)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  /// The lock guarding this dispatcher's task queues, its tasks, and their
+  /// wakers.
+  pw::sync::InterruptSpinLock& dispatcher_lock() const
+      PW_LOCK_RETURNED(lock_) {
+    return lock_;
+  }
 
   uint32_t tasks_polled() const { return tasks_polled_.value(); }
   uint32_t tasks_completed() const { return tasks_completed_.value(); }
@@ -154,29 +213,38 @@ class NativeDispatcherBase {
   /// This method's implementation should ensure that the ``Dispatcher`` comes
   /// back from sleep and begins invoking ``RunOneTask`` again.
   ///
-  /// Note: the ``impl::dispatcher_lock()`` may or may not be held here, so it
-  /// must not be acquired by ``DoWake``, nor may ``DoWake`` assume that it has
-  /// been acquired.
+  /// Note: the ``dispatcher_lock()`` may or may not be held here, so it must
+  /// not be acquired by ``DoWake``, nor may ``DoWake`` assume that it has been
+  /// acquired.
   virtual void DoWake() = 0;
 
-  static void UnpostTaskList(IntrusiveList<Task>& list)
-      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
-  void RemoveWokenTaskLocked(Task&)
-      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
-  void RemoveSleepingTaskLocked(Task&)
-      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
+  void RemoveSleepingTaskLocked(Task&) PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
-  // For use by ``Waker``.
-  void WakeTask(Task&) PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
+  // Whether all posted tasks have completed or been deregistered.
+  bool AllTasksCompleteLocked() const PW_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    return !DoHasWokenTasks() && sleeping_.empty() && running_tasks_ == 0;
+  }
 
-  // For use by ``RunOneTask``.
-  Task* PopWokenTask() PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
+  // For use by ``Waker``.
+  void WakeTask(Task&) PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Tells thread safety analysis that ``task`` is posted to this dispatcher, so
+  // its ``dispatcher_lock()`` is this dispatcher's lock.
+  void AssertTaskLocked(const Task& task) const
+      PW_EXCLUSIVE_LOCKS_REQUIRED(lock_)
+          PW_ASSERT_EXCLUSIVE_LOCK(task.dispatcher_lock()) {
+    PW_DASSERT(task.lock_.load(std::memory_order_relaxed) == &lock_);
+  }
+  void AssertLockedByTask(const Task& task) const
+      PW_EXCLUSIVE_LOCKS_REQUIRED(task.dispatcher_lock())
+          PW_ASSERT_EXCLUSIVE_LOCK(lock_) {
+    PW_DASSERT(task.lock_.load(std::memory_order_relaxed) == &lock_);
+  }
 
   void LogRegisteredTasks();
 
 #if PW_ASYNC2_DEBUG_WAIT_REASON
-  void LogTaskWakers(const Task& task)
-      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
+  void LogTaskWakers(const Task& task) PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
 #endif  // PW_ASYNC2_DEBUG_WAIT_REASON
 
   // A lock guarding ``Task`` execution.
@@ -185,16 +253,25 @@ class NativeDispatcherBase {
   // queue, and only released after they have been run and possibly
   // destroyed.
   //
-  // If acquiring this lock and ``impl::dispatcher_lock()``, this lock must
-  // be acquired first in order to avoid deadlocks.
+  // If acquiring this lock and ``dispatcher_lock()``, this lock must be
+  // acquired first in order to avoid deadlocks.
   //
   // Acquiring this lock may be a slow process, as it must wait until
   // the running task has finished executing ``Task::Pend``.
+  //
+  // Backends which run tasks on multiple threads use their own lock for each
+  // thread instead.
   pw::sync::Mutex task_execution_lock_;
 
-  IntrusiveList<Task> woken_ PW_GUARDED_BY(impl::dispatcher_lock());
-  IntrusiveList<Task> sleeping_ PW_GUARDED_BY(impl::dispatcher_lock());
-  bool wants_wake_ PW_GUARDED_BY(impl::dispatcher_lock()) = false;
+  // Tasks posted to this dispatcher, and their wakers, refer to this lock, so
+  // it is not stored in the dispatcher: it must outlive the dispatcher. See
+  // ``impl::AssignDispatcherLock``.
+  pw::sync::InterruptSpinLock& lock_ = impl::AssignDispatcherLock();
+
+  IntrusiveList<Task> woken_ PW_GUARDED_BY(lock_);
+  IntrusiveList<Task> sleeping_ PW_GUARDED_BY(lock_);
+  size_t running_tasks_ PW_GUARDED_BY(lock_) = 0;
+  bool wants_wake_ PW_GUARDED_BY(lock_) = false;
 
   PW_METRIC_GROUP(metrics_, "pw::async2::NativeDispatcherBase");
   PW_METRIC(metrics_, tasks_polled_, "tasks_polled", 0u);
@@ -25,6 +25,30 @@
 #define PW_ASYNC2_CONFIG_LOG_MODULE_NAME "PW_ASYNC2"
 #endif  // PW_ASYNC2_CONFIG_LOG_MODULE_NAME
 
+/// The number of locks shared by ``Dispatcher`` s. Each ``Dispatcher`` is
+/// assigned one of these locks when it is constructed, in turn, so
+/// dispatchers only contend on each other's locks when more than this many
+/// exist at once.
+#ifndef PW_ASYNC2_CONFIG_DISPATCHER_LOCKS
+#define PW_ASYNC2_CONFIG_DISPATCHER_LOCKS 4
+#endif  // PW_ASYNC2_CONFIG_DISPATCHER_LOCKS
+
+/// The alignment of each ``Dispatcher`` lock. On systems where dispatchers run
+/// on several cores, set this to the cache line size so that dispatchers on
+/// different cores do not share a cache line.
+#ifndef PW_ASYNC2_CONFIG_DISPATCHER_LOCK_ALIGNMENT
+#define PW_ASYNC2_CONFIG_DISPATCHER_LOCK_ALIGNMENT \
+  alignof(::pw::sync::InterruptSpinLock)
+#endif  // PW_ASYNC2_CONFIG_DISPATCHER_LOCK_ALIGNMENT
+
+/// The number of levels in the ``TimerWheel`` which holds the timers of the
+/// ``TimeProvider`` returned by ``GetSystemTimeProvider``. Each level holds 64
+/// timer lists. If this is 0, timers are kept in a sorted list instead, which
+/// needs no extra memory but takes longer to insert into as more timers wait.
+#ifndef PW_ASYNC2_CONFIG_SYSTEM_TIME_PROVIDER_TIMER_WHEEL_LEVELS
+#define PW_ASYNC2_CONFIG_SYSTEM_TIME_PROVIDER_TIMER_WHEEL_LEVELS 0
+#endif  // PW_ASYNC2_CONFIG_SYSTEM_TIME_PROVIDER_TIMER_WHEEL_LEVELS
+
 /// Controls how the ``wait_reason_string`` argument to
 /// @c_macro{PW_ASYNC_STORE_WAKER} and @c_macro{PW_ASYNC_CLONE_WAKER} is used.
 /// If enabled, wait reasons are stored within their wakers, allowing easier
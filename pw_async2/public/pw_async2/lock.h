@@ -13,24 +13,43 @@
 // the License.
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <mutex>
+
+#include "pw_async2/internal/config.h"
 #include "pw_sync/interrupt_spin_lock.h"
 #include "pw_toolchain/no_destructor.h"
 
 namespace pw::async2::impl {
 
-/// A lock guarding the `Task` queue and `Waker` lists. This is a `Dispatcher`
-/// implementation detail and should only be used by `Dispatcher` backends.
+/// Returns the lock for a new ``Dispatcher``, which guards its ``Task`` queues,
+/// its ``Task`` s, and their ``Waker`` s. This is a ``Dispatcher``
+/// implementation detail and should only be used by ``Dispatcher`` backends.
 ///
 /// This is an `InterruptSpinLock` in order to allow posting work from ISR
 /// contexts.
 ///
-/// This lock is global rather than per-dispatcher in order to allow `Task` and
-/// `Waker` to take out the lock without dereferencing their `Dispatcher*`
-/// fields, which are themselves guarded by the lock in order to allow the
-/// `Dispatcher` to `Deregister` itself upon destruction.
-inline pw::sync::InterruptSpinLock& dispatcher_lock() {
-  static NoDestructor<pw::sync::InterruptSpinLock> lock;
-  return *lock;
+/// Locks are assigned in turn from a static table of
+/// ``PW_ASYNC2_CONFIG_DISPATCHER_LOCKS`` locks, so dispatchers only share a
+/// lock when more than that many are created. The locks are never destroyed, so
+/// ``Task`` and ``Waker`` can take out the lock of their dispatcher without
+/// dereferencing their ``Dispatcher*`` fields, which are themselves guarded by
+/// the lock in order to allow the ``Dispatcher`` to ``Deregister`` itself upon
+/// destruction.
+inline pw::sync::InterruptSpinLock& AssignDispatcherLock() {
+  struct alignas(PW_ASYNC2_CONFIG_DISPATCHER_LOCK_ALIGNMENT) Entry {
+    pw::sync::InterruptSpinLock lock;
+  };
+  static NoDestructor<std::array<Entry, PW_ASYNC2_CONFIG_DISPATCHER_LOCKS>>
+      locks;
+  static size_t next = 0;
+
+  // Dispatchers are rarely created, so guard the index with the first lock.
+  std::lock_guard guard((*locks)[0].lock);
+  Entry& entry = (*locks)[next];
+  next = (next + 1) % PW_ASYNC2_CONFIG_DISPATCHER_LOCKS;
+  return entry.lock;
 }
 
 }  // namespace pw::async2::impl
@@ -28,6 +28,14 @@ class SimulatedTimeProvider final : public TimeProvider<Clock> {
           typename Clock::time_point(typename Clock::duration(0)))
       : now_(timestamp) {}
 
+  /// Constructs a `SimulatedTimeProvider` which keeps its waiting timers in a
+  /// `TimerWheel`.
+  explicit SimulatedTimeProvider(
+      TimerWheel<Clock>& wheel,
+      typename Clock::time_point timestamp =
+          typename Clock::time_point(typename Clock::duration(0)))
+      : TimeProvider<Clock>(wheel), now_(timestamp) {}
+
   /// Advances the simulated time and runs any newly-expired timers.
   void AdvanceTime(typename Clock::duration duration) {
     lock_.lock();
@@ -65,7 +73,7 @@ class SimulatedTimeProvider final : public TimeProvider<Clock> {
   /// for a time in the past and neither `AdvanceTime` nor `SetTime` are
   /// subsequently invoked, the timer will not have a chance to run until
   /// one of `AdvanceTime`, `SetTime`, or `RunExpiredTimers` has been called.
-  void RunExpiredTimers() { RunExpired(now()); }
+  void RunExpiredTimers() { TimeProvider<Clock>::RunExpired(now()); }
 
   typename Clock::time_point now() final {
     std::lock_guard lock(lock_);
@@ -13,12 +13,14 @@
 // the License.
 #pragma once
 
+#include <atomic>
+
 #include "pw_async2/context.h"
-#include "pw_async2/lock.h"
 #include "pw_async2/poll.h"
 #include "pw_containers/intrusive_forward_list.h"
 #include "pw_containers/intrusive_list.h"
 #include "pw_log/tokenized_args.h"
+#include "pw_sync/interrupt_spin_lock.h"
 #include "pw_sync/lock_annotations.h"
 
 namespace pw::async2 {
@@ -146,7 +148,7 @@ class Task : public IntrusiveList<Task>::Item {
   ///
   /// If the task is currently running, this will return false and the task
   /// will not be deregistered.
-  bool TryDeregister() PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
+  bool TryDeregisterLocked() PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
 
   /// Attempts to advance this ``Task`` to completion.
   ///
@@ -176,32 +178,66 @@ class Task : public IntrusiveList<Task>::Item {
   /// here.
   virtual void DoDestroy() {}
 
+  // The lock of the dispatcher this task is posted to, which guards the
+  // task's state and wakers. This names the lock in thread safety annotations,
+  // and must only be called while the task is posted.
+  pw::sync::InterruptSpinLock& dispatcher_lock() const {
+    return *lock_.load(std::memory_order_relaxed);
+  }
+
+  // Acquires ``dispatcher_lock()`` and returns it, or returns null without
+  // acquiring a lock if the task is not posted. The lock is released with
+  // ``UnlockDispatcher``, which must be passed the returned lock since
+  // ``dispatcher_lock()`` may change while it is held.
+  pw::sync::InterruptSpinLock* LockDispatcher() const
+      PW_EXCLUSIVE_TRYLOCK_FUNCTION(true, dispatcher_lock());
+  void UnlockDispatcher(pw::sync::InterruptSpinLock& lock) const
+      PW_UNLOCK_FUNCTION(dispatcher_lock());
+
+  // Tells thread safety analysis that ``waker`` wakes this task, so they share
+  // ``dispatcher_lock()``.
+  void AssertLockedByWaker(const Waker& waker) const
+      PW_EXCLUSIVE_LOCKS_REQUIRED(waker.dispatcher_lock())
+          PW_ASSERT_EXCLUSIVE_LOCK(dispatcher_lock());
+  void AssertWakerLocked(const Waker& waker) const
+      PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock())
+          PW_ASSERT_EXCLUSIVE_LOCK(waker.dispatcher_lock());
+
+  // Posts this task to ``dispatcher``, whose lock must be held. After this
+  // call, that lock is ``dispatcher_lock()``.
+  void SetDispatcherLocked(NativeDispatcherBase& dispatcher)
+      PW_ASSERT_EXCLUSIVE_LOCK(dispatcher_lock());
+
+  // Unposts this task from its dispatcher.
+  void ClearDispatcherLocked() PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
+
   // Unlinks all ``Waker`` objects associated with this ``Task.``
-  void RemoveAllWakersLocked()
-      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
+  void RemoveAllWakersLocked() PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
 
   // Adds a ``Waker`` to the linked list of ``Waker`` s tracked by this
   // ``Task``.
-  void AddWakerLocked(Waker&)
-      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
+  void AddWakerLocked(Waker&) PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
 
   // Removes a ``Waker`` from the linked list of ``Waker`` s tracked by this
   // ``Task``
   //
   // Precondition: the provided waker *must* be in the list of ``Waker`` s
   // tracked by this ``Task``.
-  void RemoveWakerLocked(Waker&)
-      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
+  void RemoveWakerLocked(Waker&) PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
 
   enum class State {
     kUnposted,
     kRunning,
+    // Running, and woken since its current ``Pend`` call started. The task is
+    // queued to run again once ``Pend`` returns, so that it is never run on
+    // two threads at once.
+    kWokenWhileRunning,
     kWoken,
     kSleeping,
   };
 
   // The current state of the task.
-  State state_ PW_GUARDED_BY(impl::dispatcher_lock()) = State::kUnposted;
+  State state_ PW_GUARDED_BY(dispatcher_lock()) = State::kUnposted;
 
   // A pointer to the dispatcher this task is associated with.
   //
@@ -209,11 +245,15 @@ class Task : public IntrusiveList<Task>::Item {
   //
   // This value must be cleared by the dispatcher upon destruction in order to
   // prevent null access.
-  NativeDispatcherBase* dispatcher_ PW_GUARDED_BY(impl::dispatcher_lock()) =
-      nullptr;
+  NativeDispatcherBase* dispatcher_ PW_GUARDED_BY(dispatcher_lock()) = nullptr;
+
+  // The lock of ``dispatcher_``, or null if the task is unposted. This is only
+  // changed with the lock it points to held, so it may be read without the
+  // lock to find which lock to acquire.
+  std::atomic<pw::sync::InterruptSpinLock*> lock_ = nullptr;
 
   // Linked list of ``Waker`` s that may awaken this ``Task``.
-  IntrusiveForwardList<Waker> wakers_ PW_GUARDED_BY(impl::dispatcher_lock());
+  IntrusiveForwardList<Waker> wakers_ PW_GUARDED_BY(dispatcher_lock());
 
   // Optional user-facing name for the task. If set, it will be included in
   // debug logs.
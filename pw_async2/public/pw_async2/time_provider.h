@@ -15,12 +15,19 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
 
+#include <algorithm>
+#include <array>
+#include <limits>
 #include <mutex>
+#include <type_traits>
 
+#include "lib/stdcompat/bit.h"
 #include "pw_async2/dispatcher.h"
 #include "pw_chrono/virtual_clock.h"
 #include "pw_containers/intrusive_list.h"
+#include "pw_span/span.h"
 #include "pw_sync/interrupt_spin_lock.h"
 #include "pw_sync/lock_annotations.h"
 #include "pw_toolchain/no_destructor.h"
@@ -38,11 +45,19 @@ inline pw::sync::InterruptSpinLock& time_lock() {
 // `Timer` objects must not outlive their `TimeProvider`.
 void AssertTimeFutureObjectsAllGone(bool empty);
 
+// Level count of the `TimerWheel` specialization that may have any number of
+// levels.
+inline constexpr size_t kGenericTimerWheelLevels =
+    std::numeric_limits<size_t>::max();
+
 }  // namespace internal
 
 template <typename Clock>
 class TimeFuture;
 
+template <typename Clock, size_t kLevels = internal::kGenericTimerWheelLevels>
+class TimerWheel;
+
 /// A factory for time and timers.
 ///
 /// This extends the `VirtualClock` interface with the ability to create async
@@ -56,11 +71,18 @@ class TimeFuture;
 ///
 /// Note that `Timer` objects must not outlive the `TimeProvider` from which
 /// they were created.
+///
+/// By default, waiting timers are kept in a list sorted by expiration, so
+/// creating a timer takes time proportional to the number of timers already
+/// waiting. Providers which may have many timers waiting at once can instead
+/// be constructed with a `TimerWheel`, which creates and destroys timers in
+/// constant time.
 template <typename Clock>
 class TimeProvider : public chrono::VirtualClock<Clock> {
  public:
   ~TimeProvider() override {
-    internal::AssertTimeFutureObjectsAllGone(futures_.empty());
+    internal::AssertTimeFutureObjectsAllGone(
+        futures_.empty() && (wheel_ == nullptr || wheel_->empty()));
   }
 
   typename Clock::time_point now() override = 0;
@@ -87,6 +109,14 @@ class TimeProvider : public chrono::VirtualClock<Clock> {
   }
 
  protected:
+  TimeProvider() = default;
+
+  /// Constructs a `TimeProvider` which keeps its waiting timers in `wheel`.
+  ///
+  /// `wheel` must outlive the `TimeProvider`, and may not be used by any other
+  /// `TimeProvider`.
+  explicit TimeProvider(TimerWheel<Clock>& wheel) : wheel_(&wheel) {}
+
   /// Run all expired timers with the current (provided) `time_point`.
   ///
   /// This method should be invoked by subclasses when `DoInvokeAt`'s timer
@@ -106,9 +136,11 @@ class TimeProvider : public chrono::VirtualClock<Clock> {
   virtual void DoCancel()
       PW_EXCLUSIVE_LOCKS_REQUIRED(internal::time_lock()) = 0;
 
-  // Head of the waiting timers list.
-  IntrusiveList<TimeFuture<Clock>> futures_
+  // Head of the waiting timers list, which is used if there is no `wheel_`.
+  containers::future::IntrusiveList<TimeFuture<Clock>> futures_
       PW_GUARDED_BY(internal::time_lock());
+
+  TimerWheel<Clock>* const wheel_ = nullptr;
 };
 
 /// A timer which can asynchronously wait for time to pass.
@@ -117,7 +149,7 @@ class TimeProvider : public chrono::VirtualClock<Clock> {
 /// used with any `TimeProvider` with a compatible `Clock` type.
 template <typename Clock>
 class [[nodiscard]] TimeFuture
-    : public IntrusiveForwardList<TimeFuture<Clock>>::Item {
+    : public containers::future::IntrusiveList<TimeFuture<Clock>>::Item {
  public:
   TimeFuture() : provider_(nullptr) {}
   TimeFuture(const TimeFuture&) = delete;
@@ -134,17 +166,12 @@ class [[nodiscard]] TimeFuture
     provider_ = other.provider_;
     expiration_ = other.expiration_;
 
-    // Replace the entry of `other_` in the list.
+    // Replace the entry of `other_` in the list or timer wheel.
+    //
+    // NOTE: this will leave `other` reporting (falsely) that it has expired.
+    // However, `other` should not be used post-`move`.
     if (!other.unlisted()) {
-      auto previous = provider_->futures_.before_begin();
-      while (&*std::next(previous) != &other) {
-        previous++;
-      }
-
-      // NOTE: this will leave `other` reporting (falsely) that it has expired.
-      // However, `other` should not be used post-`move`.
-      other.unlist(&*previous);
-      provider_->futures_.insert_after(previous, *this);
+      this->replace(other);
     }
 
     return *this;
@@ -199,6 +226,7 @@ class [[nodiscard]] TimeFuture
 
  private:
   friend class TimeProvider<Clock>;
+  friend class TimerWheel<Clock>;
 
   /// Constructs a `Timer` from a `TimeProvider` and a `time_point`.
   TimeFuture(TimeProvider<Clock>& provider,
@@ -212,22 +240,27 @@ class [[nodiscard]] TimeFuture
     // Skip enlisting if the expiration of the timer is in the past.
     // NOTE: this *does not* trigger a waker since `Poll` has not yet been
     // invoked, so none has been registered.
-    if (provider_->now() >= expiration_) {
+    const typename Clock::time_point now = provider_->now();
+    if (now >= expiration_) {
       return;
     }
 
-    if (provider_->futures_.empty() ||
-        provider_->futures_.front().expiration_ > expiration_) {
-      provider_->futures_.push_front(*this);
-      provider_->DoInvokeAt(expiration_);
+    if (provider_->wheel_ != nullptr) {
+      if (provider_->wheel_->Insert(*this, now)) {
+        provider_->DoInvokeAt(expiration_);
+      }
       return;
     }
-    auto current = provider_->futures_.begin();
-    while (std::next(current) != provider_->futures_.end() &&
-           std::next(current)->expiration_ < expiration_) {
-      current++;
+
+    auto& futures = provider_->futures_;
+    auto next = futures.begin();
+    while (next != futures.end() && next->expiration_ <= expiration_) {
+      ++next;
     }
-    provider_->futures_.insert_after(current, *this);
+    if (next == futures.begin()) {
+      provider_->DoInvokeAt(expiration_);
+    }
+    futures.insert(next, *this);
   }
 
   void Unlist() PW_LOCKS_EXCLUDED(internal::time_lock()) {
@@ -244,6 +277,17 @@ class [[nodiscard]] TimeFuture
     if (this->unlisted()) {
       return;
     }
+    if (provider_->wheel_ != nullptr) {
+      TimerWheel<Clock>& wheel = *provider_->wheel_;
+      if (wheel.Remove(*this)) {
+        if (wheel.empty()) {
+          provider_->DoCancel();
+        } else {
+          provider_->DoInvokeAt(wheel.next_expiration());
+        }
+      }
+      return;
+    }
     if (&provider_->futures_.front() == this) {
       provider_->futures_.pop_front();
       if (provider_->futures_.empty()) {
@@ -254,7 +298,7 @@ class [[nodiscard]] TimeFuture
       return;
     }
 
-    provider_->futures_.remove(*this);
+    provider_->futures_.erase(*this);
   }
 
   Waker waker_;
@@ -269,9 +313,344 @@ class [[nodiscard]] TimeFuture
   typename Clock::time_point expiration_ PW_GUARDED_BY(internal::time_lock());
 };
 
+/// Generic-size specialization of `TimerWheel`, which is used to refer to a
+/// `TimerWheel` with any number of levels.
+template <typename Clock>
+class TimerWheel<Clock, internal::kGenericTimerWheelLevels> {
+ public:
+  /// The number of slots in each level of the wheel.
+  static constexpr size_t kSlotsPerLevel = 64;
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+ protected:
+  using List = containers::future::IntrusiveList<TimeFuture<Clock>>;
+
+  struct Level {
+    uint64_t occupied = 0;  // Bit `n` is set if `slots[n]` is not empty.
+    std::array<List, kSlotsPerLevel> slots;
+  };
+
+  explicit constexpr TimerWheel(span<Level> levels) : levels_(levels) {}
+
+  ~TimerWheel() = default;
+
+ private:
+  friend class TimeProvider<Clock>;
+  friend class TimeFuture<Clock>;
+
+  static_assert(std::is_integral_v<typename Clock::rep> &&
+                    sizeof(typename Clock::rep) <= sizeof(uint64_t),
+                "TimerWheel requires a clock with an integer tick count");
+
+  static constexpr size_t kSlotBits = 6;
+  static_assert(kSlotsPerLevel == size_t{1} << kSlotBits);
+
+  bool empty() const PW_EXCLUSIVE_LOCKS_REQUIRED(internal::time_lock()) {
+    return size_ == 0;
+  }
+
+  // Returns the expiration of the timer which expires next. The wheel must not
+  // be empty.
+  typename Clock::time_point next_expiration() const
+      PW_EXCLUSIVE_LOCKS_REQUIRED(internal::time_lock()) {
+    return FromTicks(next_);
+  }
+
+  // Adds a timer which expires after `now`. Returns whether it expires before
+  // all other timers in the wheel.
+  bool Insert(TimeFuture<Clock>& future, typename Clock::time_point now)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(internal::time_lock());
+
+  // Removes a timer. Returns whether the next expiration of the wheel changed,
+  // including if the wheel is now empty.
+  bool Remove(TimeFuture<Clock>& future)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(internal::time_lock());
+
+  // Removes and wakes all timers which expire at or before `now`.
+  void RunExpired(typename Clock::time_point now)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(internal::time_lock());
+
+  // Adds a timer to the slot for its expiration relative to the cursor.
+  void Link(TimeFuture<Clock>& future)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(internal::time_lock());
+
+  // Wakes the timers in `list` which expire at or before the cursor, and links
+  // the rest into the slots for their expirations.
+  void ExpireOrLink(List& list)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(internal::time_lock());
+
+  // Returns the ticks of the earliest expiration in the wheel.
+  uint64_t FindNext() const PW_EXCLUSIVE_LOCKS_REQUIRED(internal::time_lock());
+
+  // Returns the ticks at which a timer is placed in the wheel. Timers may only
+  // expire before the cursor if time goes backwards, in which case they are
+  // placed to run the next time the cursor advances.
+  uint64_t Placement(const TimeFuture<Clock>& future) const
+      PW_EXCLUSIVE_LOCKS_REQUIRED(internal::time_lock()) {
+    const uint64_t ticks = ToTicks(future.expiration_);
+    return ticks > cursor_ ? ticks : cursor_ + 1;
+  }
+
+  // Returns the level for a timer placed at `ticks`, which must be after the
+  // cursor. A timer is at level `n` if the highest bit in which its ticks
+  // differ from the cursor is in that level's bits, so every timer in a level
+  // expires before every timer in the levels above it. Levels past the last
+  // refer to `overflow_`.
+  size_t LevelFor(uint64_t ticks) const
+      PW_EXCLUSIVE_LOCKS_REQUIRED(internal::time_lock()) {
+    const int highest_bit = 63 - cpp20::countl_zero(ticks ^ cursor_);
+    return static_cast<size_t>(highest_bit) / kSlotBits;
+  }
+
+  static size_t SlotFor(uint64_t ticks, size_t level) {
+    return static_cast<size_t>(ticks >> (level * kSlotBits)) &
+           (kSlotsPerLevel - 1);
+  }
+
+  // Returns the first tick covered by a slot.
+  uint64_t SlotStart(size_t level, size_t slot) const
+      PW_EXCLUSIVE_LOCKS_REQUIRED(internal::time_lock()) {
+    const size_t shift = (level + 1) * kSlotBits;
+    const uint64_t prefix = shift < 64 ? cursor_ >> shift << shift : 0;
+    return prefix | (uint64_t{slot} << (level * kSlotBits));
+  }
+
+  // Returns whether `a` and `b` differ in bits above the wheel's span.
+  bool OutsideSpan(uint64_t a, uint64_t b) const {
+    const size_t bits = levels_.size() * kSlotBits;
+    return bits < 64 && (a >> bits) != (b >> bits);
+  }
+
+  // Converts times to and from unsigned tick counts, preserving their order.
+  static uint64_t ToTicks(typename Clock::time_point time) {
+    const auto count = time.time_since_epoch().count();
+    if constexpr (std::is_signed_v<typename Clock::rep>) {
+      return static_cast<uint64_t>(static_cast<int64_t>(count)) ^ kSignBit;
+    } else {
+      return static_cast<uint64_t>(count);
+    }
+  }
+
+  static typename Clock::time_point FromTicks(uint64_t ticks) {
+    typename Clock::rep count;
+    if constexpr (std::is_signed_v<typename Clock::rep>) {
+      count = static_cast<typename Clock::rep>(
+          static_cast<int64_t>(ticks ^ kSignBit));
+    } else {
+      count = static_cast<typename Clock::rep>(ticks);
+    }
+    return typename Clock::time_point(typename Clock::duration(count));
+  }
+
+  static constexpr uint64_t kSignBit = uint64_t{1} << 63;
+
+  const span<Level> levels_;
+
+  // Timers which expire beyond the span of the levels.
+  List overflow_ PW_GUARDED_BY(internal::time_lock());
+
+  // The time to which the wheel has advanced. Timers are placed in slots by
+  // their expiration relative to the cursor.
+  uint64_t cursor_ PW_GUARDED_BY(internal::time_lock()) = 0;
+
+  // The earliest expiration in the wheel, if it is not empty.
+  uint64_t next_ PW_GUARDED_BY(internal::time_lock()) = 0;
+
+  size_t size_ PW_GUARDED_BY(internal::time_lock()) = 0;
+};
+
+/// Storage for the waiting timers of a `TimeProvider`, arranged as a
+/// hierarchical timing wheel.
+///
+/// A `TimeProvider` constructed with a `TimerWheel` adds and removes timers in
+/// constant time, regardless of how many timers are waiting. Timers which
+/// expire at the same time are run together.
+///
+/// Each level of the wheel has 64 slots. A slot in the lowest level holds
+/// timers which expire on a single tick of the clock, and each slot of the
+/// next level spans all of the slots of the level below it. As time passes,
+/// the timers in a slot of a higher level are moved to the levels below. A
+/// wheel with `kLevels` levels spans `2^(6 * kLevels)` ticks; timers further
+/// in the future are kept in a list which is searched whenever time passes the
+/// end of the wheel's span. Choose `kLevels` so that the wheel spans the
+/// longest timeout commonly used; four levels span about 4.6 hours of a 1 ms
+/// clock.
+///
+/// Removing the timer which expires next, such as when it is destroyed before
+/// expiring, searches the slot of the timer which expires after it.
+template <typename Clock, size_t kLevels>
+class TimerWheel final : public TimerWheel<Clock> {
+ public:
+  static_assert(kLevels > 0, "TimerWheel must have at least one level");
+
+  constexpr TimerWheel() : TimerWheel<Clock>(levels_) {}
+
+ private:
+  std::array<typename TimerWheel<Clock>::Level, kLevels> levels_;
+};
+
+template <typename Clock>
+bool TimerWheel<Clock>::Insert(TimeFuture<Clock>& future,
+                               typename Clock::time_point now) {
+  if (size_ == 0) {
+    cursor_ = ToTicks(now);
+  }
+  Link(future);
+  size_ += 1;
+
+  const uint64_t ticks = ToTicks(future.expiration_);
+  if (size_ == 1 || ticks < next_) {
+    next_ = ticks;
+    return true;
+  }
+  return false;
+}
+
+template <typename Clock>
+bool TimerWheel<Clock>::Remove(TimeFuture<Clock>& future) {
+  const uint64_t placement = Placement(future);
+  const size_t level = LevelFor(placement);
+  if (level < levels_.size()) {
+    const size_t slot = SlotFor(placement, level);
+    List& list = levels_[level].slots[slot];
+    list.erase(future);
+    if (list.empty()) {
+      levels_[level].occupied &= ~(uint64_t{1} << slot);
+    }
+  } else {
+    overflow_.erase(future);
+  }
+  size_ -= 1;
+
+  if (size_ == 0) {
+    return true;
+  }
+  const uint64_t ticks = ToTicks(future.expiration_);
+  if (ticks != next_) {
+    return false;
+  }
+  next_ = FindNext();
+  return next_ != ticks;
+}
+
+template <typename Clock>
+void TimerWheel<Clock>::RunExpired(typename Clock::time_point now) {
+  const uint64_t now_ticks = ToTicks(now);
+  while (size_ != 0) {
+    size_t level = 0;
+    while (level < levels_.size() && levels_[level].occupied == 0) {
+      level += 1;
+    }
+
+    if (level == levels_.size()) {
+      // Only timers beyond the wheel's span remain. Advance to the earliest of
+      // them, and move the rest into the wheel if they are now within its
+      // span.
+      const uint64_t earliest = FindNext();
+      if (earliest > now_ticks) {
+        break;
+      }
+      cursor_ = std::max(cursor_, earliest);
+      ExpireOrLink(overflow_);
+      continue;
+    }
+
+    // Advance to the start of the first occupied slot in the lowest occupied
+    // level. Timers in the lowest level expire there; timers in higher levels
+    // either expire there or move to a lower level.
+    const size_t slot =
+        static_cast<size_t>(cpp20::countr_zero(levels_[level].occupied));
+    const uint64_t start = SlotStart(level, slot);
+    if (start > now_ticks) {
+      break;
+    }
+    levels_[level].occupied &= ~(uint64_t{1} << slot);
+    cursor_ = start;
+    ExpireOrLink(levels_[level].slots[slot]);
+  }
+
+  // All remaining timers expire after `now`, so advancing the cursor leaves
+  // timers within the wheel in the same slots. Timers beyond its span are
+  // moved if the span changes.
+  if (now_ticks > cursor_) {
+    const bool span_changed = OutsideSpan(now_ticks, cursor_);
+    cursor_ = now_ticks;
+    if (span_changed) {
+      ExpireOrLink(overflow_);
+    }
+  }
+
+  if (size_ != 0) {
+    next_ = FindNext();
+  }
+}
+
+template <typename Clock>
+void TimerWheel<Clock>::Link(TimeFuture<Clock>& future) {
+  const uint64_t placement = Placement(future);
+  const size_t level = LevelFor(placement);
+  if (level >= levels_.size()) {
+    overflow_.push_back(future);
+    return;
+  }
+  const size_t slot = SlotFor(placement, level);
+  levels_[level].slots[slot].push_back(future);
+  levels_[level].occupied |= uint64_t{1} << slot;
+}
+
+template <typename Clock>
+void TimerWheel<Clock>::ExpireOrLink(List& list) {
+  List pending;
+  pending.splice(pending.end(), list);
+  while (!pending.empty()) {
+    TimeFuture<Clock>& future = pending.front();
+    pending.pop_front();
+    if (ToTicks(future.expiration_) <= cursor_) {
+      size_ -= 1;
+      std::move(future.waker_).Wake();
+    } else {
+      Link(future);
+    }
+  }
+}
+
+template <typename Clock>
+uint64_t TimerWheel<Clock>::FindNext() const {
+  const List* list = &overflow_;
+  for (size_t level = 0; level < levels_.size(); ++level) {
+    const uint64_t occupied = levels_[level].occupied;
+    if (occupied == 0) {
+      continue;
+    }
+    list = &levels_[level].slots[static_cast<size_t>(
+        cpp20::countr_zero(occupied))];
+
+    // All timers in a slot of the lowest level expire on the same tick.
+    if (level == 0) {
+      return ToTicks(list->begin()->expiration_);
+    }
+    break;
+  }
+
+  uint64_t earliest = std::numeric_limits<uint64_t>::max();
+  for (const TimeFuture<Clock>& future : *list) {
+    earliest = std::min(earliest, ToTicks(future.expiration_));
+  }
+  return earliest;
+}
+
 template <typename Clock>
 void TimeProvider<Clock>::RunExpired(typename Clock::time_point now) {
   std::lock_guard lock(internal::time_lock());
+  if (wheel_ != nullptr) {
+    wheel_->RunExpired(now);
+    if (!wheel_->empty()) {
+      DoInvokeAt(wheel_->next_expiration());
+    }
+    return;
+  }
   while (!futures_.empty()) {
     if (futures_.front().expiration_ > now) {
       DoInvokeAt(futures_.front().expiration_);
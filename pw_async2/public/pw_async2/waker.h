@@ -13,11 +13,13 @@
 // the License.
 #pragma once
 
+#include <atomic>
+
 #include "pw_assert/assert.h"
 #include "pw_async2/internal/config.h"
-#include "pw_async2/lock.h"
 #include "pw_containers/intrusive_forward_list.h"
 #include "pw_log/tokenized_args.h"
+#include "pw_sync/interrupt_spin_lock.h"
 #include "pw_sync/lock_annotations.h"
 
 namespace pw::async2 {
@@ -29,8 +31,7 @@ namespace internal {
 
 bool CloneWaker(Waker& waker_in,
                 Waker& waker_out,
-                log::Token wait_reason = log::kDefaultToken)
-    PW_LOCKS_EXCLUDED(impl::dispatcher_lock());
+                log::Token wait_reason = log::kDefaultToken);
 
 }  // namespace internal
 
@@ -149,13 +150,13 @@ class Waker : public pw::IntrusiveForwardList<Waker>::Item {
 
  public:
   constexpr Waker() = default;
-  Waker(Waker&& other) noexcept PW_LOCKS_EXCLUDED(impl::dispatcher_lock());
+  Waker(Waker&& other) noexcept PW_LOCKS_EXCLUDED(other.dispatcher_lock());
 
   /// Replace this ``Waker`` with another.
   ///
   /// This operation is guaranteed to be thread-safe.
   Waker& operator=(Waker&& other) noexcept
-      PW_LOCKS_EXCLUDED(impl::dispatcher_lock());
+      PW_LOCKS_EXCLUDED(dispatcher_lock(), other.dispatcher_lock());
 
   ~Waker() noexcept { RemoveFromTaskWakerList(); }
 
@@ -168,7 +169,7 @@ class Waker : public pw::IntrusiveForwardList<Waker>::Item {
   /// wake up and make progress.
   ///
   /// This operation is guaranteed to be thread-safe.
-  void Wake() && PW_LOCKS_EXCLUDED(impl::dispatcher_lock());
+  void Wake() && PW_LOCKS_EXCLUDED(dispatcher_lock());
 
   /// Returns whether this ``Waker`` is empty.
   ///
@@ -178,7 +179,7 @@ class Waker : public pw::IntrusiveForwardList<Waker>::Item {
   /// moved-from ``Waker`` will be empty.
   ///
   /// This operation is guaranteed to be thread-safe.
-  [[nodiscard]] bool IsEmpty() const PW_LOCKS_EXCLUDED(impl::dispatcher_lock());
+  [[nodiscard]] bool IsEmpty() const;
 
   /// Clears this ``Waker``.
   ///
@@ -186,7 +187,7 @@ class Waker : public pw::IntrusiveForwardList<Waker>::Item {
   /// ``IsEmpty`` will return ``true``.
   ///
   /// This operation is guaranteed to be thread-safe.
-  void Clear() PW_LOCKS_EXCLUDED(impl::dispatcher_lock()) {
+  void Clear() PW_LOCKS_EXCLUDED(dispatcher_lock()) {
     RemoveFromTaskWakerList();
   }
 
@@ -195,9 +196,7 @@ class Waker : public pw::IntrusiveForwardList<Waker>::Item {
                                    Waker& waker_out,
                                    log::Token wait_reason);
 
-  Waker(Task& task) PW_LOCKS_EXCLUDED(impl::dispatcher_lock()) : task_(&task) {
-    InsertIntoTaskWakerList();
-  }
+  Waker(Task& task) { InsertIntoTaskWakerList(task); }
 
   /// INTERNAL-ONLY: users should use the `PW_ASYNC_CLONE_WAKER` macro.
   ///
@@ -207,18 +206,45 @@ class Waker : public pw::IntrusiveForwardList<Waker>::Item {
   /// the different ``Waker``s that may wake up a ``Task``.
   ///
   /// This operation is guaranteed to be thread-safe.
+  ///
+  /// ``waker_out`` must be empty or guarded by the same lock as this ``Waker``.
   void InternalCloneIntoLocked(Waker& waker_out, log::Token wait_reason) &
-      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
+      PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
 
-  void InsertIntoTaskWakerList();
-  void InsertIntoTaskWakerListLocked()
-      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
-  void RemoveFromTaskWakerList();
+  // The lock of the dispatcher ``task_`` is posted to. This names the lock in
+  // thread safety annotations, and must only be called while the waker is not
+  // empty.
+  pw::sync::InterruptSpinLock& dispatcher_lock() const {
+    return *lock_.load(std::memory_order_relaxed);
+  }
+
+  // Acquires ``dispatcher_lock()`` and returns it, or returns null without
+  // acquiring a lock if the waker is empty. The lock is released with
+  // ``UnlockDispatcher``, which must be passed the returned lock since
+  // ``dispatcher_lock()`` may change while it is held.
+  pw::sync::InterruptSpinLock* LockDispatcher() const
+      PW_EXCLUSIVE_TRYLOCK_FUNCTION(true, dispatcher_lock());
+  void UnlockDispatcher(pw::sync::InterruptSpinLock& lock) const
+      PW_UNLOCK_FUNCTION(dispatcher_lock());
+
+  // Tells thread safety analysis that this waker is empty or refers to the
+  // same lock as ``other``.
+  void AssertSameLockAs(const Waker& other) const
+      PW_EXCLUSIVE_LOCKS_REQUIRED(other.dispatcher_lock())
+          PW_ASSERT_EXCLUSIVE_LOCK(dispatcher_lock());
+
+  void InsertIntoTaskWakerList(Task& task);
+  void RemoveFromTaskWakerList() PW_LOCKS_EXCLUDED(dispatcher_lock());
   void RemoveFromTaskWakerListLocked()
-      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
+      PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
 
   // The ``Task`` to poll when awoken.
-  Task* task_ PW_GUARDED_BY(impl::dispatcher_lock()) = nullptr;
+  Task* task_ PW_GUARDED_BY(dispatcher_lock()) = nullptr;
+
+  // The lock of the dispatcher ``task_`` is posted to, or null if the waker is
+  // empty. This is only changed with the lock it points to held, so it may be
+  // read without the lock to find which lock to acquire.
+  std::atomic<pw::sync::InterruptSpinLock*> lock_ = nullptr;
 
 #if PW_ASYNC2_DEBUG_WAIT_REASON
   log::Token wait_reason_ = log::kDefaultToken;
@@ -14,6 +14,7 @@
 
 #include "pw_async2/system_time_provider.h"
 
+#include "pw_async2/internal/config.h"
 #include "pw_chrono/system_timer.h"
 #include "pw_toolchain/no_destructor.h"
 
@@ -28,6 +29,11 @@ class SystemTimeProvider final : public TimeProvider<SystemClock> {
       : timer_(
             [this](SystemClock::time_point expired) { RunExpired(expired); }) {}
 
+  explicit SystemTimeProvider(TimerWheel<SystemClock>& wheel)
+      : TimeProvider<SystemClock>(wheel),
+        timer_(
+            [this](SystemClock::time_point expired) { RunExpired(expired); }) {}
+
  private:
   SystemClock::time_point now() final { return SystemClock::now(); }
 
@@ -43,7 +49,15 @@ class SystemTimeProvider final : public TimeProvider<SystemClock> {
 }  // namespace
 
 TimeProvider<SystemClock>& GetSystemTimeProvider() {
+#if PW_ASYNC2_CONFIG_SYSTEM_TIME_PROVIDER_TIMER_WHEEL_LEVELS > 0
+  static pw::NoDestructor<TimerWheel<
+      SystemClock,
+      PW_ASYNC2_CONFIG_SYSTEM_TIME_PROVIDER_TIMER_WHEEL_LEVELS>>
+      wheel;
+  static pw::NoDestructor<SystemTimeProvider> time_provider(*wheel);
+#else
   static pw::NoDestructor<SystemTimeProvider> time_provider;
+#endif  // PW_ASYNC2_CONFIG_SYSTEM_TIME_PROVIDER_TIMER_WHEEL_LEVELS > 0
   return *time_provider;
 }
 
@@ -0,0 +1,114 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Compares the cost of timers kept in a sorted list with timers kept in a
+// `TimerWheel`, with many timers waiting at once.
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_async2/simulated_time_provider.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_log/log.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace pw::async2 {
+namespace {
+
+using ::pw::chrono::SystemClock;
+
+constexpr size_t kTimers = 10000;
+
+// Timers expire within this many ticks, which is within the span of a
+// four-level wheel.
+constexpr uint32_t kMaxDelayTicks = 1 << 20;
+
+std::array<TimeFuture<SystemClock>, kTimers> timers;
+
+TimerWheel<SystemClock, 4> wheel;
+SimulatedTimeProvider<SystemClock> list_provider;
+SimulatedTimeProvider<SystemClock> wheel_provider(wheel);
+
+// Starts all timers, with delays from a linear congruential generator.
+void StartTimers(SimulatedTimeProvider<SystemClock>& provider) {
+  uint32_t value = 1;
+  for (TimeFuture<SystemClock>& timer : timers) {
+    value = value * 1664525u + 1013904223u;
+    timer = provider.WaitFor(
+        SystemClock::duration(1 + (value >> 8) % kMaxDelayTicks));
+  }
+}
+
+void LogRate(const char* name,
+             size_t iterations,
+             std::chrono::steady_clock::time_point start) {
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  const double timers_started = static_cast<double>(iterations * kTimers);
+  PW_LOG_INFO(
+      "%s: %.1f ns/timer", name, elapsed.count() * 1e9 / timers_started);
+}
+
+// Starts and then cancels each timer.
+void StartAndCancel(perf_test::State& state,
+                    SimulatedTimeProvider<SystemClock>& provider,
+                    const char* name) {
+  size_t iterations = 0;
+  const auto start = std::chrono::steady_clock::now();
+  while (state.KeepRunning()) {
+    StartTimers(provider);
+    for (TimeFuture<SystemClock>& timer : timers) {
+      timer = TimeFuture<SystemClock>();
+    }
+    iterations += 1;
+  }
+  LogRate(name, iterations, start);
+}
+
+// Starts each timer, and then advances time until all have expired.
+void StartAndExpire(perf_test::State& state,
+                    SimulatedTimeProvider<SystemClock>& provider,
+                    const char* name) {
+  size_t iterations = 0;
+  const auto start = std::chrono::steady_clock::now();
+  while (state.KeepRunning()) {
+    StartTimers(provider);
+    while (provider.AdvanceUntilNextExpiration()) {
+    }
+    iterations += 1;
+  }
+  LogRate(name, iterations, start);
+}
+
+PW_PERF_TEST(SortedList_StartAndCancel10k,
+             StartAndCancel,
+             list_provider,
+             "sorted list");
+PW_PERF_TEST(TimerWheel_StartAndCancel10k,
+             StartAndCancel,
+             wheel_provider,
+             "timer wheel");
+PW_PERF_TEST(SortedList_StartAndExpire10k,
+             StartAndExpire,
+             list_provider,
+             "sorted list");
+PW_PERF_TEST(TimerWheel_StartAndExpire10k,
+             StartAndExpire,
+             wheel_provider,
+             "timer wheel");
+
+}  // namespace
+}  // namespace pw::async2
@@ -0,0 +1,213 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstdint>
+
+#include "pw_async2/dispatcher.h"
+#include "pw_async2/simulated_time_provider.h"
+#include "pw_async2/time_provider.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+using ::pw::async2::Dispatcher;
+using ::pw::async2::SimulatedTimeProvider;
+using ::pw::async2::TimeFuture;
+using ::pw::async2::TimerWheel;
+using ::pw::chrono::SystemClock;
+
+constexpr SystemClock::duration Ticks(int64_t ticks) {
+  return SystemClock::duration(ticks);
+}
+
+// A two-level wheel spans 4096 ticks, so tests can cover timers in each level
+// and beyond the wheel's span.
+class TimerWheelTest : public ::testing::Test {
+ protected:
+  bool IsReady(TimeFuture<SystemClock>& timer) {
+    return dispatcher_.RunPendableUntilStalled(timer).IsReady();
+  }
+
+  TimerWheel<SystemClock, 2> wheel_;
+  SimulatedTimeProvider<SystemClock> tp_{wheel_};
+  Dispatcher dispatcher_;
+};
+
+TEST_F(TimerWheelTest, Timer_ExpiresAtExpiration) {
+  auto timer = tp_.WaitUntil(tp_.now() + Ticks(100));
+  EXPECT_FALSE(IsReady(timer));
+
+  tp_.AdvanceTime(Ticks(99));
+  EXPECT_FALSE(IsReady(timer));
+  tp_.AdvanceTime(Ticks(1));
+  EXPECT_TRUE(IsReady(timer));
+  EXPECT_FALSE(tp_.NextExpiration().has_value());
+}
+
+TEST_F(TimerWheelTest, TimersInEachLevel_ExpireInOrder) {
+  const SystemClock::time_point start = tp_.now();
+  constexpr std::array<int64_t, 8> kExpirations = {
+      100000, 4096, 1, 64, 63, 4095, 65, 5000};
+  constexpr std::array<int64_t, 8> kSorted = {
+      1, 63, 64, 65, 4095, 4096, 5000, 100000};
+
+  std::array<TimeFuture<SystemClock>, kExpirations.size()> timers;
+  for (size_t i = 0; i < timers.size(); ++i) {
+    timers[i] = tp_.WaitUntil(start + Ticks(kExpirations[i]));
+  }
+
+  for (int64_t expiration : kSorted) {
+    ASSERT_EQ(tp_.NextExpiration(), start + Ticks(expiration));
+    ASSERT_TRUE(tp_.AdvanceUntilNextExpiration());
+    for (size_t i = 0; i < timers.size(); ++i) {
+      EXPECT_EQ(IsReady(timers[i]), kExpirations[i] <= expiration);
+    }
+  }
+  EXPECT_FALSE(tp_.AdvanceUntilNextExpiration());
+}
+
+TEST_F(TimerWheelTest, TimersWithSameExpiration_ExpireTogether) {
+  const SystemClock::time_point expiration = tp_.now() + Ticks(300);
+  std::array<TimeFuture<SystemClock>, 4> timers;
+  for (auto& timer : timers) {
+    timer = tp_.WaitUntil(expiration);
+  }
+
+  tp_.AdvanceTime(Ticks(299));
+  for (auto& timer : timers) {
+    EXPECT_FALSE(IsReady(timer));
+  }
+  tp_.AdvanceTime(Ticks(1));
+  for (auto& timer : timers) {
+    EXPECT_TRUE(IsReady(timer));
+  }
+}
+
+TEST_F(TimerWheelTest, DestroyNextTimer_UpdatesNextExpiration) {
+  const SystemClock::time_point start = tp_.now();
+  auto later = tp_.WaitUntil(start + Ticks(200));
+  {
+    auto sooner = tp_.WaitUntil(start + Ticks(100));
+    EXPECT_EQ(tp_.NextExpiration(), start + Ticks(100));
+  }
+  EXPECT_EQ(tp_.NextExpiration(), start + Ticks(200));
+
+  later = TimeFuture<SystemClock>();
+  EXPECT_FALSE(tp_.NextExpiration().has_value());
+}
+
+TEST_F(TimerWheelTest, DestroyOtherTimer_KeepsNextExpiration) {
+  const SystemClock::time_point start = tp_.now();
+  auto sooner = tp_.WaitUntil(start + Ticks(100));
+  {
+    auto later = tp_.WaitUntil(start + Ticks(200));
+  }
+  EXPECT_EQ(tp_.NextExpiration(), start + Ticks(100));
+  tp_.AdvanceTime(Ticks(200));
+  EXPECT_TRUE(IsReady(sooner));
+}
+
+TEST_F(TimerWheelTest, MovedTimer_ExpiresInPlaceOfOriginal) {
+  const SystemClock::time_point start = tp_.now();
+  auto original = tp_.WaitUntil(start + Ticks(1000));
+  TimeFuture<SystemClock> moved = std::move(original);
+  EXPECT_EQ(tp_.NextExpiration(), start + Ticks(1000));
+
+  tp_.AdvanceTime(Ticks(999));
+  EXPECT_FALSE(IsReady(moved));
+  tp_.AdvanceTime(Ticks(1));
+  EXPECT_TRUE(IsReady(moved));
+}
+
+TEST_F(TimerWheelTest, Reset_MovesTimerToNewExpiration) {
+  const SystemClock::time_point start = tp_.now();
+  auto timer = tp_.WaitUntil(start + Ticks(10));
+  timer.Reset(start + Ticks(3000));
+  EXPECT_EQ(tp_.NextExpiration(), start + Ticks(3000));
+
+  tp_.AdvanceTime(Ticks(2999));
+  EXPECT_FALSE(IsReady(timer));
+  tp_.AdvanceTime(Ticks(1));
+  EXPECT_TRUE(IsReady(timer));
+}
+
+TEST_F(TimerWheelTest, TimersBeyondSpan_ExpireAfterTimeCrossesSpan) {
+  const SystemClock::time_point start = tp_.now();
+  auto first = tp_.WaitUntil(start + Ticks(10000));
+  auto second = tp_.WaitUntil(start + Ticks(10001));
+
+  // Advance into the span which contains the timers without expiring them.
+  tp_.AdvanceTime(Ticks(9990));
+  tp_.RunExpiredTimers();
+  EXPECT_FALSE(IsReady(first));
+  EXPECT_EQ(tp_.NextExpiration(), start + Ticks(10000));
+
+  // Insert a timer before them, which is now within the wheel's span.
+  auto third = tp_.WaitUntil(start + Ticks(9995));
+  EXPECT_EQ(tp_.NextExpiration(), start + Ticks(9995));
+
+  tp_.AdvanceTime(Ticks(10));
+  EXPECT_TRUE(IsReady(third));
+  EXPECT_TRUE(IsReady(first));
+  EXPECT_FALSE(IsReady(second));
+  tp_.AdvanceTime(Ticks(1));
+  EXPECT_TRUE(IsReady(second));
+}
+
+TEST(TimerWheel, NegativeTimes_ExpireInOrder) {
+  TimerWheel<SystemClock, 1> wheel;
+  const SystemClock::time_point start{Ticks(-1000)};
+  SimulatedTimeProvider<SystemClock> tp(wheel, start);
+  Dispatcher dispatcher;
+
+  auto positive = tp.WaitUntil(SystemClock::time_point(Ticks(10)));
+  auto negative = tp.WaitUntil(SystemClock::time_point(Ticks(-10)));
+  EXPECT_EQ(tp.NextExpiration(), SystemClock::time_point(Ticks(-10)));
+
+  tp.SetTime(SystemClock::time_point(Ticks(0)));
+  EXPECT_TRUE(dispatcher.RunPendableUntilStalled(negative).IsReady());
+  EXPECT_FALSE(dispatcher.RunPendableUntilStalled(positive).IsReady());
+  tp.SetTime(SystemClock::time_point(Ticks(10)));
+  EXPECT_TRUE(dispatcher.RunPendableUntilStalled(positive).IsReady());
+}
+
+TEST_F(TimerWheelTest, ManyTimers_ExpireExactlyWhenDue) {
+  constexpr size_t kTimers = 200;
+  const SystemClock::time_point start = tp_.now();
+  std::array<TimeFuture<SystemClock>, kTimers> timers;
+
+  // Spread the timers' expirations over two spans of the wheel with a linear
+  // congruential generator.
+  uint32_t value = 1;
+  for (auto& timer : timers) {
+    value = value * 1664525u + 1013904223u;
+    timer = tp_.WaitUntil(start + Ticks(1 + (value >> 8) % 8192));
+  }
+
+  int64_t elapsed = 0;
+  while (elapsed <= 8192) {
+    value = value * 1664525u + 1013904223u;
+    const int64_t step = 1 + (value >> 8) % 300;
+    tp_.AdvanceTime(Ticks(step));
+    elapsed += step;
+    for (auto& timer : timers) {
+      ASSERT_EQ(IsReady(timer), timer.expiration() <= tp_.now());
+    }
+  }
+  EXPECT_FALSE(tp_.NextExpiration().has_value());
+}
+
+}  // namespace
@@ -14,10 +14,11 @@
 
 #include "pw_async2/dispatcher_native.h"
 
-#include <fcntl.h>
 #include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <unistd.h>
 
+#include <array>
 #include <cstring>
 #include <mutex>
 
@@ -25,13 +26,9 @@
 #include "pw_log/log.h"
 #include "pw_preprocessor/compiler.h"
 #include "pw_status/status.h"
+#include "pw_status/try.h"
 
 namespace pw::async2::backend {
-namespace {
-
-constexpr char kNotificationSignal = 'c';
-
-}  // namespace
 
 Status NativeDispatcher::NativeInit() {
   epoll_fd_ = epoll_create1(0);
@@ -40,19 +37,16 @@ Status NativeDispatcher::NativeInit() {
     return Status::Internal();
   }
 
-  int pipefd[2];
-  if (pipe2(pipefd, O_DIRECT | O_NONBLOCK) == -1) {
-    PW_LOG_ERROR("Failed to create pipe: %s", std::strerror(errno));
+  wake_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (wake_fd_ == -1) {
+    PW_LOG_ERROR("Failed to create eventfd: %s", std::strerror(errno));
     return Status::Internal();
   }
 
-  wait_fd_ = pipefd[0];
-  notify_fd_ = pipefd[1];
-
   struct epoll_event event;
   event.events = EPOLLIN;
-  event.data.fd = wait_fd_;
-  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wait_fd_, &event) == -1) {
+  event.data.fd = wake_fd_;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event) == -1) {
     PW_LOG_ERROR("Failed to initialize epoll event for dispatcher");
     return Status::Internal();
   }
@@ -62,7 +56,7 @@ Status NativeDispatcher::NativeInit() {
 
 Poll<> NativeDispatcher::DoRunUntilStalled(Dispatcher& dispatcher, Task* task) {
   {
-    std::lock_guard lock(impl::dispatcher_lock());
+    std::lock_guard lock(dispatcher_lock());
     PW_CHECK(task == nullptr || HasPostedTask(*task),
              "Attempted to run a dispatcher until a task was stalled, "
              "but that task has not been `Post`ed to that `Dispatcher`.");
@@ -80,7 +74,7 @@ Poll<> NativeDispatcher::DoRunUntilStalled(Dispatcher& dispatcher, Task* task) {
 
 void NativeDispatcher::DoRunToCompletion(Dispatcher& dispatcher, Task* task) {
   {
-    std::lock_guard lock(impl::dispatcher_lock());
+    std::lock_guard lock(dispatcher_lock());
     PW_CHECK(task == nullptr || HasPostedTask(*task),
              "Attempted to run a dispatcher until a task was complete, "
              "but that task has not been `Post`ed to that `Dispatcher`.");
@@ -102,13 +96,45 @@ void NativeDispatcher::DoRunToCompletion(Dispatcher& dispatcher, Task* task) {
 }
 
 Status NativeDispatcher::NativeWaitForWake() {
+  if (busy_poll_duration_ > chrono::SystemClock::duration(0)) {
+    PW_TRY_ASSIGN(const bool woken, NativeBusyPoll());
+    if (woken) {
+      return OkStatus();
+    }
+  }
+  return NativePollEvents(/*timeout_ms=*/-1).status();
+}
+
+Result<bool> NativeDispatcher::NativeBusyPoll() {
+  // If the eventfd has already been written, the wake is handled by blocking.
+  WakeState state = kNoWake;
+  if (!wake_state_.compare_exchange_strong(state, kPolling)) {
+    return false;
+  }
+
+  const chrono::SystemClock::time_point deadline =
+      chrono::SystemClock::TimePointAfterAtLeast(busy_poll_duration_);
+  Result<int> events = 0;
+  do {
+    events = NativePollEvents(/*timeout_ms=*/0);
+  } while (events.ok() && *events == 0 &&
+           wake_state_.load(std::memory_order_relaxed) != kWokenWhilePolling &&
+           chrono::SystemClock::now() < deadline);
+
+  // Wakes after this point write to the eventfd.
+  const bool woken = wake_state_.exchange(kNoWake) == kWokenWhilePolling;
+  PW_TRY(events.status());
+  return woken || *events > 0;
+}
+
+Result<int> NativeDispatcher::NativePollEvents(int timeout_ms) {
   std::array<epoll_event, kMaxEventsToProcessAtOnce> events;
 
   int num_events =
-      epoll_wait(epoll_fd_, events.data(), events.size(), /*timeout=*/-1);
+      epoll_wait(epoll_fd_, events.data(), events.size(), timeout_ms);
   if (num_events < 0) {
     if (errno == EINTR) {
-      return OkStatus();
+      return 0;
     }
 
     PW_LOG_ERROR("Dispatcher failed to wait for incoming events: %s",
@@ -118,20 +144,24 @@ Status NativeDispatcher::NativeWaitForWake() {
 
   for (int i = 0; i < num_events; ++i) {
     epoll_event& event = events[i];
-    if (event.data.fd == wait_fd_) {
-      // Consume the wake notification.
-      char unused;
-      ssize_t bytes_read = read(wait_fd_, &unused, 1);
-      PW_CHECK_INT_EQ(
-          bytes_read, 1, "Dispatcher failed to read wake notification");
-      PW_DCHECK_INT_EQ(unused, kNotificationSignal);
+    if (event.data.fd == wake_fd_) {
+      // Consume the wake notification. The state is reset after reading so
+      // that a wake from another thread in between is not lost; the
+      // dispatcher checks for woken tasks after this returns.
+      uint64_t unused;
+      ssize_t bytes_read = read(wake_fd_, &unused, sizeof(unused));
+      PW_CHECK_INT_EQ(bytes_read,
+                      static_cast<ssize_t>(sizeof(unused)),
+                      "Dispatcher failed to read wake notification");
+      wake_state_.store(kNoWake);
       continue;
     }
 
+    ReadWriteWaker& wakers = wakers_[event.data.fd];
+
     // Debug log for missed events.
-    if (PW_LOG_LEVEL >= PW_LOG_LEVEL_DEBUG &&
-        wakers_[event.data.fd].read.IsEmpty() &&
-        wakers_[event.data.fd].write.IsEmpty()) {
+    if (PW_LOG_LEVEL >= PW_LOG_LEVEL_DEBUG && wakers.read.IsEmpty() &&
+        wakers.write.IsEmpty()) {
       PW_LOG_DEBUG(
           "Received an event for registered file descriptor %d, but there is "
           "no task to wake",
@@ -139,14 +169,14 @@ Status NativeDispatcher::NativeWaitForWake() {
     }
 
     if ((event.events & (EPOLLIN | EPOLLRDHUP)) != 0) {
-      std::move(wakers_[event.data.fd].read).Wake();
+      std::move(wakers.read).Wake();
     }
     if ((event.events & EPOLLOUT) != 0) {
-      std::move(wakers_[event.data.fd].write).Wake();
+      std::move(wakers.write).Wake();
     }
   }
 
-  return OkStatus();
+  return num_events;
 }
 
 Status NativeDispatcher::NativeRegisterFileDescriptor(int fd,
@@ -182,13 +212,32 @@ Status NativeDispatcher::NativeUnregisterFileDescriptor(int fd) {
 }
 
 void NativeDispatcher::DoWake() {
-  // Perform a write to unblock the waiting dispatcher.
-  //
-  // We ignore the result of the write, since nonblocking writes can
-  // fail due to there already being messages in the `notify_fd_` pipe.
-  // This is fine, since it means that the dispatcher thread is already queued
-  // to wake up.
-  write(notify_fd_, &kNotificationSignal, 1);
+  // Signal the dispatcher unless a wake is already pending, so that any number
+  // of wakes before the dispatcher handles the first cost one write. While
+  // the dispatcher is busy polling, it checks the state directly and no write
+  // is needed.
+  WakeState state = wake_state_.load();
+  while (true) {
+    switch (state) {
+      case kWakeSignaled:
+      case kWokenWhilePolling:
+        return;
+      case kPolling:
+        if (wake_state_.compare_exchange_weak(state, kWokenWhilePolling)) {
+          return;
+        }
+        break;
+      case kNoWake:
+        if (wake_state_.compare_exchange_weak(state, kWakeSignaled)) {
+          // Writes only fail if the counter would overflow, which it cannot
+          // since it is read before another write.
+          const uint64_t kWake = 1;
+          write(wake_fd_, &kWake, sizeof(kWake));
+          return;
+        }
+        break;
+    }
+  }
 }
 
 }  // namespace pw::async2::backend
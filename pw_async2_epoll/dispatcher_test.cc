@@ -0,0 +1,150 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+#include <thread>
+
+#include "pw_async2/dispatcher.h"
+#include "pw_async2/pend_func_task.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::async2 {
+namespace {
+
+using namespace std::chrono_literals;
+
+// Waits to be woken once by another thread.
+class WokenTask : public Task {
+ public:
+  bool woken() const { return woken_; }
+  Waker& waker() { return waker_; }
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    if (waiting_) {
+      woken_ = true;
+      return Ready();
+    }
+    waiting_ = true;
+    PW_ASYNC_STORE_WAKER(cx, waker_, "test is waiting for another thread");
+    return Pending();
+  }
+
+  Waker waker_;
+  bool waiting_ = false;
+  bool woken_ = false;
+};
+
+void WakeFromOtherThread(chrono::SystemClock::duration busy_poll,
+                         std::chrono::milliseconds delay) {
+  Dispatcher dispatcher;
+  dispatcher.native().NativeSetBusyPollDuration(busy_poll);
+
+  WokenTask task;
+  dispatcher.Post(task);
+  EXPECT_EQ(dispatcher.RunUntilStalled(), Pending());
+
+  std::thread wake_thread([&] {
+    std::this_thread::sleep_for(delay);
+    std::move(task.waker()).Wake();
+  });
+  dispatcher.RunToCompletion();
+  wake_thread.join();
+
+  EXPECT_TRUE(task.woken());
+}
+
+TEST(EpollDispatcher, WakeFromOtherThread_WakesBlockedDispatcher) {
+  WakeFromOtherThread(chrono::SystemClock::duration(0), 10ms);
+}
+
+TEST(EpollDispatcher, WakeFromOtherThread_WakesPollingDispatcher) {
+  WakeFromOtherThread(chrono::SystemClock::for_at_least(1s), 10ms);
+}
+
+TEST(EpollDispatcher, WakeFromOtherThread_AfterBusyPollEnds) {
+  WakeFromOtherThread(chrono::SystemClock::for_at_least(1ms), 20ms);
+}
+
+TEST(EpollDispatcher, ManyWakesFromOtherThread_WakeAllTasks) {
+  Dispatcher dispatcher;
+  std::array<WokenTask, 16> tasks;
+  for (WokenTask& task : tasks) {
+    dispatcher.Post(task);
+  }
+  EXPECT_EQ(dispatcher.RunUntilStalled(), Pending());
+
+  // Wakes which arrive before the dispatcher runs are handled together.
+  std::thread wake_thread([&] {
+    for (WokenTask& task : tasks) {
+      std::move(task.waker()).Wake();
+    }
+  });
+  wake_thread.join();
+  dispatcher.RunToCompletion();
+
+  for (const WokenTask& task : tasks) {
+    EXPECT_TRUE(task.woken());
+  }
+}
+
+TEST(EpollDispatcher, ReadableFileDescriptor_WakesPollingDispatcher) {
+  Dispatcher dispatcher;
+  dispatcher.native().NativeSetBusyPollDuration(
+      chrono::SystemClock::for_at_least(1s));
+
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  ASSERT_EQ(dispatcher.native().NativeRegisterFileDescriptor(
+                fds[0], backend::NativeDispatcher::kReadable),
+            OkStatus());
+
+  bool readable = false;
+  PendFuncTask task([&](Context& cx) -> Poll<> {
+    char byte;
+    if (read(fds[0], &byte, 1) == 1) {
+      readable = true;
+      return Ready();
+    }
+    PW_ASYNC_STORE_WAKER(
+        cx,
+        dispatcher.native().NativeAddReadWakerForFileDescriptor(fds[0]),
+        "test is waiting for the pipe to be readable");
+    return Pending();
+  });
+  ASSERT_EQ(fcntl(fds[0], F_SETFL, O_NONBLOCK), 0);
+  dispatcher.Post(task);
+
+  std::thread write_thread([&] {
+    std::this_thread::sleep_for(10ms);
+    const char byte = 'a';
+    EXPECT_EQ(write(fds[1], &byte, 1), 1);
+  });
+  dispatcher.RunToCompletion();
+  write_thread.join();
+
+  EXPECT_TRUE(readable);
+  EXPECT_EQ(dispatcher.native().NativeUnregisterFileDescriptor(fds[0]),
+            OkStatus());
+  close(fds[0]);
+  close(fds[1]);
+}
+
+}  // namespace
+}  // namespace pw::async2
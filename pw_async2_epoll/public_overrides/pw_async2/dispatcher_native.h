@@ -13,10 +13,20 @@
 // the License.
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <unordered_map>
 
 #include "pw_assert/assert.h"
 #include "pw_async2/dispatcher_base.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_result/result.h"
+
+/// The maximum number of file descriptor events a dispatcher handles each
+/// time it waits. Events beyond this are handled after the woken tasks run.
+#ifndef PW_ASYNC2_EPOLL_MAX_EVENTS
+#define PW_ASYNC2_EPOLL_MAX_EVENTS 32
+#endif  // PW_ASYNC2_EPOLL_MAX_EVENTS
 
 namespace pw::async2::backend {
 
@@ -32,6 +42,10 @@ class NativeDispatcher final : public NativeDispatcherBase {
     kReadWrite = kReadable | kWritable,
   };
 
+  /// Registers a file descriptor to wake the tasks waiting on it.
+  /// Registrations are edge-triggered: a task waiting on a file descriptor is
+  /// woken when it becomes ready, not each time the dispatcher waits while it
+  /// remains ready.
   Status NativeRegisterFileDescriptor(int fd, FileDescriptorType type);
   Status NativeUnregisterFileDescriptor(int fd);
 
@@ -43,10 +57,27 @@ class NativeDispatcher final : public NativeDispatcherBase {
     return wakers_[fd].write;
   }
 
+  /// Sets how long the dispatcher polls for events and wakes before blocking
+  /// in ``epoll_wait`` when it runs out of tasks. Polling uses a core while
+  /// the dispatcher is idle, but wakes received while polling skip a system
+  /// call and a thread wakeup. Defaults to zero, which never polls.
+  void NativeSetBusyPollDuration(chrono::SystemClock::duration duration) {
+    busy_poll_duration_ = duration;
+  }
+
  private:
   friend class ::pw::async2::Dispatcher;
 
-  static constexpr size_t kMaxEventsToProcessAtOnce = 5;
+  static constexpr size_t kMaxEventsToProcessAtOnce =
+      PW_ASYNC2_EPOLL_MAX_EVENTS;
+
+  // Whether a wake is pending, and whether the dispatcher is busy polling.
+  enum WakeState : uint8_t {
+    kNoWake,
+    kWakeSignaled,  // The eventfd has been written.
+    kPolling,       // The dispatcher is busy polling.
+    kWokenWhilePolling,
+  };
 
   struct ReadWriteWaker {
     Waker read;
@@ -58,11 +89,21 @@ class NativeDispatcher final : public NativeDispatcherBase {
   void DoRunToCompletion(Dispatcher&, Task* task);
 
   Status NativeWaitForWake();
-  void NativeFindAndWakeFileDescriptor(int fd, FileDescriptorType type);
+
+  // Polls for events and wakes until ``busy_poll_duration_`` has passed.
+  // Returns ``true`` if the dispatcher was woken or woke a task, or ``false``
+  // if it should block.
+  Result<bool> NativeBusyPoll();
+
+  // Waits up to ``timeout_ms`` for events and wakes the tasks waiting on them.
+  // Returns the number of events handled.
+  Result<int> NativePollEvents(int timeout_ms);
 
   int epoll_fd_;
-  int notify_fd_;
-  int wait_fd_;
+  int wake_fd_;
+
+  std::atomic<WakeState> wake_state_ = kNoWake;
+  chrono::SystemClock::duration busy_poll_duration_{0};
 
   std::unordered_map<int, ReadWriteWaker> wakers_;
 };
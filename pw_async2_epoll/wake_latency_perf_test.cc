@@ -0,0 +1,180 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures the time from waking a task on another thread to the task running,
+// with and without busy polling. Each test logs a histogram of the latencies.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "pw_async2/dispatcher.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_log/log.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace pw::async2 {
+namespace {
+
+using namespace std::chrono_literals;
+
+constexpr uint32_t kWakesPerIteration = 100;
+constexpr size_t kMaxSamples = 100 * kWakesPerIteration;
+
+// Bucket `n` counts latencies from 2^(n - 1) us up to 2^n us. The last bucket
+// counts all longer latencies.
+constexpr size_t kBuckets = 12;
+
+int64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Waits to be woken by another thread, and records how long it took to run
+// after each wake.
+class LatencyTask : public Task {
+ public:
+  void Reset() { wakes_ = 0; }
+
+  void Start() { done_.store(false, std::memory_order_relaxed); }
+  void Stop() { done_.store(true, std::memory_order_relaxed); }
+
+  // Wakes the task once it is waiting. The thread sleeps for `delay` between
+  // checks, so the dispatcher has gone idle by the time it is woken. Returns
+  // false once the test has stopped.
+  bool WakeWhenWaiting(std::chrono::microseconds delay) {
+    do {
+      std::this_thread::sleep_for(delay);
+      if (done_.load(std::memory_order_relaxed)) {
+        return false;
+      }
+    } while (!waiting_.load(std::memory_order_acquire));
+    waiting_.store(false, std::memory_order_relaxed);
+    wake_time_ns_.store(NowNs(), std::memory_order_relaxed);
+    std::move(waker_).Wake();
+    return true;
+  }
+
+  void Log(const char* name) {
+    std::array<uint32_t, kBuckets> buckets{};
+    for (size_t i = 0; i < samples_; ++i) {
+      const int64_t us = latencies_ns_[i] / 1000;
+      size_t bucket = 0;
+      while (bucket < kBuckets - 1 && us >= (int64_t{1} << bucket)) {
+        bucket += 1;
+      }
+      buckets[bucket] += 1;
+    }
+
+    PW_LOG_INFO("%s: %u wakes", name, static_cast<unsigned>(samples_));
+    for (size_t i = 0; i < kBuckets; ++i) {
+      if (buckets[i] == 0) {
+        continue;
+      }
+      if (i == kBuckets - 1) {
+        PW_LOG_INFO("  >= %5u us: %u",
+                    1u << (i - 1),
+                    static_cast<unsigned>(buckets[i]));
+      } else {
+        PW_LOG_INFO(
+            "   < %5u us: %u", 1u << i, static_cast<unsigned>(buckets[i]));
+      }
+    }
+
+    std::sort(latencies_ns_.begin(), latencies_ns_.begin() + samples_);
+    PW_LOG_INFO("  p50: %.1f us, p99: %.1f us",
+                Percentile(50) / 1000.0,
+                Percentile(99) / 1000.0);
+    samples_ = 0;
+  }
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    const int64_t wake_time_ns =
+        wake_time_ns_.exchange(0, std::memory_order_relaxed);
+    if (wake_time_ns != 0 && samples_ < kMaxSamples) {
+      latencies_ns_[samples_++] = NowNs() - wake_time_ns;
+    }
+    if (wakes_ == kWakesPerIteration) {
+      return Ready();
+    }
+    wakes_ += 1;
+    PW_ASYNC_STORE_WAKER(cx, waker_, "waiting for another thread");
+    waiting_.store(true, std::memory_order_release);
+    return Pending();
+  }
+
+  double Percentile(size_t percent) const {
+    if (samples_ == 0) {
+      return 0;
+    }
+    return static_cast<double>(latencies_ns_[(samples_ - 1) * percent / 100]);
+  }
+
+  Waker waker_;
+  uint32_t wakes_ = 0;
+  std::atomic<bool> waiting_ = false;
+  std::atomic<bool> done_ = false;
+  std::atomic<int64_t> wake_time_ns_ = 0;
+
+  std::array<int64_t, kMaxSamples> latencies_ns_;
+  size_t samples_ = 0;
+};
+
+LatencyTask task;
+
+// Wakes the task from another thread, which checks whether the task is waiting
+// every `delay`.
+void WakeLatency(perf_test::State& state,
+                 std::chrono::microseconds busy_poll,
+                 std::chrono::microseconds delay,
+                 const char* name) {
+  Dispatcher dispatcher;
+  dispatcher.native().NativeSetBusyPollDuration(
+      chrono::SystemClock::for_at_least(busy_poll));
+
+  task.Start();
+  std::thread waker_thread([delay] {
+    while (task.WakeWhenWaiting(delay)) {
+    }
+  });
+
+  while (state.KeepRunning()) {
+    task.Reset();
+    dispatcher.Post(task);
+    dispatcher.RunToCompletion();
+  }
+  task.Stop();
+  waker_thread.join();
+  task.Log(name);
+}
+
+PW_PERF_TEST(CrossThreadWake_Blocking,
+             WakeLatency,
+             0us,
+             20us,
+             "blocking in epoll_wait");
+PW_PERF_TEST(CrossThreadWake_BusyPoll100us,
+             WakeLatency,
+             100us,
+             20us,
+             "busy polling for 100 us");
+
+}  // namespace
+}  // namespace pw::async2
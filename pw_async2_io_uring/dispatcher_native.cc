@@ -0,0 +1,443 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_async2/dispatcher_native.h"
+
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+
+#include "pw_assert/check.h"
+#include "pw_log/log.h"
+#include "pw_result/result.h"
+#include "pw_status/status.h"
+
+namespace pw::async2::backend {
+namespace {
+
+// There is no libc wrapper for the io_uring system calls.
+int IoUringSetup(uint32_t entries, io_uring_params& params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+}
+
+int IoUringEnter(int ring_fd,
+                 uint32_t to_submit,
+                 uint32_t min_complete,
+                 uint32_t flags) {
+  return static_cast<int>(syscall(__NR_io_uring_enter,
+                                  ring_fd,
+                                  to_submit,
+                                  min_complete,
+                                  flags,
+                                  nullptr,
+                                  0));
+}
+
+// The ring indices are shared with the kernel, which reads and writes them
+// concurrently.
+uint32_t LoadAcquire(const uint32_t* index) {
+  return __atomic_load_n(index, __ATOMIC_ACQUIRE);
+}
+
+void StoreRelease(uint32_t* index, uint32_t value) {
+  __atomic_store_n(index, value, __ATOMIC_RELEASE);
+}
+
+template <typename T>
+T* RingField(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<std::byte*>(ring) + offset);
+}
+
+}  // namespace
+
+Poll<int32_t> NativeDispatcher::Operation::Pend(Context& cx) {
+  if (state_ == State::kInFlight) {
+    PW_ASYNC_STORE_WAKER(
+        cx, waker_, "io_uring dispatcher is waiting for an I/O operation");
+    return Pending();
+  }
+  state_ = State::kIdle;
+  return result_;
+}
+
+Status NativeDispatcher::NativeInit() {
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  ring_fd_ = IoUringSetup(kEntries, params);
+  if (ring_fd_ == -1) {
+    PW_LOG_ERROR("Failed to set up io_uring: %s", std::strerror(errno));
+    return Status::Internal();
+  }
+
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  cq_ring_size_ =
+      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+  // Newer kernels map both rings with a single mapping.
+  const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    sq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+
+  sq_ring_ = mmap(nullptr,
+                  sq_ring_size_,
+                  PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE,
+                  ring_fd_,
+                  IORING_OFF_SQ_RING);
+  if (sq_ring_ == MAP_FAILED) {
+    sq_ring_ = nullptr;
+    PW_LOG_ERROR("Failed to map io_uring: %s", std::strerror(errno));
+    return Status::Internal();
+  }
+
+  if (single_mmap) {
+    cq_ring_ = sq_ring_;
+  } else {
+    cq_ring_ = mmap(nullptr,
+                    cq_ring_size_,
+                    PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE,
+                    ring_fd_,
+                    IORING_OFF_CQ_RING);
+    if (cq_ring_ == MAP_FAILED) {
+      cq_ring_ = nullptr;
+      PW_LOG_ERROR("Failed to map io_uring: %s", std::strerror(errno));
+      return Status::Internal();
+    }
+  }
+
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  void* sqes = mmap(nullptr,
+                    sqes_size_,
+                    PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE,
+                    ring_fd_,
+                    IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    PW_LOG_ERROR("Failed to map io_uring: %s", std::strerror(errno));
+    return Status::Internal();
+  }
+  sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+  sq_head_ = RingField<uint32_t>(sq_ring_, params.sq_off.head);
+  sq_tail_ = RingField<uint32_t>(sq_ring_, params.sq_off.tail);
+  sq_array_ = RingField<uint32_t>(sq_ring_, params.sq_off.array);
+  sq_mask_ = *RingField<uint32_t>(sq_ring_, params.sq_off.ring_mask);
+  sq_entries_ = params.sq_entries;
+
+  cq_head_ = RingField<uint32_t>(cq_ring_, params.cq_off.head);
+  cq_tail_ = RingField<uint32_t>(cq_ring_, params.cq_off.tail);
+  cq_mask_ = *RingField<uint32_t>(cq_ring_, params.cq_off.ring_mask);
+  cqes_ = RingField<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+
+  // The eventfd is blocking, since io_uring fails reads from nonblocking files
+  // with EAGAIN rather than waiting for them to be readable.
+  wake_fd_ = eventfd(0, EFD_CLOEXEC);
+  if (wake_fd_ == -1) {
+    PW_LOG_ERROR("Failed to create eventfd: %s", std::strerror(errno));
+    return Status::Internal();
+  }
+
+  return NativeQueueWakeRead();
+}
+
+NativeDispatcher::~NativeDispatcher() {
+  if (sqes_ != nullptr) {
+    munmap(sqes_, sqes_size_);
+  }
+  if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) {
+    munmap(cq_ring_, cq_ring_size_);
+  }
+  if (sq_ring_ != nullptr) {
+    munmap(sq_ring_, sq_ring_size_);
+  }
+  if (ring_fd_ != -1) {
+    close(ring_fd_);
+  }
+  if (wake_fd_ != -1) {
+    close(wake_fd_);
+  }
+}
+
+Poll<> NativeDispatcher::DoRunUntilStalled(Dispatcher& dispatcher, Task* task) {
+  {
+    std::lock_guard lock(dispatcher_lock());
+    PW_CHECK(task == nullptr || HasPostedTask(*task),
+             "Attempted to run a dispatcher until a task was stalled, "
+             "but that task has not been `Post`ed to that `Dispatcher`.");
+  }
+  while (true) {
+    RunOneTaskResult result = RunOneTask(dispatcher, task);
+    if (result.completed_main_task() || result.completed_all_tasks()) {
+      return Ready();
+    }
+    if (result.ran_a_task() &&
+        ++tasks_since_poll_ < PW_ASYNC2_IO_URING_TASKS_PER_POLL) {
+      continue;
+    }
+    tasks_since_poll_ = 0;
+
+    // Submit queued operations and collect any that have already completed,
+    // without waiting.
+    Result<size_t> completed = NativeSubmitAndWait(/*min_complete=*/0);
+    PW_CHECK_OK(completed.status());
+    if (!result.ran_a_task() && *completed == 0) {
+      return Pending();
+    }
+  }
+}
+
+void NativeDispatcher::DoRunToCompletion(Dispatcher& dispatcher, Task* task) {
+  {
+    std::lock_guard lock(dispatcher_lock());
+    PW_CHECK(task == nullptr || HasPostedTask(*task),
+             "Attempted to run a dispatcher until a task was complete, "
+             "but that task has not been `Post`ed to that `Dispatcher`.");
+  }
+  while (true) {
+    RunOneTaskResult result = RunOneTask(dispatcher, task);
+    if (result.completed_main_task() || result.completed_all_tasks()) {
+      return;
+    }
+    if (result.ran_a_task()) {
+      if (++tasks_since_poll_ == PW_ASYNC2_IO_URING_TASKS_PER_POLL) {
+        tasks_since_poll_ = 0;
+        if (!NativeSubmitAndWait(/*min_complete=*/0).ok()) {
+          break;
+        }
+      }
+      continue;
+    }
+    tasks_since_poll_ = 0;
+
+    SleepInfo sleep_info = AttemptRequestWake(/*allow_empty=*/false);
+    const uint32_t min_complete = sleep_info.should_sleep() ? 1 : 0;
+    if (!NativeSubmitAndWait(min_complete).ok()) {
+      break;
+    }
+  }
+}
+
+io_uring_sqe* NativeDispatcher::NativeGetSubmissionEntry() {
+  if (*sq_tail_ - LoadAcquire(sq_head_) == sq_entries_) {
+    // The queue is full; submit it to make room.
+    if (!NativeSubmitAndWait(/*min_complete=*/0).ok() ||
+        *sq_tail_ - LoadAcquire(sq_head_) == sq_entries_) {
+      return nullptr;
+    }
+  }
+
+  // Processing completions may have queued an entry, so read the tail after.
+  const uint32_t tail = *sq_tail_;
+  const uint32_t index = tail & sq_mask_;
+  io_uring_sqe* sqe = &sqes_[index];
+  std::memset(sqe, 0, sizeof(*sqe));
+  sq_array_[index] = index;
+  return sqe;
+}
+
+Status NativeDispatcher::NativeSubmit(Operation& operation, io_uring_sqe* sqe) {
+  sqe->user_data = reinterpret_cast<uintptr_t>(&operation);
+  operation.state_ = Operation::State::kInFlight;
+  operation.result_ = 0;
+  StoreRelease(sq_tail_, *sq_tail_ + 1);
+  unsubmitted_ += 1;
+  return OkStatus();
+}
+
+Status NativeDispatcher::NativeSubmitRead(Operation& operation,
+                                          int fd,
+                                          ByteSpan buffer) {
+  if (!operation.idle()) {
+    return Status::FailedPrecondition();
+  }
+  io_uring_sqe* sqe = NativeGetSubmissionEntry();
+  if (sqe == nullptr) {
+    return Status::Internal();
+  }
+  sqe->opcode = IORING_OP_READ;
+  sqe->fd = fd;
+  sqe->off = static_cast<uint64_t>(-1);  // Use the file position, if any.
+  sqe->addr = reinterpret_cast<uintptr_t>(buffer.data());
+  sqe->len = static_cast<uint32_t>(buffer.size());
+  return NativeSubmit(operation, sqe);
+}
+
+Status NativeDispatcher::NativeSubmitWrite(Operation& operation,
+                                           int fd,
+                                           ConstByteSpan data) {
+  if (!operation.idle()) {
+    return Status::FailedPrecondition();
+  }
+  io_uring_sqe* sqe = NativeGetSubmissionEntry();
+  if (sqe == nullptr) {
+    return Status::Internal();
+  }
+  sqe->opcode = IORING_OP_WRITE;
+  sqe->fd = fd;
+  sqe->off = static_cast<uint64_t>(-1);  // Use the file position, if any.
+  sqe->addr = reinterpret_cast<uintptr_t>(data.data());
+  sqe->len = static_cast<uint32_t>(data.size());
+  return NativeSubmit(operation, sqe);
+}
+
+Status NativeDispatcher::NativeSubmitWritev(Operation& operation,
+                                            int fd,
+                                            span<const iovec> iov) {
+  if (!operation.idle()) {
+    return Status::FailedPrecondition();
+  }
+  io_uring_sqe* sqe = NativeGetSubmissionEntry();
+  if (sqe == nullptr) {
+    return Status::Internal();
+  }
+  sqe->opcode = IORING_OP_WRITEV;
+  sqe->fd = fd;
+  sqe->off = static_cast<uint64_t>(-1);  // Use the file position, if any.
+  sqe->addr = reinterpret_cast<uintptr_t>(iov.data());
+  sqe->len = static_cast<uint32_t>(iov.size());
+  return NativeSubmit(operation, sqe);
+}
+
+Status NativeDispatcher::NativeSubmitAccept(Operation& operation, int fd) {
+  if (!operation.idle()) {
+    return Status::FailedPrecondition();
+  }
+  io_uring_sqe* sqe = NativeGetSubmissionEntry();
+  if (sqe == nullptr) {
+    return Status::Internal();
+  }
+  sqe->opcode = IORING_OP_ACCEPT;
+  sqe->fd = fd;
+  sqe->accept_flags = SOCK_CLOEXEC;
+  return NativeSubmit(operation, sqe);
+}
+
+void NativeDispatcher::NativeCancel(Operation& operation) {
+  operation.waker_.Clear();
+  if (!operation.in_flight()) {
+    operation.state_ = Operation::State::kIdle;
+    return;
+  }
+
+  io_uring_sqe* sqe = NativeGetSubmissionEntry();
+  PW_CHECK_NOTNULL(sqe, "Failed to queue an io_uring cancellation");
+  sqe->opcode = IORING_OP_ASYNC_CANCEL;
+  sqe->addr = reinterpret_cast<uintptr_t>(&operation);
+  sqe->user_data = kCancelUserData;
+  StoreRelease(sq_tail_, *sq_tail_ + 1);
+  unsubmitted_ += 1;
+
+  // The operation completes with -ECANCELED, or with its result if it had
+  // already started.
+  while (operation.in_flight()) {
+    PW_CHECK_OK(NativeSubmitAndWait(/*min_complete=*/1).status());
+  }
+  operation.waker_.Clear();
+  operation.state_ = Operation::State::kIdle;
+}
+
+Status NativeDispatcher::NativeQueueWakeRead() {
+  io_uring_sqe* sqe = NativeGetSubmissionEntry();
+  if (sqe == nullptr) {
+    return Status::Internal();
+  }
+  sqe->opcode = IORING_OP_READ;
+  sqe->fd = wake_fd_;
+  sqe->addr = reinterpret_cast<uintptr_t>(&wake_buffer_);
+  sqe->len = sizeof(wake_buffer_);
+  sqe->user_data = kWakeUserData;
+  StoreRelease(sq_tail_, *sq_tail_ + 1);
+  unsubmitted_ += 1;
+  return OkStatus();
+}
+
+Result<size_t> NativeDispatcher::NativeSubmitAndWait(uint32_t min_complete) {
+  size_t completed = 0;
+  while (true) {
+    const int result = IoUringEnter(
+        ring_fd_, unsubmitted_, min_complete, IORING_ENTER_GETEVENTS);
+    if (result >= 0) {
+      unsubmitted_ -= static_cast<uint32_t>(result);
+      break;
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    if (errno == EBUSY || errno == EAGAIN) {
+      // The completion queue is full. Process completions and try again.
+      completed += NativeReapCompletions();
+      continue;
+    }
+    PW_LOG_ERROR("Dispatcher failed to enter io_uring: %s",
+                 std::strerror(errno));
+    return Status::Internal();
+  }
+
+  return completed + NativeReapCompletions();
+}
+
+size_t NativeDispatcher::NativeReapCompletions() {
+  size_t completed = 0;
+  bool queue_wake_read = false;
+
+  uint32_t head = *cq_head_;
+  const uint32_t tail = LoadAcquire(cq_tail_);
+  for (; head != tail; ++head) {
+    const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+    if (cqe.user_data == kWakeUserData) {
+      // A task was woken from another thread. The woken task is already
+      // queued, so only the read needs to be queued again.
+      queue_wake_read = true;
+      continue;
+    }
+    if (cqe.user_data == kCancelUserData) {
+      continue;
+    }
+
+    Operation& operation =
+        *reinterpret_cast<Operation*>(static_cast<uintptr_t>(cqe.user_data));
+    operation.result_ = cqe.res;
+    operation.state_ = Operation::State::kComplete;
+    std::move(operation.waker_).Wake();
+    completed += 1;
+  }
+  StoreRelease(cq_head_, head);
+
+  if (queue_wake_read) {
+    PW_CHECK_OK(NativeQueueWakeRead());
+  }
+  return completed;
+}
+
+void NativeDispatcher::DoWake() {
+  // Complete the dispatcher's read on the eventfd, which wakes it if it is
+  // waiting in io_uring_enter.
+  //
+  // We ignore the result of the write. The eventfd's counter is reset by each
+  // read, so the write cannot block or fail in practice.
+  const uint64_t value = 1;
+  write(wake_fd_, &value, sizeof(value));
+}
+
+}  // namespace pw::async2::backend
@@ -0,0 +1,320 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <optional>
+#include <thread>
+
+#include "pw_async2/dispatcher.h"
+#include "pw_async2/pend_func_task.h"
+#include "pw_bytes/array.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::async2 {
+namespace {
+
+using namespace std::chrono_literals;
+
+using Operation = backend::NativeDispatcher::Operation;
+
+class IoUringDispatcherTest : public ::testing::Test {
+ protected:
+  IoUringDispatcherTest() {
+    int fds[2];
+    PW_ASSERT(pipe(fds) == 0);
+    read_fd_ = fds[0];
+    write_fd_ = fds[1];
+  }
+
+  ~IoUringDispatcherTest() override {
+    close(read_fd_);
+    close(write_fd_);
+  }
+
+  int read_fd_;
+  int write_fd_;
+};
+
+TEST_F(IoUringDispatcherTest, Read_CompletesWhenDataIsWritten) {
+  Dispatcher dispatcher;
+  Operation read_op;
+  std::array<std::byte, 16> buffer{};
+  std::optional<int32_t> result;
+  int polls = 0;
+
+  PendFuncTask task([&](Context& cx) -> Poll<> {
+    ++polls;
+    if (read_op.idle() && polls == 1) {
+      EXPECT_EQ(OkStatus(),
+                dispatcher.native().NativeSubmitRead(
+                    read_op, read_fd_, ByteSpan(buffer)));
+    }
+    Poll<int32_t> poll = read_op.Pend(cx);
+    if (poll.IsPending()) {
+      return Pending();
+    }
+    result = *poll;
+    return Ready();
+  });
+  dispatcher.Post(task);
+
+  EXPECT_EQ(dispatcher.RunUntilStalled(), Pending());
+  EXPECT_TRUE(read_op.in_flight());
+  EXPECT_EQ(polls, 1);
+
+  ASSERT_EQ(write(write_fd_, "hello", 5), 5);
+  dispatcher.RunToCompletion();
+
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(*result, 5);
+  EXPECT_EQ(polls, 2);
+  EXPECT_TRUE(read_op.idle());
+  EXPECT_EQ(std::memcmp(buffer.data(), "hello", 5), 0);
+}
+
+TEST_F(IoUringDispatcherTest, Write_ReturnsBytesWritten) {
+  Dispatcher dispatcher;
+  Operation write_op;
+  constexpr auto kData = bytes::Array<1, 2, 3, 4>();
+  std::optional<int32_t> result;
+
+  PendFuncTask task([&](Context& cx) -> Poll<> {
+    if (write_op.idle()) {
+      EXPECT_EQ(OkStatus(),
+                dispatcher.native().NativeSubmitWrite(
+                    write_op, write_fd_, ConstByteSpan(kData)));
+    }
+    Poll<int32_t> poll = write_op.Pend(cx);
+    if (poll.IsPending()) {
+      return Pending();
+    }
+    result = *poll;
+    return Ready();
+  });
+  dispatcher.Post(task);
+  dispatcher.RunToCompletion();
+
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(*result, 4);
+  std::array<std::byte, 4> buffer;
+  ASSERT_EQ(read(read_fd_, buffer.data(), buffer.size()), 4);
+  EXPECT_EQ(buffer, kData);
+}
+
+TEST_F(IoUringDispatcherTest, Read_ErrorIsNegatedErrno) {
+  Dispatcher dispatcher;
+  Operation read_op;
+  std::array<std::byte, 4> buffer;
+  std::optional<int32_t> result;
+
+  PendFuncTask task([&](Context& cx) -> Poll<> {
+    if (read_op.idle()) {
+      // Reading from the write end of a pipe fails.
+      EXPECT_EQ(OkStatus(),
+                dispatcher.native().NativeSubmitRead(
+                    read_op, write_fd_, ByteSpan(buffer)));
+    }
+    Poll<int32_t> poll = read_op.Pend(cx);
+    if (poll.IsPending()) {
+      return Pending();
+    }
+    result = *poll;
+    return Ready();
+  });
+  dispatcher.Post(task);
+  dispatcher.RunToCompletion();
+
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(*result, -EBADF);
+}
+
+TEST_F(IoUringDispatcherTest, Submit_InFlightOperation_FailsPrecondition) {
+  Dispatcher dispatcher;
+  Operation read_op;
+  std::array<std::byte, 4> buffer;
+
+  EXPECT_EQ(OkStatus(),
+            dispatcher.native().NativeSubmitRead(
+                read_op, read_fd_, ByteSpan(buffer)));
+  EXPECT_EQ(Status::FailedPrecondition(),
+            dispatcher.native().NativeSubmitRead(
+                read_op, read_fd_, ByteSpan(buffer)));
+
+  dispatcher.native().NativeCancel(read_op);
+  EXPECT_TRUE(read_op.idle());
+}
+
+TEST_F(IoUringDispatcherTest, Cancel_ReleasesOperationWithoutWakingTask) {
+  Dispatcher dispatcher;
+  Operation read_op;
+  std::array<std::byte, 4> buffer;
+  int polls = 0;
+
+  PendFuncTask task([&](Context& cx) -> Poll<> {
+    ++polls;
+    if (read_op.idle()) {
+      EXPECT_EQ(OkStatus(),
+                dispatcher.native().NativeSubmitRead(
+                    read_op, read_fd_, ByteSpan(buffer)));
+    }
+    return read_op.Pend(cx).IsReady() ? Ready() : Pending();
+  });
+  dispatcher.Post(task);
+
+  EXPECT_EQ(dispatcher.RunUntilStalled(), Pending());
+  EXPECT_TRUE(read_op.in_flight());
+
+  dispatcher.native().NativeCancel(read_op);
+  EXPECT_TRUE(read_op.idle());
+
+  // Data written after the cancellation is not read.
+  ASSERT_EQ(write(write_fd_, "x", 1), 1);
+  EXPECT_EQ(dispatcher.RunUntilStalled(), Pending());
+  EXPECT_EQ(polls, 1);
+
+  char byte;
+  EXPECT_EQ(read(read_fd_, &byte, 1), 1);
+  task.Deregister();
+}
+
+TEST_F(IoUringDispatcherTest, ManyOperations_SubmitsWhenQueueIsFull) {
+  constexpr size_t kWrites = backend::NativeDispatcher::kEntries * 2;
+  Dispatcher dispatcher;
+  std::array<Operation, kWrites> writes;
+  size_t completed = 0;
+  const std::byte kByte{0x5a};
+
+  PendFuncTask task([&](Context& cx) -> Poll<> {
+    if (completed == 0 && writes[0].idle()) {
+      for (Operation& op : writes) {
+        EXPECT_EQ(OkStatus(),
+                  dispatcher.native().NativeSubmitWrite(
+                      op, write_fd_, ConstByteSpan(&kByte, 1)));
+      }
+    }
+    for (Operation& op : writes) {
+      if (!op.idle()) {
+        Poll<int32_t> poll = op.Pend(cx);
+        if (poll.IsPending()) {
+          return Pending();
+        }
+        EXPECT_EQ(*poll, 1);
+        ++completed;
+      }
+    }
+    return Ready();
+  });
+  dispatcher.Post(task);
+  dispatcher.RunToCompletion();
+
+  EXPECT_EQ(completed, kWrites);
+  std::array<std::byte, kWrites> buffer;
+  EXPECT_EQ(read(read_fd_, buffer.data(), buffer.size()),
+            static_cast<ssize_t>(kWrites));
+}
+
+TEST(IoUringDispatcher, Accept_ReturnsConnectedSocket) {
+  int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  ASSERT_GE(listener, 0);
+
+  // Bind to an abstract socket address, which needs no file.
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  constexpr char kName[] = "pw_async2_io_uring_accept_test";
+  std::memcpy(address.sun_path + 1, kName, sizeof(kName) - 1);
+  const socklen_t address_size =
+      static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + sizeof(kName));
+  ASSERT_EQ(
+      bind(listener, reinterpret_cast<sockaddr*>(&address), address_size), 0);
+  ASSERT_EQ(listen(listener, 1), 0);
+
+  Dispatcher dispatcher;
+  Operation accept_op;
+  std::optional<int32_t> result;
+
+  PendFuncTask task([&](Context& cx) -> Poll<> {
+    if (accept_op.idle() && !result.has_value()) {
+      EXPECT_EQ(OkStatus(),
+                dispatcher.native().NativeSubmitAccept(accept_op, listener));
+    }
+    Poll<int32_t> poll = accept_op.Pend(cx);
+    if (poll.IsPending()) {
+      return Pending();
+    }
+    result = *poll;
+    return Ready();
+  });
+  dispatcher.Post(task);
+  EXPECT_EQ(dispatcher.RunUntilStalled(), Pending());
+
+  int client = socket(AF_UNIX, SOCK_STREAM, 0);
+  ASSERT_GE(client, 0);
+  std::thread connect_thread([&] {
+    std::this_thread::sleep_for(10ms);
+    EXPECT_EQ(
+        connect(client, reinterpret_cast<sockaddr*>(&address), address_size),
+        0);
+  });
+  dispatcher.RunToCompletion();
+  connect_thread.join();
+
+  ASSERT_TRUE(result.has_value());
+  ASSERT_GE(*result, 0);
+  EXPECT_EQ(write(client, "a", 1), 1);
+  char byte;
+  EXPECT_EQ(read(*result, &byte, 1), 1);
+  EXPECT_EQ(byte, 'a');
+
+  close(*result);
+  close(client);
+  close(listener);
+}
+
+TEST(IoUringDispatcher, WakeFromOtherThread_WakesWaitingDispatcher) {
+  Dispatcher dispatcher;
+  Waker waker;
+  bool woken = false;
+  bool waiting = false;
+
+  PendFuncTask task([&](Context& cx) -> Poll<> {
+    if (waiting) {
+      woken = true;
+      return Ready();
+    }
+    waiting = true;
+    PW_ASYNC_STORE_WAKER(cx, waker, "test is waiting for another thread");
+    return Pending();
+  });
+  dispatcher.Post(task);
+  EXPECT_EQ(dispatcher.RunUntilStalled(), Pending());
+
+  std::thread wake_thread([&] {
+    std::this_thread::sleep_for(10ms);
+    std::move(waker).Wake();
+  });
+  dispatcher.RunToCompletion();
+  wake_thread.join();
+
+  EXPECT_TRUE(woken);
+}
+
+}  // namespace
+}  // namespace pw::async2
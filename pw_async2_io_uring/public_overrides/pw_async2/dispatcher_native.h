@@ -0,0 +1,206 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <sys/uio.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_assert/assert.h"
+#include "pw_async2/dispatcher_base.h"
+#include "pw_bytes/span.h"
+#include "pw_result/result.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+
+/// The number of submission queue entries in each dispatcher's io_uring. More
+/// operations than this may be in flight at once, but queueing more than this
+/// many operations between runs of the dispatcher submits them early.
+#ifndef PW_ASYNC2_IO_URING_ENTRIES
+#define PW_ASYNC2_IO_URING_ENTRIES 64
+#endif  // PW_ASYNC2_IO_URING_ENTRIES
+
+/// The number of tasks a dispatcher runs before submitting queued operations
+/// and reaping completions, if it has not run out of tasks first.
+#ifndef PW_ASYNC2_IO_URING_TASKS_PER_POLL
+#define PW_ASYNC2_IO_URING_TASKS_PER_POLL 32
+#endif  // PW_ASYNC2_IO_URING_TASKS_PER_POLL
+
+struct io_uring_cqe;
+struct io_uring_sqe;
+
+namespace pw::async2::backend {
+
+// Windows GCC doesn't realize the nonvirtual destructor is protected and that
+// the class is final.
+PW_MODIFY_DIAGNOSTICS_PUSH();
+PW_MODIFY_DIAGNOSTIC_GCC(ignored, "-Wnon-virtual-dtor");
+
+// A ``Dispatcher`` backend which performs I/O with Linux's io_uring.
+//
+// Tasks queue reads, writes, and accepts with the ``NativeSubmit`` functions.
+// Queued operations are submitted to the kernel together, with one system
+// call, when the dispatcher runs out of tasks to run or every
+// ``PW_ASYNC2_IO_URING_TASKS_PER_POLL`` tasks. When an operation completes,
+// the dispatcher stores its result in the ``Operation`` and wakes the task
+// waiting on it.
+//
+// Wakes from other threads are signaled with an eventfd, which the dispatcher
+// keeps a read queued on, so the dispatcher only ever waits in io_uring.
+//
+// The ``NativeSubmit`` functions and ``NativeCancel`` may only be called from
+// tasks run by this dispatcher, or from the thread which runs it.
+class NativeDispatcher final : public NativeDispatcherBase {
+ public:
+  static constexpr uint32_t kEntries = PW_ASYNC2_IO_URING_ENTRIES;
+
+  // An I/O operation on a file descriptor. An ``Operation`` must not be moved
+  // or destroyed while it is in flight, since the kernel refers to it; cancel
+  // it with ``NativeCancel`` first.
+  class Operation {
+   public:
+    constexpr Operation() = default;
+
+    Operation(const Operation&) = delete;
+    Operation& operator=(const Operation&) = delete;
+
+    ~Operation() { PW_ASSERT(state_ != State::kInFlight); }
+
+    // True if the operation has not been submitted, or if its result has been
+    // returned by ``Pend``.
+    bool idle() const { return state_ == State::kIdle; }
+
+    // True if the operation has been submitted and has not completed.
+    bool in_flight() const { return state_ == State::kInFlight; }
+
+    // Returns the operation's result once it completes, and makes the
+    // operation idle. The result is the return value of the corresponding
+    // system call, or the negated error number if it failed. Stores a waker for
+    // the task if the operation is in flight.
+    Poll<int32_t> Pend(Context& cx);
+
+   private:
+    friend class NativeDispatcher;
+
+    enum class State : uint8_t {
+      kIdle,
+      kInFlight,
+      kComplete,
+    };
+
+    Waker waker_;
+    int32_t result_ = 0;
+    State state_ = State::kIdle;
+  };
+
+  NativeDispatcher() { PW_ASSERT_OK(NativeInit()); }
+
+  ~NativeDispatcher();
+
+  Status NativeInit();
+
+  // Queues a read of up to ``buffer.size()`` bytes from ``fd`` into
+  // ``buffer``. The operation's result is the number of bytes read. The buffer
+  // must remain valid until the operation completes or is canceled.
+  //
+  // Returns:
+  //   OK - The read was queued.
+  //   FAILED_PRECONDITION - The operation is in flight or has an unreturned
+  //       result.
+  //   INTERNAL - The submission queue was full and submitting it failed.
+  Status NativeSubmitRead(Operation& operation, int fd, ByteSpan buffer);
+
+  // Queues a write of ``data`` to ``fd``. The operation's result is the number
+  // of bytes written. The data must remain valid until the operation completes
+  // or is canceled. Returns the same statuses as ``NativeSubmitRead``.
+  Status NativeSubmitWrite(Operation& operation, int fd, ConstByteSpan data);
+
+  // Queues a write of the buffers described by ``iov`` to ``fd``, as with
+  // ``writev``. The ``iovec`` array and the buffers must remain valid until the
+  // operation completes or is canceled. Returns the same statuses as
+  // ``NativeSubmitRead``.
+  Status NativeSubmitWritev(Operation& operation,
+                            int fd,
+                            span<const iovec> iov);
+
+  // Queues an accept on the listening socket ``fd``. The operation's result is
+  // the accepted socket's file descriptor. Returns the same statuses as
+  // ``NativeSubmitRead``.
+  Status NativeSubmitAccept(Operation& operation, int fd);
+
+  // Cancels an operation, and blocks until the kernel has released it.
+  // Completions of other operations are processed while blocked. Afterwards,
+  // the operation is idle and its waker is cleared.
+  void NativeCancel(Operation& operation);
+
+ private:
+  friend class ::pw::async2::Dispatcher;
+
+  // ``user_data`` values which are not ``Operation`` pointers.
+  static constexpr uint64_t kWakeUserData = 0;
+  static constexpr uint64_t kCancelUserData = 1;
+
+  void DoWake() final;
+  Poll<> DoRunUntilStalled(Dispatcher&, Task* task);
+  void DoRunToCompletion(Dispatcher&, Task* task);
+
+  // Returns the next free submission queue entry, submitting queued entries
+  // first if the queue is full. Returns nullptr if that fails.
+  io_uring_sqe* NativeGetSubmissionEntry();
+
+  Status NativeSubmit(Operation& operation, io_uring_sqe* sqe);
+  Status NativeQueueWakeRead();
+
+  // Submits queued entries and waits for at least ``min_complete``
+  // completions, then processes all available completions. Returns the number
+  // of operations which completed.
+  Result<size_t> NativeSubmitAndWait(uint32_t min_complete);
+
+  // Processes all available completions. Returns the number of operations
+  // which completed.
+  size_t NativeReapCompletions();
+
+  int ring_fd_ = -1;
+  int wake_fd_ = -1;
+  uint64_t wake_buffer_ = 0;
+
+  // Submission queue ring, shared with the kernel.
+  void* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  uint32_t* sq_head_ = nullptr;
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t* sq_array_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  // Completion queue ring, shared with the kernel. May be the same mapping as
+  // the submission queue ring.
+  void* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  io_uring_cqe* cqes_ = nullptr;
+
+  // Entries queued in the submission queue but not yet submitted.
+  uint32_t unsubmitted_ = 0;
+  uint32_t tasks_since_poll_ = 0;
+};
+
+PW_MODIFY_DIAGNOSTICS_POP();
+
+}  // namespace pw::async2::backend
@@ -0,0 +1,260 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_async2/dispatcher_native.h"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+#include "pw_assert/check.h"
+
+namespace pw::async2::backend {
+namespace {
+
+// The dispatcher and worker whose tasks this thread is running.
+thread_local const NativeDispatcher* current_dispatcher = nullptr;
+thread_local size_t current_worker = 0;
+
+// Sets the current worker for the lifetime of the object. Saves and restores
+// the previous worker, in case a task runs another dispatcher.
+class CurrentWorkerScope {
+ public:
+  CurrentWorkerScope(const NativeDispatcher& dispatcher, size_t worker)
+      : previous_dispatcher_(current_dispatcher),
+        previous_worker_(current_worker) {
+    current_dispatcher = &dispatcher;
+    current_worker = worker;
+  }
+
+  ~CurrentWorkerScope() {
+    current_dispatcher = previous_dispatcher_;
+    current_worker = previous_worker_;
+  }
+
+ private:
+  const NativeDispatcher* previous_dispatcher_;
+  size_t previous_worker_;
+};
+
+}  // namespace
+
+NativeDispatcher::NativeDispatcher() {
+  NativeSetWorkerCount(std::thread::hardware_concurrency());
+}
+
+void NativeDispatcher::NativeSetWorkerCount(size_t workers) {
+  worker_count_ = std::clamp<size_t>(workers, 1, kMaxWorkers);
+}
+
+void NativeDispatcher::Deregister() {
+  {
+    std::lock_guard lock(dispatcher_lock());
+    for (Worker& worker : workers_) {
+      UnpostTaskList(worker.queue);
+      worker.queued = 0;
+    }
+    queued_ = 0;
+  }
+  NativeDispatcherBase::Deregister();
+}
+
+void NativeDispatcher::DoWake() { WakeOneWorker(); }
+
+void NativeDispatcher::DoPushWokenTask(Task& task) {
+  if (Worker* worker = CurrentWorker(); worker != nullptr) {
+    worker->queue.push_back(task);
+    worker->queued += 1;
+    queued_ += 1;
+  } else {
+    NativeDispatcherBase::DoPushWokenTask(task);
+  }
+  // Let a sleeping worker take or steal the task.
+  WakeOneWorker();
+}
+
+Task* NativeDispatcher::DoPopWokenTask() {
+  Worker* worker = CurrentWorker();
+  if (worker == nullptr) {
+    return NativeDispatcherBase::DoPopWokenTask();
+  }
+
+  // Move one task from the shared queue to the back of this worker's queue
+  // each time, so that tasks woken on this worker do not starve tasks woken
+  // elsewhere.
+  Task* shared = NativeDispatcherBase::DoPopWokenTask();
+  if (shared != nullptr) {
+    worker->queue.push_back(*shared);
+    worker->queued += 1;
+    queued_ += 1;
+  }
+
+  if (worker->queued == 0u && !Steal(*worker)) {
+    worker->running = nullptr;
+    return nullptr;
+  }
+  Task& task = worker->queue.front();
+  worker->queue.pop_front();
+  worker->queued -= 1;
+  queued_ -= 1;
+  worker->running = &task;
+  return &task;
+}
+
+void NativeDispatcher::DoRemoveWokenTask(Task& task) {
+  for (Worker& worker : workers_) {
+    if (worker.queued != 0u && worker.queue.remove(task)) {
+      worker.queued -= 1;
+      queued_ -= 1;
+      return;
+    }
+  }
+  NativeDispatcherBase::DoRemoveWokenTask(task);
+}
+
+bool NativeDispatcher::DoHasWokenTasks() const {
+  return queued_ != 0u || NativeDispatcherBase::DoHasWokenTasks();
+}
+
+pw::sync::Mutex& NativeDispatcher::DoTaskExecutionLock(Task& task) {
+  for (Worker& worker : workers_) {
+    if (worker.running == &task) {
+      return worker.execution_lock;
+    }
+  }
+  // Tasks are only run by workers, so this should be unreachable. If it
+  // happens, Task::Deregister waits on this lock and then checks again.
+  return workers_[0].execution_lock;
+}
+
+Poll<> NativeDispatcher::DoRunUntilStalled(Dispatcher& dispatcher, Task* task) {
+  {
+    std::lock_guard lock(dispatcher_lock());
+    PW_CHECK(task == nullptr || HasPostedTask(*task),
+             "Attempted to run a dispatcher until a task was stalled, "
+             "but that task has not been `Post`ed to that `Dispatcher`.");
+  }
+  CurrentWorkerScope scope(*this, 0);
+  while (true) {
+    RunOneTaskResult result =
+        RunOneTask(dispatcher, task, workers_[0].execution_lock);
+    if (result.completed_main_task() || result.completed_all_tasks()) {
+      return Ready();
+    }
+    if (!result.ran_a_task()) {
+      return Pending();
+    }
+  }
+}
+
+void NativeDispatcher::DoRunToCompletion(Dispatcher& dispatcher, Task* task) {
+  {
+    std::lock_guard lock(dispatcher_lock());
+    PW_CHECK(task == nullptr || HasPostedTask(*task),
+             "Attempted to run a dispatcher until a task was complete, "
+             "but that task has not been `Post`ed to that `Dispatcher`.");
+  }
+  stopping_ = false;
+
+  std::array<std::thread, kMaxWorkers> threads;
+  for (size_t i = 1; i < worker_count_; ++i) {
+    threads[i] = std::thread(
+        [this, &dispatcher, i, task] { RunWorker(dispatcher, i, task); });
+  }
+  RunWorker(dispatcher, 0, task);
+  for (size_t i = 1; i < worker_count_; ++i) {
+    threads[i].join();
+  }
+}
+
+void NativeDispatcher::RunWorker(Dispatcher& dispatcher,
+                                 size_t index,
+                                 Task* task) {
+  CurrentWorkerScope scope(*this, index);
+  Worker& worker = workers_[index];
+  while (!stopping_) {
+    RunOneTaskResult result =
+        RunOneTask(dispatcher, task, worker.execution_lock);
+    if (result.completed_main_task() || result.completed_all_tasks()) {
+      Stop();
+      return;
+    }
+    if (!result.ran_a_task()) {
+      Sleep(worker);
+    }
+  }
+}
+
+void NativeDispatcher::Sleep(Worker& worker) {
+  // Mark the worker as sleeping first, so that tasks woken from here on
+  // release its notification. A release with no matching acquire only causes a
+  // spurious wakeup later.
+  worker.sleeping = true;
+  SleepInfo sleep_info = AttemptRequestWake(/*allow_empty=*/false);
+  if (sleep_info.should_sleep() && !stopping_) {
+    worker.notification.acquire();
+  }
+  worker.sleeping = false;
+}
+
+void NativeDispatcher::Stop() {
+  stopping_ = true;
+  for (Worker& worker : workers_) {
+    if (worker.sleeping.exchange(false)) {
+      worker.notification.release();
+    }
+  }
+}
+
+NativeDispatcher::Worker* NativeDispatcher::CurrentWorker() {
+  if (current_dispatcher != this) {
+    return nullptr;
+  }
+  return &workers_[current_worker];
+}
+
+bool NativeDispatcher::Steal(Worker& thief) {
+  if (queued_ == 0u) {
+    return false;
+  }
+  const size_t thief_index = static_cast<size_t>(&thief - workers_.data());
+  for (size_t i = 1; i < kMaxWorkers; ++i) {
+    Worker& victim = workers_[(thief_index + i) % kMaxWorkers];
+    if (victim.queued == 0u) {
+      continue;
+    }
+    // Take the oldest half of the victim's tasks, rounding up.
+    const size_t count = (victim.queued + 1) / 2;
+    for (size_t j = 0; j < count; ++j) {
+      Task& task = victim.queue.front();
+      victim.queue.pop_front();
+      thief.queue.push_back(task);
+    }
+    victim.queued -= count;
+    thief.queued += count;
+    return true;
+  }
+  return false;
+}
+
+void NativeDispatcher::WakeOneWorker() {
+  for (size_t i = 0; i < worker_count_; ++i) {
+    if (workers_[i].sleeping.exchange(false)) {
+      workers_[i].notification.release();
+      return;
+    }
+  }
+}
+
+}  // namespace pw::async2::backend
@@ -0,0 +1,100 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures how task wakeups scale with the number of worker threads. Each test
+// runs tasks which wake themselves a number of times, doing some work in each
+// Pend, and logs the wakeups per second.
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_async2/dispatcher.h"
+#include "pw_log/log.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace pw::async2 {
+namespace {
+
+constexpr size_t kTasks = 256;
+constexpr uint32_t kWakeupsPerTask = 100;
+
+class SelfWakingTask : public Task {
+ public:
+  void Reset(uint32_t work_iterations) {
+    wakeups_ = 0;
+    work_iterations_ = work_iterations;
+  }
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    // Simulate the work of a Pend call.
+    volatile uint32_t sink = 0;
+    for (uint32_t i = 0; i < work_iterations_; ++i) {
+      sink = i;
+    }
+    static_cast<void>(sink);
+    if (wakeups_ == kWakeupsPerTask) {
+      return Ready();
+    }
+    wakeups_ += 1;
+    cx.ReEnqueue();
+    return Pending();
+  }
+
+  uint32_t wakeups_ = 0;
+  uint32_t work_iterations_ = 0;
+};
+
+std::array<SelfWakingTask, kTasks> tasks;
+
+void WakeupTest(perf_test::State& state,
+                size_t workers,
+                uint32_t work_iterations) {
+  Dispatcher dispatcher;
+  dispatcher.native().NativeSetWorkerCount(workers);
+
+  size_t iterations = 0;
+  const auto start = std::chrono::steady_clock::now();
+  while (state.KeepRunning()) {
+    for (SelfWakingTask& task : tasks) {
+      task.Reset(work_iterations);
+      dispatcher.Post(task);
+    }
+    dispatcher.RunToCompletion();
+    iterations += 1;
+  }
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  PW_LOG_INFO("workers: %u, work per Pend: %u, wakeups/s: %.0f",
+              static_cast<unsigned>(dispatcher.native().NativeWorkerCount()),
+              static_cast<unsigned>(work_iterations),
+              static_cast<double>(iterations * kTasks * kWakeupsPerTask) /
+                  elapsed.count());
+}
+
+PW_PERF_TEST(Wakeups_1Worker, WakeupTest, 1, 0);
+PW_PERF_TEST(Wakeups_2Workers, WakeupTest, 2, 0);
+PW_PERF_TEST(Wakeups_4Workers, WakeupTest, 4, 0);
+PW_PERF_TEST(Wakeups_8Workers, WakeupTest, 8, 0);
+
+PW_PERF_TEST(WakeupsWithWork_1Worker, WakeupTest, 1, 1000);
+PW_PERF_TEST(WakeupsWithWork_2Workers, WakeupTest, 2, 1000);
+PW_PERF_TEST(WakeupsWithWork_4Workers, WakeupTest, 4, 1000);
+PW_PERF_TEST(WakeupsWithWork_8Workers, WakeupTest, 8, 1000);
+
+}  // namespace
+}  // namespace pw::async2
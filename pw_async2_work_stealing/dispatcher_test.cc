@@ -0,0 +1,270 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "pw_async2/dispatcher.h"
+#include "pw_sync/mutex.h"
+#include "pw_sync/thread_notification.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::async2 {
+namespace {
+
+using namespace std::chrono_literals;
+
+// Records the threads it runs on, and checks that it is never run on two
+// threads at once.
+class RecordingTask : public Task {
+ public:
+  explicit RecordingTask(int polls_to_complete = 4,
+                         std::chrono::microseconds work = 500us)
+      : polls_to_complete_(polls_to_complete), work_(work) {}
+
+  int polls() const { return polls_; }
+  bool ran_concurrently() const { return ran_concurrently_; }
+
+  std::set<std::thread::id> threads() const {
+    std::lock_guard lock(mutex_);
+    return threads_;
+  }
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    if (running_.exchange(true)) {
+      ran_concurrently_ = true;
+    }
+    {
+      std::lock_guard lock(mutex_);
+      threads_.insert(std::this_thread::get_id());
+    }
+    if (work_ != 0us) {
+      std::this_thread::sleep_for(work_);
+    }
+    const int polls = ++polls_;
+    running_ = false;
+
+    if (polls == polls_to_complete_) {
+      return Ready();
+    }
+    cx.ReEnqueue();
+    return Pending();
+  }
+
+  const int polls_to_complete_;
+  const std::chrono::microseconds work_;
+  std::atomic<int> polls_ = 0;
+  std::atomic<bool> running_ = false;
+  std::atomic<bool> ran_concurrently_ = false;
+  mutable pw::sync::Mutex mutex_;
+  std::set<std::thread::id> threads_;
+};
+
+TEST(WorkStealingDispatcher, SetWorkerCount_IsClamped) {
+  Dispatcher dispatcher;
+  EXPECT_GE(dispatcher.native().NativeWorkerCount(), 1u);
+
+  dispatcher.native().NativeSetWorkerCount(0);
+  EXPECT_EQ(dispatcher.native().NativeWorkerCount(), 1u);
+
+  dispatcher.native().NativeSetWorkerCount(3);
+  EXPECT_EQ(dispatcher.native().NativeWorkerCount(), 3u);
+
+  dispatcher.native().NativeSetWorkerCount(1000);
+  EXPECT_EQ(dispatcher.native().NativeWorkerCount(),
+            backend::NativeDispatcher::kMaxWorkers);
+}
+
+TEST(WorkStealingDispatcher, RunToCompletion_RunsTasksOnWorkerThreads) {
+  Dispatcher dispatcher;
+  dispatcher.native().NativeSetWorkerCount(4);
+
+  std::array<RecordingTask, 16> tasks;
+  for (RecordingTask& task : tasks) {
+    dispatcher.Post(task);
+  }
+  dispatcher.RunToCompletion();
+
+  std::set<std::thread::id> threads;
+  for (RecordingTask& task : tasks) {
+    EXPECT_EQ(task.polls(), 4);
+    EXPECT_FALSE(task.ran_concurrently());
+    for (std::thread::id id : task.threads()) {
+      threads.insert(id);
+    }
+  }
+  EXPECT_GT(threads.size(), 1u);
+  EXPECT_LE(threads.size(), 4u);
+  EXPECT_EQ(dispatcher.tasks_polled(), 64u);
+  EXPECT_EQ(dispatcher.tasks_completed(), 16u);
+}
+
+TEST(WorkStealingDispatcher, RunUntilStalled_RunsTasksOnCallingThread) {
+  Dispatcher dispatcher;
+  dispatcher.native().NativeSetWorkerCount(4);
+
+  RecordingTask task_1(/*polls_to_complete=*/3, /*work=*/0us);
+  RecordingTask task_2(/*polls_to_complete=*/3, /*work=*/0us);
+  dispatcher.Post(task_1);
+  dispatcher.Post(task_2);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+
+  EXPECT_EQ(task_1.polls(), 3);
+  EXPECT_EQ(task_2.polls(), 3);
+  EXPECT_EQ(task_1.threads(),
+            std::set<std::thread::id>{std::this_thread::get_id()});
+  EXPECT_EQ(task_2.threads(),
+            std::set<std::thread::id>{std::this_thread::get_id()});
+}
+
+// Wakes itself from other threads while it runs.
+class ExternallyWokenTask : public Task {
+ public:
+  std::atomic<bool> done = false;
+  std::atomic<bool> ran_concurrently = false;
+  std::atomic<int> polls = 0;
+
+  void Wake() {
+    std::lock_guard lock(waker_lock_);
+    std::move(waker_).Wake();
+  }
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    if (running_.exchange(true)) {
+      ran_concurrently = true;
+    }
+    ++polls;
+    {
+      std::lock_guard lock(waker_lock_);
+      PW_ASYNC_STORE_WAKER(cx, waker_, "ExternallyWokenTask");
+    }
+    std::this_thread::yield();
+    running_ = false;
+    return done ? Ready() : Pending();
+  }
+
+  std::atomic<bool> running_ = false;
+  pw::sync::Mutex waker_lock_;
+  Waker waker_;
+};
+
+TEST(WorkStealingDispatcher, TaskWokenWhileRunning_IsNotRunConcurrently) {
+  Dispatcher dispatcher;
+  dispatcher.native().NativeSetWorkerCount(4);
+
+  ExternallyWokenTask task;
+  dispatcher.Post(task);
+
+  std::atomic<bool> stop = false;
+  std::array<std::thread, 3> wakers;
+  for (std::thread& thread : wakers) {
+    thread = std::thread([&task, &stop] {
+      while (!stop) {
+        task.Wake();
+        std::this_thread::yield();
+      }
+    });
+  }
+  std::thread finisher([&task] {
+    while (task.polls < 200) {
+      std::this_thread::yield();
+    }
+    task.done = true;
+    task.Wake();
+  });
+
+  dispatcher.RunToCompletion(task);
+  stop = true;
+  finisher.join();
+  for (std::thread& thread : wakers) {
+    thread.join();
+  }
+
+  EXPECT_GE(task.polls, 200);
+  EXPECT_FALSE(task.ran_concurrently);
+}
+
+// Blocks in its first Pend until released, then waits to be woken.
+class BlockingTask : public Task {
+ public:
+  pw::sync::ThreadNotification started;
+  pw::sync::ThreadNotification release;
+  std::atomic<bool> finished_pend = false;
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    if (!finished_pend) {
+      started.release();
+      release.acquire();
+      finished_pend = true;
+    }
+    PW_ASYNC_STORE_WAKER(cx, waker_, "BlockingTask is never woken");
+    return Pending();
+  }
+
+  Waker waker_;
+};
+
+TEST(WorkStealingDispatcher, Deregister_WaitsForRunningTask) {
+  Dispatcher dispatcher;
+  dispatcher.native().NativeSetWorkerCount(2);
+
+  BlockingTask task;
+  dispatcher.Post(task);
+
+  std::atomic<bool> deregistered = false;
+  std::thread deregister_thread([&task, &deregistered] {
+    task.started.acquire();
+    std::thread releaser([&task] {
+      std::this_thread::sleep_for(10ms);
+      task.release.release();
+    });
+    task.Deregister();
+    deregistered = true;
+    EXPECT_TRUE(task.finished_pend);
+    releaser.join();
+  });
+
+  // Returns once the task is deregistered, since no tasks remain.
+  dispatcher.RunToCompletion();
+  deregister_thread.join();
+
+  EXPECT_TRUE(deregistered);
+  EXPECT_FALSE(task.IsRegistered());
+}
+
+TEST(WorkStealingDispatcher, Destructor_UnpostsQueuedTasks) {
+  RecordingTask task_1(/*polls_to_complete=*/2, /*work=*/0us);
+  RecordingTask task_2(/*polls_to_complete=*/2, /*work=*/0us);
+  {
+    Dispatcher dispatcher;
+    dispatcher.Post(task_1);
+    dispatcher.Post(task_2);
+    // Running the first task moves the second to the calling thread's worker
+    // queue.
+    EXPECT_TRUE(dispatcher.RunUntilStalled(task_1).IsReady());
+    EXPECT_TRUE(task_2.IsRegistered());
+  }
+  EXPECT_FALSE(task_1.IsRegistered());
+  EXPECT_FALSE(task_2.IsRegistered());
+}
+
+}  // namespace
+}  // namespace pw::async2
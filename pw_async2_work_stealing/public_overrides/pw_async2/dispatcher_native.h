@@ -0,0 +1,137 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+#include "pw_async2/dispatcher_base.h"
+#include "pw_containers/intrusive_list.h"
+#include "pw_sync/lock_annotations.h"
+#include "pw_sync/mutex.h"
+#include "pw_sync/thread_notification.h"
+
+/// The maximum number of threads which run a dispatcher's tasks at once.
+#ifndef PW_ASYNC2_WORK_STEALING_MAX_WORKERS
+#define PW_ASYNC2_WORK_STEALING_MAX_WORKERS 32
+#endif  // PW_ASYNC2_WORK_STEALING_MAX_WORKERS
+
+namespace pw::async2::backend {
+
+// Windows GCC doesn't realize the nonvirtual destructor is protected and that
+// the class is final.
+PW_MODIFY_DIAGNOSTICS_PUSH();
+PW_MODIFY_DIAGNOSTIC_GCC(ignored, "-Wnon-virtual-dtor");
+
+// A ``Dispatcher`` backend which runs tasks on several threads at once.
+//
+// ``RunToCompletion`` runs tasks on the calling thread and on
+// ``NativeWorkerCount() - 1`` additional worker threads, which it starts and
+// joins. Each worker has its own run queue. Tasks woken by a worker are queued
+// on that worker, and tasks posted or woken from other threads are queued on a
+// shared queue. Each time a worker takes a task, it first moves one task from
+// the shared queue to the back of its own queue, so neither queue starves the
+// other. Workers with empty queues steal half of another worker's queue, and
+// then sleep until a task is woken.
+//
+// A task is never run on more than one thread at a time. A task woken while it
+// is running is queued again once its ``Pend`` returns.
+//
+// ``RunUntilStalled`` runs tasks only on the calling thread.
+class NativeDispatcher final : public NativeDispatcherBase {
+ public:
+  static constexpr size_t kMaxWorkers = PW_ASYNC2_WORK_STEALING_MAX_WORKERS;
+
+  NativeDispatcher();
+
+  // Sets the number of threads, including the calling thread, which run tasks
+  // in ``RunToCompletion``. Defaults to the number of hardware threads, up to
+  // ``kMaxWorkers``. Must not be called while the dispatcher is running.
+  void NativeSetWorkerCount(size_t workers);
+
+  size_t NativeWorkerCount() const { return worker_count_; }
+
+ private:
+  friend class ::pw::async2::Dispatcher;
+
+  // The queue fields are guarded by ``dispatcher_lock()``, which cannot be
+  // named in annotations within this struct.
+  struct Worker {
+    IntrusiveList<Task> queue;
+    size_t queued = 0;
+
+    // The task this worker most recently took from a queue, or null if it
+    // found none. The task may have finished running.
+    const Task* running = nullptr;
+
+    // Set while the worker sleeps, or is about to. Cleared by the thread which
+    // wakes it.
+    std::atomic<bool> sleeping = false;
+
+    // Held while the worker runs a task.
+    pw::sync::Mutex execution_lock;
+    pw::sync::ThreadNotification notification;
+  };
+
+  // Unposts the tasks in worker queues before deregistering the rest.
+  void Deregister() PW_LOCKS_EXCLUDED(dispatcher_lock());
+
+  void DoWake() final;
+
+  void DoPushWokenTask(Task& task) final
+      PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
+  Task* DoPopWokenTask() final PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
+  void DoRemoveWokenTask(Task& task) final
+      PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
+  bool DoHasWokenTasks() const final
+      PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
+  pw::sync::Mutex& DoTaskExecutionLock(Task& task) final
+      PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
+
+  Poll<> DoRunUntilStalled(Dispatcher&, Task* task);
+  void DoRunToCompletion(Dispatcher&, Task* task);
+
+  // Runs tasks as worker `index` until the dispatcher is stopped.
+  void RunWorker(Dispatcher& dispatcher, size_t index, Task* task);
+
+  // Sleeps until a task is woken or the dispatcher is stopped.
+  void Sleep(Worker& worker) PW_LOCKS_EXCLUDED(dispatcher_lock());
+
+  // Stops all workers in ``RunToCompletion``.
+  void Stop();
+
+  // Returns the worker running on this thread, or null if this thread is not
+  // running this dispatcher's tasks.
+  Worker* CurrentWorker();
+
+  // Moves half of another worker's queued tasks to `thief`.
+  bool Steal(Worker& thief) PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
+
+  // Wakes a sleeping worker, if there is one. Does not acquire
+  // ``dispatcher_lock()``, which may or may not be held.
+  void WakeOneWorker();
+
+  size_t worker_count_;
+  std::atomic<bool> stopping_ = false;
+
+  // Tasks in all worker queues.
+  size_t queued_ PW_GUARDED_BY(dispatcher_lock()) = 0;
+
+  std::array<Worker, kMaxWorkers> workers_;
+};
+
+PW_MODIFY_DIAGNOSTICS_POP();
+
+}  // namespace pw::async2::backend
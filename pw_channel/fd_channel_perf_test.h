@@ -0,0 +1,205 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+// Loopback benchmarks for channels backed by file descriptors. Both ends of a
+// Unix socket pair are wrapped in channels run by a single dispatcher.
+
+#include <sys/socket.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "pw_allocator/libc_allocator.h"
+#include "pw_assert/check.h"
+#include "pw_async2/dispatcher.h"
+#include "pw_channel/channel.h"
+#include "pw_log/log.h"
+#include "pw_multibuf/simple_allocator.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace pw::channel::perf_test {
+
+// Each round, a task sends messages and then receives a reply, or receives and
+// then replies.
+struct ExchangeConfig {
+  uint32_t rounds;
+  bool receive_first;
+  uint32_t messages_per_round;
+  size_t message_size;
+  size_t reply_size;
+};
+
+class ExchangeTask : public async2::Task {
+ public:
+  ExchangeTask(ByteReaderWriter& channel, const ExchangeConfig& config)
+      : channel_(channel), config_(config) {}
+
+  void Reset() {
+    round_ = 0;
+    sent_ = 0;
+    received_ = 0;
+    receiving_ = config_.receive_first;
+  }
+
+ private:
+  async2::Poll<> DoPend(async2::Context& cx) override {
+    while (round_ < config_.rounds) {
+      if (receiving_) {
+        const size_t size =
+            config_.receive_first
+                ? config_.messages_per_round * config_.message_size
+                : config_.reply_size;
+        if (PendReceive(cx, size).IsPending()) {
+          return async2::Pending();
+        }
+        receiving_ = false;
+        if (!config_.receive_first) {
+          round_ += 1;
+        }
+        continue;
+      }
+
+      const bool replying = config_.receive_first;
+      const uint32_t messages = replying ? 1 : config_.messages_per_round;
+      const size_t size = replying ? config_.reply_size : config_.message_size;
+      while (sent_ < messages) {
+        if (PendStage(cx, size).IsPending()) {
+          return async2::Pending();
+        }
+        sent_ += 1;
+      }
+      async2::Poll<Status> written = channel_.PendWrite(cx);
+      if (written.IsPending()) {
+        return async2::Pending();
+      }
+      PW_CHECK_OK(*written);
+      sent_ = 0;
+      receiving_ = true;
+      if (replying) {
+        round_ += 1;
+      }
+    }
+    return async2::Ready();
+  }
+
+  // Stages a message. Messages are written by PendWrite once all of a round's
+  // messages are staged.
+  async2::Poll<> PendStage(async2::Context& cx, size_t size) {
+    async2::Poll<Status> ready = channel_.PendReadyToWrite(cx);
+    if (ready.IsPending()) {
+      return async2::Pending();
+    }
+    PW_CHECK_OK(*ready);
+
+    async2::Poll<std::optional<multibuf::MultiBuf>> buffer =
+        channel_.PendAllocateWriteBuffer(cx, size);
+    if (buffer.IsPending()) {
+      return async2::Pending();
+    }
+    PW_CHECK(buffer->has_value());
+    PW_CHECK_OK(channel_.StageWrite(std::move(**buffer)));
+    return async2::Ready();
+  }
+
+  async2::Poll<> PendReceive(async2::Context& cx, size_t size) {
+    while (received_ < size) {
+      async2::Poll<Result<multibuf::MultiBuf>> read = channel_.PendRead(cx);
+      if (read.IsPending()) {
+        return async2::Pending();
+      }
+      PW_CHECK_OK(read->status());
+      received_ += (**read).size();
+    }
+    PW_CHECK_UINT_EQ(received_, size, "Received more data than was sent");
+    received_ = 0;
+    return async2::Ready();
+  }
+
+  ByteReaderWriter& channel_;
+  const ExchangeConfig config_;
+  uint32_t round_ = 0;
+  uint32_t sent_ = 0;
+  size_t received_ = 0;
+  bool receiving_ = false;
+};
+
+// Runs a client and server task over a socket pair, and logs the number of
+// rounds and bytes exchanged per second.
+template <typename ChannelType>
+void RunExchange(pw::perf_test::State& state,
+                 const char* name,
+                 const ExchangeConfig& client_config) {
+  int fds[2];
+  PW_CHECK_INT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+  std::array<std::byte, 64 * 1024> data_area;
+  multibuf::SimpleAllocator allocator(data_area,
+                                     allocator::GetLibCAllocator());
+  async2::Dispatcher dispatcher;
+  ChannelType client(fds[0], dispatcher, allocator);
+  ChannelType server(fds[1], dispatcher, allocator);
+
+  ExchangeConfig server_config = client_config;
+  server_config.receive_first = !client_config.receive_first;
+  ExchangeTask client_task(client.channel(), client_config);
+  ExchangeTask server_task(server.channel(), server_config);
+
+  uint32_t iterations = 0;
+  const auto start = std::chrono::steady_clock::now();
+  while (state.KeepRunning()) {
+    client_task.Reset();
+    server_task.Reset();
+    dispatcher.Post(client_task);
+    dispatcher.Post(server_task);
+    dispatcher.RunToCompletion();
+    iterations += 1;
+  }
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  const double rounds =
+      static_cast<double>(iterations) * client_config.rounds;
+  const double bytes = rounds * client_config.messages_per_round *
+                       static_cast<double>(client_config.message_size);
+  PW_LOG_INFO("%s: %.0f rounds/s, %.1f us/round, %.1f MB/s",
+              name,
+              rounds / elapsed.count(),
+              elapsed.count() * 1e6 / rounds,
+              bytes / elapsed.count() / 1e6);
+}
+
+// One 64-byte message and a 64-byte reply per round.
+inline constexpr ExchangeConfig kRoundTrip = {
+    /*rounds=*/1000,
+    /*receive_first=*/false,
+    /*messages_per_round=*/1,
+    /*message_size=*/64,
+    /*reply_size=*/64,
+};
+
+// Sixteen 1 KiB messages and a one-byte acknowledgement per round. The
+// acknowledgement keeps the socket from filling.
+inline constexpr ExchangeConfig kThroughput = {
+    /*rounds=*/100,
+    /*receive_first=*/false,
+    /*messages_per_round=*/16,
+    /*message_size=*/1024,
+    /*reply_size=*/1,
+};
+
+}  // namespace pw::channel::perf_test
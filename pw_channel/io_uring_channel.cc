@@ -0,0 +1,148 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_channel/io_uring_channel.h"
+
+#include <unistd.h>
+
+#include <cstring>
+
+#include "pw_log/log.h"
+#include "pw_status/try.h"
+
+namespace pw::channel {
+
+async2::Poll<Result<multibuf::MultiBuf>> IoUringChannel::DoPendRead(
+    async2::Context& cx) {
+  if (read_.idle()) {
+    read_alloc_future_.SetDesiredSizes(
+        kMinimumReadSize, kDesiredReadSize, pw::multibuf::kNeedsContiguous);
+    async2::Poll<std::optional<multibuf::MultiBuf>> maybe_multibuf =
+        read_alloc_future_.Pend(cx);
+    if (maybe_multibuf.IsPending()) {
+      return async2::Pending();
+    }
+
+    if (!maybe_multibuf->has_value()) {
+      PW_LOG_ERROR("Failed to allocate multibuf for reading");
+      return Status::ResourceExhausted();
+    }
+
+    read_buffer_ = std::move(**maybe_multibuf);
+    multibuf::Chunk& chunk = *read_buffer_.Chunks().begin();
+    PW_TRY(dispatcher_->native().NativeSubmitRead(
+        read_, channel_fd_, ByteSpan(chunk.data(), chunk.size())));
+  }
+
+  async2::Poll<int32_t> result = read_.Pend(cx);
+  if (result.IsPending()) {
+    return async2::Pending();
+  }
+
+  multibuf::MultiBuf buf = std::move(read_buffer_);
+  if (*result < 0) {
+    PW_LOG_ERROR("io_uring channel read failed: %s", std::strerror(-*result));
+    return Status::Internal();
+  }
+  buf.Truncate(static_cast<size_t>(*result));
+  return async2::Ready(std::move(buf));
+}
+
+async2::Poll<Status> IoUringChannel::DoPendReadyToWrite(async2::Context& cx) {
+  async2::Poll<Status> written = DoPendWrite(cx);
+  if (written.IsPending() && queued_write_bytes_ < kMaxQueuedWriteBytes) {
+    // Data staged now is queued behind the write in flight.
+    return OkStatus();
+  }
+  return written;
+}
+
+Status IoUringChannel::DoStageWrite(multibuf::MultiBuf&& data) {
+  if (!write_.idle()) {
+    queued_write_bytes_ += data.size();
+    write_queue_.PushSuffix(std::move(data));
+    return OkStatus();
+  }
+  write_data_ = std::move(data);
+  return SubmitWrite();
+}
+
+async2::Poll<Status> IoUringChannel::DoPendWrite(async2::Context& cx) {
+  while (!write_.idle()) {
+    async2::Poll<int32_t> result = write_.Pend(cx);
+    if (result.IsPending()) {
+      return async2::Pending();
+    }
+
+    if (*result < 0) {
+      PW_LOG_ERROR("io_uring channel write failed: %s",
+                   std::strerror(-*result));
+      write_data_.Release();
+      write_queue_.Release();
+      queued_write_bytes_ = 0;
+      return Status::Internal();
+    }
+
+    // Writes may be partial; submit whatever remains, followed by any data
+    // queued in the meantime.
+    write_data_.DiscardPrefix(static_cast<size_t>(*result));
+    PW_TRY(SubmitWrite());
+  }
+  return OkStatus();
+}
+
+Status IoUringChannel::SubmitWrite() {
+  write_data_.PushSuffix(std::move(write_queue_));
+  queued_write_bytes_ = 0;
+
+  size_t chunks = 0;
+  for (multibuf::Chunk& chunk : write_data_.Chunks()) {
+    if (chunks == write_iov_.size()) {
+      break;
+    }
+    if (!chunk.empty()) {
+      write_iov_[chunks++] = {chunk.data(), chunk.size()};
+    }
+  }
+
+  if (chunks == 0) {
+    // All staged data has been written.
+    write_data_.Release();
+    return OkStatus();
+  }
+
+  Status status = dispatcher_->native().NativeSubmitWritev(
+      write_, channel_fd_, span<const iovec>(write_iov_.data(), chunks));
+  if (!status.ok()) {
+    write_data_.Release();
+  }
+  return status;
+}
+
+void IoUringChannel::Cleanup() {
+  if (channel_fd_ == -1) {
+    return;
+  }
+  dispatcher_->native().NativeCancel(read_);
+  dispatcher_->native().NativeCancel(write_);
+  read_buffer_.Release();
+  write_data_.Release();
+  write_queue_.Release();
+  queued_write_bytes_ = 0;
+  set_closed();
+  close(channel_fd_);
+  channel_fd_ = -1;
+}
+
+}  // namespace pw::channel
@@ -0,0 +1,33 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "fd_channel_perf_test.h"
+#include "pw_channel/io_uring_channel.h"
+
+namespace pw::channel::perf_test {
+namespace {
+
+void RoundTrip(pw::perf_test::State& state) {
+  RunExchange<IoUringChannel>(state, "IoUringChannel round trip", kRoundTrip);
+}
+
+void Throughput(pw::perf_test::State& state) {
+  RunExchange<IoUringChannel>(state, "IoUringChannel throughput", kThroughput);
+}
+
+PW_PERF_TEST(IoUringChannel_RoundTrip, RoundTrip);
+PW_PERF_TEST(IoUringChannel_Throughput, Throughput);
+
+}  // namespace
+}  // namespace pw::channel::perf_test
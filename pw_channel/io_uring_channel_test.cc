@@ -0,0 +1,377 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_channel/io_uring_channel.h"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "pw_assert/check.h"
+#include "pw_async2/dispatcher.h"
+#include "pw_bytes/array.h"
+#include "pw_channel/channel.h"
+#include "pw_multibuf/simple_allocator_for_test.h"
+#include "pw_status/status.h"
+#include "pw_thread/sleep.h"
+#include "pw_thread/thread.h"
+#include "pw_thread_stl/options.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+using namespace std::chrono_literals;
+
+using ::pw::async2::Context;
+using ::pw::async2::Dispatcher;
+using ::pw::async2::Pending;
+using ::pw::async2::Poll;
+using ::pw::async2::Ready;
+using ::pw::async2::Task;
+using ::pw::channel::ByteReader;
+using ::pw::channel::ByteWriter;
+using ::pw::channel::IoUringChannel;
+using ::pw::multibuf::MultiBuf;
+using ::pw::multibuf::test::SimpleAllocatorForTest;
+
+template <typename ChannelKind>
+class ReaderTask : public Task {
+ public:
+  ReaderTask(ChannelKind& channel, int num_reads)
+      : channel_(channel), num_reads_(num_reads) {}
+
+  int poll_count = 0;
+  int read_count = 0;
+  int bytes_read = 0;
+  pw::Status read_status = pw::Status::Unknown();
+
+ private:
+  Poll<> DoPend(Context& cx) final {
+    ++poll_count;
+    while (read_count < num_reads_) {
+      auto result = channel_.PendRead(cx);
+      if (result.IsPending()) {
+        return Pending();
+      }
+      read_status = result->status();
+      if (!result->ok()) {
+        // We hit an error-- call it quits.
+        return Ready();
+      }
+      ++read_count;
+      bytes_read += (**result).size();
+
+      (**result).Release();
+    }
+
+    return Ready();
+  }
+
+  ChannelKind& channel_;
+  int num_reads_;
+};
+
+template <typename ChannelKind>
+class CloseTask : public Task {
+ public:
+  CloseTask(ChannelKind& channel) : channel_(channel) {}
+
+  pw::Status close_status = pw::Status::Unknown();
+
+ private:
+  Poll<> DoPend(Context& cx) final {
+    auto result = channel_.PendClose(cx);
+    if (result.IsPending()) {
+      return Pending();
+    }
+
+    close_status = *result;
+    return Ready();
+  }
+
+  ChannelKind& channel_;
+};
+
+class IoUringChannelTest : public ::testing::Test {
+ protected:
+  IoUringChannelTest() {
+    int pipefd[2];
+    PW_CHECK_INT_NE(pipe(pipefd), -1);
+    read_fd_ = pipefd[0];
+    write_fd_ = pipefd[1];
+  }
+
+  ~IoUringChannelTest() override {
+    close(read_fd_);
+    close(write_fd_);
+  }
+
+  int read_fd_;
+  int write_fd_;
+};
+
+TEST_F(IoUringChannelTest, Read_ValidData_Succeeds) {
+  SimpleAllocatorForTest alloc;
+  Dispatcher dispatcher;
+
+  IoUringChannel channel(read_fd_, dispatcher, alloc);
+  ASSERT_TRUE(channel.is_read_open());
+  ASSERT_TRUE(channel.is_write_open());
+
+  ReaderTask<ByteReader> read_task(channel.channel(), 1);
+  dispatcher.Post(read_task);
+
+  EXPECT_EQ(dispatcher.RunUntilStalled(), Pending());
+  EXPECT_EQ(read_task.poll_count, 1);
+  EXPECT_EQ(read_task.read_count, 0);
+  EXPECT_EQ(read_task.bytes_read, 0);
+
+  pw::Thread work_thread(pw::thread::stl::Options(), [this] {
+    pw::this_thread::sleep_for(100ms);
+    const char* data = "hello world";
+    PW_CHECK_INT_EQ(write(write_fd_, data, 11), 11);
+  });
+
+  dispatcher.RunToCompletion();
+  work_thread.join();
+  EXPECT_EQ(read_task.read_status, pw::OkStatus());
+  EXPECT_EQ(read_task.poll_count, 2);
+  EXPECT_EQ(read_task.read_count, 1);
+  EXPECT_EQ(read_task.bytes_read, 11);
+
+  CloseTask close_task(channel);
+  dispatcher.Post(close_task);
+  EXPECT_EQ(dispatcher.RunUntilStalled(), Ready());
+  EXPECT_EQ(close_task.close_status, pw::OkStatus());
+}
+
+TEST_F(IoUringChannelTest, Read_Closed_ReturnsFailedPrecondition) {
+  SimpleAllocatorForTest alloc;
+  Dispatcher dispatcher;
+
+  IoUringChannel channel(read_fd_, dispatcher, alloc);
+  ASSERT_TRUE(channel.is_read_open());
+  ASSERT_TRUE(channel.is_write_open());
+
+  CloseTask close_task(channel);
+  dispatcher.Post(close_task);
+  EXPECT_EQ(dispatcher.RunUntilStalled(), Ready());
+  EXPECT_EQ(close_task.close_status, pw::OkStatus());
+
+  ReaderTask<ByteReader> read_task(channel.channel(), 1);
+  dispatcher.Post(read_task);
+
+  EXPECT_EQ(dispatcher.RunUntilStalled(), Ready());
+  EXPECT_EQ(read_task.read_status, pw::Status::FailedPrecondition());
+}
+
+TEST_F(IoUringChannelTest, Close_CancelsPendingRead) {
+  SimpleAllocatorForTest alloc;
+  Dispatcher dispatcher;
+
+  IoUringChannel channel(read_fd_, dispatcher, alloc);
+  ReaderTask<ByteReader> read_task(channel.channel(), 1);
+  dispatcher.Post(read_task);
+  EXPECT_EQ(dispatcher.RunUntilStalled(), Pending());
+
+  CloseTask close_task(channel);
+  dispatcher.Post(close_task);
+  EXPECT_EQ(dispatcher.RunUntilStalled(close_task), Ready());
+  EXPECT_EQ(close_task.close_status, pw::OkStatus());
+  EXPECT_FALSE(channel.is_read_open());
+  EXPECT_EQ(read_task.read_count, 0);
+  read_task.Deregister();
+}
+
+template <typename ChannelKind>
+class WriterTask : public Task {
+ public:
+  WriterTask(ChannelKind& channel,
+             int num_writes,
+             pw::ConstByteSpan data_to_write)
+      : max_writes(num_writes),
+        channel_(channel),
+        data_to_write_(data_to_write) {}
+
+  int poll_count = 0;
+  int write_pending_count = 0;
+  int write_count = 0;
+  int max_writes = 0;
+  pw::Status last_write_status = pw::Status::Unknown();
+
+ private:
+  Poll<> DoPend(Context& cx) final {
+    ++poll_count;
+
+    while (write_count < max_writes) {
+      auto result = channel_.PendReadyToWrite(cx);
+      if (result.IsPending()) {
+        ++write_pending_count;
+        return Pending();
+      }
+      last_write_status = *result;
+      if (!result->ok()) {
+        // We hit an error-- call it quits.
+        return Ready();
+      }
+      ++write_count;
+
+      Poll<std::optional<MultiBuf>> multibuf_result =
+          channel_.PendAllocateWriteBuffer(cx, data_to_write_.size());
+      PW_CHECK(multibuf_result.IsReady());
+      PW_CHECK(multibuf_result->has_value());
+      MultiBuf& multibuf = **multibuf_result;
+      std::copy(data_to_write_.begin(), data_to_write_.end(), multibuf.begin());
+
+      last_write_status = channel_.StageWrite(std::move(multibuf));
+
+      Poll<pw::Status> write_status = channel_.PendWrite(cx);
+      if (write_status.IsPending()) {
+        return Pending();
+      }
+
+      PW_CHECK_OK(*write_status);
+    }
+
+    // Wait for the last write to complete.
+    if (channel_.PendWrite(cx).IsPending()) {
+      return Pending();
+    }
+    return Ready();
+  }
+
+  ChannelKind& channel_;
+  pw::ConstByteSpan data_to_write_;
+};
+
+TEST_F(IoUringChannelTest, Write_ValidData_Succeeds) {
+  SimpleAllocatorForTest alloc;
+  Dispatcher dispatcher;
+
+  IoUringChannel channel(write_fd_, dispatcher, alloc);
+  ASSERT_TRUE(channel.is_read_open());
+  ASSERT_TRUE(channel.is_write_open());
+
+  constexpr auto kData = pw::bytes::Initialized<32>(0x3f);
+  WriterTask<ByteWriter> write_task(channel.channel(), 1, kData);
+  dispatcher.Post(write_task);
+
+  dispatcher.RunToCompletion();
+  EXPECT_EQ(write_task.last_write_status, pw::OkStatus());
+
+  std::array<std::byte, 64> buffer;
+  EXPECT_EQ(read(read_fd_, buffer.data(), buffer.size()),
+            static_cast<int>(kData.size()));
+  EXPECT_EQ(std::memcmp(buffer.data(), kData.data(), kData.size()), 0);
+
+  CloseTask close_task(channel);
+  dispatcher.Post(close_task);
+  EXPECT_EQ(dispatcher.RunUntilStalled(), Ready());
+  EXPECT_EQ(close_task.close_status, pw::OkStatus());
+}
+
+TEST_F(IoUringChannelTest, Write_EmptyData_Succeeds) {
+  SimpleAllocatorForTest alloc;
+  Dispatcher dispatcher;
+
+  IoUringChannel channel(write_fd_, dispatcher, alloc);
+  ASSERT_TRUE(channel.is_read_open());
+  ASSERT_TRUE(channel.is_write_open());
+
+  WriterTask<ByteWriter> write_task(channel.channel(), 1, {});
+  dispatcher.Post(write_task);
+
+  dispatcher.RunToCompletion();
+  EXPECT_EQ(write_task.last_write_status, pw::OkStatus());
+
+  CloseTask close_task(channel);
+  dispatcher.Post(close_task);
+  EXPECT_EQ(dispatcher.RunUntilStalled(), Ready());
+  EXPECT_EQ(close_task.close_status, pw::OkStatus());
+}
+
+TEST_F(IoUringChannelTest, Write_Closed_ReturnsFailedPrecondition) {
+  SimpleAllocatorForTest alloc;
+  Dispatcher dispatcher;
+
+  IoUringChannel channel(write_fd_, dispatcher, alloc);
+  ASSERT_TRUE(channel.is_read_open());
+  ASSERT_TRUE(channel.is_write_open());
+
+  CloseTask close_task(channel);
+  dispatcher.Post(close_task);
+  EXPECT_EQ(dispatcher.RunUntilStalled(), Ready());
+  EXPECT_EQ(close_task.close_status, pw::OkStatus());
+
+  WriterTask<ByteWriter> write_task(channel.channel(), 1, {});
+  dispatcher.Post(write_task);
+
+  dispatcher.RunToCompletion();
+  EXPECT_EQ(write_task.last_write_status, pw::Status::FailedPrecondition());
+}
+
+TEST_F(IoUringChannelTest, Destructor_ClosesFileDescriptor) {
+  SimpleAllocatorForTest alloc;
+  Dispatcher dispatcher;
+
+  {
+    IoUringChannel channel(write_fd_, dispatcher, alloc);
+    ASSERT_TRUE(channel.is_read_open());
+    ASSERT_TRUE(channel.is_write_open());
+  }
+
+  const char kArbitraryByte = 'b';
+  EXPECT_EQ(write(write_fd_, &kArbitraryByte, 1), -1);
+  EXPECT_EQ(errno, EBADF);
+}
+
+TEST_F(IoUringChannelTest, PendWrite_WaitsForFullPipeToDrain) {
+  SimpleAllocatorForTest alloc;
+  Dispatcher dispatcher;
+  IoUringChannel channel(write_fd_, dispatcher, alloc);
+
+  constexpr auto kData =
+      pw::bytes::Initialized<decltype(alloc)::data_size_bytes()>('c');
+  constexpr int kWrites = 100;  // Enough to fill the pipe.
+  WriterTask<ByteWriter> write_task(
+      channel.channel(), kWrites, pw::ConstByteSpan(kData));
+  dispatcher.Post(write_task);
+
+  // The task fills the pipe, then waits for its write to complete.
+  EXPECT_EQ(dispatcher.RunUntilStalled(), Pending());
+  EXPECT_LT(write_task.write_count, kWrites);
+
+  // Drain the pipe after a delay.
+  pw::Thread work_thread(pw::thread::stl::Options(), [this] {
+    pw::this_thread::sleep_for(100ms);
+    for (int i = 0; i < kWrites; ++i) {
+      std::array<std::byte, decltype(alloc)::data_size_bytes()> buffer;
+      size_t total = 0;
+      while (total < buffer.size()) {
+        ssize_t bytes = read(read_fd_, buffer.data(), buffer.size() - total);
+        PW_CHECK_INT_GT(bytes, 0);
+        total += static_cast<size_t>(bytes);
+      }
+    }
+  });
+
+  dispatcher.RunToCompletion();
+  work_thread.join();
+
+  EXPECT_EQ(write_task.write_count, kWrites);
+  EXPECT_EQ(write_task.last_write_status, pw::OkStatus());
+}
+
+}  // namespace
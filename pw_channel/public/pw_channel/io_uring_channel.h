@@ -0,0 +1,128 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <sys/uio.h>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+#include "pw_async2/dispatcher.h"
+#include "pw_async2/poll.h"
+#include "pw_channel/channel.h"
+#include "pw_multibuf/allocator.h"
+#include "pw_multibuf/allocator_async.h"
+#include "pw_multibuf/multibuf.h"
+
+namespace pw::channel {
+
+/// @defgroup pw_channel_io_uring
+/// @{
+
+/// Channel implementation which writes to and reads from a file descriptor
+/// with Linux's io_uring.
+///
+/// Reads are submitted to the dispatcher's io_uring and complete directly into
+/// a `MultiBuf` from the channel's allocator. `StageWrite` submits a write of
+/// the staged data, which `PendWrite` waits for. Data staged while a write is
+/// in flight is queued, and written with a single `writev` once the write in
+/// flight completes. Operations from all of a dispatcher's channels are
+/// submitted together.
+///
+/// This channel depends on APIs provided by the io_uring dispatcher and cannot
+/// be used with any other dispatcher backend.
+///
+/// An instantiated IoUringChannel takes ownership of the file descriptor it is
+/// given, and will close it if the channel is closed or destroyed. Users should
+/// not close a channel's file descriptor from outside. Since the kernel refers
+/// to the channel while operations are in flight, the channel cannot be moved.
+class IoUringChannel : public Implement<ByteReaderWriter> {
+ public:
+  IoUringChannel(int channel_fd,
+                 async2::Dispatcher& dispatcher,
+                 multibuf::MultiBufAllocator& allocator)
+      : channel_fd_(channel_fd),
+        dispatcher_(&dispatcher),
+        read_alloc_future_(allocator),
+        write_alloc_future_(allocator) {}
+
+  ~IoUringChannel() override { Cleanup(); }
+
+  IoUringChannel(const IoUringChannel&) = delete;
+  IoUringChannel& operator=(const IoUringChannel&) = delete;
+
+ private:
+  using Operation = async2::backend::NativeDispatcher::Operation;
+
+  static constexpr size_t kMinimumReadSize = 64;
+  static constexpr size_t kDesiredReadSize = 4096;
+
+  // Limits on the data queued while a write is in flight, and on the number of
+  // chunks written by each operation.
+  static constexpr size_t kMaxQueuedWriteBytes = 16384;
+  static constexpr size_t kMaxWriteChunks = 16;
+
+  async2::Poll<Result<multibuf::MultiBuf>> DoPendRead(
+      async2::Context& cx) override;
+
+  async2::Poll<Status> DoPendReadyToWrite(async2::Context& cx) final;
+
+  async2::Poll<std::optional<multibuf::MultiBuf>> DoPendAllocateWriteBuffer(
+      async2::Context& cx, size_t min_bytes) final {
+    write_alloc_future_.SetDesiredSize(min_bytes);
+    return write_alloc_future_.Pend(cx);
+  }
+
+  Status DoStageWrite(multibuf::MultiBuf&& data) final;
+
+  async2::Poll<Status> DoPendWrite(async2::Context& cx) final;
+
+  async2::Poll<Status> DoPendClose(async2::Context&) final {
+    Cleanup();
+    return async2::Ready(OkStatus());
+  }
+
+  void set_closed() {
+    set_read_closed();
+    set_write_closed();
+  }
+
+  // Submits a write of the data that is not yet written, starting with the
+  // remainder of the previous write.
+  Status SubmitWrite();
+
+  void Cleanup();
+
+  int channel_fd_;
+
+  async2::Dispatcher* dispatcher_;
+  multibuf::MultiBufAllocationFuture read_alloc_future_;
+  multibuf::MultiBufAllocationFuture write_alloc_future_;
+
+  // The buffer being read into, the data being written, and the data staged
+  // while a write is in flight.
+  multibuf::MultiBuf read_buffer_;
+  multibuf::MultiBuf write_data_;
+  multibuf::MultiBuf write_queue_;
+  size_t queued_write_bytes_ = 0;
+  std::array<iovec, kMaxWriteChunks> write_iov_;
+
+  Operation read_;
+  Operation write_;
+};
+
+/// @}
+
+}  // namespace pw::channel
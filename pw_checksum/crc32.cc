@@ -16,6 +16,23 @@
 
 #include <array>
 
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define _PW_CHECKSUM_CRC32_HAS_PCLMUL 1
+#else
+#define _PW_CHECKSUM_CRC32_HAS_PCLMUL 0
+#endif  // x86 && (GCC || Clang)
+
+#if defined(__ARM_FEATURE_CRC32) && !defined(__ARM_BIG_ENDIAN)
+#include <arm_acle.h>
+
+#include <cstring>
+#define _PW_CHECKSUM_CRC32_HAS_ARM_CRC32 1
+#else
+#define _PW_CHECKSUM_CRC32_HAS_ARM_CRC32 0
+#endif  // __ARM_FEATURE_CRC32 && !__ARM_BIG_ENDIAN
+
 namespace pw::checksum {
 namespace {
 
@@ -53,6 +70,185 @@ constexpr std::array<uint32_t, (1 << kBits)> GenerateCrc32Table() {
 // https://en.wikipedia.org/wiki/Cyclic_redundancy_check#Polynomial_representations_of_cyclic_redundancy_checks
 constexpr uint32_t kCrc32Polynomial = 0xEDB88320;
 
+// Generates the lookup tables for a slice-by-kSlices CRC32 implementation.
+// Table 0 is the regular 8-bit table. Table k holds the CRC of a byte followed
+// by k zero bytes, which allows kSlices bytes to be folded into the CRC state
+// with independent lookups.
+template <std::size_t kSlices, uint32_t kPolynomial>
+constexpr std::array<std::array<uint32_t, 256>, kSlices>
+GenerateCrc32SliceTables() {
+  std::array<std::array<uint32_t, 256>, kSlices> tables{};
+  tables[0] = GenerateCrc32Table<8, kPolynomial>();
+  for (std::size_t k = 1; k < kSlices; ++k) {
+    for (std::size_t i = 0; i < 256; ++i) {
+      const uint32_t previous = tables[k - 1][i];
+      tables[k][i] = (previous >> 8) ^ tables[0][previous & 0xFFu];
+    }
+  }
+  return tables;
+}
+
+// Loads a little-endian 32-bit word. Compilers turn this into a single load on
+// little-endian targets.
+inline uint32_t LoadLittleEndian32(const uint8_t* data) {
+  return static_cast<uint32_t>(data[0]) |
+         (static_cast<uint32_t>(data[1]) << 8) |
+         (static_cast<uint32_t>(data[2]) << 16) |
+         (static_cast<uint32_t>(data[3]) << 24);
+}
+
+// Processes kSlices bytes per iteration using kSlices lookup tables, then
+// finishes any remaining bytes with the 8-bit table.
+template <std::size_t kSlices>
+uint32_t Crc32SliceBy(
+    const std::array<std::array<uint32_t, 256>, kSlices>& tables,
+    const uint8_t* data,
+    size_t size_bytes,
+    uint32_t state) {
+  static_assert(kSlices % 4 == 0, "Slices are processed one word at a time");
+
+  while (size_bytes >= kSlices) {
+    uint32_t next_state = 0;
+    for (std::size_t word = 0; word < kSlices / 4; ++word) {
+      uint32_t value = LoadLittleEndian32(&data[word * 4]);
+      if (word == 0) {
+        value ^= state;
+      }
+      // Byte n of the block is followed by (kSlices - 1 - n) bytes.
+      const std::size_t table = kSlices - 1 - word * 4;
+      next_state ^= tables[table][value & 0xFFu] ^
+                    tables[table - 1][(value >> 8) & 0xFFu] ^
+                    tables[table - 2][(value >> 16) & 0xFFu] ^
+                    tables[table - 3][value >> 24];
+    }
+    state = next_state;
+    data += kSlices;
+    size_bytes -= kSlices;
+  }
+
+  for (size_t i = 0; i < size_bytes; ++i) {
+    state = tables[0][(state ^ data[i]) & 0xFFu] ^ (state >> 8);
+  }
+  return state;
+}
+
+#if _PW_CHECKSUM_CRC32_HAS_PCLMUL
+
+// Folding constants for the reflected CRC32 polynomial, as described in Intel's
+// "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction".
+alignas(16) constexpr uint64_t kFold4x128[] = {0x0154442bd4, 0x01c6e41596};
+alignas(16) constexpr uint64_t kFold1x128[] = {0x01751997d0, 0x00ccaa009e};
+alignas(16) constexpr uint64_t kFold64[] = {0x0163cd6124, 0x0000000000};
+alignas(16) constexpr uint64_t kBarrett[] = {0x01db710641, 0x01f7011641};
+
+#define _PW_CHECKSUM_PCLMUL_TARGET __attribute__((target("pclmul,sse4.1")))
+
+_PW_CHECKSUM_PCLMUL_TARGET inline __m128i Load128(const uint8_t* bytes) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+}
+
+_PW_CHECKSUM_PCLMUL_TARGET inline __m128i Load128(const uint64_t* constants) {
+  return _mm_load_si128(reinterpret_cast<const __m128i*>(constants));
+}
+
+// Folds 128 bits of CRC state forward by the distance encoded in constants and
+// adds the next 128 bits of data.
+_PW_CHECKSUM_PCLMUL_TARGET inline __m128i Fold128(__m128i value,
+                                                   __m128i constants,
+                                                   __m128i next) {
+  const __m128i low = _mm_clmulepi64_si128(value, constants, 0x00);
+  const __m128i high = _mm_clmulepi64_si128(value, constants, 0x11);
+  return _mm_xor_si128(_mm_xor_si128(high, low), next);
+}
+
+// Computes the CRC32 state of a buffer using carry-less multiplication. The
+// buffer must be at least 64 bytes long and a multiple of 16 bytes.
+_PW_CHECKSUM_PCLMUL_TARGET uint32_t Crc32Pclmul(const uint8_t* data,
+                                                size_t size_bytes,
+                                                uint32_t state) {
+  __m128i x1 = Load128(data);
+  __m128i x2 = Load128(data + 16);
+  __m128i x3 = Load128(data + 32);
+  __m128i x4 = Load128(data + 48);
+  x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(state)));
+  data += 64;
+  size_bytes -= 64;
+
+  // Fold four 128-bit lanes in parallel.
+  __m128i constants = Load128(kFold4x128);
+  while (size_bytes >= 64) {
+    x1 = Fold128(x1, constants, Load128(data));
+    x2 = Fold128(x2, constants, Load128(data + 16));
+    x3 = Fold128(x3, constants, Load128(data + 32));
+    x4 = Fold128(x4, constants, Load128(data + 48));
+    data += 64;
+    size_bytes -= 64;
+  }
+
+  // Fold the four lanes into one, then fold any remaining 16-byte blocks.
+  constants = Load128(kFold1x128);
+  x1 = Fold128(x1, constants, x2);
+  x1 = Fold128(x1, constants, x3);
+  x1 = Fold128(x1, constants, x4);
+  while (size_bytes >= 16) {
+    x1 = Fold128(x1, constants, Load128(data));
+    data += 16;
+    size_bytes -= 16;
+  }
+
+  // Fold 128 bits down to 64 bits.
+  const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+  x2 = _mm_clmulepi64_si128(x1, constants, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+  constants = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(kFold64));
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), constants, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  // Barrett reduction to 32 bits.
+  constants = Load128(kBarrett);
+  x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), constants, 0x10);
+  x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask), constants, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+bool CpuSupportsPclmul() {
+  static const bool supported = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("pclmul") &&
+           __builtin_cpu_supports("sse4.1");
+  }();
+  return supported;
+}
+
+#endif  // _PW_CHECKSUM_CRC32_HAS_PCLMUL
+
+#if _PW_CHECKSUM_CRC32_HAS_ARM_CRC32
+
+// Uses the ARMv8 CRC32 instructions, which implement the same reflected
+// polynomial as this module.
+uint32_t Crc32ArmCrc32(const uint8_t* data, size_t size_bytes, uint32_t state) {
+  while (size_bytes >= sizeof(uint64_t)) {
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    state = __crc32d(state, value);
+    data += sizeof(value);
+    size_bytes -= sizeof(value);
+  }
+  for (size_t i = 0; i < size_bytes; ++i) {
+    state = __crc32b(state, data[i]);
+  }
+  return state;
+}
+
+#endif  // _PW_CHECKSUM_CRC32_HAS_ARM_CRC32
+
+constexpr std::array<std::array<uint32_t, 256>, 8> kCrc32SliceByEightTables =
+    GenerateCrc32SliceTables<8, kCrc32Polynomial>();
+
 }  // namespace
 
 extern "C" uint32_t _pw_checksum_InternalCrc32EightBit(const void* data,
@@ -97,4 +293,42 @@ extern "C" uint32_t _pw_checksum_InternalCrc32OneBit(const void* data,
   return state;
 }
 
+extern "C" uint32_t _pw_checksum_InternalCrc32SliceByEight(const void* data,
+                                                           size_t size_bytes,
+                                                           uint32_t state) {
+  return Crc32SliceBy<8>(kCrc32SliceByEightTables,
+                         static_cast<const uint8_t*>(data),
+                         size_bytes,
+                         state);
+}
+
+extern "C" uint32_t _pw_checksum_InternalCrc32SliceBySixteen(
+    const void* data, size_t size_bytes, uint32_t state) {
+  static constexpr std::array<std::array<uint32_t, 256>, 16> kTables =
+      GenerateCrc32SliceTables<16, kCrc32Polynomial>();
+  return Crc32SliceBy<16>(
+      kTables, static_cast<const uint8_t*>(data), size_bytes, state);
+}
+
+extern "C" uint32_t _pw_checksum_InternalCrc32Accelerated(const void* data,
+                                                          size_t size_bytes,
+                                                          uint32_t state) {
+  const uint8_t* data_bytes = static_cast<const uint8_t*>(data);
+
+#if _PW_CHECKSUM_CRC32_HAS_ARM_CRC32
+  return Crc32ArmCrc32(data_bytes, size_bytes, state);
+#else
+#if _PW_CHECKSUM_CRC32_HAS_PCLMUL
+  if (size_bytes >= 64 && CpuSupportsPclmul()) {
+    const size_t folded_bytes = size_bytes & ~static_cast<size_t>(15);
+    state = Crc32Pclmul(data_bytes, folded_bytes, state);
+    data_bytes += folded_bytes;
+    size_bytes -= folded_bytes;
+  }
+#endif  // _PW_CHECKSUM_CRC32_HAS_PCLMUL
+  return Crc32SliceBy<8>(
+      kCrc32SliceByEightTables, data_bytes, size_bytes, state);
+#endif  // _PW_CHECKSUM_CRC32_HAS_ARM_CRC32
+}
+
 }  // namespace pw::checksum
@@ -12,6 +12,8 @@
 // License for the specific language governing permissions and limitations under
 // the License.
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <string_view>
 
@@ -46,13 +48,100 @@ void Crc32EightBitTest(perf_test::State& state, span<const std::byte> data) {
   }
 }
 
+void Crc32SliceByEightTest(perf_test::State& state,
+                           span<const std::byte> data) {
+  while (state.KeepRunning()) {
+    Crc32SliceByEight::Calculate(data);
+  }
+}
+
+void Crc32SliceBySixteenTest(perf_test::State& state,
+                             span<const std::byte> data) {
+  while (state.KeepRunning()) {
+    Crc32SliceBySixteen::Calculate(data);
+  }
+}
+
+void Crc32AcceleratedTest(perf_test::State& state,
+                          span<const std::byte> data) {
+  while (state.KeepRunning()) {
+    Crc32Accelerated::Calculate(data);
+  }
+}
+
 PW_PERF_TEST(CrcOneBitStringTest, Crc32OneBitTest, as_bytes(span(kString)));
 PW_PERF_TEST(CrcFourBitStringTest, Crc32FourBitTest, as_bytes(span(kString)));
 PW_PERF_TEST(CrcEightBitStringTest, Crc32EightBitTest, as_bytes(span(kString)));
+PW_PERF_TEST(CrcSliceByEightStringTest,
+             Crc32SliceByEightTest,
+             as_bytes(span(kString)));
+PW_PERF_TEST(CrcSliceBySixteenStringTest,
+             Crc32SliceBySixteenTest,
+             as_bytes(span(kString)));
+PW_PERF_TEST(CrcAcceleratedStringTest,
+             Crc32AcceleratedTest,
+             as_bytes(span(kString)));
 
 PW_PERF_TEST(CrcOneBitBytesTest, Crc32OneBitTest, kBytes);
 PW_PERF_TEST(CrcFourBitBytesTest, Crc32FourBitTest, kBytes);
 PW_PERF_TEST(CrcEightBitBytesTest, Crc32EightBitTest, kBytes);
+PW_PERF_TEST(CrcSliceByEightBytesTest, Crc32SliceByEightTest, kBytes);
+PW_PERF_TEST(CrcSliceBySixteenBytesTest, Crc32SliceBySixteenTest, kBytes);
+PW_PERF_TEST(CrcAcceleratedBytesTest, Crc32AcceleratedTest, kBytes);
+
+// Larger buffers show the throughput of the wide implementations. Buffers over
+// 4 KiB are only measured on hosts, where RAM is not a concern.
+#if defined(__linux__) || defined(__APPLE__) || defined(_WIN32)
+constexpr size_t kLargestBuffer = 1024 * 1024;
+#else
+constexpr size_t kLargestBuffer = 4096;
+#endif  // defined(__linux__) || defined(__APPLE__) || defined(_WIN32)
+
+std::array<std::byte, kLargestBuffer> buffer;
+
+span<const std::byte> BufferOfSize(size_t size) {
+  return span(buffer).first(size);
+}
+
+PW_PERF_TEST(CrcEightBit64BTest, Crc32EightBitTest, BufferOfSize(64));
+PW_PERF_TEST(CrcSliceByEight64BTest, Crc32SliceByEightTest, BufferOfSize(64));
+PW_PERF_TEST(CrcSliceBySixteen64BTest,
+             Crc32SliceBySixteenTest,
+             BufferOfSize(64));
+PW_PERF_TEST(CrcAccelerated64BTest, Crc32AcceleratedTest, BufferOfSize(64));
+
+PW_PERF_TEST(CrcEightBit4KiBTest, Crc32EightBitTest, BufferOfSize(4096));
+PW_PERF_TEST(CrcSliceByEight4KiBTest,
+             Crc32SliceByEightTest,
+             BufferOfSize(4096));
+PW_PERF_TEST(CrcSliceBySixteen4KiBTest,
+             Crc32SliceBySixteenTest,
+             BufferOfSize(4096));
+PW_PERF_TEST(CrcAccelerated4KiBTest, Crc32AcceleratedTest, BufferOfSize(4096));
+
+#if defined(__linux__) || defined(__APPLE__) || defined(_WIN32)
+PW_PERF_TEST(CrcEightBit64KiBTest, Crc32EightBitTest, BufferOfSize(65536));
+PW_PERF_TEST(CrcSliceByEight64KiBTest,
+             Crc32SliceByEightTest,
+             BufferOfSize(65536));
+PW_PERF_TEST(CrcSliceBySixteen64KiBTest,
+             Crc32SliceBySixteenTest,
+             BufferOfSize(65536));
+PW_PERF_TEST(CrcAccelerated64KiBTest,
+             Crc32AcceleratedTest,
+             BufferOfSize(65536));
+
+PW_PERF_TEST(CrcEightBit1MiBTest, Crc32EightBitTest, BufferOfSize(1 << 20));
+PW_PERF_TEST(CrcSliceByEight1MiBTest,
+             Crc32SliceByEightTest,
+             BufferOfSize(1 << 20));
+PW_PERF_TEST(CrcSliceBySixteen1MiBTest,
+             Crc32SliceBySixteenTest,
+             BufferOfSize(1 << 20));
+PW_PERF_TEST(CrcAccelerated1MiBTest,
+             Crc32AcceleratedTest,
+             BufferOfSize(1 << 20));
+#endif  // defined(__linux__) || defined(__APPLE__) || defined(_WIN32)
 
 }  // namespace
 }  // namespace pw::checksum
@@ -13,6 +13,7 @@
 // the License.
 #include "pw_checksum/crc32.h"
 
+#include <array>
 #include <string_view>
 
 #include "pw_bytes/array.h"
@@ -46,6 +47,12 @@ TEST(Crc32, Empty) {
   EXPECT_EQ(Crc32FourBit::Calculate(span<std::byte>()),
             PW_CHECKSUM_EMPTY_CRC32);
   EXPECT_EQ(Crc32OneBit::Calculate(span<std::byte>()), PW_CHECKSUM_EMPTY_CRC32);
+  EXPECT_EQ(Crc32SliceByEight::Calculate(span<std::byte>()),
+            PW_CHECKSUM_EMPTY_CRC32);
+  EXPECT_EQ(Crc32SliceBySixteen::Calculate(span<std::byte>()),
+            PW_CHECKSUM_EMPTY_CRC32);
+  EXPECT_EQ(Crc32Accelerated::Calculate(span<std::byte>()),
+            PW_CHECKSUM_EMPTY_CRC32);
 }
 
 TEST(Crc32, Buffer) {
@@ -53,6 +60,9 @@ TEST(Crc32, Buffer) {
   EXPECT_EQ(Crc32EightBit::Calculate(as_bytes(span(kBytes))), kBufferCrc);
   EXPECT_EQ(Crc32FourBit::Calculate(as_bytes(span(kBytes))), kBufferCrc);
   EXPECT_EQ(Crc32OneBit::Calculate(as_bytes(span(kBytes))), kBufferCrc);
+  EXPECT_EQ(Crc32SliceByEight::Calculate(as_bytes(span(kBytes))), kBufferCrc);
+  EXPECT_EQ(Crc32SliceBySixteen::Calculate(as_bytes(span(kBytes))), kBufferCrc);
+  EXPECT_EQ(Crc32Accelerated::Calculate(as_bytes(span(kBytes))), kBufferCrc);
 }
 
 TEST(Crc32, String) {
@@ -60,6 +70,10 @@ TEST(Crc32, String) {
   EXPECT_EQ(Crc32EightBit::Calculate(as_bytes(span(kString))), kStringCrc);
   EXPECT_EQ(Crc32FourBit::Calculate(as_bytes(span(kString))), kStringCrc);
   EXPECT_EQ(Crc32OneBit::Calculate(as_bytes(span(kString))), kStringCrc);
+  EXPECT_EQ(Crc32SliceByEight::Calculate(as_bytes(span(kString))), kStringCrc);
+  EXPECT_EQ(Crc32SliceBySixteen::Calculate(as_bytes(span(kString))),
+            kStringCrc);
+  EXPECT_EQ(Crc32Accelerated::Calculate(as_bytes(span(kString))), kStringCrc);
 }
 
 template <typename CrcVariant>
@@ -76,6 +90,9 @@ TEST(Crc32Class, ByteByByte) {
   TestByByte<Crc32EightBit>();
   TestByByte<Crc32FourBit>();
   TestByByte<Crc32OneBit>();
+  TestByByte<Crc32SliceByEight>();
+  TestByByte<Crc32SliceBySixteen>();
+  TestByByte<Crc32Accelerated>();
 }
 
 template <typename CrcVariant>
@@ -90,6 +107,9 @@ TEST(Crc32Class, Buffer) {
   TestBuffer<Crc32EightBit>();
   TestBuffer<Crc32FourBit>();
   TestBuffer<Crc32OneBit>();
+  TestBuffer<Crc32SliceByEight>();
+  TestBuffer<Crc32SliceBySixteen>();
+  TestBuffer<Crc32Accelerated>();
 }
 
 template <typename CrcVariant>
@@ -105,6 +125,9 @@ TEST(Crc32Class, BufferAppend) {
   TestBufferAppend<Crc32EightBit>();
   TestBufferAppend<Crc32FourBit>();
   TestBufferAppend<Crc32OneBit>();
+  TestBufferAppend<Crc32SliceByEight>();
+  TestBufferAppend<Crc32SliceBySixteen>();
+  TestBufferAppend<Crc32Accelerated>();
 }
 
 template <typename CrcVariant>
@@ -119,6 +142,61 @@ TEST(Crc32Class, String) {
   TestString<Crc32EightBit>();
   TestString<Crc32FourBit>();
   TestString<Crc32OneBit>();
+  TestString<Crc32SliceByEight>();
+  TestString<Crc32SliceBySixteen>();
+  TestString<Crc32Accelerated>();
+}
+
+// Fills a buffer with a deterministic pseudorandom byte pattern.
+template <size_t kSize>
+std::array<std::byte, kSize> GeneratePattern() {
+  std::array<std::byte, kSize> data;
+  uint32_t value = 0x12345678;
+  for (std::byte& b : data) {
+    value = value * 1103515245u + 12345u;
+    b = static_cast<std::byte>(value >> 24);
+  }
+  return data;
+}
+
+// Compares a variant against the 8-bit implementation for every length and
+// starting alignment, covering the tails that wide implementations handle
+// separately.
+template <typename CrcVariant>
+void TestMatchesEightBit() {
+  static const auto kData = GeneratePattern<600>();
+  for (size_t offset = 0; offset < 16; ++offset) {
+    for (size_t size = 0; size + offset <= kData.size(); size += 7) {
+      const auto data = span(kData).subspan(offset, size);
+      ASSERT_EQ(CrcVariant::Calculate(data), Crc32EightBit::Calculate(data));
+    }
+  }
+}
+
+TEST(Crc32, MatchesEightBit) {
+  TestMatchesEightBit<Crc32FourBit>();
+  TestMatchesEightBit<Crc32SliceByEight>();
+  TestMatchesEightBit<Crc32SliceBySixteen>();
+  TestMatchesEightBit<Crc32Accelerated>();
+}
+
+template <typename CrcVariant>
+void TestUnevenAppend() {
+  static const auto kData = GeneratePattern<4096>();
+  CrcVariant crc32;
+  size_t position = 0;
+  for (size_t size = 1; position + size <= kData.size(); size += 61) {
+    crc32.Update(span(kData).subspan(position, size));
+    position += size;
+  }
+  crc32.Update(span(kData).subspan(position));
+  EXPECT_EQ(crc32.value(), Crc32EightBit::Calculate(kData));
+}
+
+TEST(Crc32Class, UnevenAppend) {
+  TestUnevenAppend<Crc32SliceByEight>();
+  TestUnevenAppend<Crc32SliceBySixteen>();
+  TestUnevenAppend<Crc32Accelerated>();
 }
 
 extern "C" uint32_t CallChecksumCrc32(const void* data, size_t size_bytes);
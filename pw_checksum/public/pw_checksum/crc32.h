@@ -45,6 +45,15 @@ uint32_t _pw_checksum_InternalCrc32FourBit(const void* data,
 uint32_t _pw_checksum_InternalCrc32OneBit(const void* data,
                                           size_t size_bytes,
                                           uint32_t state);
+uint32_t _pw_checksum_InternalCrc32SliceByEight(const void* data,
+                                                size_t size_bytes,
+                                                uint32_t state);
+uint32_t _pw_checksum_InternalCrc32SliceBySixteen(const void* data,
+                                                  size_t size_bytes,
+                                                  uint32_t state);
+uint32_t _pw_checksum_InternalCrc32Accelerated(const void* data,
+                                               size_t size_bytes,
+                                               uint32_t state);
 
 #if PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_8BITS
 #define _pw_checksum_InternalCrc32 _pw_checksum_InternalCrc32EightBit
@@ -52,6 +61,12 @@ uint32_t _pw_checksum_InternalCrc32OneBit(const void* data,
 #define _pw_checksum_InternalCrc32 _pw_checksum_InternalCrc32FourBit
 #elif PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_1BITS
 #define _pw_checksum_InternalCrc32 _pw_checksum_InternalCrc32OneBit
+#elif PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_SLICE_BY_8
+#define _pw_checksum_InternalCrc32 _pw_checksum_InternalCrc32SliceByEight
+#elif PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_SLICE_BY_16
+#define _pw_checksum_InternalCrc32 _pw_checksum_InternalCrc32SliceBySixteen
+#elif PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_ACCELERATED
+#define _pw_checksum_InternalCrc32 _pw_checksum_InternalCrc32Accelerated
 #endif
 
 // Calculates the CRC32 for the provided data.
@@ -116,6 +131,14 @@ using Crc32 = Crc32Impl<_pw_checksum_InternalCrc32>;
 using Crc32EightBit = Crc32Impl<_pw_checksum_InternalCrc32EightBit>;
 using Crc32FourBit = Crc32Impl<_pw_checksum_InternalCrc32FourBit>;
 using Crc32OneBit = Crc32Impl<_pw_checksum_InternalCrc32OneBit>;
+using Crc32SliceByEight = Crc32Impl<_pw_checksum_InternalCrc32SliceByEight>;
+using Crc32SliceBySixteen =
+    Crc32Impl<_pw_checksum_InternalCrc32SliceBySixteen>;
+
+// Uses CRC32 instructions when the CPU provides them (PCLMULQDQ on x86,
+// selected at runtime; the ARMv8 CRC32 extension, selected at compile time)
+// and falls back to the slice-by-8 implementation otherwise.
+using Crc32Accelerated = Crc32Impl<_pw_checksum_InternalCrc32Accelerated>;
 
 }  // namespace pw::checksum
 
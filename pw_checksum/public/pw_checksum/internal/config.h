@@ -17,6 +17,9 @@
 #define PW_CHECKSUM_CRC32_8BITS 8
 #define PW_CHECKSUM_CRC32_4BITS 4
 #define PW_CHECKSUM_CRC32_1BITS 1
+#define PW_CHECKSUM_CRC32_SLICE_BY_8 64
+#define PW_CHECKSUM_CRC32_SLICE_BY_16 128
+#define PW_CHECKSUM_CRC32_ACCELERATED 512
 
 #ifndef PW_CHECKSUM_CRC32_DEFAULT_IMPL
 #define PW_CHECKSUM_CRC32_DEFAULT_IMPL PW_CHECKSUM_CRC32_8BITS
@@ -25,5 +28,8 @@
 #ifdef __cplusplus
 static_assert(PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_8BITS ||
               PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_4BITS ||
-              PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_1BITS);
+              PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_1BITS ||
+              PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_SLICE_BY_8 ||
+              PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_SLICE_BY_16 ||
+              PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_ACCELERATED);
 #endif  // __cplusplus
@@ -118,6 +118,93 @@ void Decoder::AppendByte(byte new_byte) {
   current_frame_size_ += 1;
 }
 
+size_t Decoder::ProcessRun(ConstByteSpan data) {
+  switch (state_) {
+    case State::kInterFrame: {
+      // Count bytes to track how many are discarded.
+      const size_t discarded = FindControlByte(data, /*find_escape=*/false);
+      current_frame_size_ += discarded;
+      return discarded;
+    }
+    case State::kFrame: {
+      // Short runs and unescaped bytes are gathered so that their checksum is
+      // updated in bulk.
+      std::array<byte, 32> pending;
+      size_t pending_size = 0;
+      const auto append_pending = [&] {
+        AppendRun(span(pending).first(pending_size));
+        pending_size = 0;
+      };
+
+      size_t consumed = 0;
+      while (true) {
+        const ConstByteSpan rest = data.subspan(consumed);
+        const ConstByteSpan run =
+            rest.first(FindControlByte(rest, /*find_escape=*/true));
+        if (run.size() <= pending.size() - pending_size) {
+          std::copy(run.begin(), run.end(), pending.begin() + pending_size);
+          pending_size += run.size();
+        } else {
+          append_pending();
+          AppendRun(run);
+        }
+        consumed += run.size();
+
+        // Unescape valid escape sequences here. Flags and invalid escapes are
+        // left for Process(std::byte).
+        if (consumed + 1 >= data.size() || data[consumed] != kEscape ||
+            data[consumed + 1] == kFlag || data[consumed + 1] == kEscape) {
+          append_pending();
+          return consumed;
+        }
+        if (pending_size == pending.size()) {
+          append_pending();
+        }
+        pending[pending_size++] = Escape(data[consumed + 1]);
+        consumed += 2;
+      }
+    }
+    case State::kFrameEscape:
+      return 0;
+  }
+  PW_CRASH("Bad decoder state");
+}
+
+void Decoder::AppendRun(ConstByteSpan run) {
+  if (run.size() < last_read_bytes_.size()) {
+    for (byte b : run) {
+      AppendByte(b);
+    }
+    return;
+  }
+
+  if (current_frame_size_ < max_size()) {
+    const size_t to_copy =
+        std::min(run.size(), max_size() - current_frame_size_);
+    std::memcpy(&buffer_[current_frame_size_], run.data(), to_copy);
+  }
+
+  // The run replaces all of the last read bytes. Add the evicted bytes, oldest
+  // first, and then all but the last four bytes of the run to the checksum.
+  const size_t buffered =
+      std::min(current_frame_size_, last_read_bytes_.size());
+  size_t index =
+      (last_read_bytes_index_ + last_read_bytes_.size() - buffered) %
+      last_read_bytes_.size();
+  for (size_t i = 0; i < buffered; ++i) {
+    fcs_.Update(last_read_bytes_[index]);
+    index = (index + 1) % last_read_bytes_.size();
+  }
+
+  const size_t checksummed = run.size() - last_read_bytes_.size();
+  fcs_.Update(run.first(checksummed));
+  const ConstByteSpan last_bytes = run.subspan(checksummed);
+  std::copy(last_bytes.begin(), last_bytes.end(), last_read_bytes_.begin());
+  last_read_bytes_index_ = 0;
+
+  current_frame_size_ += run.size();
+}
+
 Status Decoder::CheckFrame() const {
   // Empty frames are not an error; repeated flag characters are okay.
   if (current_frame_size_ == 0u) {
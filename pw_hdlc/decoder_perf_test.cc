@@ -0,0 +1,84 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+
+#include "pw_assert/check.h"
+#include "pw_bytes/span.h"
+#include "pw_hdlc/decoder.h"
+#include "pw_hdlc/encoder.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_stream/memory_stream.h"
+
+namespace pw::hdlc {
+namespace {
+
+constexpr size_t kPayloadSize = 256;
+constexpr size_t kFrames = 4;
+
+// Encodes kFrames frames with kPayloadSize-byte payloads. If kEscapeInterval
+// is nonzero, one in kEscapeInterval payload bytes is a flag byte, which must
+// be escaped.
+template <size_t kEscapeInterval>
+ConstByteSpan EncodeFrames() {
+  static stream::MemoryWriterBuffer<kFrames * (2 * kPayloadSize + 16)> writer;
+  if (writer.bytes_written() == 0u) {
+    std::array<std::byte, kPayloadSize> payload;
+    payload.fill(std::byte{'a'});
+    if constexpr (kEscapeInterval != 0) {
+      for (size_t i = 0; i < payload.size(); i += kEscapeInterval) {
+        payload[i] = kFlag;
+      }
+    }
+    for (size_t i = 0; i < kFrames; ++i) {
+      PW_CHECK_OK(WriteUIFrame(123, payload, writer));
+    }
+  }
+  return writer.WrittenData();
+}
+
+void DecodeByteByByteTest(perf_test::State& state, ConstByteSpan data) {
+  DecoderBuffer<kPayloadSize + 16> decoder;
+  while (state.KeepRunning()) {
+    for (std::byte b : data) {
+      PW_CHECK(decoder.Process(b).status() != Status::DataLoss());
+    }
+  }
+}
+
+void DecodeSpanTest(perf_test::State& state, ConstByteSpan data) {
+  DecoderBuffer<kPayloadSize + 16> decoder;
+  while (state.KeepRunning()) {
+    decoder.Process(data, [](const Result<Frame>& frame) {
+      PW_CHECK(frame.status() != Status::DataLoss());
+    });
+  }
+}
+
+PW_PERF_TEST(DecodeByteByByteNoEscapes,
+             DecodeByteByByteTest,
+             EncodeFrames<0>());
+PW_PERF_TEST(DecodeSpanNoEscapes, DecodeSpanTest, EncodeFrames<0>());
+PW_PERF_TEST(DecodeByteByByteFewEscapes,
+             DecodeByteByByteTest,
+             EncodeFrames<64>());
+PW_PERF_TEST(DecodeSpanFewEscapes, DecodeSpanTest, EncodeFrames<64>());
+PW_PERF_TEST(DecodeByteByByteManyEscapes,
+             DecodeByteByByteTest,
+             EncodeFrames<4>());
+PW_PERF_TEST(DecodeSpanManyEscapes, DecodeSpanTest, EncodeFrames<4>());
+
+}  // namespace
+}  // namespace pw::hdlc
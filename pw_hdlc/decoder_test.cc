@@ -14,12 +14,17 @@
 
 #include "pw_hdlc/decoder.h"
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstdint>
 
 #include "pw_bytes/array.h"
+#include "pw_checksum/crc32.h"
 #include "pw_fuzzer/fuzztest.h"
+#include "pw_hdlc/encoder.h"
 #include "pw_hdlc/internal/protocol.h"
+#include "pw_stream/memory_stream.h"
 #include "pw_unit_test/framework.h"
 
 namespace pw::hdlc {
@@ -154,6 +159,128 @@ TEST(Decoder, TooLargeForBuffer_DecodesNextFrame) {
   EXPECT_EQ(OkStatus(), decoder.Process(kFlag).status());
 }
 
+// Summarizes the frames and errors reported by a decoder, so that the results
+// of decoding the same data in different ways can be compared.
+class DecodeResults {
+ public:
+  void Add(const Result<Frame>& result) {
+    count_ += 1;
+    digest_.Update(static_cast<byte>(result.status().code()));
+    if (result.ok()) {
+      const uint64_t address = result->address();
+      digest_.Update(as_bytes(span(&address, 1)));
+      digest_.Update(result->control());
+      digest_.Update(result->data());
+    }
+  }
+
+  size_t count() const { return count_; }
+  uint32_t digest() const { return digest_.value(); }
+
+ private:
+  size_t count_ = 0;
+  checksum::Crc32 digest_;
+};
+
+constexpr size_t kDifferentialBufferSize = 64;
+
+DecodeResults DecodeByteByByte(ConstByteSpan data) {
+  DecoderBuffer<kDifferentialBufferSize> decoder;
+  DecodeResults results;
+  for (byte b : data) {
+    Result<Frame> result = decoder.Process(b);
+    if (result.status() != Status::Unavailable()) {
+      results.Add(result);
+    }
+  }
+  return results;
+}
+
+DecodeResults DecodeInChunks(ConstByteSpan data, size_t chunk_size) {
+  DecoderBuffer<kDifferentialBufferSize> decoder;
+  DecodeResults results;
+  while (!data.empty()) {
+    const size_t size = std::min(chunk_size, data.size());
+    decoder.Process(data.first(size),
+                    [&results](const Result<Frame>& result) {
+                      results.Add(result);
+                    });
+    data = data.subspan(size);
+  }
+  return results;
+}
+
+void ExpectSameResults(ConstByteSpan data) {
+  const DecodeResults expected = DecodeByteByByte(data);
+  for (size_t chunk_size : {size_t{1}, size_t{2}, size_t{3}, size_t{7},
+                            size_t{8}, size_t{13}, data.size()}) {
+    const DecodeResults actual = DecodeInChunks(data, chunk_size);
+    EXPECT_EQ(expected.count(), actual.count());
+    EXPECT_EQ(expected.digest(), actual.digest());
+  }
+}
+
+TEST(Decoder, ProcessSpan_MatchesProcessByte_ValidFrames) {
+  stream::MemoryWriterBuffer<8192> writer;
+  std::array<byte, kDifferentialBufferSize> payload;
+
+  // Payloads of every size up to and past the decoder's buffer size. The
+  // payloads include flag and escape bytes, which are escaped.
+  for (size_t size = 0; size < payload.size(); ++size) {
+    for (size_t i = 0; i < size; ++i) {
+      payload[i] = static_cast<byte>(0x7a + (i * (size + 1)) % 7);
+    }
+    ASSERT_EQ(OkStatus(),
+              WriteUIFrame(size * 131, span(payload).first(size), writer));
+  }
+
+  const DecodeResults results = DecodeByteByByte(writer.WrittenData());
+  EXPECT_EQ(results.count(), payload.size());
+  ExpectSameResults(writer.WrittenData());
+}
+
+TEST(Decoder, ProcessSpan_MatchesProcessByte_Errors) {
+  // Junk between frames, invalid escapes, escaped flags, a bad frame check
+  // sequence, and an incomplete frame, in between valid frames.
+  static constexpr auto kData = bytes::String(
+      "junk~1234\xa3\xe0\xe3\x9b~~}}1234\xa3\xe0\xe3\x9b~"
+      "~12}~34\xa3\xe0\xe3\x9b~1234\xa3\xe0\xe3\x9b~"
+      "~1234\xa3\xe0\xe3\x9c~~1234\xa3\xe0\xe3\x9b~"
+      "~12345678901234567890123456789012345678901234567890123456789012345"
+      "67890\xf2\x19\x63\x90~~12~1234\xa3\xe0\xe3\x9b~12345");
+  ExpectSameResults(kData);
+}
+
+TEST(Decoder, ProcessSpan_MatchesProcessByte_PseudoRandom) {
+  // Mostly printable characters, with frequent flag and escape bytes.
+  std::array<byte, 4096> data;
+  uint32_t state = 1;
+  for (byte& b : data) {
+    state = state * 1664525u + 1013904223u;
+    switch (state >> 28) {
+      case 0:
+        b = kFlag;
+        break;
+      case 1:
+        b = kEscape;
+        break;
+      default:
+        b = static_cast<byte>('a' + (state >> 8) % 26);
+    }
+  }
+  ExpectSameResults(data);
+}
+
+void ProcessSpanMatchesProcessByte(ConstByteSpan data) {
+  ExpectSameResults(data);
+}
+
+// Bias the input towards control bytes so that the decoder changes state
+// often.
+FUZZ_TEST(Decoder, ProcessSpanMatchesProcessByte)
+    .WithDomains(VectorOf<1024>(OneOf(ElementOf({kFlag, kEscape}),
+                                      Arbitrary<byte>())));
+
 void ProcessNeverCrashes(ConstByteSpan data) {
   DecoderBuffer<1024> decoder;
   for (byte b : data) {
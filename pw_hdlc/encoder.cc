@@ -22,6 +22,7 @@
 #include "pw_bytes/endian.h"
 #include "pw_hdlc/encoded_size.h"
 #include "pw_span/span.h"
+#include "pw_status/try.h"
 #include "pw_varint/varint.h"
 
 using std::byte;
@@ -39,21 +40,23 @@ Status EscapeAndWrite(const byte b, stream::Writer& writer) {
 }
 
 Status Encoder::WriteData(ConstByteSpan data) {
-  auto begin = data.begin();
+  ConstByteSpan remaining = data;
   while (true) {
-    auto end = std::find_if(begin, data.end(), NeedsEscaping);
+    const size_t run_size = FindControlByte(remaining, /*find_escape=*/true);
 
-    if (Status status = writer_.Write(span(begin, end)); !status.ok()) {
+    if (Status status = writer_.Write(remaining.first(run_size));
+        !status.ok()) {
       return status;
     }
-    if (end == data.end()) {
+    if (run_size == remaining.size()) {
       fcs_.Update(data);
       return OkStatus();
     }
-    if (Status status = EscapeAndWrite(*end, writer_); !status.ok()) {
+    if (Status status = EscapeAndWrite(remaining[run_size], writer_);
+        !status.ok()) {
       return status;
     }
-    begin = end + 1;
+    remaining = remaining.subspan(run_size + 1);
   }
 }
 
@@ -83,6 +86,58 @@ Status Encoder::StartFrame(uint64_t address, std::byte control) {
   return WriteData(span(metadata_buffer).first(metadata_size));
 }
 
+Status BufferEncoder::WriteData(ConstByteSpan data) {
+  ConstByteSpan remaining = data;
+  while (true) {
+    const ConstByteSpan run =
+        remaining.first(FindControlByte(remaining, /*find_escape=*/true));
+    if (run.size() > buffer_.size() - size_) {
+      return Status::ResourceExhausted();
+    }
+    std::copy(run.begin(), run.end(), buffer_.subspan(size_).begin());
+    size_ += run.size();
+
+    if (run.size() == remaining.size()) {
+      fcs_.Update(data);
+      return OkStatus();
+    }
+    if (buffer_.size() - size_ < 2) {
+      return Status::ResourceExhausted();
+    }
+    buffer_[size_++] = kEscape;
+    buffer_[size_++] = Escape(remaining[run.size()]);
+    remaining = remaining.subspan(run.size() + 1);
+  }
+}
+
+Result<ConstByteSpan> BufferEncoder::FinishFrame() {
+  PW_TRY(WriteData(bytes::CopyInOrder(endian::little, fcs_.value())));
+  if (size_ == buffer_.size()) {
+    return Status::ResourceExhausted();
+  }
+  buffer_[size_++] = kFlag;
+  return ConstByteSpan(buffer_.first(size_));
+}
+
+Status BufferEncoder::StartFrame(uint64_t address, std::byte control) {
+  fcs_.clear();
+  size_ = 0;
+  if (buffer_.empty()) {
+    return Status::ResourceExhausted();
+  }
+  buffer_[size_++] = kFlag;
+
+  std::array<std::byte, 16> metadata_buffer;
+  size_t metadata_size =
+      varint::Encode(address, metadata_buffer, kAddressFormat);
+  if (metadata_size == 0) {
+    return Status::InvalidArgument();
+  }
+
+  metadata_buffer[metadata_size++] = control;
+  return WriteData(span(metadata_buffer).first(metadata_size));
+}
+
 Status WriteUIFrame(uint64_t address,
                     ConstByteSpan payload,
                     stream::Writer& writer) {
@@ -101,4 +156,13 @@ Status WriteUIFrame(uint64_t address,
   return encoder.FinishFrame();
 }
 
+Result<ConstByteSpan> EncodeUIFrame(uint64_t address,
+                                    ConstByteSpan payload,
+                                    ByteSpan buffer) {
+  BufferEncoder encoder(buffer);
+  PW_TRY(encoder.StartUnnumberedFrame(address));
+  PW_TRY(encoder.WriteData(payload));
+  return encoder.FinishFrame();
+}
+
 }  // namespace pw::hdlc
@@ -0,0 +1,72 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+
+#include "pw_assert/check.h"
+#include "pw_bytes/span.h"
+#include "pw_hdlc/encoded_size.h"
+#include "pw_hdlc/encoder.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_stream/memory_stream.h"
+
+namespace pw::hdlc {
+namespace {
+
+constexpr uint64_t kAddress = 123;
+constexpr size_t kPayloadSize = 256;
+constexpr size_t kMaxFrameSize = MaxEncodedFrameSize(kPayloadSize);
+
+// Returns a kPayloadSize-byte payload. If kEscapeInterval is nonzero, one in
+// kEscapeInterval bytes is a flag byte, which must be escaped.
+template <size_t kEscapeInterval>
+ConstByteSpan Payload() {
+  static std::array<std::byte, kPayloadSize> payload = [] {
+    std::array<std::byte, kPayloadSize> data;
+    data.fill(std::byte{'a'});
+    if constexpr (kEscapeInterval != 0) {
+      for (size_t i = 0; i < data.size(); i += kEscapeInterval) {
+        data[i] = kFlag;
+      }
+    }
+    return data;
+  }();
+  return payload;
+}
+
+void WriteUIFrameTest(perf_test::State& state, ConstByteSpan payload) {
+  std::array<std::byte, kMaxFrameSize> buffer;
+  while (state.KeepRunning()) {
+    stream::MemoryWriter writer(buffer);
+    PW_CHECK_OK(WriteUIFrame(kAddress, payload, writer));
+  }
+}
+
+void EncodeUIFrameTest(perf_test::State& state, ConstByteSpan payload) {
+  std::array<std::byte, kMaxFrameSize> buffer;
+  while (state.KeepRunning()) {
+    PW_CHECK_OK(EncodeUIFrame(kAddress, payload, buffer).status());
+  }
+}
+
+PW_PERF_TEST(WriteUIFrameNoEscapes, WriteUIFrameTest, Payload<0>());
+PW_PERF_TEST(EncodeUIFrameNoEscapes, EncodeUIFrameTest, Payload<0>());
+PW_PERF_TEST(WriteUIFrameFewEscapes, WriteUIFrameTest, Payload<64>());
+PW_PERF_TEST(EncodeUIFrameFewEscapes, EncodeUIFrameTest, Payload<64>());
+PW_PERF_TEST(WriteUIFrameManyEscapes, WriteUIFrameTest, Payload<4>());
+PW_PERF_TEST(EncodeUIFrameManyEscapes, EncodeUIFrameTest, Payload<4>());
+
+}  // namespace
+}  // namespace pw::hdlc
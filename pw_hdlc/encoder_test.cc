@@ -194,5 +194,99 @@ TEST(WriteUIFrame, WriterError) {
             WriteUIFrame(kAddress, bytes::Array<0x01>(), writer));
 }
 
+class EncodeUnnumberedFrame : public ::testing::Test {
+ protected:
+  // Checks that EncodeUIFrame() matches WriteUIFrame() and fits in a buffer of
+  // MaxEncodedFrameSize(address, payload) bytes.
+  void ExpectMatchesWriteUIFrame(uint64_t address, ConstByteSpan payload) {
+    std::array<byte, 512> expected_buffer;
+    stream::MemoryWriter writer(expected_buffer);
+    ASSERT_EQ(OkStatus(), WriteUIFrame(address, payload, writer));
+
+    std::array<byte, 512> buffer;
+    const size_t max_size = MaxEncodedFrameSize(address, payload);
+    ASSERT_LE(max_size, buffer.size());
+    Result<ConstByteSpan> frame =
+        EncodeUIFrame(address, payload, span(buffer).first(max_size));
+    ASSERT_EQ(OkStatus(), frame.status());
+    EXPECT_EQ(frame->data(), buffer.data());
+    ASSERT_EQ(frame->size(), writer.bytes_written());
+    EXPECT_EQ(0, std::memcmp(frame->data(), writer.data(), frame->size()));
+  }
+};
+
+TEST_F(EncodeUnnumberedFrame, MatchesWriteUIFrame) {
+  ExpectMatchesWriteUIFrame(kAddress, {});
+  ExpectMatchesWriteUIFrame(kAddress, bytes::String("1995 toyota corolla"));
+  ExpectMatchesWriteUIFrame(0x3fff, bytes::String("abc"));
+  ExpectMatchesWriteUIFrame(
+      kAddress, bytes::Array<0x7E, 0x7B, 0x61, 0x62, 0x63, 0x7D, 0x7E>());
+  ExpectMatchesWriteUIFrame(0x7e7e7e7e7e, bytes::Initialized<64>(0x7d));
+}
+
+TEST_F(EncodeUnnumberedFrame, MatchesWriteUIFrame_AllPayloadSizes) {
+  std::array<byte, 100> payload;
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<byte>(0x7a + i % 5);
+  }
+  for (size_t size = 0; size <= payload.size(); ++size) {
+    ExpectMatchesWriteUIFrame(size, span(payload).first(size));
+  }
+}
+
+TEST_F(EncodeUnnumberedFrame, BufferTooSmall) {
+  constexpr auto kPayload = bytes::String("abc\x7e");
+  std::array<byte, 64> buffer;
+  Result<ConstByteSpan> frame = EncodeUIFrame(kAddress, kPayload, buffer);
+  ASSERT_EQ(OkStatus(), frame.status());
+
+  for (size_t size = 0; size < frame->size(); ++size) {
+    std::array<byte, 64> small_buffer;
+    EXPECT_EQ(Status::ResourceExhausted(),
+              EncodeUIFrame(kAddress, kPayload, span(small_buffer).first(size))
+                  .status());
+  }
+}
+
+TEST(BufferEncoder, GathersPayload) {
+  std::array<byte, 64> expected_buffer;
+  Result<ConstByteSpan> expected =
+      EncodeUIFrame(kAddress, bytes::String("ab~cd}ef"), expected_buffer);
+  ASSERT_EQ(OkStatus(), expected.status());
+
+  std::array<byte, 64> buffer;
+  BufferEncoder encoder(buffer);
+  ASSERT_EQ(OkStatus(), encoder.StartUnnumberedFrame(kAddress));
+  ASSERT_EQ(OkStatus(), encoder.WriteData(bytes::String("ab~")));
+  ASSERT_EQ(OkStatus(), encoder.WriteData(bytes::String("")));
+  ASSERT_EQ(OkStatus(), encoder.WriteData(bytes::String("cd}ef")));
+  Result<ConstByteSpan> frame = encoder.FinishFrame();
+  ASSERT_EQ(OkStatus(), frame.status());
+
+  ASSERT_EQ(expected->size(), frame->size());
+  EXPECT_EQ(0, std::memcmp(expected->data(), frame->data(), frame->size()));
+}
+
+TEST(BufferEncoder, RestartsFrame) {
+  std::array<byte, 64> buffer;
+  BufferEncoder encoder(buffer);
+  ASSERT_EQ(OkStatus(), encoder.StartUnnumberedFrame(kAddress));
+  ASSERT_EQ(OkStatus(), encoder.WriteData(bytes::String("discarded")));
+
+  ASSERT_EQ(OkStatus(), encoder.StartUnnumberedFrame(kAddress));
+  ASSERT_EQ(OkStatus(), encoder.WriteData(bytes::String("ABC")));
+  Result<ConstByteSpan> frame = encoder.FinishFrame();
+  ASSERT_EQ(OkStatus(), frame.status());
+
+  constexpr auto kExpected = bytes::Concat(kFlag,
+                                           kEncodedAddress,
+                                           kUnnumberedControl,
+                                           bytes::String("ABC"),
+                                           uint32_t{0x72410ee4},
+                                           kFlag);
+  ASSERT_EQ(kExpected.size(), frame->size());
+  EXPECT_EQ(0, std::memcmp(kExpected.data(), frame->data(), frame->size()));
+}
+
 }  // namespace
 }  // namespace pw::hdlc
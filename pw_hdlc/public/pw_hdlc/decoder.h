@@ -112,10 +112,20 @@ class Decoder {
 
   /// @brief Processes a span of data and calls the provided callback with each
   /// frame or error.
+  ///
+  /// Produces the same frames and errors as calling `Process(std::byte)` for
+  /// each byte, but copies and checksums runs of bytes without flag or escape
+  /// characters in bulk.
   template <typename F, typename... Args>
   void Process(ConstByteSpan data, F&& callback, Args&&... args) {
-    for (std::byte b : data) {
-      auto result = Process(b);
+    while (!data.empty()) {
+      data = data.subspan(ProcessRun(data));
+      if (data.empty()) {
+        break;
+      }
+
+      auto result = Process(data.front());
+      data = data.subspan(1);
       if (result.status() != Status::Unavailable()) {
         callback(std::forward<Args>(args)..., result);
       }
@@ -147,6 +157,16 @@ class Decoder {
 
   void AppendByte(std::byte new_byte);
 
+  // Consumes the leading bytes of data that cannot complete a frame or change
+  // the decoder's state: non-flag bytes between frames, or data bytes and
+  // valid escape sequences within a frame. Returns the number of bytes
+  // consumed.
+  size_t ProcessRun(ConstByteSpan data);
+
+  // Appends bytes to the current frame. Equivalent to calling AppendByte()
+  // for each byte.
+  void AppendRun(ConstByteSpan run);
+
   Status CheckFrame() const;
 
   bool VerifyFrameCheckSequence() const;
@@ -19,6 +19,7 @@
 #include "pw_bytes/span.h"
 #include "pw_checksum/crc32.h"
 #include "pw_hdlc/internal/protocol.h"
+#include "pw_result/result.h"
 #include "pw_status/status.h"
 #include "pw_stream/stream.h"
 
@@ -61,6 +62,36 @@ Status WriteUIFrame(uint64_t address,
                     ConstByteSpan payload,
                     stream::Writer& writer);
 
+/// @brief Encodes an HDLC unnumbered information frame (UI frame) into the
+/// provided buffer.
+///
+/// Unlike ``WriteUIFrame``, the frame is produced as a single contiguous span,
+/// which can be passed to a transport in one write. Runs of payload bytes that
+/// do not need escaping are copied in bulk.
+///
+/// @param address The frame address.
+///
+/// @param payload The frame data to encode.
+///
+/// @param buffer The buffer to encode the frame into. The frame always fits if
+/// the buffer is at least ``MaxEncodedFrameSize(address, payload)`` bytes.
+///
+/// @returns @rst
+///
+/// .. pw-status-codes::
+///
+///    OK: Returns the encoded frame, which starts at the beginning of
+///    ``buffer``.
+///
+///    RESOURCE_EXHAUSTED: The frame does not fit in ``buffer``.
+///
+///    INVALID_ARGUMENT: The ``address`` could not be encoded.
+///
+/// @endrst
+Result<ConstByteSpan> EncodeUIFrame(uint64_t address,
+                                    ConstByteSpan payload,
+                                    ByteSpan buffer);
+
 /// Encodes and writes HDLC frames.
 class Encoder {
  public:
@@ -90,4 +121,40 @@ class Encoder {
   checksum::Crc32 fcs_;
 };
 
+/// Encodes HDLC frames into a buffer.
+///
+/// ``BufferEncoder`` has the same interface as ``Encoder``, but escapes data
+/// directly into a caller-provided buffer instead of writing it through a
+/// ``pw::stream::Writer``. This allows gathering a payload from several
+/// buffers, such as the chunks of a ``pw::multibuf::MultiBuf``, into one
+/// contiguous frame.
+///
+/// If a call fails, the frame is incomplete and must be restarted.
+class BufferEncoder {
+ public:
+  /// Constructs an encoder which encodes frames into ``buffer``.
+  constexpr BufferEncoder(ByteSpan buffer) : buffer_(buffer), size_(0) {}
+
+  /// Starts a U-frame at the beginning of the buffer. After successfully
+  /// calling StartUnnumberedFrame, WriteData may be called any number of times.
+  Status StartUnnumberedFrame(uint64_t address) {
+    return StartFrame(address, UFrameControl::UnnumberedInformation().data());
+  }
+
+  /// Escapes data into an ongoing frame. Returns RESOURCE_EXHAUSTED if the
+  /// escaped data does not fit in the remainder of the buffer.
+  Status WriteData(ConstByteSpan data);
+
+  /// Finishes a frame by adding the frame check sequence and a terminating
+  /// flag. Returns the encoded frame.
+  Result<ConstByteSpan> FinishFrame();
+
+ private:
+  Status StartFrame(uint64_t address, std::byte control);
+
+  ByteSpan buffer_;
+  size_t size_;
+  checksum::Crc32 fcs_;
+};
+
 }  // namespace pw::hdlc
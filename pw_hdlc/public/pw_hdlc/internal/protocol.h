@@ -14,7 +14,10 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 
+#include "pw_bytes/span.h"
 #include "pw_varint/varint.h"
 
 namespace pw::hdlc {
@@ -68,6 +71,41 @@ constexpr bool NeedsEscaping(std::byte b) {
 
 constexpr std::byte Escape(std::byte b) { return b ^ kEscapeConstant; }
 
+// Returns the index of the first flag byte in data, or of the first flag or
+// escape byte if find_escape is true. Returns data.size() if there is none.
+//
+// Searches a machine word at a time, so long runs of bytes that do not need
+// escaping are found quickly.
+inline size_t FindControlByte(ConstByteSpan data, bool find_escape) {
+  // Word-at-a-time search constants: 0x0101...01 and 0x8080...80.
+  constexpr size_t kLowBits = ~size_t{0} / 0xff;
+  constexpr size_t kHighBits = kLowBits * 0x80;
+  constexpr size_t kFlags = kLowBits * static_cast<uint8_t>(kFlag);
+  const size_t escapes =
+      find_escape ? kLowBits * static_cast<uint8_t>(kEscape) : kFlags;
+
+  // True if any byte of the word is zero.
+  constexpr auto has_zero_byte = [](size_t word) {
+    return ((word - kLowBits) & ~word & kHighBits) != 0u;
+  };
+
+  size_t i = 0;
+  for (; i + sizeof(size_t) <= data.size(); i += sizeof(size_t)) {
+    size_t word;
+    std::memcpy(&word, &data[i], sizeof(word));
+    if (has_zero_byte(word ^ kFlags) || has_zero_byte(word ^ escapes)) {
+      break;
+    }
+  }
+
+  for (; i < data.size(); ++i) {
+    if (data[i] == kFlag || (find_escape && data[i] == kEscape)) {
+      break;
+    }
+  }
+  return i;
+}
+
 // Class that manages the 1-byte control field of an HDLC U-frame.
 class UFrameControl {
  public:
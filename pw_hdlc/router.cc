@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <cinttypes>
+#include <optional>
 
 #include "pw_hdlc/encoder.h"
 #include "pw_log/log.h"
@@ -65,6 +66,30 @@ Status WriteMultiBufUIFrame(uint64_t address,
   return encoder.FinishFrame();
 }
 
+/// HDLC encodes the contents of ``payload`` into ``write_buffer``.
+///
+/// If ``write_buffer`` is contiguous, the frame is escaped directly into it.
+/// Otherwise, the frame is written through a ``multibuf::Stream``.
+Status EncodeMultiBufUIFrame(uint64_t address,
+                             const MultiBuf& payload,
+                             MultiBuf& write_buffer) {
+  std::optional<ByteSpan> contiguous = write_buffer.ContiguousSpan();
+  if (!contiguous.has_value()) {
+    return WriteMultiBufUIFrame(
+        address, payload, pw::multibuf::Stream(write_buffer));
+  }
+  BufferEncoder encoder(*contiguous);
+  if (Status status = encoder.StartUnnumberedFrame(address); !status.ok()) {
+    return status;
+  }
+  for (const Chunk& chunk : payload.Chunks()) {
+    if (Status status = encoder.WriteData(chunk); !status.ok()) {
+      return status;
+    }
+  }
+  return encoder.FinishFrame().status();
+}
+
 /// Calculates the size of ``payload`` once HDLC-encoded.
 Result<size_t> CalculateSizeOnceEncoded(uint64_t address,
                                         const MultiBuf& payload) {
@@ -307,10 +332,8 @@ void Router::WriteOutgoingMessages(Context& cx) {
       continue;
     }
     MultiBuf write_buffer = std::move(**maybe_write_buffer);
-    Status encode_status =
-        WriteMultiBufUIFrame(target_address,
-                             buffer_to_encode_and_send_->buffer,
-                             pw::multibuf::Stream(write_buffer));
+    Status encode_status = EncodeMultiBufUIFrame(
+        target_address, buffer_to_encode_and_send_->buffer, write_buffer);
     buffer_to_encode_and_send_ = std::nullopt;
     if (!encode_status.ok()) {
       PW_LOG_ERROR(
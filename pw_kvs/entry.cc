@@ -45,7 +45,7 @@ Status Entry::Read(FlashPartition& partition,
   if (partition.AppearsErased(as_bytes(span(&header.magic, 1)))) {
     return Status::NotFound();
   }
-  if (header.key_length_bytes > kMaxKeyLength) {
+  if ((header.key_length_bytes & ~(kMaxKeyLength | kBatchedBit)) != 0) {
     return Status::DataLoss();
   }
 
@@ -79,7 +79,8 @@ Entry::Entry(FlashPartition& partition,
              std::string_view key,
              span<const byte> value,
              uint16_t value_size_bytes,
-             uint32_t transaction_id)
+             uint32_t transaction_id,
+             bool batched)
     : Entry(&partition,
             address,
             format,
@@ -87,7 +88,8 @@ Entry::Entry(FlashPartition& partition,
              .checksum = 0,
              .alignment_units =
                  alignment_bytes_to_units(partition.alignment_bytes()),
-             .key_length_bytes = static_cast<uint8_t>(key.size()),
+             .key_length_bytes = static_cast<uint8_t>(
+                 key.size() | (batched ? kBatchedBit : 0u)),
              .value_size_bytes = value_size_bytes,
              .transaction_id = transaction_id}) {
   if (checksum_algo_ != nullptr) {
@@ -107,6 +109,22 @@ StatusWithSize Entry::Write(std::string_view key,
       {as_bytes(span(&header_, 1)), as_bytes(span(key)), value});
 }
 
+StatusWithSize Entry::Write(AlignedWriter& writer,
+                            std::string_view key,
+                            span<const byte> value) const {
+  PW_TRY_WITH_SIZE(writer.Write(&header_, sizeof(header_)));
+  PW_TRY_WITH_SIZE(writer.Write(as_bytes(span(key))));
+  PW_TRY_WITH_SIZE(writer.Write(value));
+
+  static constexpr std::array<byte, kMinAlignmentBytes> kPadding{};
+  for (size_t padding = size() - content_size(); padding > 0u;) {
+    const size_t padding_size = std::min(padding, kPadding.size());
+    PW_TRY_WITH_SIZE(writer.Write(span(kPadding).first(padding_size)));
+    padding -= padding_size;
+  }
+  return StatusWithSize(size());
+}
+
 Status Entry::Update(const EntryFormat& new_format,
                      uint32_t new_transaction_id) {
   checksum_algo_ = new_format.checksum;
@@ -114,6 +132,7 @@ Status Entry::Update(const EntryFormat& new_format,
   header_.alignment_units =
       alignment_bytes_to_units(partition_->alignment_bytes());
   header_.transaction_id = new_transaction_id;
+  header_.key_length_bytes = static_cast<uint8_t>(key_length());
 
   // If we could write the header last, we could avoid reading the entry twice
   // when moving an entry. However, to support alignments greater than the
@@ -122,6 +141,11 @@ Status Entry::Update(const EntryFormat& new_format,
   return CalculateChecksumFromFlash();
 }
 
+Status Entry::ClearBatched() {
+  header_.key_length_bytes = static_cast<uint8_t>(key_length());
+  return CalculateChecksumFromFlash();
+}
+
 StatusWithSize Entry::Copy(Address new_address) const {
   PW_LOG_DEBUG("Copying entry from %u to %u as ID %" PRIu32,
                unsigned(address()),
@@ -17,6 +17,7 @@
 
 #include "pw_kvs/internal/entry_cache.h"
 
+#include <algorithm>
 #include <cinttypes>
 
 #include "pw_assert/check.h"
@@ -31,6 +32,8 @@ namespace {
 
 constexpr FlashPartition::Address kNoAddress = FlashPartition::Address(-1);
 
+constexpr EntryCache::HashIndexSlot kEmptySlot = 0;
+
 }  // namespace
 
 void EntryMetadata::RemoveAddress(Address address_to_remove) {
@@ -66,56 +69,59 @@ StatusWithSize EntryCache::Find(FlashPartition& partition,
                                 std::string_view key,
                                 EntryMetadata* metadata) const {
   const uint32_t hash = internal::Hash(key);
+  const int index = FindIndex(hash);
+  if (index == -1) {
+    return StatusWithSize::NotFound();
+  }
+
   Entry::KeyBuffer key_buffer;
   bool error_detected = false;
+  bool key_found = false;
+  std::string_view read_key;
 
-  for (size_t i = 0; i < descriptors_.size(); ++i) {
-    if (descriptors_[i].key_hash == hash) {
-      bool key_found = false;
-      std::string_view read_key;
-
-      for (Address address : addresses(i)) {
-        Status read_result =
-            Entry::ReadKey(partition, address, key.size(), key_buffer.data());
-
-        read_key = std::string_view(key_buffer.data(), key.size());
-
-        if (read_result.ok() && hash == internal::Hash(read_key)) {
-          key_found = true;
-          break;
-        } else {
-          // A hash mismatch can be caused by reading invalid data or a key hash
-          // collision of keys with differing size. To verify the data read from
-          // flash is good, validate the entry.
-          Entry entry;
-          read_result = Entry::Read(partition, address, formats, &entry);
-          if (read_result.ok() && entry.VerifyChecksumInFlash().ok()) {
-            key_found = true;
-            break;
-          }
-
-          PW_LOG_WARN(
-              "   Found corrupt entry, invalidating this copy of the key");
-          error_detected = true;
-          sectors.FromAddress(address).mark_corrupt();
-        }
-      }
-      size_t error_val = error_detected ? 1 : 0;
-
-      if (!key_found) {
-        PW_LOG_ERROR("No valid entries for key. Data has been lost!");
-        return StatusWithSize::DataLoss(error_val);
-      } else if (key == read_key) {
-        PW_LOG_DEBUG("Found match for key hash 0x%08" PRIx32, hash);
-        *metadata = EntryMetadata(descriptors_[i], addresses(i));
-        return StatusWithSize(error_val);
-      } else {
-        PW_LOG_WARN("Found key hash collision for 0x%08" PRIx32, hash);
-        return StatusWithSize::AlreadyExists(error_val);
+  for (Address address : addresses(index)) {
+    Status read_result =
+        Entry::ReadKey(partition, address, key.size(), key_buffer.data());
+
+    read_key = std::string_view(key_buffer.data(), key.size());
+
+    if (read_result.ok() && hash == internal::Hash(read_key)) {
+      key_found = true;
+      break;
+    } else {
+      // A hash mismatch can be caused by reading invalid data or a key hash
+      // collision of keys with differing size. To verify the data read from
+      // flash is good, validate the entry.
+      Entry entry;
+      read_result = Entry::Read(partition, address, formats, &entry);
+      if (read_result.ok() && entry.VerifyChecksumInFlash().ok()) {
+        key_found = true;
+        break;
       }
+
+      PW_LOG_WARN("   Found corrupt entry, invalidating this copy of the key");
+      error_detected = true;
+      sectors.FromAddress(address).mark_corrupt();
     }
   }
-  return StatusWithSize::NotFound();
+  size_t error_val = error_detected ? 1 : 0;
+
+  if (!key_found) {
+    PW_LOG_ERROR("No valid entries for key. Data has been lost!");
+    return StatusWithSize::DataLoss(error_val);
+  } else if (key == read_key) {
+    PW_LOG_DEBUG("Found match for key hash 0x%08" PRIx32, hash);
+    *metadata = EntryMetadata(descriptors_[index], addresses(index));
+    return StatusWithSize(error_val);
+  } else {
+    PW_LOG_WARN("Found key hash collision for 0x%08" PRIx32, hash);
+    return StatusWithSize::AlreadyExists(error_val);
+  }
+}
+
+void EntryCache::Reset() const {
+  descriptors_.clear();
+  std::fill(hash_index_.begin(), hash_index_.end(), kEmptySlot);
 }
 
 EntryMetadata EntryCache::AddNew(const KeyDescriptor& descriptor,
@@ -123,6 +129,7 @@ EntryMetadata EntryCache::AddNew(const KeyDescriptor& descriptor,
   // TODO(hepler): DCHECK(!full());
   Address* first_address = ResetAddresses(descriptors_.size(), address);
   descriptors_.push_back(descriptor);
+  AddToHashIndex(descriptors_.size() - 1);
   return EntryMetadata(descriptors_.back(), span(first_address, 1));
 }
 
@@ -134,6 +141,8 @@ EntryCache::iterator EntryCache::RemoveEntry(iterator& entry_it) {
       entry_it.metadata_.descriptor_ - &descriptors_.front();
   const KeyDescriptor last_desc = descriptors_[descriptors_.size() - 1];
 
+  RemoveFromHashIndex(index_to_remove);
+
   // Since order is not important, this copies the last descriptor into the
   // deleted descriptor's space and then pops the last entry.
   Address* addresses_at_end = first_address(descriptors_.size() - 1);
@@ -144,6 +153,11 @@ EntryCache::iterator EntryCache::RemoveEntry(iterator& entry_it) {
       addresses_to_remove[i] = addresses_at_end[i];
     }
     descriptors_[index_to_remove] = last_desc;
+
+    if (!hash_index_.empty()) {
+      hash_index_[FindHashIndexSlot(last_desc.key_hash)] =
+          static_cast<HashIndexSlot>(index_to_remove + 1);
+    }
   }
 
   // Erase the last entry since it was copied over the entry being deleted.
@@ -152,10 +166,9 @@ EntryCache::iterator EntryCache::RemoveEntry(iterator& entry_it) {
   return {this, descriptors_.data() + index_to_remove};
 }
 
-// TODO(hepler): This method is the trigger of the O(valid_entries *
-// all_entries) time complexity for reading. At some cost to memory, this could
-// be optimized by using a hash table instead of scanning, but in practice this
-// should be fine for a small number of keys
+// Without a hash index, this method is the trigger of the O(valid_entries *
+// all_entries) time complexity for reading, which is fine for a small number of
+// keys. With a hash index, finding the existing entry takes constant time.
 Status EntryCache::AddNewOrUpdateExisting(const KeyDescriptor& descriptor,
                                           Address address,
                                           size_t sector_size_bytes) const {
@@ -220,6 +233,20 @@ size_t EntryCache::present_entries() const {
 }
 
 int EntryCache::FindIndex(uint32_t key_hash) const {
+  if (!hash_index_.empty()) {
+    // The index is at most half full, so probing always reaches an empty slot.
+    for (size_t slot = HashIndexStart(key_hash);;
+         slot = NextHashIndexSlot(slot)) {
+      const HashIndexSlot value = hash_index_[slot];
+      if (value == kEmptySlot) {
+        return -1;
+      }
+      if (descriptors_[value - 1].key_hash == key_hash) {
+        return value - 1;
+      }
+    }
+  }
+
   for (size_t i = 0; i < descriptors_.size(); ++i) {
     if (descriptors_[i].key_hash == key_hash) {
       return i;
@@ -228,6 +255,48 @@ int EntryCache::FindIndex(uint32_t key_hash) const {
   return -1;
 }
 
+size_t EntryCache::FindHashIndexSlot(uint32_t key_hash) const {
+  for (size_t slot = HashIndexStart(key_hash);;
+       slot = NextHashIndexSlot(slot)) {
+    PW_DCHECK_UINT_NE(hash_index_[slot], kEmptySlot);
+    if (descriptors_[hash_index_[slot] - 1].key_hash == key_hash) {
+      return slot;
+    }
+  }
+}
+
+void EntryCache::AddToHashIndex(size_t descriptor_index) const {
+  if (hash_index_.empty()) {
+    return;
+  }
+  size_t slot = HashIndexStart(descriptors_[descriptor_index].key_hash);
+  while (hash_index_[slot] != kEmptySlot) {
+    slot = NextHashIndexSlot(slot);
+  }
+  hash_index_[slot] = static_cast<HashIndexSlot>(descriptor_index + 1);
+}
+
+void EntryCache::RemoveFromHashIndex(size_t descriptor_index) const {
+  if (hash_index_.empty()) {
+    return;
+  }
+  size_t hole = FindHashIndexSlot(descriptors_[descriptor_index].key_hash);
+
+  // Shift back any following entries in the probe sequence that can move into
+  // the hole, so that lookups do not stop early at an empty slot.
+  const size_t mask = hash_index_.size() - 1;
+  for (size_t slot = NextHashIndexSlot(hole); hash_index_[slot] != kEmptySlot;
+       slot = NextHashIndexSlot(slot)) {
+    const size_t start =
+        HashIndexStart(descriptors_[hash_index_[slot] - 1].key_hash);
+    if (((slot - start) & mask) >= ((slot - hole) & mask)) {
+      hash_index_[hole] = hash_index_[slot];
+      hole = slot;
+    }
+  }
+  hash_index_[hole] = kEmptySlot;
+}
+
 void EntryCache::AddAddressIfRoom(size_t descriptor_index,
                                   Address address) const {
   Address* const existing = first_address(descriptor_index);
@@ -14,6 +14,8 @@
 
 #include "pw_kvs/internal/entry_cache.h"
 
+#include <array>
+
 #include "pw_bytes/array.h"
 #include "pw_kvs/fake_flash_memory.h"
 #include "pw_kvs/flash_memory.h"
@@ -194,6 +196,124 @@ TEST_F(EmptyEntryCache, Iterator_Const_CanBeAssignedFromMutable) {
   EXPECT_EQ(99u, it->first_address());
 }
 
+// Runs the same operations on EntryCaches with and without a hash index and
+// checks that they produce the same results.
+class HashIndexEntryCache : public ::testing::Test {
+ protected:
+  static constexpr size_t kMaxEntries = 64;
+  static constexpr size_t kRedundancy = 1;
+
+  HashIndexEntryCache()
+      : scanned_(scanned_descriptors_, scanned_addresses_, kRedundancy),
+        indexed_(indexed_descriptors_,
+                 indexed_addresses_,
+                 kRedundancy,
+                 hash_index_) {}
+
+  void AddNewOrUpdateExisting(uint32_t key_hash,
+                              uint32_t transaction_id,
+                              EntryCache::Address address) {
+    const KeyDescriptor descriptor = {.key_hash = key_hash,
+                                      .transaction_id = transaction_id,
+                                      .state = EntryState::kValid};
+    EXPECT_EQ(scanned_.AddNewOrUpdateExisting(descriptor, address, 1),
+              indexed_.AddNewOrUpdateExisting(descriptor, address, 1));
+    ExpectSameEntries();
+  }
+
+  // Removes the entry at the specified position in iteration order.
+  void RemoveEntry(size_t position) {
+    EntryCache::iterator scanned_it = scanned_.begin();
+    EntryCache::iterator indexed_it = indexed_.begin();
+    for (size_t i = 0; i < position; ++i) {
+      ++scanned_it;
+      ++indexed_it;
+    }
+    scanned_.RemoveEntry(scanned_it);
+    indexed_.RemoveEntry(indexed_it);
+    ExpectSameEntries();
+  }
+
+  void ExpectSameEntries() {
+    ASSERT_EQ(scanned_.total_entries(), indexed_.total_entries());
+    EntryCache::const_iterator indexed_it = indexed_.cbegin();
+    for (const EntryMetadata& entry : scanned_) {
+      EXPECT_EQ(entry.hash(), indexed_it->hash());
+      EXPECT_EQ(entry.transaction_id(), indexed_it->transaction_id());
+      EXPECT_EQ(entry.first_address(), indexed_it->first_address());
+      ++indexed_it;
+    }
+  }
+
+  Vector<KeyDescriptor, kMaxEntries> scanned_descriptors_;
+  EntryCache::AddressList<kMaxEntries, kRedundancy> scanned_addresses_;
+  EntryCache scanned_;
+
+  Vector<KeyDescriptor, kMaxEntries> indexed_descriptors_;
+  EntryCache::AddressList<kMaxEntries, kRedundancy> indexed_addresses_;
+  std::array<EntryCache::HashIndexSlot,
+             EntryCache::kHashIndexSlots<kMaxEntries>>
+      hash_index_{};
+  EntryCache indexed_;
+};
+
+TEST_F(HashIndexEntryCache, SlotCount) {
+  EXPECT_EQ(2u, EntryCache::kHashIndexSlots<1>);
+  EXPECT_EQ(128u, EntryCache::kHashIndexSlots<64>);
+  EXPECT_EQ(256u, EntryCache::kHashIndexSlots<65>);
+}
+
+TEST_F(HashIndexEntryCache, AddUpdateAndRemove) {
+  // Hashes that share their low bits, so that they collide in the index.
+  for (uint32_t i = 0; i < kMaxEntries; ++i) {
+    AddNewOrUpdateExisting(i << 16, 1, i);
+  }
+  AddNewOrUpdateExisting(12345, 1, 0);  // Full
+
+  for (uint32_t i = 0; i < kMaxEntries; i += 3) {
+    AddNewOrUpdateExisting(i << 16, 2, 100 + i);  // Newer
+    AddNewOrUpdateExisting(i << 16, 1, 200 + i);  // Stale
+  }
+
+  for (size_t position : {0u, 10u, 61u, 5u, 5u, 5u, 30u}) {
+    RemoveEntry(position);
+  }
+  RemoveEntry(indexed_.total_entries() - 1);
+
+  for (uint32_t i = 0; i < kMaxEntries; ++i) {
+    AddNewOrUpdateExisting(i << 16, 3, 300 + i);
+  }
+}
+
+TEST_F(HashIndexEntryCache, RemoveAndAddRepeatedly) {
+  uint32_t hash = 1;
+  for (int round = 0; round < 500; ++round) {
+    // Advance a linear congruential generator for pseudo-random hashes.
+    hash = hash * 1664525u + 1013904223u;
+    if (indexed_.full() || (hash >> 31) != 0u) {
+      if (indexed_.total_entries() > 0u) {
+        RemoveEntry((hash >> 8) % indexed_.total_entries());
+      }
+    } else {
+      AddNewOrUpdateExisting(hash & 0xff00ffff, 1, round);
+    }
+  }
+}
+
+TEST_F(HashIndexEntryCache, Reset) {
+  for (uint32_t i = 0; i < 10; ++i) {
+    AddNewOrUpdateExisting(i, 1, i);
+  }
+  scanned_.Reset();
+  indexed_.Reset();
+  ExpectSameEntries();
+
+  for (uint32_t i = 0; i < 10; ++i) {
+    AddNewOrUpdateExisting(i, 1, i);
+  }
+  EXPECT_EQ(10u, indexed_.total_entries());
+}
+
 constexpr size_t kSectorSize = 64;
 constexpr uint32_t kMagic = 0xa14ae726;
 // For KVS entry magic value always use a random 32 bit integer rather than a
@@ -0,0 +1,229 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_kvs/internal/index_snapshot.h"
+
+#include <algorithm>
+
+#include "pw_bytes/span.h"
+#include "pw_checksum/crc32.h"
+#include "pw_kvs/alignment.h"
+#include "pw_kvs_private/config.h"
+#include "pw_status/try.h"
+
+namespace pw::kvs::internal {
+namespace {
+
+constexpr size_t kWriteBufferSize = std::max<size_t>(kMaxFlashAlignment, 64);
+
+template <typename T>
+ConstByteSpan AsBytes(const T& value) {
+  return ConstByteSpan(reinterpret_cast<const std::byte*>(&value),
+                       sizeof(value));
+}
+
+}  // namespace
+
+template <typename Function>
+Status IndexSnapshot::Serialize(const Header& header,
+                                const Sectors& sectors,
+                                const EntryCache& entry_cache,
+                                size_t sector_size_bytes,
+                                Function&& function) {
+  PW_TRY(function(AsBytes(header)));
+
+  for (const SectorDescriptor& sector : sectors) {
+    const uint16_t written_bytes =
+        static_cast<uint16_t>(sector_size_bytes - sector.writable_bytes());
+    PW_TRY(function(AsBytes(written_bytes)));
+  }
+
+  for (const EntryMetadata& metadata : entry_cache) {
+    const EntryRecord record = {
+        .key_hash = metadata.hash(),
+        .transaction_id = metadata.transaction_id(),
+        .deleted = metadata.state() == EntryState::kDeleted,
+        .reserved = {},
+    };
+    PW_TRY(function(AsBytes(record)));
+    PW_TRY(function(as_bytes(metadata.addresses())));
+  }
+  return OkStatus();
+}
+
+Status IndexSnapshot::Invalidate() {
+  if (!enabled() || erased_) {
+    return OkStatus();
+  }
+  PW_TRY(partition_->Erase());
+  erased_ = true;
+  return OkStatus();
+}
+
+Status IndexSnapshot::Write(const Sectors& sectors,
+                            const EntryCache& entry_cache,
+                            size_t sector_size_bytes,
+                            uint32_t last_transaction_id) {
+  if (!enabled()) {
+    return Status::FailedPrecondition();
+  }
+
+  // Every entry is stored with the same number of addresses, so entries that
+  // are missing redundant copies cannot be stored.
+  for (const EntryMetadata& metadata : entry_cache) {
+    if (metadata.addresses().size() != entry_cache.redundancy()) {
+      return Status::FailedPrecondition();
+    }
+  }
+
+  if (SnapshotSize(sectors.size(),
+                   entry_cache.total_entries(),
+                   entry_cache.redundancy()) > partition_->size_bytes()) {
+    return Status::ResourceExhausted();
+  }
+
+  Header header = {
+      .magic = kMagic,
+      .checksum = 0,
+      .sequence_number = sequence_number_ + 1,
+      .last_transaction_id = last_transaction_id,
+      .sector_size_bytes = static_cast<uint32_t>(sector_size_bytes),
+      .sector_count = static_cast<uint16_t>(sectors.size()),
+      .redundancy = static_cast<uint16_t>(entry_cache.redundancy()),
+      .entry_count = static_cast<uint32_t>(entry_cache.total_entries()),
+  };
+
+  checksum::Crc32 crc;
+  PW_TRY(Serialize(header,
+                   sectors,
+                   entry_cache,
+                   sector_size_bytes,
+                   [&crc](ConstByteSpan data) {
+                     crc.Update(data);
+                     return OkStatus();
+                   }));
+  header.checksum = crc.value();
+
+  PW_TRY(Invalidate());
+  erased_ = false;
+
+  FlashPartition::Output output(*partition_, 0);
+  AlignedWriterBuffer<kWriteBufferSize> writer(partition_->alignment_bytes(),
+                                               output);
+  PW_TRY(Serialize(header,
+                   sectors,
+                   entry_cache,
+                   sector_size_bytes,
+                   [&writer](ConstByteSpan data) {
+                     return writer.Write(data).status();
+                   }));
+  PW_TRY(writer.Flush());
+
+  sequence_number_ = header.sequence_number;
+  return OkStatus();
+}
+
+Status IndexSnapshot::Read(Sectors& sectors,
+                           EntryCache& entry_cache,
+                           size_t sector_size_bytes,
+                           uint32_t& last_transaction_id) {
+  if (!enabled()) {
+    return Status::FailedPrecondition();
+  }
+
+  checksum::Crc32 crc;
+  Address address = 0;
+
+  // Reads the next part of the snapshot and adds it to the checksum.
+  auto read = [&](void* data, size_t size) -> Status {
+    if (size > partition_->size_bytes() - address) {
+      return Status::DataLoss();
+    }
+    PW_TRY(partition_->Read(address, size, data));
+    crc.Update(span(static_cast<const std::byte*>(data), size));
+    address += size;
+    return OkStatus();
+  };
+
+  Header header;
+  PW_TRY(partition_->Read(address, sizeof(header), &header));
+  address += sizeof(header);
+
+  if (header.magic != kMagic ||
+      header.sector_size_bytes != sector_size_bytes ||
+      header.sector_count != sectors.size() ||
+      header.redundancy != entry_cache.redundancy() ||
+      header.entry_count > entry_cache.max_entries() ||
+      SnapshotSize(header.sector_count,
+                   header.entry_count,
+                   header.redundancy) > partition_->size_bytes()) {
+    return Status::DataLoss();
+  }
+
+  const uint32_t checksum = header.checksum;
+  header.checksum = 0;
+  crc.Update(AsBytes(header));
+
+  for (SectorDescriptor& sector : sectors) {
+    uint16_t written_bytes;
+    PW_TRY(read(&written_bytes, sizeof(written_bytes)));
+    if (written_bytes > sector_size_bytes) {
+      return Status::DataLoss();
+    }
+    sector.set_writable_bytes(
+        static_cast<uint16_t>(sector_size_bytes - written_bytes));
+  }
+
+  const Address partition_end = header.sector_count * sector_size_bytes;
+
+  for (uint32_t i = 0; i < header.entry_count; ++i) {
+    EntryRecord record;
+    PW_TRY(read(&record, sizeof(record)));
+    if (record.deleted > 1u) {
+      return Status::DataLoss();
+    }
+
+    const KeyDescriptor descriptor = {
+        .key_hash = record.key_hash,
+        .transaction_id = record.transaction_id,
+        .state = record.deleted != 0u ? EntryState::kDeleted
+                                      : EntryState::kValid,
+    };
+
+    EntryMetadata metadata;
+    for (size_t copy = 0; copy < header.redundancy; ++copy) {
+      Address entry_address;
+      PW_TRY(read(&entry_address, sizeof(entry_address)));
+      if (entry_address >= partition_end) {
+        return Status::DataLoss();
+      }
+
+      if (copy == 0u) {
+        metadata = entry_cache.AddNew(descriptor, entry_address);
+      } else {
+        metadata.AddNewAddress(entry_address);
+      }
+    }
+  }
+
+  if (crc.value() != checksum) {
+    return Status::DataLoss();
+  }
+
+  sequence_number_ = header.sequence_number;
+  last_transaction_id = header.last_transaction_id;
+  return OkStatus();
+}
+
+}  // namespace pw::kvs::internal
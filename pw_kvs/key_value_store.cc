@@ -32,6 +32,11 @@ namespace {
 
 using std::byte;
 
+// Batches are written through a larger buffer than single entries, so that
+// runs of small entries are combined into fewer flash writes.
+constexpr size_t kBatchWriteBufferSize =
+    std::max<size_t>(kMaxFlashAlignment, 256);
+
 constexpr bool InvalidKey(std::string_view key) {
   return key.empty() || (key.size() > internal::Entry::kMaxKeyLength);
 }
@@ -45,11 +50,13 @@ KeyValueStore::KeyValueStore(FlashPartition* partition,
                              Vector<SectorDescriptor>& sector_descriptor_list,
                              const SectorDescriptor** temp_sectors_to_skip,
                              Vector<KeyDescriptor>& key_descriptor_list,
-                             Address* addresses)
+                             Address* addresses,
+                             span<internal::EntryCache::HashIndexSlot>
+                                 hash_index)
     : partition_(*partition),
       formats_(formats),
       sectors_(sector_descriptor_list, *partition, temp_sectors_to_skip),
-      entry_cache_(key_descriptor_list, addresses, redundancy),
+      entry_cache_(key_descriptor_list, addresses, redundancy, hash_index),
       options_(options),
       initialized_(InitializationState::kNotInitialized),
       error_detected_(false),
@@ -92,7 +99,16 @@ Status KeyValueStore::Init() {
     return Status::FailedPrecondition();
   }
 
-  Status metadata_result = InitializeMetadata();
+  Status metadata_result;
+  if (index_snapshot_.enabled() && InitializeMetadataFromSnapshot().ok()) {
+    PW_LOG_INFO("KVS init: Loaded index snapshot %u",
+                unsigned(index_snapshot_.sequence_number()));
+  } else {
+    if (index_snapshot_.enabled()) {
+      PW_LOG_INFO("KVS init: No usable index snapshot; reading all entries");
+    }
+    metadata_result = InitializeMetadata();
+  }
 
   if (!error_detected_) {
     initialized_ = InitializationState::kReady;
@@ -307,6 +323,82 @@ Status KeyValueStore::InitializeMetadata() {
   return OkStatus();
 }
 
+Status KeyValueStore::InitializeMetadataFromSnapshot() {
+  const size_t sector_size_bytes = partition_.sector_size_bytes();
+
+  sectors_.Reset();
+  entry_cache_.Reset();
+
+  uint32_t snapshot_transaction_id;
+  PW_TRY(index_snapshot_.Read(
+      sectors_, entry_cache_, sector_size_bytes, snapshot_transaction_id));
+
+  PW_LOG_DEBUG("Read entries written after the index snapshot");
+  bool empty_sector_found = false;
+
+  for (SectorDescriptor& sector : sectors_) {
+    const Address sector_address = sectors_.BaseAddress(sector);
+    Address entry_address = sectors_.NextWritableAddress(sector);
+
+    while (sectors_.AddressInSector(sector, entry_address)) {
+      Address next_entry_address;
+      Status status = LoadEntry(entry_address, &next_entry_address);
+      if (status.IsNotFound()) {
+        break;
+      }
+      // Any corruption is handled by reading all entries instead.
+      PW_TRY(status);
+
+      entry_address = next_entry_address;
+      sector.set_writable_bytes(sector_size_bytes -
+                                (entry_address - sector_address));
+    }
+
+    if (sector.Empty(sector_size_bytes)) {
+      empty_sector_found = true;
+    }
+  }
+
+  if (!empty_sector_found) {
+    return Status::DataLoss();
+  }
+
+  PW_LOG_DEBUG("Check that the snapshot's entries are in flash");
+  Address newest_key = 0;
+  uint32_t last_transaction_id = last_transaction_id_;
+
+  // Read the header of every entry copy to confirm that the partition holds
+  // the entries the snapshot describes, and count the valid bytes in each
+  // sector.
+  for (EntryMetadata& metadata : entry_cache_) {
+    if (metadata.addresses().size() < redundancy()) {
+      return Status::DataLoss();
+    }
+
+    for (Address address : metadata.addresses()) {
+      Entry entry;
+      PW_TRY(Entry::Read(partition_, address, formats_, &entry));
+      if (entry.transaction_id() != metadata.transaction_id()) {
+        return Status::DataLoss();
+      }
+      sectors_.FromAddress(address).AddValidBytes(entry.size());
+    }
+
+    if (metadata.IsNewerThan(last_transaction_id)) {
+      last_transaction_id = metadata.transaction_id();
+      newest_key = metadata.addresses().back();
+    }
+  }
+
+  if (last_transaction_id < snapshot_transaction_id) {
+    return Status::DataLoss();
+  }
+
+  sectors_.set_last_new_sector(newest_key);
+  last_transaction_id_ = last_transaction_id;
+  return OkStatus();
+}
+
 KeyValueStore::StorageStats KeyValueStore::GetStorageStats() const {
   StorageStats stats{};
   const size_t sector_size = partition_.sector_size_bytes();
@@ -375,10 +467,40 @@ Status KeyValueStore::LoadEntry(Address entry_address,
   // A valid entry was found, so update the next entry address before doing any
   // of the checks that happen in AddNewOrUpdateExisting.
   *next_entry_address = entry.next_address();
+
+  // Entries from a batch that was not completely written are skipped. Their
+  // transaction ID must not be reused, or a later entry could appear to
+  // complete the batch.
+  if (entry.batched() && !BatchCommitted(entry)) {
+    PW_LOG_DEBUG("Skipping entry from incomplete batch at %u",
+                 unsigned(entry_address));
+    last_transaction_id_ = std::max(last_transaction_id_, entry.transaction_id());
+    return OkStatus();
+  }
+
   return entry_cache_.AddNewOrUpdateExisting(
       entry.descriptor(key), entry.address(), partition_.sector_size_bytes());
 }
 
+// Checks that the final entry of a batched entry's batch follows it. A batch
+// is written as a contiguous run in one sector.
+bool KeyValueStore::BatchCommitted(const Entry& batched_entry) const {
+  const SectorDescriptor& sector =
+      sectors_.FromAddress(batched_entry.address());
+
+  Entry entry = batched_entry;
+  while (sectors_.AddressInSector(sector, entry.next_address())) {
+    if (!Entry::Read(partition_, entry.next_address(), formats_, &entry).ok() ||
+        entry.transaction_id() != batched_entry.transaction_id()) {
+      return false;
+    }
+    if (!entry.batched()) {
+      return entry.VerifyChecksumInFlash().ok();
+    }
+  }
+  return false;
+}
+
 // Scans flash memory within a sector to find a KVS entry magic.
 Status KeyValueStore::ScanForEntry(const SectorDescriptor& sector,
                                    Address start_address,
@@ -501,6 +623,181 @@ Status KeyValueStore::Delete(std::string_view key) {
   return WriteEntryForExistingKey(metadata, EntryState::kDeleted, key, {});
 }
 
+Status KeyValueStore::Commit(const WriteBatch& batch) {
+  if (!initialized()) {
+    return Status::FailedPrecondition();
+  }
+  if (batch.empty()) {
+    return OkStatus();
+  }
+
+  // Check every operation before writing anything, so that a batch that would
+  // fail partway through is not written at all.
+  size_t write_size;
+  PW_TRY(CheckBatch(batch, &write_size));
+
+  // Find sectors with room for a copy of the whole batch. This may involve
+  // garbage collecting one or more sectors.
+  Address* reserved_addresses = entry_cache_.TempReservedAddressesForWrite();
+  PW_TRY(GetAddressesForWrite(reserved_addresses, write_size));
+
+  // All entries in a batch share one transaction ID, which is burned even if
+  // the write fails, as in CreateEntry.
+  last_transaction_id_ += 1;
+  const uint32_t transaction_id = last_transaction_id_;
+
+  PW_TRY(WriteBatchEntries(batch, reserved_addresses[0], transaction_id));
+
+  // After the first copy of the batch is written, update the key descriptors.
+  // The old entries for these keys are now stale.
+  Address address = reserved_addresses[0];
+  PW_TRY(batch.ForEach([&](const WriteBatch::Operation& operation) {
+    const internal::KeyDescriptor descriptor = {
+        .key_hash = internal::Hash(operation.key),
+        .transaction_id = transaction_id,
+        .state = operation.deleted ? EntryState::kDeleted : EntryState::kValid,
+    };
+
+    EntryMetadata metadata;
+    if (FindEntry(operation.key, &metadata).ok()) {
+      Entry prior_entry;
+      PW_TRY(ReadEntry(metadata, prior_entry));
+      for (Address prior_address : metadata.addresses()) {
+        sectors_.FromAddress(prior_address)
+            .RemoveValidBytes(prior_entry.size());
+      }
+      metadata.Reset(descriptor, address);
+    } else {
+      entry_cache_.AddNew(descriptor, address);
+    }
+    address += Entry::size(partition_, operation.key, operation.value);
+    return OkStatus();
+  }));
+
+  // Write the additional copies of the batch, if redundancy is greater than 1.
+  for (size_t i = 1; i < redundancy(); ++i) {
+    PW_TRY(WriteBatchEntries(batch, reserved_addresses[i], transaction_id));
+
+    address = reserved_addresses[i];
+    PW_TRY(batch.ForEach([&](const WriteBatch::Operation& operation) {
+      EntryMetadata metadata;
+      PW_TRY(FindEntry(operation.key, &metadata));
+      metadata.AddNewAddress(address);
+      address += Entry::size(partition_, operation.key, operation.value);
+      return OkStatus();
+    }));
+  }
+  return OkStatus();
+}
+
+Status KeyValueStore::CheckBatch(const WriteBatch& batch,
+                                 size_t* write_size) const {
+  size_t total_size = 0;
+  size_t new_keys = 0;
+
+  PW_TRY(batch.ForEach([&](const WriteBatch::Operation& operation) {
+    total_size += Entry::size(partition_, operation.key, operation.value);
+
+    // Keys in the batch must not collide with each other. Operations for the
+    // same key are merged when they are staged.
+    const uint32_t hash = internal::Hash(operation.key);
+    PW_TRY(batch.ForEach([&](const WriteBatch::Operation& other) {
+      if (other.key != operation.key && internal::Hash(other.key) == hash) {
+        return Status::AlreadyExists();
+      }
+      return OkStatus();
+    }));
+
+    EntryMetadata metadata;
+    const Status status = FindEntry(operation.key, &metadata);
+    if (status.IsNotFound()) {
+      new_keys += 1;
+    } else {
+      PW_TRY(status);
+    }
+
+    if (operation.deleted &&
+        (status.IsNotFound() || metadata.state() == EntryState::kDeleted)) {
+      return Status::NotFound();
+    }
+    return OkStatus();
+  }));
+
+  if (total_size > partition_.sector_size_bytes()) {
+    PW_LOG_DEBUG("%u B batch cannot fit in one sector", unsigned(total_size));
+    return Status::InvalidArgument();
+  }
+
+  if (new_keys > entry_cache_.max_entries() - entry_cache_.total_entries()) {
+    PW_LOG_WARN("KVS full: trying to store %u new entries, but can't. Have %u",
+                unsigned(new_keys),
+                unsigned(entry_cache_.total_entries()));
+    return Status::ResourceExhausted();
+  }
+
+  *write_size = total_size;
+  return OkStatus();
+}
+
+Status KeyValueStore::WriteBatchEntries(const WriteBatch& batch,
+                                        Address address,
+                                        uint32_t transaction_id) {
+  SectorDescriptor& sector = sectors_.FromAddress(address);
+
+  FlashPartition::Output output(partition_, address);
+  AlignedWriterBuffer<kBatchWriteBufferSize> writer(partition_.alignment_bytes(),
+                                                    output);
+
+  // Every entry but the last is marked as batched. The last entry completes
+  // the batch.
+  size_t remaining = batch.size();
+  Address entry_address = address;
+  Status status = batch.ForEach([&](const WriteBatch::Operation& operation) {
+    remaining -= 1;
+    const bool batched = remaining != 0u;
+    const Entry entry = operation.deleted
+                            ? Entry::Tombstone(partition_,
+                                               entry_address,
+                                               formats_.primary(),
+                                               operation.key,
+                                               transaction_id,
+                                               batched)
+                            : Entry::Valid(partition_,
+                                           entry_address,
+                                           formats_.primary(),
+                                           operation.key,
+                                           operation.value,
+                                           transaction_id,
+                                           batched);
+    entry_address = entry.next_address();
+    return entry.Write(writer, operation.key, operation.value).status();
+  });
+
+  const StatusWithSize result = writer.Flush();
+  status.Update(result.status());
+  if (!status.ok()) {
+    PW_LOG_ERROR("Failed to write %u byte batch at %#x. %u actually written",
+                 unsigned(entry_address - address),
+                 unsigned(address),
+                 unsigned(result.size()));
+    return MarkSectorCorruptIfNotOk(status, &sector);
+  }
+
+  if (options_.verify_on_write) {
+    for (Address verify_address = address; verify_address < entry_address;) {
+      Entry entry;
+      PW_TRY(MarkSectorCorruptIfNotOk(
+          Entry::Read(partition_, verify_address, formats_, &entry), &sector));
+      PW_TRY(MarkSectorCorruptIfNotOk(entry.VerifyChecksumInFlash(), &sector));
+      verify_address = entry.next_address();
+    }
+  }
+
+  sector.RemoveWritableBytes(entry_address - address);
+  sector.AddValidBytes(entry_address - address);
+  return OkStatus();
+}
+
 void KeyValueStore::Item::ReadKey() {
   key_buffer_.fill('\0');
 
@@ -882,6 +1179,10 @@ Status KeyValueStore::AppendEntry(const Entry& entry,
 StatusWithSize KeyValueStore::CopyEntryToSector(Entry& entry,
                                                 SectorDescriptor* new_sector,
                                                 Address new_address) {
+  // Copies of batched entries are not part of a batch.
+  if (entry.batched()) {
+    PW_TRY_WITH_SIZE(entry.ClearBatched());
+  }
   const StatusWithSize result = entry.Copy(new_address);
 
   PW_TRY_WITH_SIZE(MarkSectorCorruptIfNotOk(result.status(), new_sector));
@@ -1012,6 +1313,18 @@ Status KeyValueStore::FullMaintenanceHelper(MaintenanceType maintenance_type) {
   }
 #endif  // PW_KVS_REMOVE_DELETED_KEYS_IN_HEAVY_MAINTENANCE
 
+  // Step 5: Save the index so the next Init() does not have to read every
+  // entry. Failing to save it does not affect the KVS.
+  if (overall_status.ok() && !error_detected_ && index_snapshot_.enabled()) {
+    Status snapshot_status = index_snapshot_.Write(sectors_,
+                                                   entry_cache_,
+                                                   partition_.sector_size_bytes(),
+                                                   last_transaction_id_);
+    if (!snapshot_status.ok()) {
+      PW_LOG_WARN("Failed to write index snapshot: %s", snapshot_status.str());
+    }
+  }
+
   if (overall_status.ok()) {
     PW_LOG_INFO("Full maintenance complete");
   } else {
@@ -1093,6 +1406,8 @@ Status KeyValueStore::GarbageCollectSector(
   if (!sector_to_gc.Empty(partition_.sector_size_bytes())) {
     sector_to_gc.mark_corrupt();
     internal_stats_.sector_erase_count++;
+    // The index snapshot refers to entries in this sector, so discard it.
+    PW_TRY(index_snapshot_.Invalidate());
     PW_TRY(partition_.Erase(sectors_.BaseAddress(sector_to_gc), 1));
     sector_to_gc.set_writable_bytes(partition_.sector_size_bytes());
   }
@@ -0,0 +1,335 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
+
+#include "pw_kvs/crc16_checksum.h"
+#include "pw_kvs/fake_flash_memory.h"
+#include "pw_kvs/key_value_store.h"
+#include "pw_kvs/write_batch.h"
+#include "pw_log/log.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::kvs {
+namespace {
+
+constexpr size_t kSectorSize = 4 * 1024;
+constexpr size_t kSectors = 4;
+constexpr size_t kMaxEntries = 32;
+constexpr size_t kBatchKeys = 16;
+
+using Value = std::array<uint8_t, 32>;
+
+// A FakeFlashMemoryBuffer that counts the writes made to it, and can simulate
+// losing power by dropping writes after a number of writes.
+class CountingFlashMemory : public FakeFlashMemoryBuffer<kSectorSize, kSectors> {
+ public:
+  using FakeFlashMemory::Write;
+
+  StatusWithSize Write(Address address, span<const std::byte> data) override {
+    if (writes_ >= write_limit_) {
+      return StatusWithSize::DataLoss();
+    }
+    writes_ += 1;
+    return FakeFlashMemory::Write(address, data);
+  }
+
+  size_t writes() const { return writes_; }
+
+  void reset_writes(size_t write_limit = size_t(-1)) {
+    writes_ = 0;
+    write_limit_ = write_limit;
+  }
+
+ private:
+  size_t writes_ = 0;
+  size_t write_limit_ = size_t(-1);
+};
+
+CountingFlashMemory test_flash;
+FlashPartition test_partition(&test_flash);
+
+ChecksumCrc16 checksum;
+
+// For KVS magic value always use a random 32 bit integer rather than a human
+// readable 4 bytes. See pw_kvs/format.h for more information.
+constexpr EntryFormat kFormat{.magic = 0x7d1c33b5, .checksum = &checksum};
+
+TEST(WriteBatch, Put_StagesOperations) {
+  WriteBatchBuffer<64> batch;
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(OkStatus(), batch.Put("a", uint32_t{1}));
+  EXPECT_EQ(OkStatus(), batch.Put("b", uint32_t{2}));
+  EXPECT_EQ(OkStatus(), batch.Delete("c"));
+  EXPECT_EQ(3u, batch.size());
+
+  batch.Clear();
+  EXPECT_TRUE(batch.empty());
+}
+
+TEST(WriteBatch, Put_SameKey_ReplacesOperation) {
+  WriteBatchBuffer<64> batch;
+  EXPECT_EQ(OkStatus(), batch.Put("a", uint32_t{1}));
+  EXPECT_EQ(OkStatus(), batch.Put("b", uint32_t{2}));
+  EXPECT_EQ(OkStatus(), batch.Delete("a"));
+  EXPECT_EQ(2u, batch.size());
+}
+
+TEST(WriteBatch, Put_InvalidKey) {
+  WriteBatchBuffer<256> batch;
+  EXPECT_EQ(Status::InvalidArgument(), batch.Put("", uint32_t{1}));
+
+  constexpr std::string_view kLongKey =
+      "This key is too long to store in a KVS entry, since keys can be at most "
+      "63 bytes long.";
+  EXPECT_EQ(Status::InvalidArgument(), batch.Put(kLongKey, uint32_t{1}));
+  EXPECT_TRUE(batch.empty());
+}
+
+TEST(WriteBatch, Put_BufferFull) {
+  WriteBatchBuffer<16> batch;
+  EXPECT_EQ(OkStatus(), batch.Put("a", uint32_t{1}));
+  EXPECT_EQ(Status::ResourceExhausted(), batch.Put("bcdefgh", uint32_t{2}));
+  EXPECT_EQ(1u, batch.size());
+
+  // Replacing a staged operation may reuse its space.
+  EXPECT_EQ(OkStatus(), batch.Put("a", uint64_t{3}));
+  EXPECT_EQ(1u, batch.size());
+}
+
+class KvsBatchTest : public ::testing::Test {
+ protected:
+  template <size_t kRedundancy = 1>
+  using Kvs = KeyValueStoreBuffer<kMaxEntries, kSectors, kRedundancy>;
+
+  KvsBatchTest() : flash_(test_flash), partition_(test_partition) {
+    EXPECT_EQ(OkStatus(), flash_.Erase(0, flash_.sector_count()));
+    flash_.reset_writes();
+  }
+
+  static std::string_view Key(size_t index) {
+    static std::array<char, 16> key;
+    const int length =
+        std::snprintf(key.data(), key.size(), "key_%02u", unsigned(index));
+    return std::string_view(key.data(), static_cast<size_t>(length));
+  }
+
+  static Value MakeValue(size_t index, uint8_t version) {
+    Value value;
+    value.fill(static_cast<uint8_t>(index + version));
+    return value;
+  }
+
+  // Stages kBatchKeys Puts.
+  static void StagePuts(WriteBatch& batch, uint8_t version) {
+    for (size_t i = 0; i < kBatchKeys; ++i) {
+      ASSERT_EQ(OkStatus(), batch.Put(Key(i), MakeValue(i, version)));
+    }
+  }
+
+  static void ExpectValues(const KeyValueStore& kvs, uint8_t version) {
+    for (size_t i = 0; i < kBatchKeys; ++i) {
+      Value value;
+      ASSERT_EQ(OkStatus(), kvs.Get(Key(i), &value));
+      EXPECT_EQ(MakeValue(i, version), value);
+    }
+  }
+
+  CountingFlashMemory& flash_;
+  FlashPartition& partition_;
+  WriteBatchBuffer<1024> batch_;
+};
+
+TEST_F(KvsBatchTest, Commit_AppliesAllOperations) {
+  Kvs<> kvs(&partition_, kFormat);
+  ASSERT_EQ(OkStatus(), kvs.Init());
+  ASSERT_EQ(OkStatus(), kvs.Put("deleted", uint32_t{1}));
+
+  StagePuts(batch_, 0);
+  ASSERT_EQ(OkStatus(), batch_.Delete("deleted"));
+  ASSERT_EQ(OkStatus(), kvs.Commit(batch_));
+
+  EXPECT_EQ(kBatchKeys, kvs.size());
+  ExpectValues(kvs, 0);
+  uint32_t value;
+  EXPECT_EQ(Status::NotFound(), kvs.Get("deleted", &value));
+
+  // All of the batch's entries share one transaction.
+  EXPECT_EQ(2u, kvs.transaction_count());
+
+  Kvs<> reloaded(&partition_, kFormat);
+  ASSERT_EQ(OkStatus(), reloaded.Init());
+  EXPECT_EQ(kBatchKeys, reloaded.size());
+  ExpectValues(reloaded, 0);
+  EXPECT_EQ(Status::NotFound(), reloaded.Get("deleted", &value));
+  EXPECT_EQ(kvs.transaction_count(), reloaded.transaction_count());
+  EXPECT_EQ(kvs.GetStorageStats().in_use_bytes,
+            reloaded.GetStorageStats().in_use_bytes);
+}
+
+TEST_F(KvsBatchTest, Commit_UpdatesExistingKeys) {
+  Kvs<> kvs(&partition_, kFormat);
+  ASSERT_EQ(OkStatus(), kvs.Init());
+
+  StagePuts(batch_, 0);
+  ASSERT_EQ(OkStatus(), kvs.Commit(batch_));
+  const size_t in_use_bytes = kvs.GetStorageStats().in_use_bytes;
+
+  batch_.Clear();
+  StagePuts(batch_, 1);
+  ASSERT_EQ(OkStatus(), kvs.Commit(batch_));
+
+  ExpectValues(kvs, 1);
+  EXPECT_EQ(in_use_bytes, kvs.GetStorageStats().in_use_bytes);
+
+  Kvs<> reloaded(&partition_, kFormat);
+  ASSERT_EQ(OkStatus(), reloaded.Init());
+  ExpectValues(reloaded, 1);
+}
+
+TEST_F(KvsBatchTest, Commit_Interrupted_NoOperationsApplied) {
+  {
+    Kvs<> kvs(&partition_, kFormat);
+    ASSERT_EQ(OkStatus(), kvs.Init());
+
+    flash_.reset_writes();
+    StagePuts(batch_, 0);
+    ASSERT_EQ(OkStatus(), kvs.Commit(batch_));
+    const size_t batch_writes = flash_.writes();
+    ASSERT_GT(batch_writes, 1u);
+
+    // Lose power before the last write of the next batch, which holds the
+    // batch's final entry.
+    batch_.Clear();
+    StagePuts(batch_, 1);
+    flash_.reset_writes(batch_writes - 1);
+    EXPECT_EQ(Status::DataLoss(), kvs.Commit(batch_));
+    flash_.reset_writes();
+  }
+
+  Kvs<> reloaded(&partition_, kFormat);
+  reloaded.Init().IgnoreError();
+  EXPECT_EQ(kBatchKeys, reloaded.size());
+  ExpectValues(reloaded, 0);
+
+  // New entries do not reuse the incomplete batch's transaction ID, so they
+  // cannot complete it.
+  ASSERT_EQ(OkStatus(), reloaded.Put(Key(0), MakeValue(0, 2)));
+
+  Kvs<> reloaded_again(&partition_, kFormat);
+  reloaded_again.Init().IgnoreError();
+  Value value;
+  ASSERT_EQ(OkStatus(), reloaded_again.Get(Key(0), &value));
+  EXPECT_EQ(MakeValue(0, 2), value);
+  ASSERT_EQ(OkStatus(), reloaded_again.Get(Key(1), &value));
+  EXPECT_EQ(MakeValue(1, 0), value);
+}
+
+TEST_F(KvsBatchTest, Commit_Redundant) {
+  Kvs<2> kvs(&partition_, kFormat);
+  ASSERT_EQ(OkStatus(), kvs.Init());
+
+  StagePuts(batch_, 0);
+  ASSERT_EQ(OkStatus(), kvs.Commit(batch_));
+  ExpectValues(kvs, 0);
+
+  // Corrupt the first sector, which holds one copy of the batch.
+  flash_.buffer()[16] ^= std::byte{0x01};
+
+  Kvs<2> reloaded(&partition_, kFormat);
+  reloaded.Init().IgnoreError();
+  EXPECT_EQ(kBatchKeys, reloaded.size());
+  ExpectValues(reloaded, 0);
+}
+
+TEST_F(KvsBatchTest, Commit_GarbageCollected_EntriesRelocated) {
+  Kvs<> kvs(&partition_, kFormat);
+  ASSERT_EQ(OkStatus(), kvs.Init());
+
+  StagePuts(batch_, 0);
+  ASSERT_EQ(OkStatus(), kvs.Commit(batch_));
+  ASSERT_EQ(OkStatus(), kvs.Put("other", uint32_t{1}));
+
+  // Relocating the batch's entries makes them ordinary entries.
+  ASSERT_EQ(OkStatus(), kvs.HeavyMaintenance());
+  ASSERT_EQ(OkStatus(), kvs.Put("other", uint32_t{2}));
+  ASSERT_EQ(OkStatus(), kvs.HeavyMaintenance());
+  ExpectValues(kvs, 0);
+
+  Kvs<> reloaded(&partition_, kFormat);
+  ASSERT_EQ(OkStatus(), reloaded.Init());
+  EXPECT_EQ(kBatchKeys + 1, reloaded.size());
+  ExpectValues(reloaded, 0);
+}
+
+TEST_F(KvsBatchTest, Commit_DeleteMissingKey_NothingWritten) {
+  Kvs<> kvs(&partition_, kFormat);
+  ASSERT_EQ(OkStatus(), kvs.Init());
+
+  StagePuts(batch_, 0);
+  ASSERT_EQ(OkStatus(), batch_.Delete("missing"));
+  flash_.reset_writes();
+  EXPECT_EQ(Status::NotFound(), kvs.Commit(batch_));
+  EXPECT_EQ(0u, flash_.writes());
+  EXPECT_EQ(0u, kvs.size());
+}
+
+TEST_F(KvsBatchTest, Commit_LargerThanSector_InvalidArgument) {
+  Kvs<> kvs(&partition_, kFormat);
+  ASSERT_EQ(OkStatus(), kvs.Init());
+
+  WriteBatchBuffer<2 * kSectorSize> batch;
+  std::array<std::byte, kSectorSize / 2> value{};
+  ASSERT_EQ(OkStatus(), batch.Put("a", value));
+  ASSERT_EQ(OkStatus(), batch.Put("b", value));
+  EXPECT_EQ(Status::InvalidArgument(), kvs.Commit(batch));
+  EXPECT_EQ(0u, kvs.size());
+}
+
+TEST_F(KvsBatchTest, Commit_TooManyKeys_ResourceExhausted) {
+  KeyValueStoreBuffer<kBatchKeys - 1, kSectors> kvs(&partition_, kFormat);
+  ASSERT_EQ(OkStatus(), kvs.Init());
+
+  StagePuts(batch_, 0);
+  EXPECT_EQ(Status::ResourceExhausted(), kvs.Commit(batch_));
+  EXPECT_EQ(0u, kvs.size());
+}
+
+TEST_F(KvsBatchTest, Commit_FewerFlashWritesThanPuts) {
+  Kvs<> kvs(&partition_, kFormat);
+  ASSERT_EQ(OkStatus(), kvs.Init());
+
+  flash_.reset_writes();
+  for (size_t i = 0; i < kBatchKeys; ++i) {
+    ASSERT_EQ(OkStatus(), kvs.Put(Key(i), MakeValue(i, 0)));
+  }
+  const size_t put_writes = flash_.writes();
+
+  StagePuts(batch_, 1);
+  flash_.reset_writes();
+  ASSERT_EQ(OkStatus(), kvs.Commit(batch_));
+  const size_t batch_writes = flash_.writes();
+
+  PW_LOG_INFO("Flash writes for %u keys: %u with Put, %u with a batch",
+              unsigned(kBatchKeys),
+              unsigned(put_writes),
+              unsigned(batch_writes));
+  EXPECT_LT(batch_writes, put_writes);
+}
+
+}  // namespace
+}  // namespace pw::kvs
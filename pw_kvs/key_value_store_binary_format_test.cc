@@ -127,6 +127,39 @@ constexpr auto MakeDeletedEntry(uint32_t magic,
   return data;
 }
 
+// Creates a buffer containing a valid entry that is part of a batch, but is not
+// the batch's final entry, at compile time.
+template <uint32_t (*kChecksum)(span<const byte>, uint32_t) = &SimpleChecksum,
+          size_t kAlignmentBytes = sizeof(internal::EntryHeader),
+          size_t kKeyLengthWithNull,
+          size_t kValueSize>
+constexpr auto MakeBatchedEntry(uint32_t magic,
+                                uint32_t id,
+                                const char (&key)[kKeyLengthWithNull],
+                                const std::array<byte, kValueSize>& value) {
+  constexpr size_t kKeyLength = kKeyLengthWithNull - 1;
+
+  auto data =
+      bytes::Concat(magic,
+                    uint32_t(0),
+                    uint8_t(kAlignmentBytes / 16 - 1),
+                    uint8_t(kKeyLength | 0b1000000),  // Batched entry bit
+                    uint16_t(kValueSize),
+                    id,
+                    bytes::String(key),
+                    span(value),
+                    EntryPadding<kAlignmentBytes, kKeyLength, kValueSize>());
+
+  // Calculate the checksum
+  uint32_t checksum = kChecksum(data, 0);
+  for (size_t i = 0; i < sizeof(checksum); ++i) {
+    data[4 + i] = byte(checksum & 0xff);
+    checksum >>= 8;
+  }
+
+  return data;
+}
+
 // For KVS magic value always use a random 32 bit integer rather than a
 // human readable 4 bytes. See pw_kvs/format.h for more information.
 constexpr uint32_t kMagic = 0x5ab2f0b5;
@@ -372,6 +405,95 @@ TEST_F(KvsErrorHandling, Put_WriteFailure_EntryNotAddedButBytesMarkedWritten) {
   EXPECT_EQ(stats.writable_bytes, 512u * 2 - (32 * kvs_.redundancy()));
 }
 
+// A batch of three entries with transaction ID 6. The last entry completes the
+// batch.
+constexpr auto kBatchedEntry1 =
+    MakeBatchedEntry(kMagic, 6, "b1", bytes::String("batch1"));
+constexpr auto kBatchedEntry2 =
+    MakeBatchedEntry(kMagic, 6, "b2", bytes::String("batch2"));
+constexpr auto kBatchEnd =
+    MakeValidEntry(kMagic, 6, "b3", bytes::String("batch3"));
+
+TEST_F(KvsErrorHandling, Init_CompleteBatch_ReadsAllEntries) {
+  InitFlashTo(
+      bytes::Concat(kEntry1, kBatchedEntry1, kBatchedEntry2, kBatchEnd));
+
+  EXPECT_EQ(OkStatus(), kvs_.Init());
+  EXPECT_EQ(4u, kvs_.size());
+  byte buffer[64];
+  EXPECT_EQ(OkStatus(), kvs_.Get("key1", buffer).status());
+  EXPECT_EQ(OkStatus(), kvs_.Get("b1", buffer).status());
+  EXPECT_EQ(OkStatus(), kvs_.Get("b2", buffer).status());
+  EXPECT_EQ(OkStatus(), kvs_.Get("b3", buffer).status());
+  EXPECT_EQ(6u, kvs_.transaction_count());
+}
+
+TEST_F(KvsErrorHandling, Init_IncompleteBatch_IgnoresBatchedEntries) {
+  // Each prefix of the batch, which is what an interrupted write leaves.
+  InitFlashTo(bytes::Concat(kEntry1, kBatchedEntry1));
+  EXPECT_EQ(OkStatus(), kvs_.Init());
+  EXPECT_EQ(1u, kvs_.size());
+
+  InitFlashTo(bytes::Concat(kEntry1, kBatchedEntry1, kBatchedEntry2));
+  EXPECT_EQ(OkStatus(), kvs_.Init());
+  EXPECT_EQ(1u, kvs_.size());
+
+  byte buffer[64];
+  EXPECT_EQ(OkStatus(), kvs_.Get("key1", buffer).status());
+  EXPECT_EQ(Status::NotFound(), kvs_.Get("b1", buffer).status());
+  EXPECT_EQ(Status::NotFound(), kvs_.Get("b2", buffer).status());
+
+  // The incomplete batch's transaction ID is not reused.
+  EXPECT_EQ(6u, kvs_.transaction_count());
+  ASSERT_EQ(OkStatus(), kvs_.Put("k2", bytes::String("new")));
+
+  EXPECT_EQ(OkStatus(), kvs_.Init());
+  EXPECT_EQ(2u, kvs_.size());
+  EXPECT_EQ(Status::NotFound(), kvs_.Get("b1", buffer).status());
+  EXPECT_EQ(Status::NotFound(), kvs_.Get("b2", buffer).status());
+}
+
+TEST_F(KvsErrorHandling, Init_CorruptBatchEnd_IgnoresBatch) {
+  // Corrupt each byte in the batch's final entry once.
+  for (size_t i = 0; i < kBatchEnd.size(); ++i) {
+    InitFlashTo(
+        bytes::Concat(kEntry1, kBatchedEntry1, kBatchedEntry2, kBatchEnd));
+    const size_t batch_end = kEntry1.size() + 2 * kBatchedEntry1.size();
+    flash_.buffer()[batch_end + i] =
+        byte(int(flash_.buffer()[batch_end + i]) + 1);
+
+    ASSERT_EQ(Status::DataLoss(), kvs_.Init());
+    byte buffer[64];
+    ASSERT_EQ(OkStatus(), kvs_.Get("key1", buffer).status());
+    ASSERT_EQ(Status::NotFound(), kvs_.Get("b1", buffer).status());
+    ASSERT_EQ(Status::NotFound(), kvs_.Get("b2", buffer).status());
+    ASSERT_EQ(Status::NotFound(), kvs_.Get("b3", buffer).status());
+  }
+}
+
+TEST_F(KvsErrorHandling, Init_BatchFollowedByOtherTransaction_IgnoresBatch) {
+  // kEntry4 has a later transaction ID, so it does not complete the batch.
+  InitFlashTo(bytes::Concat(kEntry1, kBatchedEntry1, kEntry4));
+
+  EXPECT_EQ(OkStatus(), kvs_.Init());
+  byte buffer[64];
+  EXPECT_EQ(OkStatus(), kvs_.Get("key1", buffer).status());
+  EXPECT_EQ(Status::NotFound(), kvs_.Get("b1", buffer).status());
+  EXPECT_EQ(OkStatus(), kvs_.Get("4k", buffer).status());
+}
+
+TEST_F(KvsErrorHandling, Init_BatchInOtherSector_IgnoresBatch) {
+  // A batch is written to one sector, so entries in the next sector do not
+  // complete it.
+  InitFlashTo(bytes::Concat(kEntry1, kBatchedEntry1));
+  std::memcpy(flash_.buffer().data() + 512, kBatchEnd.data(), kBatchEnd.size());
+
+  EXPECT_EQ(OkStatus(), kvs_.Init());
+  byte buffer[64];
+  EXPECT_EQ(Status::NotFound(), kvs_.Get("b1", buffer).status());
+  EXPECT_EQ(OkStatus(), kvs_.Get("b3", buffer).status());
+}
+
 class KvsErrorRecovery : public ::testing::Test {
  protected:
   KvsErrorRecovery()
@@ -0,0 +1,302 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
+
+#include "pw_kvs/crc16_checksum.h"
+#include "pw_kvs/fake_flash_memory.h"
+#include "pw_kvs/key_value_store.h"
+#include "pw_log/log.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::kvs {
+namespace {
+
+constexpr size_t kSectorSize = 4 * 1024;
+constexpr size_t kKvsSectors = 6;
+constexpr size_t kSnapshotSectors = 2;
+constexpr size_t kMaxEntries = 64;
+constexpr size_t kKeys = 48;
+
+using Value = std::array<uint8_t, 64>;
+
+// A FakeFlashMemoryBuffer that counts how many bytes are read from it.
+class CountingFlashMemory
+    : public FakeFlashMemoryBuffer<kSectorSize, kKvsSectors + kSnapshotSectors> {
+ public:
+  using FakeFlashMemory::Read;
+
+  StatusWithSize Read(Address address, span<std::byte> output) override {
+    bytes_read_ += output.size();
+    return FakeFlashMemory::Read(address, output);
+  }
+
+  size_t bytes_read() const { return bytes_read_; }
+  void reset_bytes_read() { bytes_read_ = 0; }
+
+ private:
+  size_t bytes_read_ = 0;
+};
+
+CountingFlashMemory test_flash;
+FlashPartition test_partition(&test_flash, 0, kKvsSectors);
+FlashPartition snapshot_partition(&test_flash, kKvsSectors, kSnapshotSectors);
+
+ChecksumCrc16 checksum;
+
+// For KVS magic value always use a random 32 bit integer rather than a human
+// readable 4 bytes. See pw_kvs/format.h for more information.
+constexpr EntryFormat kFormat{.magic = 0x0c2b7a1e, .checksum = &checksum};
+
+class IndexSnapshotTest : public ::testing::Test {
+ protected:
+  template <size_t kRedundancy = 1>
+  using Kvs = KeyValueStoreBuffer<kMaxEntries, kKvsSectors, kRedundancy>;
+
+  IndexSnapshotTest()
+      : flash_(test_flash),
+        partition_(test_partition),
+        snapshot_partition_(snapshot_partition) {
+    EXPECT_EQ(OkStatus(), flash_.Erase(0, flash_.sector_count()));
+  }
+
+  static std::string_view Key(size_t index) {
+    static std::array<char, 16> key;
+    const int length =
+        std::snprintf(key.data(), key.size(), "key_%02u", unsigned(index));
+    return std::string_view(key.data(), static_cast<size_t>(length));
+  }
+
+  static Value MakeValue(size_t index, uint8_t version) {
+    Value value;
+    value.fill(static_cast<uint8_t>(index + version));
+    return value;
+  }
+
+  // Writes kKeys keys, updates half of them, and saves a snapshot.
+  template <size_t kRedundancy = 1>
+  void WriteKeysAndSnapshot() {
+    Kvs<kRedundancy> kvs(&partition_, kFormat);
+    kvs.EnableIndexSnapshot(snapshot_partition_);
+    ASSERT_EQ(OkStatus(), kvs.Init());
+
+    for (size_t i = 0; i < kKeys; ++i) {
+      ASSERT_EQ(OkStatus(), kvs.Put(Key(i), MakeValue(i, 0)));
+    }
+    for (size_t i = 0; i < kKeys; i += 2) {
+      ASSERT_EQ(OkStatus(), kvs.Put(Key(i), MakeValue(i, 1)));
+    }
+    ASSERT_EQ(OkStatus(), kvs.FullMaintenance());
+  }
+
+  // Initializes the KVS and returns the number of bytes read from flash.
+  template <typename KvsType>
+  size_t Init(KvsType& kvs, bool use_snapshot) {
+    if (use_snapshot) {
+      kvs.EnableIndexSnapshot(snapshot_partition_);
+    }
+    flash_.reset_bytes_read();
+    EXPECT_EQ(OkStatus(), kvs.Init());
+    return flash_.bytes_read();
+  }
+
+  bool SnapshotErased() const {
+    span<const std::byte> snapshot =
+        flash_.buffer().subspan(kKvsSectors * kSectorSize);
+    return std::all_of(snapshot.begin(), snapshot.end(), [](std::byte b) {
+      return b == FakeFlashMemory::kErasedValue;
+    });
+  }
+
+  static void ExpectSameState(const KeyValueStore& expected,
+                              const KeyValueStore& actual) {
+    EXPECT_EQ(expected.size(), actual.size());
+    EXPECT_EQ(expected.total_entries_with_deleted(),
+              actual.total_entries_with_deleted());
+    EXPECT_EQ(expected.transaction_count(), actual.transaction_count());
+
+    const KeyValueStore::StorageStats expected_stats =
+        expected.GetStorageStats();
+    const KeyValueStore::StorageStats actual_stats = actual.GetStorageStats();
+    EXPECT_EQ(expected_stats.writable_bytes, actual_stats.writable_bytes);
+    EXPECT_EQ(expected_stats.in_use_bytes, actual_stats.in_use_bytes);
+    EXPECT_EQ(expected_stats.reclaimable_bytes,
+              actual_stats.reclaimable_bytes);
+
+    for (const auto& item : expected) {
+      Value expected_value;
+      Value actual_value;
+      ASSERT_EQ(OkStatus(), expected.Get(item.key(), &expected_value));
+      ASSERT_EQ(OkStatus(), actual.Get(item.key(), &actual_value));
+      EXPECT_EQ(expected_value, actual_value);
+    }
+  }
+
+  CountingFlashMemory& flash_;
+  FlashPartition& partition_;
+  FlashPartition& snapshot_partition_;
+};
+
+TEST_F(IndexSnapshotTest, Init_WithSnapshot_ReadsLessAndMatchesFullScan) {
+  WriteKeysAndSnapshot();
+
+  Kvs<> full_scan(&partition_, kFormat);
+  const size_t full_scan_bytes = Init(full_scan, false);
+
+  Kvs<> from_snapshot(&partition_, kFormat);
+  const size_t snapshot_bytes = Init(from_snapshot, true);
+
+  PW_LOG_INFO("Bytes read by Init for %u keys: %u without snapshot, %u with",
+              unsigned(kKeys),
+              unsigned(full_scan_bytes),
+              unsigned(snapshot_bytes));
+
+  EXPECT_EQ(kKeys, from_snapshot.size());
+  EXPECT_LT(snapshot_bytes * 2, full_scan_bytes);
+  ExpectSameState(full_scan, from_snapshot);
+}
+
+TEST_F(IndexSnapshotTest, Init_ReadsEntriesWrittenAfterSnapshot) {
+  WriteKeysAndSnapshot();
+
+  {
+    Kvs<> kvs(&partition_, kFormat);
+    Init(kvs, true);
+    ASSERT_EQ(OkStatus(), kvs.Put(Key(1), MakeValue(1, 7)));
+    ASSERT_EQ(OkStatus(), kvs.Delete(Key(2)));
+    ASSERT_EQ(OkStatus(), kvs.Put("new key", MakeValue(0, 9)));
+  }
+
+  Kvs<> full_scan(&partition_, kFormat);
+  Init(full_scan, false);
+
+  Kvs<> from_snapshot(&partition_, kFormat);
+  Init(from_snapshot, true);
+
+  Value value;
+  ASSERT_EQ(OkStatus(), from_snapshot.Get(Key(1), &value));
+  EXPECT_EQ(MakeValue(1, 7), value);
+  EXPECT_EQ(Status::NotFound(), from_snapshot.Get(Key(2), &value));
+  ASSERT_EQ(OkStatus(), from_snapshot.Get("new key", &value));
+  EXPECT_EQ(MakeValue(0, 9), value);
+  ExpectSameState(full_scan, from_snapshot);
+}
+
+TEST_F(IndexSnapshotTest, Init_RedundantEntries) {
+  WriteKeysAndSnapshot<2>();
+
+  Kvs<2> full_scan(&partition_, kFormat);
+  const size_t full_scan_bytes = Init(full_scan, false);
+
+  Kvs<2> from_snapshot(&partition_, kFormat);
+  const size_t snapshot_bytes = Init(from_snapshot, true);
+
+  EXPECT_LT(snapshot_bytes * 2, full_scan_bytes);
+  ExpectSameState(full_scan, from_snapshot);
+}
+
+TEST_F(IndexSnapshotTest, Init_CorruptSnapshot_ReadsAllEntries) {
+  WriteKeysAndSnapshot();
+
+  Kvs<> full_scan(&partition_, kFormat);
+  const size_t full_scan_bytes = Init(full_scan, false);
+
+  // Flip a bit in the snapshot's first entry record.
+  flash_.buffer()[kKvsSectors * kSectorSize + 28 + 2 * kKvsSectors] ^=
+      std::byte{0x01};
+
+  Kvs<> from_snapshot(&partition_, kFormat);
+  EXPECT_GE(Init(from_snapshot, true), full_scan_bytes);
+  ExpectSameState(full_scan, from_snapshot);
+}
+
+TEST_F(IndexSnapshotTest, Init_SnapshotDoesNotMatchFlash_ReadsAllEntries) {
+  WriteKeysAndSnapshot();
+
+  // Erase the KVS without erasing the snapshot.
+  ASSERT_EQ(OkStatus(), partition_.Erase());
+
+  Kvs<> kvs(&partition_, kFormat);
+  Init(kvs, true);
+  EXPECT_EQ(0u, kvs.size());
+  EXPECT_EQ(0u, kvs.total_entries_with_deleted());
+}
+
+TEST_F(IndexSnapshotTest, Init_WrongRedundancy_ReadsAllEntries) {
+  WriteKeysAndSnapshot<1>();
+
+  Kvs<2> full_scan(&partition_, kFormat);
+  full_scan.Init().IgnoreError();
+
+  Kvs<2> from_snapshot(&partition_, kFormat);
+  from_snapshot.EnableIndexSnapshot(snapshot_partition_);
+  from_snapshot.Init().IgnoreError();
+
+  ExpectSameState(full_scan, from_snapshot);
+}
+
+TEST_F(IndexSnapshotTest, GarbageCollect_InvalidatesSnapshot) {
+  WriteKeysAndSnapshot();
+  ASSERT_FALSE(SnapshotErased());
+
+  Kvs<> kvs(&partition_, kFormat);
+  Init(kvs, true);
+
+  // Overwrite every key until a sector must be garbage collected.
+  for (uint8_t version = 2; kvs.GetStorageStats().sector_erase_count == 0;
+       ++version) {
+    for (size_t i = 0; i < kKeys; ++i) {
+      ASSERT_EQ(OkStatus(), kvs.Put(Key(i), MakeValue(i, version)));
+    }
+  }
+  EXPECT_TRUE(SnapshotErased());
+
+  // The next full maintenance writes a new snapshot.
+  ASSERT_EQ(OkStatus(), kvs.FullMaintenance());
+  EXPECT_FALSE(SnapshotErased());
+
+  Kvs<> full_scan(&partition_, kFormat);
+  const size_t full_scan_bytes = Init(full_scan, false);
+
+  Kvs<> from_snapshot(&partition_, kFormat);
+  EXPECT_LT(Init(from_snapshot, true) * 2, full_scan_bytes);
+  ExpectSameState(full_scan, from_snapshot);
+}
+
+TEST_F(IndexSnapshotTest, SnapshotPartitionTooSmall_MaintenanceSucceeds) {
+  FakeFlashMemoryBuffer<64, 1> small_flash;
+  FlashPartition small_partition(&small_flash);
+
+  {
+    Kvs<> kvs(&partition_, kFormat);
+    kvs.EnableIndexSnapshot(small_partition);
+    ASSERT_EQ(OkStatus(), kvs.Init());
+    for (size_t i = 0; i < kKeys; ++i) {
+      ASSERT_EQ(OkStatus(), kvs.Put(Key(i), MakeValue(i, 0)));
+    }
+    EXPECT_EQ(OkStatus(), kvs.FullMaintenance());
+  }
+
+  Kvs<> kvs(&partition_, kFormat);
+  kvs.EnableIndexSnapshot(small_partition);
+  ASSERT_EQ(OkStatus(), kvs.Init());
+  EXPECT_EQ(kKeys, kvs.size());
+}
+
+}  // namespace
+}  // namespace pw::kvs
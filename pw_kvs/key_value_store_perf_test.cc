@@ -0,0 +1,147 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures Get and Put latency with and without the EntryCache hash index as
+// the number of keys in a KVS grows, and compares updating several keys with
+// individual Puts to updating them with a WriteBatch.
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_assert/check.h"
+#include "pw_kvs/fake_flash_memory.h"
+#include "pw_kvs/key_value_store.h"
+#include "pw_kvs/write_batch.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_string/format.h"
+
+namespace pw::kvs {
+namespace {
+
+constexpr size_t kMaxUsableSectors = 32;
+
+// 32 x 4k sectors, which is enough for 1024 small entries and the spare space
+// needed to overwrite them.
+FakeFlashMemoryBuffer<4 * 1024, kMaxUsableSectors> test_flash(16);
+FlashPartition test_partition(&test_flash);
+
+// For KVS magic value always use a random 32 bit integer rather than a human
+// readable 4 bytes. See pw_kvs/format.h for more information.
+constexpr EntryFormat kFormat{.magic = 0x5a7b3c2e, .checksum = nullptr};
+
+// Key names are "key_0000" through "key_1023".
+using KeyBuffer = char[16];
+
+void MakeKey(size_t index, KeyBuffer& key) {
+  PW_CHECK_OK(string::Format(key, "key_%04u", static_cast<unsigned>(index))
+                  .status());
+}
+
+// Returns a KVS on an erased partition, filled with kEntries keys.
+template <size_t kEntries, bool kHashIndex>
+KeyValueStore& FilledKvs() {
+  static KeyValueStoreBuffer<kEntries, kMaxUsableSectors, 1, 1, kHashIndex> kvs(
+      &test_partition, kFormat);
+
+  PW_CHECK_OK(test_partition.Erase());
+  PW_CHECK_OK(kvs.Init());
+  for (size_t i = 0; i < kEntries; ++i) {
+    KeyBuffer key;
+    MakeKey(i, key);
+    PW_CHECK_OK(kvs.Put(key, static_cast<uint32_t>(i)));
+  }
+  return kvs;
+}
+
+// Steps through the keys so that each run of a test touches keys from the
+// whole KVS, rather than only the first keys added.
+constexpr size_t kKeyStride = 97;
+
+// Reads each key in turn.
+void GetTest(perf_test::State& state, KeyValueStore& kvs) {
+  const size_t entries = kvs.size();
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    KeyBuffer key;
+    MakeKey(i, key);
+    uint32_t value;
+    PW_CHECK_OK(kvs.Get(key, &value));
+    i = (i + kKeyStride) % entries;
+  }
+}
+
+// Overwrites each key in turn.
+void PutTest(perf_test::State& state, KeyValueStore& kvs) {
+  const size_t entries = kvs.size();
+  size_t i = 0;
+  uint32_t value = 0;
+  while (state.KeepRunning()) {
+    KeyBuffer key;
+    MakeKey(i, key);
+    PW_CHECK_OK(kvs.Put(key, ++value));
+    i = (i + kKeyStride) % entries;
+  }
+}
+
+// The number of keys updated together by the batch tests.
+constexpr size_t kBatchKeys = 16;
+
+// Overwrites kBatchKeys keys with individual Puts.
+void PutManyTest(perf_test::State& state, KeyValueStore& kvs) {
+  uint32_t value = 0;
+  while (state.KeepRunning()) {
+    value += 1;
+    for (size_t i = 0; i < kBatchKeys; ++i) {
+      KeyBuffer key;
+      MakeKey(i, key);
+      PW_CHECK_OK(kvs.Put(key, value));
+    }
+  }
+}
+
+// Overwrites kBatchKeys keys with one WriteBatch.
+void CommitBatchTest(perf_test::State& state, KeyValueStore& kvs) {
+  WriteBatchBuffer<kBatchKeys * 32> batch;
+  uint32_t value = 0;
+  while (state.KeepRunning()) {
+    value += 1;
+    batch.Clear();
+    for (size_t i = 0; i < kBatchKeys; ++i) {
+      KeyBuffer key;
+      MakeKey(i, key);
+      PW_CHECK_OK(batch.Put(key, value));
+    }
+    PW_CHECK_OK(kvs.Commit(batch));
+  }
+}
+
+PW_PERF_TEST(Get16Entries, GetTest, FilledKvs<16, false>());
+PW_PERF_TEST(Get16EntriesHashIndex, GetTest, FilledKvs<16, true>());
+PW_PERF_TEST(Get256Entries, GetTest, FilledKvs<256, false>());
+PW_PERF_TEST(Get256EntriesHashIndex, GetTest, FilledKvs<256, true>());
+PW_PERF_TEST(Get1024Entries, GetTest, FilledKvs<1024, false>());
+PW_PERF_TEST(Get1024EntriesHashIndex, GetTest, FilledKvs<1024, true>());
+
+PW_PERF_TEST(Put16Entries, PutTest, FilledKvs<16, false>());
+PW_PERF_TEST(Put16EntriesHashIndex, PutTest, FilledKvs<16, true>());
+PW_PERF_TEST(Put256Entries, PutTest, FilledKvs<256, false>());
+PW_PERF_TEST(Put256EntriesHashIndex, PutTest, FilledKvs<256, true>());
+PW_PERF_TEST(Put1024Entries, PutTest, FilledKvs<1024, false>());
+PW_PERF_TEST(Put1024EntriesHashIndex, PutTest, FilledKvs<1024, true>());
+
+PW_PERF_TEST(Put16KeysIndividually, PutManyTest, FilledKvs<256, true>());
+PW_PERF_TEST(Put16KeysInBatch, CommitBatchTest, FilledKvs<256, true>());
+
+}  // namespace
+}  // namespace pw::kvs
@@ -67,9 +67,16 @@ class Entry {
                      const EntryFormat& format,
                      std::string_view key,
                      span<const std::byte> value,
-                     uint32_t transaction_id) {
-    return Entry(
-        partition, address, format, key, value, value.size(), transaction_id);
+                     uint32_t transaction_id,
+                     bool batched = false) {
+    return Entry(partition,
+                 address,
+                 format,
+                 key,
+                 value,
+                 value.size(),
+                 transaction_id,
+                 batched);
   }
 
   // Creates a new Entry for a tombstone entry, which marks a deleted key.
@@ -77,14 +84,16 @@ class Entry {
                          Address address,
                          const EntryFormat& format,
                          std::string_view key,
-                         uint32_t transaction_id) {
+                         uint32_t transaction_id,
+                         bool batched = false) {
     return Entry(partition,
                  address,
                  format,
                  key,
                  {},
                  kDeletedValueLength,
-                 transaction_id);
+                 transaction_id,
+                 batched);
   }
 
   Entry() = default;
@@ -101,11 +110,22 @@ class Entry {
 
   StatusWithSize Write(std::string_view key, span<const std::byte> value) const;
 
+  // Writes this entry, including its padding, to an AlignedWriter. This allows
+  // a run of entries to be written with one AlignedWriter.
+  StatusWithSize Write(AlignedWriter& writer,
+                       std::string_view key,
+                       span<const std::byte> value) const;
+
   // Changes the format and transcation ID for this entry. In order to calculate
   // the new checksum, the entire entry is read into a small stack-allocated
   // buffer. The updated entry may be written to flash using the Copy function.
   Status Update(const EntryFormat& new_format, uint32_t new_transaction_id);
 
+  // Clears the batched bit so that the entry is valid on its own, which is
+  // required before copying it away from the rest of its batch. Recalculates
+  // the checksum from flash, like Update.
+  Status ClearBatched();
+
   // Writes this entry at a new address. The key and value are read from the
   // entry's current address. The Entry object's header, which may be newer than
   // what is in flash, is used.
@@ -154,7 +174,7 @@ class Entry {
   size_t size() const { return AlignUp(content_size(), alignment_bytes()); }
 
   // The length of the key in bytes. Keys are not null terminated.
-  size_t key_length() const { return header_.key_length_bytes; }
+  size_t key_length() const { return header_.key_length_bytes & kMaxKeyLength; }
 
   // The size of the value, without padding. The size is 0 if this is a
   // tombstone entry.
@@ -171,18 +191,27 @@ class Entry {
     return header_.value_size_bytes == kDeletedValueLength;
   }
 
+  // True if this entry was written as part of a batch, but is not its final
+  // entry. A batched entry is only valid if the final entry of its batch, which
+  // has the same transaction ID, follows it in the same sector.
+  bool batched() const { return (header_.key_length_bytes & kBatchedBit) != 0; }
+
   void DebugLog() const;
 
  private:
   static constexpr uint16_t kDeletedValueLength = 0xFFFF;
 
+  // Set in EntryHeader::key_length_bytes for batched entries.
+  static constexpr uint8_t kBatchedBit = 0b1000000;
+
   Entry(FlashPartition& partition,
         Address address,
         const EntryFormat& format,
         std::string_view key,
         span<const std::byte> value,
         uint16_t value_size_bytes,
-        uint32_t transaction_id);
+        uint32_t transaction_id,
+        bool batched);
 
   constexpr Entry(FlashPartition* partition,
                   Address address,
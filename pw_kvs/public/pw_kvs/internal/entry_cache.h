@@ -15,6 +15,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <string_view>
 #include <type_traits>
 
@@ -70,7 +71,8 @@ class EntryMetadata {
   void RemoveAddress(Address address_to_remove);
 
   // Resets the KeyDescrtiptor and addresses to refer to the provided
-  // KeyDescriptor and address.
+  // KeyDescriptor and address. The key hash must not change, since the
+  // EntryCache's hash index, if any, is keyed by it.
   void Reset(const KeyDescriptor& descriptor, Address address);
 
  private:
@@ -152,15 +154,38 @@ class EntryCache {
   template <size_t kMaxEntries, size_t kRedundancy>
   using AddressList = Address[kMaxEntries * kRedundancy + kRedundancy];
 
+  // A slot in the optional hash index. Holds one more than the index of a
+  // KeyDescriptor, or 0 if the slot is empty.
+  using HashIndexSlot = uint16_t;
+
+  // The number of slots in a hash index for up to kMaxEntries entries. This is
+  // the smallest power of two that keeps the index at most half full.
+  template <size_t kMaxEntries>
+  static constexpr size_t kHashIndexSlots = [] {
+    static_assert(kMaxEntries < std::numeric_limits<HashIndexSlot>::max(),
+                  "Too many entries for the hash index");
+    size_t slots = 1;
+    while (slots < 2 * kMaxEntries) {
+      slots *= 2;
+    }
+    return slots;
+  }();
+
+  // Constructs an EntryCache. If hash_index is non-empty, it is used as an
+  // open-addressed hash table over the descriptors' key hashes, so finding an
+  // entry takes constant time instead of scanning all descriptors. hash_index
+  // must have kHashIndexSlots<descriptors.max_size()> slots.
   constexpr EntryCache(Vector<KeyDescriptor>& descriptors,
                        Address* addresses,
-                       size_t redundancy)
+                       size_t redundancy,
+                       span<HashIndexSlot> hash_index = {})
       : descriptors_(descriptors),
         addresses_(addresses),
-        redundancy_(redundancy) {}
+        redundancy_(redundancy),
+        hash_index_(hash_index) {}
 
   // Clears all KeyDescriptors.
-  void Reset() const { descriptors_.clear(); }
+  void Reset() const;
 
   // Finds the metadata for an entry matching a particular key. Searches for a
   // KeyDescriptor that matches this key and sets *metadata to point to it if
@@ -226,6 +251,26 @@ class EntryCache {
  private:
   int FindIndex(uint32_t key_hash) const;
 
+  // Returns the hash index slot for the descriptor with the specified hash.
+  // The descriptor must be in the index.
+  size_t FindHashIndexSlot(uint32_t key_hash) const;
+
+  // Adds or removes the descriptor at the specified index to or from the hash
+  // index. No-ops if there is no hash index.
+  void AddToHashIndex(size_t descriptor_index) const;
+  void RemoveFromHashIndex(size_t descriptor_index) const;
+
+  // The hash index slot at which to start probing for a key hash.
+  size_t HashIndexStart(uint32_t key_hash) const {
+    // Mix the upper bits of the key hash into the lower bits used for the slot.
+    const uint32_t mixed = key_hash * 0x9E3779B1u;
+    return (mixed ^ (mixed >> 16)) & (hash_index_.size() - 1);
+  }
+
+  size_t NextHashIndexSlot(size_t slot) const {
+    return (slot + 1) & (hash_index_.size() - 1);
+  }
+
   // Adds the address to the descriptor at the specified index if there is an
   // address slot available.
   void AddAddressIfRoom(size_t descriptor_index, Address address) const;
@@ -242,6 +287,7 @@ class EntryCache {
   Vector<KeyDescriptor>& descriptors_;
   FlashPartition::Address* const addresses_;
   const size_t redundancy_;
+  const span<HashIndexSlot> hash_index_;
 };
 
 }  // namespace internal
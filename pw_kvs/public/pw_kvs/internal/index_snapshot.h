@@ -0,0 +1,129 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_kvs/flash_memory.h"
+#include "pw_kvs/internal/entry_cache.h"
+#include "pw_kvs/internal/sectors.h"
+#include "pw_status/status.h"
+
+namespace pw {
+namespace kvs {
+namespace internal {
+
+// Stores a snapshot of a KVS's in-memory index in a separate flash partition,
+// so that Init can restore the index without reading every entry.
+//
+// A snapshot records how many bytes were written to each sector and the
+// KeyDescriptor and addresses of each entry. It is only valid while the KVS
+// partition is unchanged, except for entries appended after the snapshot was
+// written, so it is invalidated before any KVS sector is erased.
+//
+// The snapshot is stored at the start of the partition as:
+//
+//   Header
+//   uint16_t written bytes for each sector
+//   EntryRecord for each entry, each followed by redundancy uint32_t addresses
+//
+class IndexSnapshot {
+ public:
+  using Address = FlashPartition::Address;
+
+  constexpr IndexSnapshot()
+      : partition_(nullptr), sequence_number_(0), erased_(false) {}
+
+  // Stores snapshots in the provided partition.
+  void set_partition(FlashPartition& partition) {
+    partition_ = &partition;
+    erased_ = false;
+  }
+
+  bool enabled() const { return partition_ != nullptr; }
+
+  // Erases the snapshot partition, unless it is known to be erased. Must be
+  // called before erasing any sector of the KVS partition.
+  Status Invalidate();
+
+  // Writes a snapshot of the sectors and entries. Returns RESOURCE_EXHAUSTED if
+  // the snapshot does not fit in the partition.
+  Status Write(const Sectors& sectors,
+               const EntryCache& entry_cache,
+               size_t sector_size_bytes,
+               uint32_t last_transaction_id);
+
+  // Restores sectors' writable bytes and the entries from a snapshot. sectors
+  // and entry_cache must be reset. Returns DATA_LOSS if there is no valid
+  // snapshot, or if it does not match the KVS's configuration. On failure,
+  // sectors and entry_cache may have been partially restored.
+  Status Read(Sectors& sectors,
+              EntryCache& entry_cache,
+              size_t sector_size_bytes,
+              uint32_t& last_transaction_id);
+
+  // Identifies the last snapshot written or read. Incremented for each new
+  // snapshot.
+  uint32_t sequence_number() const { return sequence_number_; }
+
+ private:
+  struct Header {
+    uint32_t magic;
+
+    // The CRC-32 of the entire snapshot, calculated as if this field was zero.
+    uint32_t checksum;
+
+    uint32_t sequence_number;
+    uint32_t last_transaction_id;
+    uint32_t sector_size_bytes;
+    uint16_t sector_count;
+    uint16_t redundancy;
+    uint32_t entry_count;
+  };
+  static_assert(sizeof(Header) == 28);
+
+  struct EntryRecord {
+    uint32_t key_hash;
+    uint32_t transaction_id;
+    uint8_t deleted;
+    uint8_t reserved[3];
+  };
+  static_assert(sizeof(EntryRecord) == 12);
+
+  static constexpr uint32_t kMagic = 0x5e1d5a9b;
+
+  static size_t SnapshotSize(size_t sector_count,
+                             size_t entry_count,
+                             size_t redundancy) {
+    return sizeof(Header) + sector_count * sizeof(uint16_t) +
+           entry_count * (sizeof(EntryRecord) + redundancy * sizeof(Address));
+  }
+
+  // Passes each part of a snapshot to the provided function.
+  template <typename Function>
+  static Status Serialize(const Header& header,
+                          const Sectors& sectors,
+                          const EntryCache& entry_cache,
+                          size_t sector_size_bytes,
+                          Function&& function);
+
+  FlashPartition* partition_;
+  uint32_t sequence_number_;
+  bool erased_;  // True if partition_ is known to be erased.
+};
+
+}  // namespace internal
+}  // namespace kvs
+}  // namespace pw
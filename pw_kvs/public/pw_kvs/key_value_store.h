@@ -25,9 +25,11 @@
 #include "pw_kvs/format.h"
 #include "pw_kvs/internal/entry.h"
 #include "pw_kvs/internal/entry_cache.h"
+#include "pw_kvs/internal/index_snapshot.h"
 #include "pw_kvs/internal/key_descriptor.h"
 #include "pw_kvs/internal/sectors.h"
 #include "pw_kvs/internal/span_traits.h"
+#include "pw_kvs/write_batch.h"
 #include "pw_span/span.h"
 #include "pw_status/status.h"
 #include "pw_status/status_with_size.h"
@@ -122,6 +124,21 @@ class KeyValueStore {
   /// @endrst
   Status Init();
 
+  /// Stores a snapshot of the KVS's in-memory index in `snapshot_partition`
+  /// after each successful full maintenance, so that later calls to `Init()`
+  /// can restore the index instead of reading every entry. Must be called
+  /// before `Init()`. `snapshot_partition` must not overlap the KVS's
+  /// partition and should be large enough to hold 28 bytes, 2 bytes per
+  /// sector, and `12 + 4 * redundancy` bytes per entry.
+  ///
+  /// `Init()` checks that the snapshot is intact and matches the entries in
+  /// flash, and reads any entries written after it. If the snapshot cannot be
+  /// used, `Init()` falls back to reading every entry. The snapshot is erased
+  /// before any KVS sector is erased.
+  void EnableIndexSnapshot(FlashPartition& snapshot_partition) {
+    index_snapshot_.set_partition(snapshot_partition);
+  }
+
   bool initialized() const {
     return initialized_ == InitializationState::kReady;
   }
@@ -244,6 +261,35 @@ class KeyValueStore {
   /// @endrst
   Status Delete(std::string_view key);
 
+  /// Writes all of the operations staged in a `WriteBatch`. The batch's
+  /// entries are written as one contiguous run in a single sector, and share a
+  /// transaction ID. Only the batch's last entry marks the batch as complete,
+  /// so if the write is interrupted, none of the batch's operations take
+  /// effect after the next `Init()`.
+  ///
+  /// @returns @rst
+  ///
+  /// .. pw-status-codes::
+  ///
+  ///    OK: All operations were applied, or the batch was empty.
+  ///
+  ///    DATA_LOSS: Checksum validation failed after writing data.
+  ///
+  ///    RESOURCE_EXHAUSTED: Not enough space for the batch's entries.
+  ///
+  ///    ALREADY_EXISTS: A key's hash matches the hash of a different key in
+  ///    the KVS or in the batch.
+  ///
+  ///    NOT_FOUND: The batch deletes a key that is not in the KVS.
+  ///
+  ///    FAILED_PRECONDITION: The KVS is not initialized. Call ``Init()``
+  ///    before calling this method.
+  ///
+  ///    INVALID_ARGUMENT: The batch's entries do not fit in one sector.
+  ///
+  /// @endrst
+  Status Commit(const WriteBatch& batch);
+
   /// Returns the size of the value corresponding to the key.
   ///
   /// @param[in] key - The name of the key.
@@ -475,7 +521,8 @@ class KeyValueStore {
                 Vector<SectorDescriptor>& sector_descriptor_list,
                 const SectorDescriptor** temp_sectors_to_skip,
                 Vector<KeyDescriptor>& key_descriptor_list,
-                Address* addresses);
+                Address* addresses,
+                span<internal::EntryCache::HashIndexSlot> hash_index = {});
 
  private:
   using EntryMetadata = internal::EntryMetadata;
@@ -492,7 +539,9 @@ class KeyValueStore {
   }
 
   Status InitializeMetadata();
+  Status InitializeMetadataFromSnapshot();
   Status LoadEntry(Address entry_address, Address* next_entry_address);
+  bool BatchCommitted(const Entry& batched_entry) const;
   Status ScanForEntry(const SectorDescriptor& sector,
                       Address start_address,
                       Address* next_entry_address);
@@ -563,6 +612,13 @@ class KeyValueStore {
                     EntryMetadata* prior_metadata = nullptr,
                     const internal::Entry* prior_entry = nullptr);
 
+  Status CheckBatch(const WriteBatch& batch, size_t* write_size) const;
+
+  // Writes one copy of a batch's entries as a single run starting at address.
+  Status WriteBatchEntries(const WriteBatch& batch,
+                           Address address,
+                           uint32_t transaction_id);
+
   EntryMetadata CreateOrUpdateKeyDescriptor(const Entry& new_entry,
                                             std::string_view key,
                                             EntryMetadata* prior_metadata,
@@ -651,10 +707,14 @@ class KeyValueStore {
   // List of sectors used by this KVS.
   internal::Sectors sectors_;
 
-  // Unordered list of KeyDescriptors. Finding a key requires scanning and
-  // verifying a match by reading the actual entry.
+  // Unordered list of KeyDescriptors. Finding a key requires scanning, or a
+  // lookup in the optional hash index, and verifying a match by reading the
+  // actual entry.
   internal::EntryCache entry_cache_;
 
+  // Optional snapshot of sectors_ and entry_cache_ used to speed up Init().
+  internal::IndexSnapshot index_snapshot_;
+
   Options options_;
 
   // Threshold value for when to garbage collect all stale data. Above the
@@ -691,10 +751,19 @@ class KeyValueStore {
   uint32_t last_transaction_id_;
 };
 
+/// Allocates buffers for a `KeyValueStore` with up to `kMaxEntries` keys on a
+/// partition with up to `kMaxUsableSectors` sectors.
+///
+/// If `kHashIndex` is true, the KVS also allocates an open-addressed hash index
+/// of keys, which costs `4 * kMaxEntries` to `8 * kMaxEntries` bytes of RAM.
+/// Without it, finding a key scans all entries, so `Get`, `Put`, and `Delete`
+/// slow down linearly as keys are added. The index is recommended for stores
+/// with more than a few dozen keys.
 template <size_t kMaxEntries,
           size_t kMaxUsableSectors,
           size_t kRedundancy = 1,
-          size_t kEntryFormats = 1>
+          size_t kEntryFormats = 1,
+          bool kHashIndex = false>
 class KeyValueStoreBuffer : public KeyValueStore {
  public:
   // Constructs a KeyValueStore on the partition, with support for one
@@ -723,7 +792,8 @@ class KeyValueStoreBuffer : public KeyValueStore {
                       sectors_,
                       temp_sectors_to_skip_,
                       key_descriptors_,
-                      addresses_),
+                      addresses_,
+                      hash_index_),
         sectors_(),
         key_descriptors_(),
         formats_() {
@@ -755,6 +825,12 @@ class KeyValueStoreBuffer : public KeyValueStore {
   // KeyDescriptors.
   internal::EntryCache::AddressList<kRedundancy, kMaxEntries> addresses_;
 
+  // Slots for the EntryCache's optional hash index of key hashes.
+  std::array<internal::EntryCache::HashIndexSlot,
+             kHashIndex ? internal::EntryCache::kHashIndexSlots<kMaxEntries>
+                        : 0>
+      hash_index_{};
+
   // EntryFormats that can be read by this KeyValueStore.
   std::array<EntryFormat, kEntryFormats> formats_;
 };
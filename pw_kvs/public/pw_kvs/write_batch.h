@@ -0,0 +1,166 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include "pw_kvs/internal/span_traits.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+
+namespace pw {
+namespace kvs {
+
+class KeyValueStore;
+
+/// Stages `Put()` and `Delete()` operations to apply to a `KeyValueStore` with
+/// `KeyValueStore::Commit()`. Either all of the operations take effect, or,
+/// if the commit is interrupted, none of them do.
+///
+/// Keys and values are copied into a caller-provided buffer. Each operation
+/// uses 4 bytes plus the size of its key and value. Staging a key that is
+/// already staged replaces the earlier operation.
+///
+/// A `WriteBatch` may be committed to several KVS instances, and is not
+/// cleared by `Commit()`.
+class WriteBatch {
+ public:
+  /// Creates a batch that stages operations in the provided buffer.
+  explicit constexpr WriteBatch(span<std::byte> buffer)
+      : buffer_(buffer), size_bytes_(0), operations_(0) {}
+
+  WriteBatch(const WriteBatch&) = delete;
+  WriteBatch& operator=(const WriteBatch&) = delete;
+
+  /// Stages adding or updating a key-value entry.
+  ///
+  /// @returns @rst
+  ///
+  /// .. pw-status-codes::
+  ///
+  ///    OK: The operation was staged.
+  ///
+  ///    INVALID_ARGUMENT: ``key`` is empty or too long, or ``value`` is too
+  ///    large.
+  ///
+  ///    RESOURCE_EXHAUSTED: The batch's buffer is full.
+  ///
+  /// @endrst
+  template <typename T,
+            typename std::enable_if_t<ConvertsToSpan<T>::value>* = nullptr>
+  Status Put(const std::string_view& key, const T& value) {
+    return PutBytes(key, as_bytes(internal::make_span(value)));
+  }
+
+  /// Overload of `Put()` for trivially copyable, non-span objects.
+  template <typename T,
+            typename std::enable_if_t<!ConvertsToSpan<T>::value>* = nullptr>
+  Status Put(const std::string_view& key, const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value &&
+                      !std::is_pointer<T>::value,
+                  "Only trivially copyable, non-pointer objects may be Put by "
+                  "value.");
+    return PutBytes(key, as_bytes(span<const T>(&value, 1)));
+  }
+
+  /// Stages deleting a key. `KeyValueStore::Commit()` fails with
+  /// @pw_status{NOT_FOUND} if the key is not in the KVS.
+  ///
+  /// @returns @pw_status{OK}, @pw_status{INVALID_ARGUMENT}, or
+  /// @pw_status{RESOURCE_EXHAUSTED}, as for `Put()`.
+  Status Delete(std::string_view key) { return Add(key, {}, true); }
+
+  /// Removes all staged operations.
+  void Clear() {
+    size_bytes_ = 0;
+    operations_ = 0;
+  }
+
+  /// The number of staged operations.
+  size_t size() const { return operations_; }
+
+  bool empty() const { return operations_ == 0u; }
+
+ private:
+  friend class KeyValueStore;
+
+  // Staged operations are stored as an OperationHeader, followed by the key and
+  // the value.
+  struct OperationHeader {
+    uint8_t key_size;
+    bool deleted;
+    uint16_t value_size;
+  };
+
+  struct Operation {
+    std::string_view key;
+    span<const std::byte> value;
+    bool deleted;
+  };
+
+  // Calls function with each staged Operation, in the order it was staged.
+  template <typename Function>
+  Status ForEach(Function&& function) const {
+    size_t offset = 0;
+    while (offset < size_bytes_) {
+      const Operation operation = ReadOperation(offset);
+      offset += OperationSize(operation);
+      if (Status status = function(operation); !status.ok()) {
+        return status;
+      }
+    }
+    return OkStatus();
+  }
+
+  Status PutBytes(std::string_view key, span<const std::byte> value) {
+    return Add(key, value, false);
+  }
+
+  Status Add(std::string_view key, span<const std::byte> value, bool deleted);
+
+  static constexpr size_t OperationSize(const Operation& operation) {
+    return sizeof(OperationHeader) + operation.key.size() +
+           operation.value.size();
+  }
+
+  Operation ReadOperation(size_t offset) const;
+
+  // Returns the offset of the staged operation for this key, or size_bytes_ if
+  // there is none.
+  size_t Find(std::string_view key) const;
+
+  // Removes the staged operation at this offset.
+  void Remove(size_t offset);
+
+  span<std::byte> buffer_;
+  size_t size_bytes_;
+  size_t operations_;
+};
+
+/// A `WriteBatch` with a built-in buffer of `kBufferSizeBytes`.
+template <size_t kBufferSizeBytes>
+class WriteBatchBuffer : public WriteBatch {
+ public:
+  constexpr WriteBatchBuffer() : WriteBatch(buffer_) {}
+
+ private:
+  std::array<std::byte, kBufferSizeBytes> buffer_;
+};
+
+}  // namespace kvs
+}  // namespace pw
@@ -0,0 +1,103 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_kvs/write_batch.h"
+
+#include <cstring>
+#include <limits>
+
+#include "pw_kvs/internal/entry.h"
+
+namespace pw::kvs {
+
+using internal::Entry;
+
+Status WriteBatch::Add(std::string_view key,
+                       span<const std::byte> value,
+                       bool deleted) {
+  // The largest value size is reserved to mark deleted entries.
+  if (key.empty() || key.size() > Entry::kMaxKeyLength ||
+      value.size() >= std::numeric_limits<uint16_t>::max()) {
+    return Status::InvalidArgument();
+  }
+
+  const size_t operation_size =
+      sizeof(OperationHeader) + key.size() + value.size();
+
+  // The new operation replaces any staged operation for the same key.
+  const size_t existing_offset = Find(key);
+  size_t available_bytes = buffer_.size() - size_bytes_;
+  if (existing_offset != size_bytes_) {
+    available_bytes += OperationSize(ReadOperation(existing_offset));
+  }
+  if (operation_size > available_bytes) {
+    return Status::ResourceExhausted();
+  }
+  if (existing_offset != size_bytes_) {
+    Remove(existing_offset);
+  }
+
+  const OperationHeader header = {
+      .key_size = static_cast<uint8_t>(key.size()),
+      .deleted = deleted,
+      .value_size = static_cast<uint16_t>(value.size()),
+  };
+  std::byte* data = buffer_.data() + size_bytes_;
+  std::memcpy(data, &header, sizeof(header));
+  std::memcpy(data + sizeof(header), key.data(), key.size());
+  if (!value.empty()) {
+    std::memcpy(data + sizeof(header) + key.size(), value.data(), value.size());
+  }
+
+  size_bytes_ += operation_size;
+  operations_ += 1;
+  return OkStatus();
+}
+
+WriteBatch::Operation WriteBatch::ReadOperation(size_t offset) const {
+  OperationHeader header;
+  std::memcpy(&header, buffer_.data() + offset, sizeof(header));
+
+  const char* key = reinterpret_cast<const char*>(buffer_.data()) + offset +
+                    sizeof(header);
+  return Operation{
+      .key = std::string_view(key, header.key_size),
+      .value = buffer_.subspan(offset + sizeof(header) + header.key_size,
+                               header.value_size),
+      .deleted = header.deleted,
+  };
+}
+
+size_t WriteBatch::Find(std::string_view key) const {
+  size_t offset = 0;
+  while (offset < size_bytes_) {
+    const Operation operation = ReadOperation(offset);
+    if (operation.key == key) {
+      break;
+    }
+    offset += OperationSize(operation);
+  }
+  return offset;
+}
+
+void WriteBatch::Remove(size_t offset) {
+  const size_t operation_size = OperationSize(ReadOperation(offset));
+  std::memmove(buffer_.data() + offset,
+               buffer_.data() + offset + operation_size,
+               size_bytes_ - offset - operation_size);
+  size_bytes_ -= operation_size;
+  operations_ -= 1;
+}
+
+}  // namespace pw::kvs
@@ -106,9 +106,19 @@ class RpcLogDrain : public multisink::MultiSink::Drain {
       protobuf::SizeOfFieldUint32(
           log::pwpb::LogEntries::Fields::kFirstEntrySequenceId);
 
+  // The maximum size of an encoded drop message, which holds one of the error
+  // messages above and the drop count.
+  static constexpr size_t kMaxDropMessageSize =
+      protobuf::SizeOfFieldBytes(log::pwpb::LogEntry::Fields::kMessage,
+                                 static_cast<uint32_t>(
+                                     kLargestErrorMessageOrTokenSize)) +
+      protobuf::SizeOfFieldUint32(log::pwpb::LogEntry::Fields::kDropped);
+
   // Creates a closed log stream with a writer that can be set at a later time.
   // The provided buffer must be large enough to hold the largest transmittable
-  // log::pwpb::LogEntry or a drop count message at the very least. The user can
+  // log::pwpb::LogEntry or a drop count message at the very least. The drain
+  // copies as many entries as fit in the buffer out of the MultiSink at once,
+  // so a larger buffer takes the MultiSink's lock less often. The user can
   // choose to provide a unique mutex for the drain, or share it to save RAM as
   // long as they are aware of contengency issues.
   RpcLogDrain(
@@ -207,15 +217,41 @@ class RpcLogDrain : public multisink::MultiSink::Drain {
     kMoreEntriesRemaining,
   };
 
+  // Entries peeked from the MultiSink at once, which are encoded into as many
+  // packets as needed before the next batch is peeked.
+  struct PeekedBatch {
+    std::optional<multisink::MultiSink::Drain::PeekedEntries> entries;
+    multisink::MultiSink::Drain::PeekedEntries::iterator next;
+    std::optional<multisink::MultiSink::Drain::PeekedEntry> last_handled;
+    uint32_t drop_count = 0;
+  };
+
   LogDrainState SendLogs(size_t max_num_bundles,
                          ByteSpan encoding_buffer,
                          Status& encoding_status) PW_LOCKS_EXCLUDED(mutex_);
 
-  // Fills the outgoing buffer with as many entries as possible.
+  // Fills the outgoing buffer with as many entries as possible, continuing
+  // from the entries left in `batch` before peeking more.
   LogDrainState EncodeOutgoingPacket(
       log::pwpb::LogEntries::MemoryEncoder& encoder,
+      PeekedBatch& batch,
       uint32_t& packed_entry_count_out) PW_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
+  // Removes the entries handled so far in `batch` from the MultiSink.
+  void PopHandledEntries(PeekedBatch& batch)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Encodes a peeked entry in the outgoing buffer, preceded by messages for any
+  // drops not yet reported, or drops the entry if it is filtered out or too
+  // large for the buffer. Returns false if the entry does not fit in the
+  // remaining space, in which case it must be encoded in the next packet.
+  bool EncodeEntry(log::pwpb::LogEntries::MemoryEncoder& encoder,
+                   ConstByteSpan entry,
+                   size_t total_buffer_size,
+                   uint32_t drop_count,
+                   uint32_t& packed_entry_count_out)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   const uint32_t channel_id_;
   const LogDrainErrorHandling error_handling_;
   rpc::RawServerWriter server_writer_ PW_GUARDED_BY(mutex_);
@@ -14,10 +14,12 @@
 
 #include "pw_log_rpc/rpc_log_drain.h"
 
+#include <array>
 #include <limits>
 #include <mutex>
 #include <optional>
 #include <string_view>
+#include <utility>
 
 #include "pw_assert/check.h"
 #include "pw_chrono/system_clock.h"
@@ -116,17 +118,19 @@ RpcLogDrain::LogDrainState RpcLogDrain::SendLogs(size_t max_num_bundles,
 
   LogDrainState log_sink_state = LogDrainState::kMoreEntriesRemaining;
   std::lock_guard lock(mutex_);
+  PeekedBatch batch;
   size_t sent_bundle_count = 0;
   while (sent_bundle_count < max_num_bundles &&
          log_sink_state != LogDrainState::kCaughtUp) {
     if (!server_writer_.active()) {
+      PopHandledEntries(batch);
       encoding_status_out = Status::Unavailable();
       // No reason to keep polling this drain until the writer is opened.
       return LogDrainState::kCaughtUp;
     }
     log::pwpb::LogEntries::MemoryEncoder encoder(encoding_buffer);
     uint32_t packed_entry_count = 0;
-    log_sink_state = EncodeOutgoingPacket(encoder, packed_entry_count);
+    log_sink_state = EncodeOutgoingPacket(encoder, batch, packed_entry_count);
 
     // Avoid sending empty packets.
     if (encoder.size() == 0) {
@@ -145,123 +149,151 @@ RpcLogDrain::LogDrainState RpcLogDrain::SendLogs(size_t max_num_bundles,
       drop_count_writer_error_ += packed_entry_count;
       server_writer_.Finish().IgnoreError();
       encoding_status_out = Status::Aborted();
+      PopHandledEntries(batch);
       return log_sink_state;
     }
   }
+  // Entries left in the batch are peeked again by the next call.
+  PopHandledEntries(batch);
   return log_sink_state;
 }
 
 RpcLogDrain::LogDrainState RpcLogDrain::EncodeOutgoingPacket(
     log::pwpb::LogEntries::MemoryEncoder& encoder,
+    PeekedBatch& batch,
     uint32_t& packed_entry_count_out) {
   const size_t total_buffer_size = encoder.ConservativeWriteLimit();
   do {
-    // Peek entry and get drop count from multisink.
-    uint32_t drop_count = 0;
-    uint32_t ingress_drop_count = 0;
-    Result<multisink::MultiSink::Drain::PeekedEntry> possible_entry =
-        PeekEntry(log_entry_buffer_, drop_count, ingress_drop_count);
-    drop_count_ingress_error_ += ingress_drop_count;
-
-    // Check if the entry fits in the entry buffer.
-    if (possible_entry.status().IsResourceExhausted()) {
-      ++drop_count_small_stack_buffer_;
-      continue;
-    }
+    if (!batch.entries.has_value() || batch.next == batch.entries->end()) {
+      // Remove the previous batch before peeking the next one, so that the
+      // drop count only accounts for entries that were not handled.
+      PopHandledEntries(batch);
 
-    // Check if there are any entries left.
-    if (possible_entry.status().IsOutOfRange()) {
-      // Stash multisink's reported drop count that will be reported later with
-      // any other drop counts.
-      drop_count_slow_drain_ += drop_count;
-      return LogDrainState::kCaughtUp;  // There are no more entries.
-    }
+      // Peek a batch of entries and get drop count from multisink.
+      uint32_t drop_count = 0;
+      uint32_t ingress_drop_count = 0;
+      Result<multisink::MultiSink::Drain::PeekedEntries> possible_entries =
+          PeekEntries(log_entry_buffer_, drop_count, ingress_drop_count);
+      drop_count_ingress_error_ += ingress_drop_count;
 
-    // At this point all expected errors have been handled.
-    PW_CHECK_OK(possible_entry.status());
-
-    // Check if the entry passes any set filter rules.
-    if (filter_ != nullptr &&
-        filter_->ShouldDropLog(possible_entry.value().entry())) {
-      // Add the drop count from the multisink peek, stored in `drop_count`, to
-      // the total drop count. Then drop the entry without counting it towards
-      // the total drop count. Drops will be reported later all together.
-      drop_count_slow_drain_ += drop_count;
-      PW_CHECK_OK(PopEntry(possible_entry.value()));
-      continue;
+      // Check if the entry fits in the entry buffer.
+      if (possible_entries.status().IsResourceExhausted()) {
+        ++drop_count_small_stack_buffer_;
+        continue;
+      }
+
+      // Check if there are any entries left.
+      if (possible_entries.status().IsOutOfRange()) {
+        // Stash multisink's reported drop count that will be reported later
+        // with any other drop counts.
+        drop_count_slow_drain_ += drop_count;
+        return LogDrainState::kCaughtUp;
+      }
+
+      // At this point all expected errors have been handled.
+      PW_CHECK_OK(possible_entries.status());
+
+      // The entries in a batch are consecutive, so the drop count only
+      // precedes the first one.
+      batch.entries.emplace(possible_entries.value());
+      batch.next = batch.entries->begin();
+      batch.drop_count = drop_count;
     }
 
-    // Check if the entry fits in the encoder buffer by itself.
-    const size_t encoded_entry_size =
-        possible_entry.value().entry().size() + kLogEntriesEncodeFrameSize;
-    if (encoded_entry_size + kLogEntriesEncodeFrameSize > total_buffer_size) {
-      // Entry is larger than the entire available buffer.
-      ++drop_count_small_outbound_buffer_;
-      PW_CHECK_OK(PopEntry(possible_entry.value()));
-      continue;
+    for (; batch.next != batch.entries->end(); ++batch.next) {
+      const multisink::MultiSink::Drain::PeekedEntry entry = *batch.next;
+      const uint32_t drop_count = std::exchange(batch.drop_count, 0u);
+      if (!EncodeEntry(encoder,
+                       entry.entry(),
+                       total_buffer_size,
+                       drop_count,
+                       packed_entry_count_out)) {
+        // Notify the caller there are more entries to send.
+        return LogDrainState::kMoreEntriesRemaining;
+      }
+      batch.last_handled.emplace(entry);
     }
+  } while (true);
+}
+
+void RpcLogDrain::PopHandledEntries(PeekedBatch& batch) {
+  if (batch.last_handled.has_value()) {
+    PW_CHECK_OK(PopEntries(batch.last_handled.value()));
+    batch.last_handled.reset();
+  }
+}
 
-    // At this point, we have a valid entry that may fit in the encode buffer.
-    // Report any drop counts combined reusing the log_entry_buffer_ to encode a
-    // drop message.
+bool RpcLogDrain::EncodeEntry(log::pwpb::LogEntries::MemoryEncoder& encoder,
+                              ConstByteSpan entry,
+                              size_t total_buffer_size,
+                              uint32_t drop_count,
+                              uint32_t& packed_entry_count_out) {
+  // Check if the entry passes any set filter rules.
+  if (filter_ != nullptr && filter_->ShouldDropLog(entry)) {
+    // Add the drop count from the multisink peek, stored in `drop_count`, to
+    // the total drop count. Then drop the entry without counting it towards
+    // the total drop count. Drops will be reported later all together.
     drop_count_slow_drain_ += drop_count;
-    // Account for dropped entries too large for stack buffer, which PeekEntry()
-    // also reports.
-    drop_count_slow_drain_ -= drop_count_small_stack_buffer_;
-    bool log_entry_buffer_has_valid_entry = possible_entry.ok();
-    if (drop_count_slow_drain_ > 0) {
-      TryEncodeDropMessage(log_entry_buffer_,
-                           std::string_view(kSlowDrainErrorMessage),
-                           drop_count_slow_drain_,
-                           encoder);
-      log_entry_buffer_has_valid_entry = false;
-    }
-    if (drop_count_ingress_error_ > 0) {
-      TryEncodeDropMessage(log_entry_buffer_,
-                           std::string_view(kIngressErrorMessage),
-                           drop_count_ingress_error_,
-                           encoder);
-      log_entry_buffer_has_valid_entry = false;
-    }
-    if (drop_count_small_stack_buffer_ > 0) {
-      TryEncodeDropMessage(log_entry_buffer_,
-                           std::string_view(kSmallStackBufferErrorMessage),
-                           drop_count_small_stack_buffer_,
-                           encoder);
-      log_entry_buffer_has_valid_entry = false;
-    }
-    if (drop_count_small_outbound_buffer_ > 0) {
-      TryEncodeDropMessage(log_entry_buffer_,
-                           std::string_view(kSmallOutboundBufferErrorMessage),
-                           drop_count_small_outbound_buffer_,
-                           encoder);
-      log_entry_buffer_has_valid_entry = false;
-    }
-    if (drop_count_writer_error_ > 0) {
-      TryEncodeDropMessage(log_entry_buffer_,
-                           std::string_view(kWriterErrorMessage),
-                           drop_count_writer_error_,
-                           encoder);
-      log_entry_buffer_has_valid_entry = false;
-    }
-    if (possible_entry.ok() && !log_entry_buffer_has_valid_entry) {
-      PW_CHECK_OK(PeekEntry(log_entry_buffer_, drop_count, ingress_drop_count)
-                      .status());
-    }
+    return true;
+  }
 
-    // Check if the entry fits in the partially filled encoder buffer.
-    if (encoded_entry_size > encoder.ConservativeWriteLimit()) {
-      // Notify the caller there are more entries to send.
-      return LogDrainState::kMoreEntriesRemaining;
-    }
+  // Check if the entry fits in the encoder buffer by itself.
+  const size_t encoded_entry_size = entry.size() + kLogEntriesEncodeFrameSize;
+  if (encoded_entry_size + kLogEntriesEncodeFrameSize > total_buffer_size) {
+    // Entry is larger than the entire available buffer.
+    ++drop_count_small_outbound_buffer_;
+    return true;
+  }
 
-    // Encode the entry and remove it from multisink.
-    PW_CHECK_OK(encoder.WriteBytes(
-        static_cast<uint32_t>(log::pwpb::LogEntries::Fields::kEntries),
-        possible_entry.value().entry()));
-    PW_CHECK_OK(PopEntry(possible_entry.value()));
-    ++packed_entry_count_out;
-  } while (true);
+  // At this point, we have a valid entry that may fit in the encode buffer.
+  // Report any drop counts combined. Drop messages are encoded in their own
+  // buffer, since the log_entry_buffer_ holds the peeked entries.
+  drop_count_slow_drain_ += drop_count;
+  // Account for dropped entries too large for stack buffer, which PeekEntries()
+  // also reports.
+  drop_count_slow_drain_ -= drop_count_small_stack_buffer_;
+  std::array<std::byte, kMaxDropMessageSize> drop_message_buffer;
+  if (drop_count_slow_drain_ > 0) {
+    TryEncodeDropMessage(drop_message_buffer,
+                         std::string_view(kSlowDrainErrorMessage),
+                         drop_count_slow_drain_,
+                         encoder);
+  }
+  if (drop_count_ingress_error_ > 0) {
+    TryEncodeDropMessage(drop_message_buffer,
+                         std::string_view(kIngressErrorMessage),
+                         drop_count_ingress_error_,
+                         encoder);
+  }
+  if (drop_count_small_stack_buffer_ > 0) {
+    TryEncodeDropMessage(drop_message_buffer,
+                         std::string_view(kSmallStackBufferErrorMessage),
+                         drop_count_small_stack_buffer_,
+                         encoder);
+  }
+  if (drop_count_small_outbound_buffer_ > 0) {
+    TryEncodeDropMessage(drop_message_buffer,
+                         std::string_view(kSmallOutboundBufferErrorMessage),
+                         drop_count_small_outbound_buffer_,
+                         encoder);
+  }
+  if (drop_count_writer_error_ > 0) {
+    TryEncodeDropMessage(drop_message_buffer,
+                         std::string_view(kWriterErrorMessage),
+                         drop_count_writer_error_,
+                         encoder);
+  }
+
+  // Check if the entry fits in the partially filled encoder buffer.
+  if (encoded_entry_size > encoder.ConservativeWriteLimit()) {
+    return false;
+  }
+
+  // Encode the entry. The caller removes it from the multisink.
+  PW_CHECK_OK(encoder.WriteBytes(
+      static_cast<uint32_t>(log::pwpb::LogEntries::Fields::kEntries), entry));
+  ++packed_entry_count_out;
+  return true;
 }
 
 Status RpcLogDrain::Close() {
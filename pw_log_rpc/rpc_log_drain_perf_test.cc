@@ -0,0 +1,115 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures the time to flush kEntriesPerFlush log entries through an
+// RpcLogDrain. The drain reads entries from the MultiSink in batches that fit
+// in its log entry buffer, so a larger buffer takes the MultiSink's lock fewer
+// times per Flush().
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "pw_bytes/span.h"
+#include "pw_log/proto/log.pwpb.h"
+#include "pw_log/proto_utils.h"
+#include "pw_log_rpc/log_service.h"
+#include "pw_log_rpc/rpc_log_drain.h"
+#include "pw_log_rpc/rpc_log_drain_map.h"
+#include "pw_log_tokenized/metadata.h"
+#include "pw_multisink/multisink.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_rpc/channel.h"
+#include "pw_rpc/raw/server_reader_writer.h"
+#include "pw_rpc/server.h"
+#include "pw_status/status.h"
+#include "pw_sync/mutex.h"
+
+namespace pw::log_rpc {
+namespace {
+
+constexpr uint32_t kChannelId = 1;
+constexpr size_t kEntriesPerFlush = 500;
+constexpr size_t kMaxEntrySize = 64;
+constexpr std::string_view kMessage = "The quick brown fox jumps";
+constexpr std::string_view kThreadName = "thread";
+constexpr log_tokenized::Metadata kMetadata =
+    log_tokenized::Metadata::Set<PW_LOG_LEVEL_INFO, 123, 0x03, 300>();
+
+class DiscardingOutput : public rpc::ChannelOutput {
+ public:
+  constexpr DiscardingOutput() : rpc::ChannelOutput("discard") {}
+
+  Status Send(span<const std::byte>) override { return OkStatus(); }
+};
+
+DiscardingOutput discarding_output;
+std::array<std::byte, 32 * 1024> multisink_buffer;
+std::array<std::byte, 4096> log_entry_buffer;
+std::array<std::byte, 256> encoding_buffer;
+
+// Flushes kEntriesPerFlush entries through a drain that reads them from the
+// MultiSink with a log entry buffer of `entry_buffer_size` bytes.
+void FlushTest(perf_test::State& state, size_t entry_buffer_size) {
+  std::array<std::byte, kMaxEntrySize> encode_buffer;
+  const Result<ConstByteSpan> entry =
+      log::EncodeTokenizedLog(kMetadata,
+                              as_bytes(span(kMessage)),
+                              /*ticks_since_epoch=*/9000,
+                              as_bytes(span(kThreadName)),
+                              encode_buffer);
+  if (!entry.ok()) {
+    return;
+  }
+
+  sync::Mutex mutex;
+  std::array<RpcLogDrain, 1> drains{
+      RpcLogDrain(kChannelId,
+                  span(log_entry_buffer).first(entry_buffer_size),
+                  mutex,
+                  RpcLogDrain::LogDrainErrorHandling::kIgnoreWriterErrors),
+  };
+  RpcLogDrainMap drain_map(drains);
+  LogService log_service(drain_map);
+  std::array<rpc::Channel, 1> channels{
+      rpc::Channel::Create<kChannelId>(&discarding_output)};
+  rpc::Server server(channels);
+
+  multisink::MultiSink multisink(multisink_buffer);
+  multisink.AttachDrain(drains[0]);
+  rpc::RawServerWriter writer =
+      rpc::RawServerWriter::Open<log::pw_rpc::raw::Logs::Listen>(
+          server, kChannelId, log_service);
+  drains[0].Open(writer).IgnoreError();
+
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < kEntriesPerFlush; ++i) {
+      multisink.HandleEntry(*entry);
+    }
+    drains[0].Flush(encoding_buffer).IgnoreError();
+  }
+
+  drains[0].Close().IgnoreError();
+  multisink.DetachDrain(drains[0]);
+}
+
+// Room for exactly one entry, which reads entries one at a time.
+PW_PERF_TEST(FlushOneEntryPerBatch, FlushTest, kMaxEntrySize);
+PW_PERF_TEST(FlushBatch256Bytes, FlushTest, 256);
+PW_PERF_TEST(FlushBatch1024Bytes, FlushTest, 1024);
+PW_PERF_TEST(FlushBatch4096Bytes, FlushTest, 4096);
+
+}  // namespace
+}  // namespace pw::log_rpc
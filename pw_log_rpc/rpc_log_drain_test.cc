@@ -146,6 +146,88 @@ TEST(RpcLogDrain, FlushingDrainWithOpenWriter) {
   EXPECT_EQ(drain.Flush(encoding_buffer), Status::Unavailable());
 }
 
+TEST(RpcLogDrain, FlushEncodesBatchAcrossPackets) {
+  const uint32_t drain_id = 1;
+  // Fits all the entries, so that they are peeked from the MultiSink at once.
+  std::array<std::byte, 512> buffer;
+  sync::Mutex mutex;
+  std::array<RpcLogDrain, 1> drains{
+      RpcLogDrain(drain_id,
+                  buffer,
+                  mutex,
+                  RpcLogDrain::LogDrainErrorHandling::kCloseStreamOnWriterError,
+                  nullptr),
+  };
+  RpcLogDrainMap drain_map(drains);
+  LogService log_service(drain_map);
+
+  rpc::RawFakeChannelOutput<8, 1024> output;
+  rpc::Channel channel(rpc::Channel::Create<drain_id>(&output));
+  rpc::Server server(span(&channel, 1));
+
+  RpcLogDrain& drain = drains[0];
+  std::array<std::byte, 1024> multisink_buffer;
+  multisink::MultiSink multisink(multisink_buffer);
+  multisink.AttachDrain(drain);
+
+  constexpr log_tokenized::Metadata kMetadata =
+      log_tokenized::Metadata::Set<PW_LOG_LEVEL_INFO, 123, 0x03, 300>();
+  constexpr std::string_view kThreadName = "thread";
+  constexpr std::array<std::string_view, 6> kMessages = {
+      "one", "two", "three", "four", "five", "six"};
+  Vector<TestLogEntry, kMessages.size()> expected_entries;
+  std::array<std::byte, 64> entry_buffer;
+  for (std::string_view message : kMessages) {
+    expected_entries.push_back(
+        {.metadata = kMetadata,
+         .timestamp = 9000,
+         .dropped = 0,
+         .tokenized_data = as_bytes(span<const char>(message)),
+         .thread = as_bytes(span(kThreadName))});
+    Result<ConstByteSpan> entry =
+        log::EncodeTokenizedLog(kMetadata,
+                                expected_entries.back().tokenized_data,
+                                expected_entries.back().timestamp,
+                                expected_entries.back().thread,
+                                entry_buffer);
+    ASSERT_EQ(entry.status(), OkStatus());
+    multisink.HandleEntry(entry.value());
+  }
+
+  rpc::RawServerWriter writer =
+      rpc::RawServerWriter::Open<log::pw_rpc::raw::Logs::Listen>(
+          server, drain_id, log_service);
+  ASSERT_EQ(drain.Open(writer), OkStatus());
+
+  // The encoding buffer only fits a few entries per packet.
+  std::byte encoding_buffer[96] = {};
+  EXPECT_EQ(drain.Flush(encoding_buffer), OkStatus());
+
+  rpc::PayloadsView payloads =
+      output.payloads<log::pw_rpc::raw::Logs::Listen>(drain_id);
+  EXPECT_GT(payloads.size(), 1u);
+
+  uint32_t drop_count = 0;
+  size_t entries_count = 0;
+  for (ConstByteSpan payload : payloads) {
+    protobuf::Decoder payload_decoder(payload);
+    VerifyLogEntries(payload_decoder,
+                     expected_entries,
+                     static_cast<uint32_t>(entries_count),
+                     entries_count,
+                     drop_count);
+  }
+  EXPECT_EQ(drop_count, 0u);
+  EXPECT_EQ(entries_count, kMessages.size());
+
+  // All entries were removed from the MultiSink.
+  const size_t payload_count = payloads.size();
+  EXPECT_EQ(drain.Flush(encoding_buffer), OkStatus());
+  EXPECT_EQ(
+      output.payloads<log::pw_rpc::raw::Logs::Listen>(drain_id).size(),
+      payload_count);
+}
+
 TEST(RpcLogDrain, TryReopenOpenedDrain) {
   const uint32_t drain_id = 1;
   std::array<std::byte, kBufferSize> buffer;
@@ -76,7 +76,7 @@ uint32_t Metric::as_int() const {
 void Metric::Increment(uint32_t amount) {
   PW_DCHECK(is_int());
 
-  uint32_t value = uint_.load();
+  uint32_t value = uint_.load(std::memory_order_relaxed);
   uint32_t updated;
 
   if (value == std::numeric_limits<uint32_t>::max()) {
@@ -87,13 +87,14 @@ void Metric::Increment(uint32_t amount) {
     if (PW_ADD_OVERFLOW(value, amount, &updated)) {
       updated = std::numeric_limits<uint32_t>::max();
     }
-  } while (!uint_.compare_exchange_weak(value, updated));
+  } while (!uint_.compare_exchange_weak(
+      value, updated, std::memory_order_relaxed));
 }
 
 void Metric::Decrement(uint32_t amount) {
   PW_DCHECK(is_int());
 
-  uint32_t value = uint_.load();
+  uint32_t value = uint_.load(std::memory_order_relaxed);
   uint32_t updated;
 
   do {
@@ -104,7 +105,8 @@ void Metric::Decrement(uint32_t amount) {
     if (PW_SUB_OVERFLOW(value, amount, &updated)) {
       updated = 0;
     }
-  } while (!uint_.compare_exchange_weak(value, updated));
+  } while (!uint_.compare_exchange_weak(
+      value, updated, std::memory_order_relaxed));
 }
 
 void Metric::SetInt(uint32_t value) {
@@ -19,6 +19,7 @@
 #include "pw_assert/check.h"
 #include "pw_containers/vector.h"
 #include "pw_metric/metric.h"
+#include "pw_metric/sharded_counter.h"
 #include "pw_metric_private/metric_walker.h"
 #include "pw_preprocessor/util.h"
 #include "pw_span/span.h"
@@ -74,8 +75,11 @@ class NanopbMetricWriter : public virtual internal::MetricWriter {
     return OkStatus();
   }
 
+  void set_full_snapshot(bool full_snapshot) { full_snapshot_ = full_snapshot; }
+
   void Flush() {
     if (response_.metrics_count) {
+      response_.full_snapshot = full_snapshot_;
       response_writer_.Write(response_)
           .IgnoreError();  // TODO: b/242598609 - Handle Status properly
       response_ = pw_metric_proto_MetricResponse_init_zero;
@@ -86,14 +90,16 @@ class NanopbMetricWriter : public virtual internal::MetricWriter {
   pw_metric_proto_MetricResponse response_;
   // This RPC stream writer handle must be valid for the metric writer lifetime.
   MetricService::ServerWriter<pw_metric_proto_MetricResponse>& response_writer_;
+  bool full_snapshot_ = false;
 };
 
 }  // namespace
 
 void MetricService::Get(
-    const pw_metric_proto_MetricRequest& /* request */,
+    const pw_metric_proto_MetricRequest& request,
     ServerWriter<pw_metric_proto_MetricResponse>& response) {
-  // For now, ignore the request and just stream all the metrics back.
+  // Metric paths in the request are not yet supported, so all metrics, or all
+  // changed metrics, are streamed back.
   NanopbMetricWriter writer(response);
   internal::MetricWalker walker(writer);
 
@@ -104,6 +110,16 @@ void MetricService::Get(
   //
   // In the future, this should be replaced with an optional async solution
   // that puts the application in control of when the response batches are sent.
+  FoldShardedCounters();
+  if (request.incremental) {
+    internal::IncrementalGet incremental(
+        clients_, response.channel_id(), ++request_count_, metrics_, groups_);
+    writer.set_full_snapshot(incremental.full_snapshot());
+    const Status status = incremental.Walk(writer);
+    writer.Flush();
+    incremental.Finish(status);
+    return;
+  }
   walker.Walk(metrics_).IgnoreError();
   walker.Walk(groups_).IgnoreError();
   writer.Flush();
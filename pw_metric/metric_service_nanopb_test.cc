@@ -14,6 +14,8 @@
 
 #include "pw_metric/metric_service_nanopb.h"
 
+#include <array>
+
 #include "pw_log/log.h"
 #include "pw_rpc/nanopb/test_method_context.h"
 #include "pw_unit_test/framework.h"
@@ -202,5 +204,43 @@ TEST(MetricService, TokenPaths) {
   }
 }
 
+TEST(MetricService, IncrementalOnlySendsChangedMetrics) {
+  PW_METRIC_GROUP(root, "/");
+  PW_METRIC(root, a, "a", 1u);
+  PW_METRIC(root, b, "b", 2u);
+  PW_METRIC(root, c, "c", 3u);
+
+  std::array<uint32_t, 4> values;
+  std::array<MetricClientState, 1> clients = {MetricClientState(values)};
+
+  pw_metric_proto_MetricRequest request =
+      pw_metric_proto_MetricRequest_init_zero;
+  request.incremental = true;
+
+  // The first incremental request is a full snapshot.
+  MetricMethodContext context(root.metrics(), root.children(), clients);
+  context.call(request);
+  EXPECT_TRUE(context.done());
+  EXPECT_EQ(OkStatus(), context.status());
+  ASSERT_EQ(1u, context.responses().size());
+  EXPECT_EQ(3, context.responses()[0].metrics_count);
+  EXPECT_TRUE(context.responses()[0].full_snapshot);
+
+  // Only the changed metric is sent.
+  b.Increment();
+  context.output().clear();
+  context.call(request);
+  ASSERT_EQ(1u, context.responses().size());
+  EXPECT_EQ(1, context.responses()[0].metrics_count);
+  EXPECT_FALSE(context.responses()[0].full_snapshot);
+  EXPECT_EQ(3u, context.responses()[0].metrics[0].value.as_int);
+
+  // Nothing changed.
+  context.output().clear();
+  context.call(request);
+  EXPECT_EQ(OkStatus(), context.status());
+  EXPECT_EQ(0u, context.responses().size());
+}
+
 }  // namespace
 }  // namespace pw::metric
@@ -0,0 +1,152 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Compares full and incremental MetricService scrapes. Each test serves Get
+// requests for a tree of metrics in which some metrics change between scrapes,
+// and logs the encoded RPC bytes and the time per scrape.
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "pw_log/log.h"
+#include "pw_metric/metric.h"
+#include "pw_metric/metric_client_state.h"
+#include "pw_metric/metric_service_pwpb.h"
+#include "pw_metric_proto/metric_service.pwpb.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_rpc/raw/server_reader_writer.h"
+#include "pw_rpc/server.h"
+
+namespace pw::metric {
+namespace {
+
+constexpr size_t kGroups = 16;
+constexpr size_t kMetricsPerGroup = 64;
+constexpr size_t kMetrics = kGroups * kMetricsPerGroup;
+constexpr uint32_t kChannelId = 1;
+
+class CountingOutput : public rpc::ChannelOutput {
+ public:
+  constexpr CountingOutput() : ChannelOutput("counting") {}
+
+  Status Send(span<const std::byte> buffer) override {
+    bytes_ += buffer.size();
+    return OkStatus();
+  }
+
+  size_t bytes() const { return bytes_; }
+
+ private:
+  size_t bytes_ = 0;
+};
+
+template <size_t... kIndices>
+std::array<Group, sizeof...(kIndices)> MakeGroups(
+    std::index_sequence<kIndices...>) {
+  return {Group(static_cast<Token>(kIndices + 1))...};
+}
+
+template <size_t... kIndices>
+std::array<TypedMetric<uint32_t>, sizeof...(kIndices)> MakeMetrics(
+    std::index_sequence<kIndices...>) {
+  return {TypedMetric<uint32_t>(static_cast<Token>(kGroups + kIndices + 1),
+                                0u)...};
+}
+
+std::array<Group, kGroups> groups =
+    MakeGroups(std::make_index_sequence<kGroups>());
+std::array<TypedMetric<uint32_t>, kMetrics> metrics =
+    MakeMetrics(std::make_index_sequence<kMetrics>());
+
+std::array<uint32_t, kMetrics> client_values;
+std::array<MetricClientState, 1> clients = {MetricClientState(client_values)};
+
+// Serves Get requests, changing `changed_metrics` metrics before each one.
+void ScrapeTest(perf_test::State& state,
+                bool incremental,
+                size_t changed_metrics) {
+  IntrusiveList<Metric> root_metrics;
+  IntrusiveList<Group> root_groups;
+  for (size_t i = 0; i < kMetrics; ++i) {
+    groups[i / kMetricsPerGroup].Add(metrics[i]);
+  }
+  for (Group& group : groups) {
+    root_groups.push_front(group);
+  }
+  clients[0].Reset();
+
+  CountingOutput output;
+  std::array<rpc::Channel, 1> channels{
+      rpc::Channel::Create<kChannelId>(&output)};
+  rpc::Server server(channels);
+  MetricService service(root_metrics, root_groups, clients);
+  server.RegisterService(service);
+
+  std::array<std::byte, 2> request_buffer;
+  proto::pwpb::MetricRequest::MemoryEncoder request(request_buffer);
+  request.WriteIncremental(incremental).IgnoreError();
+
+  // The first scrape is a full snapshot; only measure the steady state.
+  rpc::RawServerWriter writer =
+      rpc::RawServerWriter::Open<proto::pw_rpc::raw::MetricService::Get>(
+          server, kChannelId, service);
+  service.Get(ConstByteSpan(request), writer);
+  const size_t initial_bytes = output.bytes();
+
+  size_t scrapes = 0;
+  size_t next_metric = 0;
+  const auto start = std::chrono::steady_clock::now();
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < changed_metrics; ++i) {
+      metrics[next_metric].Increment();
+      next_metric = (next_metric + 1) % kMetrics;
+    }
+    writer =
+        rpc::RawServerWriter::Open<proto::pw_rpc::raw::MetricService::Get>(
+            server, kChannelId, service);
+    service.Get(ConstByteSpan(request), writer);
+    scrapes += 1;
+  }
+  const std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  PW_LOG_INFO("%s, %u of %u metrics changed: %u bytes/scrape, %.1f us/scrape",
+              incremental ? "Incremental" : "Full",
+              static_cast<unsigned>(changed_metrics),
+              static_cast<unsigned>(kMetrics),
+              static_cast<unsigned>((output.bytes() - initial_bytes) / scrapes),
+              elapsed.count() / static_cast<double>(scrapes));
+
+  server.UnregisterService(service);
+  root_groups.clear();
+  for (Group& group : groups) {
+    group.metrics().clear();
+  }
+}
+
+PW_PERF_TEST(Full_0Changed, ScrapeTest, false, 0);
+PW_PERF_TEST(Full_10Changed, ScrapeTest, false, 10);
+PW_PERF_TEST(Full_100Changed, ScrapeTest, false, 100);
+PW_PERF_TEST(Full_1000Changed, ScrapeTest, false, 1000);
+
+PW_PERF_TEST(Incremental_0Changed, ScrapeTest, true, 0);
+PW_PERF_TEST(Incremental_10Changed, ScrapeTest, true, 10);
+PW_PERF_TEST(Incremental_100Changed, ScrapeTest, true, 100);
+PW_PERF_TEST(Incremental_1000Changed, ScrapeTest, true, 1000);
+
+}  // namespace
+}  // namespace pw::metric
@@ -19,9 +19,11 @@
 #include "pw_assert/check.h"
 #include "pw_containers/vector.h"
 #include "pw_metric/metric.h"
+#include "pw_metric/sharded_counter.h"
 #include "pw_metric_private/metric_walker.h"
 #include "pw_metric_proto/metric_service.pwpb.h"
 #include "pw_preprocessor/util.h"
+#include "pw_protobuf/decoder.h"
 #include "pw_protobuf/serialized_size.h"
 #include "pw_rpc/raw/server_reader_writer.h"
 #include "pw_span/span.h"
@@ -69,14 +71,19 @@ class PwpbMetricWriter : public virtual internal::MetricWriter {
     return OkStatus();
   }
 
+  void set_full_snapshot(bool full_snapshot) { full_snapshot_ = full_snapshot; }
+
   Status Flush() {
     Status status;
     if (metrics_count) {
+      if (full_snapshot_) {
+        encoder_.WriteFullSnapshot(true).IgnoreError();  // Space is reserved.
+      }
       status = response_writer_.Write(encoder_);
       // Different way to clear MemoryEncoder. Copy constructor is disabled
       // for memory encoder, and there is no "clear()" method.
       encoder_.~MemoryEncoder();
-      new (&encoder_) proto::pwpb::MetricRequest::MemoryEncoder(response_);
+      new (&encoder_) proto::pwpb::MetricResponse::MemoryEncoder(response_);
       metrics_count = 0;
     }
     return status;
@@ -87,14 +94,29 @@ class PwpbMetricWriter : public virtual internal::MetricWriter {
   // This RPC stream writer handle must be valid for the metric writer
   // lifetime.
   rpc::RawServerWriter& response_writer_;
-  proto::pwpb::MetricRequest::MemoryEncoder encoder_;
+  proto::pwpb::MetricResponse::MemoryEncoder encoder_;
   size_t metrics_count = 0;
+  bool full_snapshot_ = false;
 };
+
+bool IsIncremental(ConstByteSpan request) {
+  protobuf::Decoder decoder(request);
+  bool incremental = false;
+  while (decoder.Next().ok()) {
+    if (decoder.FieldNumber() ==
+        static_cast<uint32_t>(
+            proto::pwpb::MetricRequest::Fields::kIncremental)) {
+      decoder.ReadBool(&incremental).IgnoreError();
+    }
+  }
+  return incremental;
+}
 }  // namespace
 
-void MetricService::Get(ConstByteSpan /*request*/,
+void MetricService::Get(ConstByteSpan request,
                         rpc::RawServerWriter& raw_response) {
-  // For now, ignore the request and just stream all the metrics back.
+  // Metric paths in the request are not yet supported, so all metrics, or all
+  // changed metrics, are streamed back.
 
   // The `string_path` field of Metric is not supported. The maximum size
   // without values includes the maximum token path. Additionally, include the
@@ -107,7 +129,10 @@ void MetricService::Get(ConstByteSpan /*request*/,
           pw::metric::proto::pwpb::Metric::Fields::kAsInt);
 
   // TODO(amontanez): Make this follow the metric_service.options configuration.
-  constexpr size_t kEncodeBufferSize = kMaxNumPackedEntries * kSizeOfOneMetric;
+  constexpr size_t kEncodeBufferSize =
+      kMaxNumPackedEntries * kSizeOfOneMetric +
+      protobuf::SizeOfFieldBool(
+          pw::metric::proto::pwpb::MetricResponse::Fields::kFullSnapshot);
 
   std::array<std::byte, kEncodeBufferSize> encode_buffer;
 
@@ -122,11 +147,25 @@ void MetricService::Get(ConstByteSpan /*request*/,
   // In the future, this should be replaced with an optional async solution
   // that puts the application in control of when the response batches are sent.
 
+  FoldShardedCounters();
+
   // Propagate status through walker.
   Status status;
-  status.Update(walker.Walk(metrics_));
-  status.Update(walker.Walk(groups_));
-  status.Update(writer.Flush());
+  if (IsIncremental(request)) {
+    internal::IncrementalGet incremental(clients_,
+                                         raw_response.channel_id(),
+                                         ++request_count_,
+                                         metrics_,
+                                         groups_);
+    writer.set_full_snapshot(incremental.full_snapshot());
+    status.Update(incremental.Walk(writer));
+    status.Update(writer.Flush());
+    incremental.Finish(status);
+  } else {
+    status.Update(walker.Walk(metrics_));
+    status.Update(walker.Walk(groups_));
+    status.Update(writer.Flush());
+  }
   raw_response.Finish(status).IgnoreError();
 }
 }  // namespace pw::metric
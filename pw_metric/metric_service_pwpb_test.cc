@@ -14,7 +14,10 @@
 
 #include "pw_metric/metric_service_pwpb.h"
 
+#include <array>
+
 #include "pw_log/log.h"
+#include "pw_metric/sharded_counter.h"
 #include "pw_metric_proto/metric_service.pwpb.h"
 #include "pw_protobuf/decoder.h"
 #include "pw_rpc/pwpb/test_method_context.h"
@@ -74,6 +77,27 @@ size_t GetMetricsSum(ConstByteSpan serialized_metric_buffer) {
   return metrics_sum;
 }
 
+bool IsFullSnapshot(ConstByteSpan serialized_metric_buffer) {
+  protobuf::Decoder decoder(serialized_metric_buffer);
+  bool full_snapshot = false;
+  while (decoder.Next().ok()) {
+    if (decoder.FieldNumber() ==
+        static_cast<uint32_t>(
+            pw::metric::proto::pwpb::MetricResponse::Fields::kFullSnapshot)) {
+      EXPECT_EQ(OkStatus(), decoder.ReadBool(&full_snapshot));
+    }
+  }
+  return full_snapshot;
+}
+
+// An encoded MetricRequest with incremental set.
+ConstByteSpan IncrementalRequest() {
+  static std::array<std::byte, 2> buffer;
+  proto::pwpb::MetricRequest::MemoryEncoder encoder(buffer);
+  EXPECT_EQ(OkStatus(), encoder.WriteIncremental(true));
+  return ConstByteSpan(encoder);
+}
+
 TEST(MetricService, EmptyGroupAndNoMetrics) {
   // Empty root group.
   PW_METRIC_GROUP(root, "/");
@@ -245,5 +269,208 @@ TEST(MetricService, MaxDepth4) {
   EXPECT_EQ(6u, GetMetricsSum(ctx.responses()[0]));
 }
 
+TEST(MetricService, ShardedCounterIsSummed) {
+  PW_METRIC_GROUP(root, "/");
+  PW_METRIC(root, a, "a", 1u);
+  PW_METRIC_SHARDED_COUNTER(root, sharded, "sharded", 4);
+  sharded.Increment(2u);
+  sharded.Increment(3u);
+
+  PW_RAW_TEST_METHOD_CONTEXT(MetricService, Get)
+  ctx{root.metrics(), root.children()};
+  ctx.call({});
+  EXPECT_TRUE(ctx.done());
+  EXPECT_EQ(OkStatus(), ctx.status());
+
+  ASSERT_EQ(1u, ctx.responses().size());
+  EXPECT_EQ(2u, CountEncodedMetrics(ctx.responses()[0]));
+  EXPECT_EQ(6u, GetMetricsSum(ctx.responses()[0]));
+}
+
+TEST(MetricService, Incremental_NoClientState_SendsFullSnapshot) {
+  PW_METRIC_GROUP(root, "/");
+  PW_METRIC(root, a, "a", 1u);
+  PW_METRIC(root, b, "b", 2u);
+
+  PW_RAW_TEST_METHOD_CONTEXT(MetricService, Get)
+  ctx{root.metrics(), root.children()};
+  for (int i = 0; i < 2; ++i) {
+    ctx.output().clear();
+    ctx.call(IncrementalRequest());
+    EXPECT_EQ(OkStatus(), ctx.status());
+    ASSERT_EQ(1u, ctx.responses().size());
+    EXPECT_EQ(2u, CountEncodedMetrics(ctx.responses()[0]));
+    EXPECT_TRUE(IsFullSnapshot(ctx.responses()[0]));
+  }
+}
+
+TEST(MetricService, Incremental_OnlyChangedMetrics) {
+  PW_METRIC_GROUP(root, "/");
+  PW_METRIC(root, a, "a", 1u);
+  PW_METRIC(root, b, "b", 2u);
+  PW_METRIC(root, c, "c", 0.5f);
+  PW_METRIC_GROUP(root, child, "child");
+  PW_METRIC(child, d, "d", 4u);
+
+  std::array<uint32_t, 8> values;
+  std::array<MetricClientState, 1> clients = {MetricClientState(values)};
+
+  PW_RAW_TEST_METHOD_CONTEXT(MetricService, Get)
+  ctx{root.metrics(), root.children(), clients};
+
+  // The first incremental request is a full snapshot.
+  ctx.call(IncrementalRequest());
+  EXPECT_EQ(OkStatus(), ctx.status());
+  ASSERT_EQ(2u, ctx.responses().size());
+  EXPECT_TRUE(IsFullSnapshot(ctx.responses()[0]));
+  EXPECT_TRUE(IsFullSnapshot(ctx.responses()[1]));
+  EXPECT_EQ(4u,
+            CountEncodedMetrics(ctx.responses()[0]) +
+                CountEncodedMetrics(ctx.responses()[1]));
+
+  // Nothing changed.
+  ctx.output().clear();
+  ctx.call(IncrementalRequest());
+  EXPECT_TRUE(ctx.done());
+  EXPECT_EQ(OkStatus(), ctx.status());
+  EXPECT_EQ(0u, ctx.responses().size());
+
+  // Only the changed metrics are sent.
+  b.Increment(5u);
+  c.Set(0.25f);
+  d.Set(4u);  // Same value
+  ctx.output().clear();
+  ctx.call(IncrementalRequest());
+  ASSERT_EQ(1u, ctx.responses().size());
+  EXPECT_FALSE(IsFullSnapshot(ctx.responses()[0]));
+  EXPECT_EQ(2u, CountEncodedMetrics(ctx.responses()[0]));
+  EXPECT_EQ(7u, GetMetricsSum(ctx.responses()[0]));
+
+  // Requests without incremental still return every metric.
+  ctx.output().clear();
+  ctx.call({});
+  ASSERT_EQ(2u, ctx.responses().size());
+  EXPECT_FALSE(IsFullSnapshot(ctx.responses()[0]));
+
+  // That did not affect the incremental state.
+  ctx.output().clear();
+  ctx.call(IncrementalRequest());
+  EXPECT_EQ(0u, ctx.responses().size());
+}
+
+TEST(MetricService, Incremental_FullSnapshotInterval) {
+  PW_METRIC_GROUP(root, "/");
+  PW_METRIC(root, a, "a", 1u);
+
+  std::array<uint32_t, 1> values;
+  std::array<MetricClientState, 1> clients = {
+      MetricClientState(values, /*full_snapshot_interval=*/3)};
+
+  PW_RAW_TEST_METHOD_CONTEXT(MetricService, Get)
+  ctx{root.metrics(), root.children(), clients};
+
+  constexpr size_t kExpectedResponses[] = {1, 0, 0, 1, 0, 0, 1};
+  for (size_t expected : kExpectedResponses) {
+    ctx.output().clear();
+    ctx.call(IncrementalRequest());
+    ASSERT_EQ(expected, ctx.responses().size());
+    if (expected != 0u) {
+      EXPECT_TRUE(IsFullSnapshot(ctx.responses()[0]));
+    }
+  }
+}
+
+TEST(MetricService, Incremental_TreeChangeSendsFullSnapshot) {
+  PW_METRIC_GROUP(root, "/");
+  PW_METRIC(root, a, "a", 1u);
+
+  std::array<uint32_t, 4> values;
+  std::array<MetricClientState, 1> clients = {MetricClientState(values)};
+
+  PW_RAW_TEST_METHOD_CONTEXT(MetricService, Get)
+  ctx{root.metrics(), root.children(), clients};
+  ctx.call(IncrementalRequest());
+  ASSERT_EQ(1u, ctx.responses().size());
+
+  PW_METRIC(root, b, "b", 1u);  // Added before a, with the same value.
+  ctx.output().clear();
+  ctx.call(IncrementalRequest());
+  ASSERT_EQ(1u, ctx.responses().size());
+  EXPECT_TRUE(IsFullSnapshot(ctx.responses()[0]));
+  EXPECT_EQ(2u, CountEncodedMetrics(ctx.responses()[0]));
+
+  root.metrics().remove(b);
+}
+
+TEST(MetricService, Incremental_MetricsBeyondCapacityAlwaysSent) {
+  PW_METRIC_GROUP(root, "/");
+  PW_METRIC(root, a, "a", 1u);
+  PW_METRIC(root, b, "b", 2u);
+  PW_METRIC(root, c, "c", 3u);
+
+  std::array<uint32_t, 2> values;
+  std::array<MetricClientState, 1> clients = {MetricClientState(values)};
+
+  PW_RAW_TEST_METHOD_CONTEXT(MetricService, Get)
+  ctx{root.metrics(), root.children(), clients};
+  ctx.call(IncrementalRequest());
+
+  ctx.output().clear();
+  ctx.call(IncrementalRequest());
+  ASSERT_EQ(1u, ctx.responses().size());
+  EXPECT_EQ(1u, CountEncodedMetrics(ctx.responses()[0]));
+  EXPECT_EQ(1u, GetMetricsSum(ctx.responses()[0]));  // a is walked last
+}
+
+TEST(MetricService, Incremental_ClientsPerChannel) {
+  PW_METRIC_GROUP(root, "/");
+  PW_METRIC(root, a, "a", 1u);
+
+  std::array<uint32_t, 1> values_1;
+  std::array<uint32_t, 1> values_2;
+  std::array<MetricClientState, 2> clients = {MetricClientState(values_1),
+                                              MetricClientState(values_2)};
+
+  PW_RAW_TEST_METHOD_CONTEXT(MetricService, Get)
+  ctx{root.metrics(), root.children(), clients};
+
+  ctx.set_channel_id(1);
+  ctx.call(IncrementalRequest());
+  EXPECT_EQ(1u, ctx.responses().size());
+
+  ctx.set_channel_id(2);
+  ctx.output().clear();
+  ctx.call(IncrementalRequest());
+  EXPECT_EQ(1u, ctx.responses().size());  // New client: full snapshot.
+
+  a.Increment();
+  ctx.output().clear();
+  ctx.call(IncrementalRequest());
+  EXPECT_EQ(1u, ctx.responses().size());
+
+  ctx.set_channel_id(1);
+  ctx.output().clear();
+  ctx.call(IncrementalRequest());
+  ASSERT_EQ(1u, ctx.responses().size());  // Channel 1 has not seen the change.
+  EXPECT_FALSE(IsFullSnapshot(ctx.responses()[0]));
+
+  // A third channel replaces the least recently used client, channel 2.
+  ctx.set_channel_id(3);
+  ctx.output().clear();
+  ctx.call(IncrementalRequest());
+  EXPECT_EQ(1u, ctx.responses().size());
+
+  ctx.set_channel_id(1);
+  ctx.output().clear();
+  ctx.call(IncrementalRequest());
+  EXPECT_EQ(0u, ctx.responses().size());
+
+  ctx.set_channel_id(2);
+  ctx.output().clear();
+  ctx.call(IncrementalRequest());
+  ASSERT_EQ(1u, ctx.responses().size());
+  EXPECT_TRUE(IsFullSnapshot(ctx.responses()[0]));
+}
+
 }  // namespace
 }  // namespace pw::metric
@@ -36,7 +36,11 @@ using tokenizer::Token;
 //
 // Size: 12 bytes / 96 bits - next, name, value.
 //
-// TODO(keir): Implement Set() and Increment() using atomics.
+// Values are atomic, so metrics may be read and updated from multiple threads
+// without a lock. Updates use relaxed memory ordering; metrics count events but
+// do not order other memory accesses. For integer counters that are
+// incremented from many threads at once, see pw_metric/sharded_counter.h.
+//
 // TODO(keir): Consider an alternative structure where metrics have pointers to
 // parent groups, which would enable (1) safe destruction and (2) safe static
 // initialization, but at the cost of an additional 4 bytes per metric and 4
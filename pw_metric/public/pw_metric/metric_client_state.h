@@ -0,0 +1,70 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_span/span.h"
+
+namespace pw::metric {
+namespace internal {
+
+class IncrementalGet;
+
+}  // namespace internal
+
+// The metric values last sent to one MetricService client. With client state,
+// a Get request with "incremental" set only returns the metrics which changed
+// since that client's previous incremental request. Clients are identified by
+// their RPC channel; a MetricService assigns its least recently used state to
+// a channel it has not seen.
+//
+// The state holds one value per metric, in the order in which the service
+// walks the metrics. Metrics beyond the capacity of the values buffer are sent
+// in every response.
+//
+// A full snapshot, with every metric, is sent for a client's first incremental
+// request, after the metric tree changes, after a request which failed, and
+// every full_snapshot_interval requests if the interval is nonzero. Responses
+// which are part of a full snapshot have "full_snapshot" set.
+//
+// Size: 32 bytes + the values buffer, on 32-bit platforms.
+class MetricClientState {
+ public:
+  constexpr explicit MetricClientState(span<uint32_t> values,
+                                       uint32_t full_snapshot_interval = 0)
+      : values_(values), full_snapshot_interval_(full_snapshot_interval) {}
+
+  // Disallow copy and assign.
+  MetricClientState(const MetricClientState&) = delete;
+  void operator=(const MetricClientState&) = delete;
+
+  // Sends a full snapshot in response to the client's next incremental request.
+  void Reset() { has_snapshot_ = false; }
+
+ private:
+  friend class internal::IncrementalGet;
+
+  span<uint32_t> values_;
+  uint32_t full_snapshot_interval_;
+
+  uint32_t channel_id_ = 0;  // 0 if unassigned
+  uint32_t last_request_ = 0;
+  uint32_t requests_since_snapshot_ = 0;
+  uint32_t tree_fingerprint_ = 0;
+  bool has_snapshot_ = false;
+};
+
+}  // namespace pw::metric
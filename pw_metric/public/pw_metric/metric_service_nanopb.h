@@ -17,6 +17,7 @@
 
 #include "pw_log/log.h"
 #include "pw_metric/metric.h"
+#include "pw_metric/metric_client_state.h"
 #include "pw_metric_proto/metric_service.rpc.pb.h"
 #include "pw_span/span.h"
 
@@ -31,12 +32,17 @@ namespace pw::metric {
 // method is blocking, and sends all metrics at once (though batched). In the
 // future, we may switch to offering an async version where the Get() method
 // returns immediately, and someone else is responsible for pumping the queue.
+//
+// Requests with "incremental" set only return the metrics which changed since
+// the client's previous incremental request. This requires a MetricClientState
+// for each client; see pw_metric/metric_client_state.h.
 class MetricService final
     : public proto::pw_rpc::nanopb::MetricService::Service<MetricService> {
  public:
   MetricService(const IntrusiveList<Metric>& metrics,
-                const IntrusiveList<Group>& groups)
-      : metrics_(metrics), groups_(groups) {}
+                const IntrusiveList<Group>& groups,
+                span<MetricClientState> clients = {})
+      : metrics_(metrics), groups_(groups), clients_(clients) {}
 
   void Get(const pw_metric_proto_MetricRequest& request,
            ServerWriter<pw_metric_proto_MetricResponse>& response);
@@ -44,6 +50,8 @@ class MetricService final
  private:
   const IntrusiveList<Metric>& metrics_;
   const IntrusiveList<Group>& groups_;
+  span<MetricClientState> clients_;
+  uint32_t request_count_ = 0;
 };
 
 }  // namespace pw::metric
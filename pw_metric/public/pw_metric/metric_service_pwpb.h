@@ -18,6 +18,7 @@
 #include "pw_bytes/span.h"
 #include "pw_containers/intrusive_list.h"
 #include "pw_metric/metric.h"
+#include "pw_metric/metric_client_state.h"
 #include "pw_metric_proto/metric_service.raw_rpc.pb.h"
 #include "pw_rpc/raw/server_reader_writer.h"
 #include "pw_span/span.h"
@@ -33,18 +34,25 @@ namespace pw::metric {
 // method is blocking, and sends all metrics at once (though batched). In the
 // future, we may switch to offering an async version where the Get() method
 // returns immediately, and someone else is responsible for pumping the queue.
+//
+// Requests with "incremental" set only return the metrics which changed since
+// the client's previous incremental request. This requires a MetricClientState
+// for each client; see pw_metric/metric_client_state.h.
 class MetricService final
     : public proto::pw_rpc::raw::MetricService::Service<MetricService> {
  public:
   MetricService(const IntrusiveList<Metric>& metrics,
-                const IntrusiveList<Group>& groups)
-      : metrics_(metrics), groups_(groups) {}
+                const IntrusiveList<Group>& groups,
+                span<MetricClientState> clients = {})
+      : metrics_(metrics), groups_(groups), clients_(clients) {}
 
   void Get(ConstByteSpan request, rpc::RawServerWriter& response);
 
  private:
   const IntrusiveList<Metric>& metrics_;
   const IntrusiveList<Group>& groups_;
+  span<MetricClientState> clients_;
+  uint32_t request_count_ = 0;
 };
 
 }  // namespace pw::metric
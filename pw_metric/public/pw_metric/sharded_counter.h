@@ -0,0 +1,192 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "pw_containers/intrusive_forward_list.h"
+#include "pw_containers/intrusive_list.h"
+#include "pw_metric/metric.h"
+#include "pw_preprocessor/arguments.h"
+#include "pw_preprocessor/compiler.h"
+#include "pw_span/span.h"
+
+namespace pw::metric {
+
+// Adds the pending increments of every sharded counter to the counter's metric
+// value, so that readers of the Metric, such as MetricService, see the total.
+// MetricService calls this before reading metrics.
+void FoldShardedCounters();
+
+namespace internal {
+
+// Each shard is on its own cache line, so threads incrementing different shards
+// do not contend.
+struct alignas(64) CounterShard {
+  std::atomic<uint32_t> value{0};
+};
+
+// The next index to assign to a thread that increments a sharded counter.
+inline std::atomic<size_t> next_thread_shard_index{0};
+
+// Returns the calling thread's shard index. Threads are assigned indices
+// round-robin when they first increment a sharded counter.
+inline size_t ThreadShardIndex() {
+  thread_local const size_t index =
+      next_thread_shard_index.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+// Saturating atomic add. Results in the max value if the add would overflow.
+inline void SaturatingAdd(std::atomic<uint32_t>& value, uint32_t amount) {
+  uint32_t current = value.load(std::memory_order_relaxed);
+  uint32_t updated;
+  do {
+    if (PW_ADD_OVERFLOW(current, amount, &updated)) {
+      updated = std::numeric_limits<uint32_t>::max();
+    }
+  } while (!value.compare_exchange_weak(
+      current, updated, std::memory_order_relaxed));
+}
+
+class ShardedCounterBase;
+
+// Links a sharded counter into the list folded by FoldShardedCounters(). This
+// is a separate object since Metric is already an intrusive list item.
+class ShardedCounterRegistration
+    : public IntrusiveForwardList<ShardedCounterRegistration>::Item {
+ public:
+  explicit ShardedCounterRegistration(ShardedCounterBase& counter)
+      : counter_(counter) {}
+
+  ShardedCounterBase& counter() const { return counter_; }
+
+ private:
+  ShardedCounterBase& counter_;
+};
+
+// The shard-count-independent part of ShardedCounter.
+class ShardedCounterBase : public Metric {
+ public:
+  ~ShardedCounterBase();
+
+  // The folded value plus the pending increments in every shard.
+  uint32_t value() const;
+
+  // Moves the pending increments in every shard into the metric value.
+  void Fold();
+
+ protected:
+  explicit ShardedCounterBase(Token name) : Metric(name, 0u) {}
+
+  ShardedCounterBase(Token name, IntrusiveList<Metric>& metrics)
+      : Metric(name, 0u, metrics) {}
+
+  // Called by the derived class once its shards are constructed.
+  void Register(span<CounterShard> shards);
+
+  void Increment(size_t shard, uint32_t amount) {
+    SaturatingAdd(shards_[shard].value, amount);
+  }
+
+ private:
+  span<CounterShard> shards_;
+  ShardedCounterRegistration registration_{*this};
+};
+
+}  // namespace internal
+
+// An integer counter for metrics which are incremented from many threads at
+// once. Each thread increments one of kShards cache-line-sized counters, rather
+// than all threads updating a single value, and the shards are summed when the
+// counter is read. With at least as many shards as incrementing threads,
+// increments do not contend.
+//
+// A ShardedCounter is a Metric, so it can be added to a Group or metric list
+// like any other metric. The Metric value is brought up to date by
+// FoldShardedCounters(), which MetricService calls before reading metrics.
+//
+// Size: Metric + kShards cache lines, plus pointers for the shards and the
+// registration.
+//
+// Sharded counters use thread_local to select a shard, and may only be
+// incremented from threads, not interrupts.
+//
+// Sharded counters are usually declared with PW_METRIC_SHARDED_COUNTER.
+template <size_t kShards>
+class ShardedCounter : public internal::ShardedCounterBase {
+ public:
+  static_assert(kShards > 0u, "Sharded counters require at least one shard");
+
+  explicit ShardedCounter(Token name) : ShardedCounterBase(name) {
+    Register(shards_);
+  }
+
+  ShardedCounter(Token name, IntrusiveList<Metric>& metrics)
+      : ShardedCounterBase(name, metrics) {
+    Register(shards_);
+  }
+
+  // Saturating add. Results in the max value if the addition would overflow.
+  void Increment(uint32_t amount = 1u) {
+    ShardedCounterBase::Increment(internal::ThreadShardIndex() % kShards,
+                                  amount);
+  }
+
+ private:
+  // Shadow these accessors; use value() instead, which includes unfolded
+  // increments.
+  float as_float() const { return 0.0; }
+  uint32_t as_int() const { return 0; }
+
+  std::array<internal::CounterShard, kShards> shards_;
+};
+
+// Declare a ShardedCounter, optionally adding it to a group. Works like
+// PW_METRIC, but sharded counters always start at zero. Use:
+//
+//   PW_METRIC_SHARDED_COUNTER(variable_name, metric_name, shards)
+//   PW_METRIC_SHARDED_COUNTER(group, variable_name, metric_name, shards)
+//
+// Example:
+//
+//   class Server {
+//    public:
+//     void HandleRequest() { requests_.Increment(); }
+//
+//    private:
+//     PW_METRIC_GROUP(metrics_, "server");
+//     PW_METRIC_SHARDED_COUNTER(metrics_, requests_, "requests", 8);
+//   };
+//
+#define PW_METRIC_SHARDED_COUNTER(...) \
+  PW_DELEGATE_BY_ARG_COUNT(_PW_METRIC_SHARDED_COUNTER_, __VA_ARGS__)
+
+#define _PW_METRIC_SHARDED_COUNTER_3(variable_name, metric_name, shards) \
+  static constexpr uint32_t variable_name##_token =                      \
+      PW_METRIC_TOKEN(metric_name);                                      \
+  ::pw::metric::ShardedCounter<shards> variable_name{variable_name##_token}
+
+#define _PW_METRIC_SHARDED_COUNTER_4(                      \
+    group, variable_name, metric_name, shards)             \
+  static constexpr uint32_t variable_name##_token =        \
+      PW_METRIC_TOKEN(metric_name);                        \
+  ::pw::metric::ShardedCounter<shards> variable_name{      \
+      variable_name##_token, group.metrics()}
+
+}  // namespace pw::metric
@@ -13,11 +13,17 @@
 // the License.
 #pragma once
 
+#include <cstdint>
+#include <cstring>
+
 #include "pw_assert/check.h"
 #include "pw_containers/intrusive_list.h"
 #include "pw_containers/vector.h"
 #include "pw_metric/metric.h"
+#include "pw_metric/metric_client_state.h"
+#include "pw_span/span.h"
 #include "pw_status/status.h"
+#include "pw_status/try.h"
 #include "pw_tokenizer/tokenize.h"
 
 namespace pw::metric::internal {
@@ -72,4 +78,137 @@ class MetricWalker {
   MetricWriter& writer_;
 };
 
+// Handles a Get request with "incremental" set, for either MetricService.
+// Selects the client state for the request's channel, decides whether to send
+// a full snapshot, and filters out metrics which have not changed.
+class IncrementalGet : public MetricWriter {
+ public:
+  IncrementalGet(span<MetricClientState> clients,
+                 uint32_t channel_id,
+                 uint32_t request_number,
+                 const IntrusiveList<Metric>& metrics,
+                 const IntrusiveList<Group>& groups)
+      : metrics_(metrics), groups_(groups) {
+    client_ = SelectClient(clients, channel_id);
+    if (client_ == nullptr) {
+      return;  // No state; always send every metric.
+    }
+    client_->last_request_ = request_number;
+
+    fingerprint_ = Fingerprint(metrics, groups);
+    full_snapshot_ = !client_->has_snapshot_ ||
+                     client_->tree_fingerprint_ != fingerprint_ ||
+                     (client_->full_snapshot_interval_ != 0u &&
+                      client_->requests_since_snapshot_ + 1 >=
+                          client_->full_snapshot_interval_);
+
+    // Stored values are only valid once the request succeeds.
+    client_->has_snapshot_ = false;
+  }
+
+  // True if every metric is sent in response to this request.
+  bool full_snapshot() const { return full_snapshot_; }
+
+  // Passes the metrics to send to the writer.
+  Status Walk(MetricWriter& writer) {
+    writer_ = &writer;
+    MetricWalker walker(*this);
+    PW_TRY(walker.Walk(metrics_));
+    return walker.Walk(groups_);
+  }
+
+  // Records the outcome of the request, once all responses are written.
+  void Finish(Status status) {
+    if (client_ == nullptr || !status.ok()) {
+      return;
+    }
+    client_->has_snapshot_ = true;
+    client_->tree_fingerprint_ = fingerprint_;
+    client_->requests_since_snapshot_ =
+        full_snapshot_ ? 0u : client_->requests_since_snapshot_ + 1;
+  }
+
+  Status Write(const Metric& metric, const Vector<Token>& path) override {
+    const size_t index = index_++;
+    if (client_ != nullptr && index < client_->values_.size()) {
+      const uint32_t value = RawValue(metric);
+      if (!full_snapshot_ && client_->values_[index] == value) {
+        return OkStatus();
+      }
+      client_->values_[index] = value;
+    }
+    return writer_->Write(metric, path);
+  }
+
+ private:
+  // Computes a hash of the metric names, paths, and types, which changes if
+  // metrics are added, removed, or reordered.
+  class FingerprintWriter : public MetricWriter {
+   public:
+    Status Write(const Metric& metric, const Vector<Token>& path) override {
+      for (Token token : path) {
+        Add(token);
+      }
+      Add(metric.is_float() ? 1u : 0u);
+      return OkStatus();
+    }
+
+    uint32_t fingerprint() const { return hash_; }
+
+   private:
+    void Add(uint32_t value) {  // FNV-1a, one 32-bit word at a time
+      hash_ = (hash_ ^ value) * 16777619u;
+    }
+
+    uint32_t hash_ = 2166136261u;
+  };
+
+  static uint32_t Fingerprint(const IntrusiveList<Metric>& metrics,
+                              const IntrusiveList<Group>& groups) {
+    FingerprintWriter fingerprint;
+    MetricWalker walker(fingerprint);
+    walker.Walk(metrics).IgnoreError();
+    walker.Walk(groups).IgnoreError();
+    return fingerprint.fingerprint();
+  }
+
+  // Returns the state for the channel, or assigns the least recently used
+  // state to it.
+  static MetricClientState* SelectClient(span<MetricClientState> clients,
+                                         uint32_t channel_id) {
+    MetricClientState* oldest = nullptr;
+    for (MetricClientState& client : clients) {
+      if (client.channel_id_ == channel_id) {
+        return &client;
+      }
+      if (oldest == nullptr || client.last_request_ < oldest->last_request_) {
+        oldest = &client;
+      }
+    }
+    if (oldest != nullptr) {
+      oldest->channel_id_ = channel_id;
+      oldest->has_snapshot_ = false;
+    }
+    return oldest;
+  }
+
+  static uint32_t RawValue(const Metric& metric) {
+    if (metric.is_int()) {
+      return metric.as_int();
+    }
+    const float value = metric.as_float();
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  }
+
+  const IntrusiveList<Metric>& metrics_;
+  const IntrusiveList<Group>& groups_;
+  MetricClientState* client_;
+  MetricWriter* writer_ = nullptr;
+  uint32_t fingerprint_ = 0;
+  size_t index_ = 0;
+  bool full_snapshot_ = true;
+};
+
 }  // namespace pw::metric::internal
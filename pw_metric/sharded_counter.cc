@@ -0,0 +1,75 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_metric/sharded_counter.h"
+
+#include <limits>
+#include <mutex>
+
+#include "pw_polyfill/language_feature_macros.h"
+#include "pw_sync/interrupt_spin_lock.h"
+#include "pw_sync/lock_annotations.h"
+
+namespace pw::metric {
+namespace {
+
+PW_CONSTINIT sync::InterruptSpinLock registry_lock;
+
+IntrusiveForwardList<internal::ShardedCounterRegistration> registry
+    PW_GUARDED_BY(registry_lock);
+
+}  // namespace
+
+void FoldShardedCounters() {
+  std::lock_guard lock(registry_lock);
+  for (const internal::ShardedCounterRegistration& registration : registry) {
+    registration.counter().Fold();
+  }
+}
+
+namespace internal {
+
+ShardedCounterBase::~ShardedCounterBase() {
+  std::lock_guard lock(registry_lock);
+  registry.remove(registration_);
+}
+
+void ShardedCounterBase::Register(span<CounterShard> shards) {
+  shards_ = shards;
+  std::lock_guard lock(registry_lock);
+  registry.push_front(registration_);
+}
+
+uint32_t ShardedCounterBase::value() const {
+  uint32_t total = as_int();
+  for (const CounterShard& shard : shards_) {
+    if (PW_ADD_OVERFLOW(
+            total, shard.value.load(std::memory_order_relaxed), &total)) {
+      return std::numeric_limits<uint32_t>::max();
+    }
+  }
+  return total;
+}
+
+void ShardedCounterBase::Fold() {
+  for (CounterShard& shard : shards_) {
+    const uint32_t pending = shard.value.exchange(0, std::memory_order_relaxed);
+    if (pending != 0u) {
+      Metric::Increment(pending);
+    }
+  }
+}
+
+}  // namespace internal
+}  // namespace pw::metric
@@ -0,0 +1,90 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures contended counter increments. Each test increments one counter from
+// a number of threads at once, and logs the total increments per second, for a
+// Metric and for a ShardedCounter.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "pw_log/log.h"
+#include "pw_metric/metric.h"
+#include "pw_metric/sharded_counter.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace pw::metric {
+namespace {
+
+constexpr uint32_t kIncrementsPerThread = 20000;
+constexpr size_t kShards = 16;
+
+template <typename Counter>
+void IncrementFromThreads(perf_test::State& state,
+                          Counter& counter,
+                          const char* name,
+                          size_t threads) {
+  size_t iterations = 0;
+  const auto start = std::chrono::steady_clock::now();
+  while (state.KeepRunning()) {
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < threads; ++i) {
+      workers.emplace_back([&counter] {
+        for (uint32_t j = 0; j < kIncrementsPerThread; ++j) {
+          counter.Increment();
+        }
+      });
+    }
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+    iterations += 1;
+  }
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  PW_LOG_INFO("%s, threads: %u, increments/s: %.0f",
+              name,
+              static_cast<unsigned>(threads),
+              static_cast<double>(iterations * threads * kIncrementsPerThread) /
+                  elapsed.count());
+}
+
+void MetricIncrement(perf_test::State& state, size_t threads) {
+  PW_METRIC(counter, "counter", 0u);
+  IncrementFromThreads(state, counter, "Metric", threads);
+}
+
+void ShardedCounterIncrement(perf_test::State& state, size_t threads) {
+  PW_METRIC_SHARDED_COUNTER(counter, "sharded_counter", kShards);
+  IncrementFromThreads(state, counter, "ShardedCounter", threads);
+}
+
+PW_PERF_TEST(Metric_1Thread, MetricIncrement, 1);
+PW_PERF_TEST(Metric_2Threads, MetricIncrement, 2);
+PW_PERF_TEST(Metric_4Threads, MetricIncrement, 4);
+PW_PERF_TEST(Metric_8Threads, MetricIncrement, 8);
+PW_PERF_TEST(Metric_16Threads, MetricIncrement, 16);
+
+PW_PERF_TEST(ShardedCounter_1Thread, ShardedCounterIncrement, 1);
+PW_PERF_TEST(ShardedCounter_2Threads, ShardedCounterIncrement, 2);
+PW_PERF_TEST(ShardedCounter_4Threads, ShardedCounterIncrement, 4);
+PW_PERF_TEST(ShardedCounter_8Threads, ShardedCounterIncrement, 8);
+PW_PERF_TEST(ShardedCounter_16Threads, ShardedCounterIncrement, 16);
+
+}  // namespace
+}  // namespace pw::metric
@@ -0,0 +1,152 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_metric/sharded_counter.h"
+
+#include <array>
+#include <limits>
+#include <thread>
+
+#include "pw_unit_test/framework.h"
+
+namespace pw::metric {
+namespace {
+
+constexpr Token kToken = 0x71223344;
+
+TEST(ShardedCounter, IsIntMetric) {
+  ShardedCounter<4> counter(kToken);
+  const Metric& metric = counter;
+  EXPECT_EQ(metric.name(), kToken);
+  EXPECT_TRUE(metric.is_int());
+  EXPECT_EQ(counter.value(), 0u);
+}
+
+TEST(ShardedCounter, Increment) {
+  ShardedCounter<4> counter(kToken);
+  counter.Increment();
+  counter.Increment(10u);
+  EXPECT_EQ(counter.value(), 11u);
+}
+
+TEST(ShardedCounter, FoldUpdatesMetricValue) {
+  ShardedCounter<4> counter(kToken);
+  const Metric& metric = counter;
+  counter.Increment(5u);
+  EXPECT_EQ(metric.as_int(), 0u);
+
+  FoldShardedCounters();
+  EXPECT_EQ(metric.as_int(), 5u);
+  EXPECT_EQ(counter.value(), 5u);
+
+  counter.Increment(2u);
+  EXPECT_EQ(counter.value(), 7u);
+  FoldShardedCounters();
+  EXPECT_EQ(metric.as_int(), 7u);
+}
+
+TEST(ShardedCounter, Saturates) {
+  ShardedCounter<2> counter(kToken);
+  counter.Increment(std::numeric_limits<uint32_t>::max() - 1);
+  counter.Increment(5u);
+  EXPECT_EQ(counter.value(), std::numeric_limits<uint32_t>::max());
+
+  FoldShardedCounters();
+  counter.Increment(5u);
+  EXPECT_EQ(counter.value(), std::numeric_limits<uint32_t>::max());
+  FoldShardedCounters();
+  EXPECT_EQ(static_cast<const Metric&>(counter).as_int(),
+            std::numeric_limits<uint32_t>::max());
+}
+
+TEST(ShardedCounter, AddedToGroup) {
+  PW_METRIC_GROUP(group, "group");
+  ShardedCounter<4> counter(kToken, group.metrics());
+  counter.Increment(3u);
+  FoldShardedCounters();
+
+  ASSERT_EQ(group.metrics().size(), 1u);
+  EXPECT_EQ(group.metrics().front().as_int(), 3u);
+}
+
+TEST(ShardedCounter, Macro) {
+  PW_METRIC_GROUP(group, "group");
+  PW_METRIC_SHARDED_COUNTER(group, counter, "counter", 2);
+  PW_METRIC_SHARDED_COUNTER(ungrouped, "ungrouped", 2);
+  counter.Increment(3u);
+  ungrouped.Increment();
+  FoldShardedCounters();
+
+  ASSERT_EQ(group.metrics().size(), 1u);
+  EXPECT_EQ(group.metrics().front().name(), counter_token);
+  EXPECT_EQ(group.metrics().front().as_int(), 3u);
+  EXPECT_EQ(ungrouped.value(), 1u);
+}
+
+TEST(ShardedCounter, DestroyedCounterIsNotFolded) {
+  {
+    ShardedCounter<4> counter(kToken);
+    counter.Increment();
+  }
+  FoldShardedCounters();  // Must not touch the destroyed counter.
+}
+
+TEST(ShardedCounter, ConcurrentIncrements) {
+  constexpr int kThreads = 8;
+  constexpr uint32_t kIncrements = 10000;
+  ShardedCounter<4> counter(kToken);
+
+  std::array<std::thread, kThreads> threads;
+  for (std::thread& thread : threads) {
+    thread = std::thread([&counter] {
+      for (uint32_t i = 0; i < kIncrements; ++i) {
+        counter.Increment();
+        if (i % 1000 == 0) {
+          FoldShardedCounters();
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(counter.value(), kThreads * kIncrements);
+  FoldShardedCounters();
+  EXPECT_EQ(static_cast<const Metric&>(counter).as_int(),
+            kThreads * kIncrements);
+}
+
+TEST(Metric, ConcurrentIncrements) {
+  constexpr int kThreads = 8;
+  constexpr uint32_t kIncrements = 10000;
+  PW_METRIC(metric, "metric", 0u);
+
+  std::array<std::thread, kThreads> threads;
+  for (std::thread& thread : threads) {
+    thread = std::thread([&metric] {
+      for (uint32_t i = 0; i < kIncrements; ++i) {
+        metric.Increment();
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(metric.value(), kThreads * kIncrements);
+}
+
+}  // namespace
+}  // namespace pw::metric
@@ -14,6 +14,7 @@
 #include "pw_multisink/multisink.h"
 
 #include <cstring>
+#include <limits>
 
 #include "pw_assert/check.h"
 #include "pw_bytes/span.h"
@@ -34,6 +35,110 @@ void MultiSink::HandleEntry(ConstByteSpan entry) {
   NotifyListeners();
 }
 
+void MultiSink::Producer::HandleEntry(ConstByteSpan entry) {
+  PW_DCHECK_NOTNULL(multisink_);
+  if (!Stage(entry)) {
+    staged_drops_.fetch_add(1, std::memory_order_relaxed);
+  }
+  multisink_->MergeStagedEntries();
+}
+
+void MultiSink::Producer::HandleDropped(uint32_t drop_count) {
+  PW_DCHECK_NOTNULL(multisink_);
+  staged_drops_.fetch_add(drop_count, std::memory_order_relaxed);
+  multisink_->MergeStagedEntries();
+}
+
+bool MultiSink::Producer::Stage(ConstByteSpan entry) {
+  const size_t capacity = buffer_.size();
+  const size_t read = read_offset_.load(std::memory_order_acquire);
+  size_t write = write_offset_.load(std::memory_order_relaxed);
+
+  // One byte is always left unused, so that a full buffer can be told apart
+  // from an empty one.
+  const size_t used = write >= read ? write - read : capacity - read + write;
+  const size_t available = capacity - 1 - used;
+
+  // Entries are not split across the end of the buffer. If the entry does not
+  // fit in the bytes before the end, those bytes are skipped.
+  const size_t record_size = sizeof(EntrySize) + entry.size();
+  const size_t bytes_to_end = capacity - write;
+  const size_t skipped = record_size > bytes_to_end ? bytes_to_end : 0;
+  if (skipped + record_size > available) {
+    return false;
+  }
+
+  if (skipped != 0u) {
+    if (skipped >= sizeof(EntrySize)) {
+      std::memcpy(&buffer_[write], &kWrapMarker, sizeof(kWrapMarker));
+    }
+    write = 0;
+  }
+
+  const EntrySize entry_size = static_cast<EntrySize>(entry.size());
+  std::memcpy(&buffer_[write], &entry_size, sizeof(entry_size));
+  if (!entry.empty()) {
+    std::memcpy(
+        &buffer_[write + sizeof(entry_size)], entry.data(), entry.size());
+  }
+
+  write += record_size;
+  write_offset_.store(write == capacity ? 0 : write, std::memory_order_release);
+  return true;
+}
+
+void MultiSink::MergeStagedEntries() {
+  // If another thread is already merging, it merges this thread's entries
+  // before it stops.
+  if (pending_merges_.fetch_add(1) != 0u) {
+    return;
+  }
+
+  std::lock_guard lock(lock_);
+  uint32_t merges;
+  do {
+    merges = pending_merges_.load();
+    for (Producer& producer : producers_) {
+      MergeProducer(producer);
+    }
+    NotifyListeners();
+  } while (pending_merges_.fetch_sub(merges) != merges);
+}
+
+void MultiSink::MergeProducer(Producer& producer)
+    PW_NO_SANITIZE("unsigned-integer-overflow") {
+  const ByteSpan buffer = producer.buffer_;
+  const size_t write = producer.write_offset_.load(std::memory_order_acquire);
+  size_t read = producer.read_offset_.load(std::memory_order_relaxed);
+
+  while (read != write) {
+    Producer::EntrySize entry_size = Producer::kWrapMarker;
+    if (buffer.size() - read >= sizeof(entry_size)) {
+      std::memcpy(&entry_size, &buffer[read], sizeof(entry_size));
+    }
+    if (entry_size == Producer::kWrapMarker) {
+      read = 0;
+      continue;
+    }
+
+    read += sizeof(entry_size);
+    const Status push_back_status =
+        ring_buffer_.PushBack(buffer.subspan(read, entry_size), sequence_id_++);
+    PW_DCHECK_OK(push_back_status);
+
+    read += entry_size;
+    if (read == buffer.size()) {
+      read = 0;
+    }
+  }
+  producer.read_offset_.store(read, std::memory_order_release);
+
+  const uint32_t drop_count =
+      producer.staged_drops_.exchange(0, std::memory_order_relaxed);
+  sequence_id_ += drop_count;
+  total_ingress_drops_ += drop_count;
+}
+
 void MultiSink::HandleDropped(uint32_t drop_count) {
   std::lock_guard lock(lock_);
   // Updating the sequence ID helps identify where the ingress drop happend when
@@ -106,6 +211,137 @@ Result<ConstByteSpan> MultiSink::PeekOrPopEntry(
     return peek_status;
   }
 
+  ComputeDropCounts(drain,
+                    entry_sequence_id_out,
+                    peek_status.ok(),
+                    drain_drop_count_out,
+                    ingress_drop_count_out);
+
+  // The Peek above may have failed due to OutOfRange, now that we've set the
+  // drop count see if we should return before attempting to pop.
+  if (peek_status.IsOutOfRange()) {
+    // No more entries, update the drain.
+    drain.last_handled_sequence_id_ = entry_sequence_id_out;
+    return peek_status;
+  }
+  if (request == Request::kPop) {
+    PW_CHECK(drain.reader_.PopFront().ok());
+    drain.last_handled_sequence_id_ = entry_sequence_id_out;
+  }
+  return as_bytes(buffer.first(bytes_read));
+}
+
+Status MultiSink::PopEntries(Drain& drain,
+                             const Drain::PeekedEntry& last_entry)
+    PW_NO_SANITIZE("unsigned-integer-overflow") {
+  std::lock_guard lock(lock_);
+  PW_DCHECK_PTR_EQ(drain.multisink_, this);
+
+  // Sequence IDs are compared by their distance from the last handled one, so
+  // that they are ordered across wraparound. Ignore the call if the entries
+  // have been handled already.
+  const uint32_t handled_span =
+      last_entry.sequence_id() - drain.last_handled_sequence_id_;
+  if (handled_span == 0u ||
+      handled_span >
+          static_cast<uint32_t>(std::numeric_limits<int32_t>::max())) {
+    return OkStatus();
+  }
+
+  // Pop entries up to and including the last one. Entries that were evicted
+  // since PeekEntries() was called are already gone.
+  uint32_t next_entry_sequence_id;
+  while (true) {
+    Status peek_status =
+        drain.reader_.PeekFrontPreamble(next_entry_sequence_id);
+    if (peek_status.IsOutOfRange()) {
+      break;
+    }
+    PW_TRY(peek_status);
+    if (next_entry_sequence_id - drain.last_handled_sequence_id_ >
+        handled_span) {
+      break;
+    }
+    PW_CHECK_OK(drain.reader_.PopFront());
+  }
+  drain.last_handled_sequence_id_ = last_entry.sequence_id();
+  return OkStatus();
+}
+
+Result<MultiSink::Drain::PeekedEntries> MultiSink::PeekEntries(
+    Drain& drain,
+    ByteSpan buffer,
+    uint32_t& drain_drop_count_out,
+    uint32_t& ingress_drop_count_out)
+    PW_NO_SANITIZE("unsigned-integer-overflow") {
+  drain_drop_count_out = 0;
+  ingress_drop_count_out = 0;
+
+  std::lock_guard lock(lock_);
+  PW_DCHECK_PTR_EQ(drain.multisink_, this);
+
+  size_t entry_count = 0;
+  size_t bytes_read = 0;
+  const Status peek_status =
+      drain.reader_.PeekEntriesWithPreamble(buffer, entry_count, bytes_read);
+  if (peek_status.IsOutOfRange()) {
+    ComputeDropCounts(drain,
+                      sequence_id_ - 1,
+                      false,
+                      drain_drop_count_out,
+                      ingress_drop_count_out);
+    drain.last_handled_sequence_id_ = sequence_id_ - 1;
+    return peek_status;
+  }
+  if (peek_status.IsResourceExhausted()) {
+    // The next entry may still fit in the buffer without its sequence ID and
+    // size, which is all that PeekEntry requires.
+    uint32_t entry_sequence_id = 0;
+    const Status entry_status = drain.reader_.PeekFrontWithPreamble(
+        buffer, entry_sequence_id, bytes_read);
+    if (entry_status.ok()) {
+      ComputeDropCounts(drain,
+                        entry_sequence_id,
+                        true,
+                        drain_drop_count_out,
+                        ingress_drop_count_out);
+      return Drain::PeekedEntries(buffer.first(bytes_read), entry_sequence_id);
+    }
+  }
+  if (!peek_status.ok()) {
+    // As in PeekOrPopEntry, discard the entry that could not be read.
+    PW_CHECK(drain.reader_.PopFront().ok());
+    return peek_status;
+  }
+
+  // Keep only the entries before the first gap in sequence IDs, so that every
+  // drop is reported before the first entry.
+  Drain::PeekedEntries entries(buffer.first(bytes_read), 1, 0);
+  const uint32_t first_sequence_id = entries.Read(0).sequence_id();
+  size_t offset = entries.NextOffset(0);
+  while (entries.size_ < entry_count &&
+         entries.Read(offset).sequence_id() ==
+             first_sequence_id + entries.size_) {
+    entries.back_offset_ = offset;
+    offset = entries.NextOffset(offset);
+    entries.size_ += 1;
+  }
+  entries.entries_ = entries.entries_.first(offset);
+
+  ComputeDropCounts(drain,
+                    first_sequence_id,
+                    true,
+                    drain_drop_count_out,
+                    ingress_drop_count_out);
+  return entries;
+}
+
+void MultiSink::ComputeDropCounts(Drain& drain,
+                                  uint32_t entry_sequence_id,
+                                  bool entry_available,
+                                  uint32_t& drain_drop_count_out,
+                                  uint32_t& ingress_drop_count_out)
+    PW_NO_SANITIZE("unsigned-integer-overflow") {
   // Compute the drop count delta by comparing this entry's sequence ID with the
   // last sequence ID this drain successfully read.
   //
@@ -113,9 +349,8 @@ Result<ConstByteSpan> MultiSink::PeekOrPopEntry(
   // current and last sequence IDs. Consecutive successful reads will always
   // differ by one at least, so it is subtracted out. If the read was not
   // successful, the difference is not adjusted.
-  drain_drop_count_out = entry_sequence_id_out -
-                         drain.last_handled_sequence_id_ -
-                         (peek_status.ok() ? 1 : 0);
+  drain_drop_count_out = entry_sequence_id - drain.last_handled_sequence_id_ -
+                         (entry_available ? 1 : 0);
 
   // Only report the ingress drop count when the drain catches up to where the
   // drop happened, accounting only for the drops found and no more, as
@@ -132,19 +367,6 @@ Result<ConstByteSpan> MultiSink::PeekOrPopEntry(
             ? total_ingress_drops_ - ingress_drop_count_out
             : total_ingress_drops_;
   }
-
-  // The Peek above may have failed due to OutOfRange, now that we've set the
-  // drop count see if we should return before attempting to pop.
-  if (peek_status.IsOutOfRange()) {
-    // No more entries, update the drain.
-    drain.last_handled_sequence_id_ = entry_sequence_id_out;
-    return peek_status;
-  }
-  if (request == Request::kPop) {
-    PW_CHECK(drain.reader_.PopFront().ok());
-    drain.last_handled_sequence_id_ = entry_sequence_id_out;
-  }
-  return as_bytes(buffer.first(bytes_read));
 }
 
 void MultiSink::AttachDrain(Drain& drain)
@@ -172,6 +394,24 @@ void MultiSink::DetachDrain(Drain& drain) {
               "The drain wasn't already attached.");
 }
 
+void MultiSink::AttachProducer(Producer& producer) {
+  std::lock_guard lock(lock_);
+  PW_DCHECK_PTR_EQ(producer.multisink_, nullptr);
+  PW_DCHECK_UINT_GT(producer.buffer_.size(), sizeof(Producer::EntrySize));
+  producer.multisink_ = this;
+  producers_.push_back(producer);
+}
+
+void MultiSink::DetachProducer(Producer& producer) {
+  std::lock_guard lock(lock_);
+  PW_DCHECK_PTR_EQ(producer.multisink_, this);
+  MergeProducer(producer);
+  NotifyListeners();
+  [[maybe_unused]] bool was_detached = producers_.remove(producer);
+  PW_DCHECK(was_detached, "The producer was not attached.");
+  producer.multisink_ = nullptr;
+}
+
 void MultiSink::AttachListener(Listener& listener) {
   std::lock_guard lock(lock_);
   listeners_.push_back(listener);
@@ -297,6 +537,42 @@ Result<MultiSink::Drain::PeekedEntry> MultiSink::Drain::PeekEntry(
   return PeekedEntry(peek_result.value(), entry_sequence_id_out);
 }
 
+Result<MultiSink::Drain::PeekedEntries> MultiSink::Drain::PeekEntries(
+    ByteSpan buffer,
+    uint32_t& drain_drop_count_out,
+    uint32_t& ingress_drop_count_out) {
+  PW_DCHECK_NOTNULL(multisink_);
+  return multisink_->PeekEntries(
+      *this, buffer, drain_drop_count_out, ingress_drop_count_out);
+}
+
+Status MultiSink::Drain::PopEntries(const PeekedEntry& last_entry) {
+  PW_DCHECK_NOTNULL(multisink_);
+  return multisink_->PopEntries(*this, last_entry);
+}
+
+MultiSink::Drain::PeekedEntry MultiSink::Drain::PeekedEntries::Read(
+    size_t offset) const {
+  if (!prefixed_) {
+    return PeekedEntry(entries_, sequence_id_);
+  }
+  uint64_t sequence_id = 0;
+  uint64_t entry_size = 0;
+  const size_t sequence_id_bytes =
+      varint::Decode(entries_.subspan(offset), &sequence_id);
+  const size_t size_bytes = varint::Decode(
+      entries_.subspan(offset + sequence_id_bytes), &entry_size);
+  PW_DCHECK(sequence_id_bytes != 0u && size_bytes != 0u);
+  return PeekedEntry(entries_.subspan(offset + sequence_id_bytes + size_bytes,
+                                      static_cast<size_t>(entry_size)),
+                     static_cast<uint32_t>(sequence_id));
+}
+
+size_t MultiSink::Drain::PeekedEntries::NextOffset(size_t offset) const {
+  const ConstByteSpan entry = Read(offset).entry();
+  return static_cast<size_t>(entry.data() + entry.size() - entries_.data());
+}
+
 Result<ConstByteSpan> MultiSink::Drain::PopEntry(
     ByteSpan buffer,
     uint32_t& drain_drop_count_out,
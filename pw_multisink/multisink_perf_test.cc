@@ -0,0 +1,102 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures the time for several threads to write entries to one MultiSink,
+// either with MultiSink::HandleEntry, which takes the multisink's lock for
+// every entry, or with a MultiSink::Producer per thread.
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+#include "pw_bytes/span.h"
+#include "pw_multisink/multisink.h"
+#include "pw_multisink/test_thread.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_thread/thread.h"
+#include "pw_thread/thread_core.h"
+
+namespace pw::multisink {
+namespace {
+
+constexpr size_t kMaxThreads = 16;
+constexpr size_t kEntriesPerThread = 1000;
+constexpr size_t kEntrySize = 32;
+
+std::array<std::byte, 64 * 1024> multisink_buffer;
+
+class WriterThread : public thread::ThreadCore {
+ public:
+  WriterThread() : producer_(producer_buffer_) { entry_.fill(std::byte{'a'}); }
+
+  void Start(MultiSink& multisink, bool use_producer) {
+    multisink_ = &multisink;
+    use_producer_ = use_producer;
+    thread_.emplace(test::MultiSinkTestThreadOptions(), *this);
+  }
+
+  void Join() { thread_->join(); }
+
+ private:
+  void Run() override {
+    if (!use_producer_) {
+      for (size_t i = 0; i < kEntriesPerThread; ++i) {
+        multisink_->HandleEntry(entry_);
+      }
+      return;
+    }
+
+    multisink_->AttachProducer(producer_);
+    for (size_t i = 0; i < kEntriesPerThread; ++i) {
+      producer_.HandleEntry(entry_);
+    }
+    multisink_->DetachProducer(producer_);
+  }
+
+  MultiSink* multisink_ = nullptr;
+  bool use_producer_ = false;
+  std::array<std::byte, kEntrySize> entry_;
+  std::array<std::byte, 4096> producer_buffer_;
+  MultiSink::Producer producer_;
+  std::optional<Thread> thread_;
+};
+
+std::array<WriterThread, kMaxThreads> writers;
+
+// Writes kEntriesPerThread entries from each of `threads` threads.
+void IngestTest(perf_test::State& state, size_t threads, bool use_producer) {
+  MultiSink multisink(multisink_buffer);
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < threads; ++i) {
+      writers[i].Start(multisink, use_producer);
+    }
+    for (size_t i = 0; i < threads; ++i) {
+      writers[i].Join();
+    }
+  }
+}
+
+PW_PERF_TEST(HandleEntry1Thread, IngestTest, 1, false);
+PW_PERF_TEST(Producer1Thread, IngestTest, 1, true);
+PW_PERF_TEST(HandleEntry2Threads, IngestTest, 2, false);
+PW_PERF_TEST(Producer2Threads, IngestTest, 2, true);
+PW_PERF_TEST(HandleEntry4Threads, IngestTest, 4, false);
+PW_PERF_TEST(Producer4Threads, IngestTest, 4, true);
+PW_PERF_TEST(HandleEntry8Threads, IngestTest, 8, false);
+PW_PERF_TEST(Producer8Threads, IngestTest, 8, true);
+PW_PERF_TEST(HandleEntry16Threads, IngestTest, 16, false);
+PW_PERF_TEST(Producer16Threads, IngestTest, 16, true);
+
+}  // namespace
+}  // namespace pw::multisink
@@ -493,6 +493,143 @@ TEST_F(MultiSinkTest, PeekReportsSlowDrainDropCount) {
                    0);
 }
 
+// Collects the entries of a batch into `entries_out`.
+void CollectEntries(const Drain::PeekedEntries& entries,
+                    std::array<ConstByteSpan, 4>& entries_out,
+                    size_t& count_out) {
+  count_out = 0;
+  for (const Drain::PeekedEntry& entry : entries) {
+    ASSERT_LT(count_out, entries_out.size());
+    entries_out[count_out++] = entry.entry();
+  }
+}
+
+bool EntryEquals(ConstByteSpan entry, ConstByteSpan expected) {
+  return entry.size() == expected.size() &&
+         std::memcmp(entry.data(), expected.data(), entry.size()) == 0;
+}
+
+TEST_F(MultiSinkTest, PeekEntries) {
+  multisink_.AttachDrain(drains_[0]);
+
+  uint32_t drop_count = 0;
+  uint32_t ingress_drop_count = 0;
+  EXPECT_EQ(
+      drains_[0].PeekEntries(entry_buffer_, drop_count, ingress_drop_count)
+          .status(),
+      Status::OutOfRange());
+
+  multisink_.HandleEntry(kMessage);
+  multisink_.HandleEntry(kMessageOther);
+  multisink_.HandleEntry(kMessage);
+
+  Result<Drain::PeekedEntries> peeked =
+      drains_[0].PeekEntries(entry_buffer_, drop_count, ingress_drop_count);
+  ASSERT_EQ(peeked.status(), OkStatus());
+  EXPECT_EQ(drop_count, 0u);
+  EXPECT_EQ(ingress_drop_count, 0u);
+  ASSERT_EQ(peeked->size(), 3u);
+
+  std::array<ConstByteSpan, 4> entries;
+  size_t count = 0;
+  CollectEntries(*peeked, entries, count);
+  ASSERT_EQ(count, 3u);
+  EXPECT_TRUE(EntryEquals(entries[0], kMessage));
+  EXPECT_TRUE(EntryEquals(entries[1], kMessageOther));
+  EXPECT_TRUE(EntryEquals(entries[2], kMessage));
+  EXPECT_TRUE(EntryEquals(peeked->back().entry(), kMessage));
+
+  // Peeking does not advance the drain.
+  EXPECT_EQ(drains_[0].GetUnreadEntriesCount(), 3u);
+  EXPECT_EQ(drains_[0].PopEntries(peeked->back()), OkStatus());
+  EXPECT_EQ(drains_[0].GetUnreadEntriesCount(), 0u);
+
+  // Popping entries already handled must not trigger errors.
+  EXPECT_EQ(drains_[0].PopEntries(peeked->back()), OkStatus());
+  VerifyPopEntry(drains_[0], std::nullopt, 0, 0);
+}
+
+TEST_F(MultiSinkTest, PopEntriesPartOfBatch) {
+  multisink_.AttachDrain(drains_[0]);
+  multisink_.HandleEntry(kMessage);
+  multisink_.HandleEntry(kMessageOther);
+
+  uint32_t drop_count = 0;
+  uint32_t ingress_drop_count = 0;
+  Result<Drain::PeekedEntries> peeked =
+      drains_[0].PeekEntries(entry_buffer_, drop_count, ingress_drop_count);
+  ASSERT_EQ(peeked.status(), OkStatus());
+  ASSERT_EQ(peeked->size(), 2u);
+
+  // Only pop the first entry of the batch.
+  EXPECT_EQ(drains_[0].PopEntries(*peeked->begin()), OkStatus());
+  VerifyPopEntry(drains_[0], kMessageOther, 0, 0);
+}
+
+TEST_F(MultiSinkTest, PeekEntriesStopsAtIngressDrop) {
+  multisink_.AttachDrain(drains_[0]);
+  multisink_.HandleEntry(kMessage);
+  multisink_.HandleEntry(kMessage);
+  const uint32_t ingress_drops = 3;
+  multisink_.HandleDropped(ingress_drops);
+  multisink_.HandleEntry(kMessageOther);
+
+  // The batch ends before the gap in sequence IDs.
+  uint32_t drop_count = 0;
+  uint32_t ingress_drop_count = 0;
+  Result<Drain::PeekedEntries> peeked =
+      drains_[0].PeekEntries(entry_buffer_, drop_count, ingress_drop_count);
+  ASSERT_EQ(peeked.status(), OkStatus());
+  EXPECT_EQ(peeked->size(), 2u);
+  EXPECT_EQ(drop_count, 0u);
+  EXPECT_EQ(ingress_drop_count, 0u);
+  ASSERT_EQ(drains_[0].PopEntries(peeked->back()), OkStatus());
+
+  // The drops are reported before the next batch.
+  peeked =
+      drains_[0].PeekEntries(entry_buffer_, drop_count, ingress_drop_count);
+  ASSERT_EQ(peeked.status(), OkStatus());
+  ASSERT_EQ(peeked->size(), 1u);
+  EXPECT_TRUE(EntryEquals(peeked->back().entry(), kMessageOther));
+  EXPECT_EQ(drop_count, 0u);
+  EXPECT_EQ(ingress_drop_count, ingress_drops);
+}
+
+TEST_F(MultiSinkTest, PeekEntriesLimitedByBuffer) {
+  multisink_.AttachDrain(drains_[0]);
+  multisink_.HandleEntry(kMessage);
+  multisink_.HandleEntry(kMessageOther);
+
+  // Each entry takes a byte for its sequence ID and a byte for its size.
+  constexpr size_t kEntrySize = sizeof(kMessage) + 2;
+  uint32_t drop_count = 0;
+  uint32_t ingress_drop_count = 0;
+  Result<Drain::PeekedEntries> peeked =
+      drains_[0].PeekEntries(span(entry_buffer_).first(2 * kEntrySize - 1),
+                             drop_count,
+                             ingress_drop_count);
+  ASSERT_EQ(peeked.status(), OkStatus());
+  ASSERT_EQ(peeked->size(), 1u);
+  EXPECT_TRUE(EntryEquals(peeked->back().entry(), kMessage));
+
+  // An entry that only fits without its sequence ID and size is still read.
+  peeked = drains_[0].PeekEntries(span(entry_buffer_).first(sizeof(kMessage)),
+                                  drop_count,
+                                  ingress_drop_count);
+  ASSERT_EQ(peeked.status(), OkStatus());
+  ASSERT_EQ(peeked->size(), 1u);
+  EXPECT_TRUE(EntryEquals(peeked->back().entry(), kMessage));
+
+  // An entry that does not fit at all is discarded.
+  EXPECT_EQ(drains_[0]
+                .PeekEntries(span(entry_buffer_).first(sizeof(kMessage) - 1),
+                             drop_count,
+                             ingress_drop_count)
+                .status(),
+            Status::ResourceExhausted());
+  VerifyPopEntry(drains_[0], kMessageOther, 1, 0);
+}
+
 TEST_F(MultiSinkTest, IngressDropCountOverflow) {
   multisink_.AttachDrain(drains_[0]);
 
@@ -583,6 +720,106 @@ TEST_F(MultiSinkTest, DrainUnreadEntriesSize) {
   EXPECT_EQ(drains_[1].GetUnreadEntriesCount(), 2u);
 }
 
+TEST_F(MultiSinkTest, Producer_EntriesAndDrops) {
+  std::byte producer_buffer[64];
+  MultiSink::Producer producer(producer_buffer);
+  multisink_.AttachProducer(producer);
+  multisink_.AttachDrain(drains_[0]);
+  multisink_.AttachListener(listeners_[0]);
+  ExpectNotificationCount(listeners_[0], 1u);
+
+  producer.HandleEntry(kMessage);
+  producer.HandleDropped(2);
+  producer.HandleEntry(kMessageOther);
+  multisink_.HandleEntry(kMessage);
+  ExpectNotificationCount(listeners_[0], 4u);
+
+  VerifyPopEntry(drains_[0], kMessage, 0u, 0u);
+  VerifyPopEntry(drains_[0], kMessageOther, 0u, 2u);
+  VerifyPopEntry(drains_[0], kMessage, 0u, 0u);
+  VerifyPopEntry(drains_[0], std::nullopt, 0u, 0u);
+
+  multisink_.DetachProducer(producer);
+}
+
+TEST_F(MultiSinkTest, Producer_WrapsAroundBuffer) {
+  std::byte producer_buffer[21];
+  MultiSink::Producer producer(producer_buffer);
+  multisink_.AttachProducer(producer);
+  multisink_.AttachDrain(drains_[0]);
+
+  // Each entry takes 8 bytes in the producer's buffer, so the buffer wraps at
+  // a different offset each time.
+  for (size_t i = 0; i < 10; ++i) {
+    producer.HandleEntry(i % 2 == 0 ? kMessage : kMessageOther);
+    VerifyPopEntry(drains_[0], i % 2 == 0 ? kMessage : kMessageOther, 0u, 0u);
+  }
+
+  multisink_.DetachProducer(producer);
+}
+
+TEST_F(MultiSinkTest, Producer_EntryLargerThanBuffer_Dropped) {
+  std::byte producer_buffer[7];
+  MultiSink::Producer producer(producer_buffer);
+  multisink_.AttachProducer(producer);
+  multisink_.AttachDrain(drains_[0]);
+
+  producer.HandleEntry(kMessage);
+  producer.HandleEntry(ConstByteSpan());
+  VerifyPopEntry(drains_[0], ConstByteSpan(), 0u, 1u);
+  VerifyPopEntry(drains_[0], std::nullopt, 0u, 0u);
+
+  multisink_.DetachProducer(producer);
+}
+
+// Writes to a second producer while the multisink notifies listeners. At that
+// point a merge is in progress, so the entry is only staged.
+class ProducingListener : public Listener {
+ public:
+  ProducingListener(MultiSink::Producer& producer, ConstByteSpan entry)
+      : producer_(producer), entry_(entry) {}
+
+  size_t entries_to_produce = 0;
+
+ private:
+  void OnNewEntryAvailable() override {
+    while (entries_to_produce > 0) {
+      entries_to_produce -= 1;
+      producer_.HandleEntry(entry_);
+    }
+  }
+
+  MultiSink::Producer& producer_;
+  ConstByteSpan entry_;
+};
+
+TEST_F(MultiSinkTest, Producer_StagedDuringMerge_MergedBeforeReturning) {
+  std::byte first_buffer[64];
+  std::byte second_buffer[32];
+  MultiSink::Producer first(first_buffer);
+  MultiSink::Producer second(second_buffer);
+  multisink_.AttachProducer(first);
+  multisink_.AttachProducer(second);
+  multisink_.AttachDrain(drains_[0]);
+
+  ProducingListener listener(second, kMessageOther);
+  multisink_.AttachListener(listener);
+
+  // The second producer's buffer holds 3 entries, so the fourth is dropped.
+  listener.entries_to_produce = 4;
+  first.HandleEntry(kMessage);
+
+  VerifyPopEntry(drains_[0], kMessage, 0u, 0u);
+  VerifyPopEntry(drains_[0], kMessageOther, 0u, 0u);
+  VerifyPopEntry(drains_[0], kMessageOther, 0u, 0u);
+  VerifyPopEntry(drains_[0], kMessageOther, 0u, 0u);
+  VerifyPopEntry(drains_[0], std::nullopt, 0u, 1u);
+
+  multisink_.DetachListener(listener);
+  multisink_.DetachProducer(first);
+  multisink_.DetachProducer(second);
+}
+
 TEST(UnsafeGetUnreadEntriesSize, ReadFromListener) {
   std::array<std::byte, 32> buffer;
   MultiSink multisink(buffer);
@@ -12,6 +12,7 @@
 // License for the specific language governing permissions and limitations under
 // the License.
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 
@@ -185,6 +186,31 @@ class LogWriterThread : public thread::ThreadCore {
   const MessageSpan& message_stack_;
 };
 
+// Adds the provided messages to the shared multisink through a producer with
+// its own staging buffer.
+class LogProducerThread : public thread::ThreadCore {
+ public:
+  LogProducerThread(MultiSink& multisink, const MessageSpan& message_stack)
+      : multisink_(multisink),
+        message_stack_(message_stack),
+        producer_(producer_buffer_) {}
+
+  void Run() override {
+    multisink_.AttachProducer(producer_);
+    for (const auto& message : message_stack_) {
+      producer_.HandleEntry(as_bytes(span(std::string_view(message))));
+      pw::this_thread::yield();
+    }
+    multisink_.DetachProducer(producer_);
+  }
+
+ private:
+  MultiSink& multisink_;
+  const MessageSpan& message_stack_;
+  std::array<std::byte, kBufferSize> producer_buffer_;
+  MultiSink::Producer producer_;
+};
+
 class MultiSinkTest : public ::testing::Test {
  protected:
   MultiSinkTest() : buffer_{}, multisink_(buffer_) {}
@@ -331,6 +357,45 @@ TEST_F(MultiSinkTest, MultipleWritersMultipleReaders) {
             expected_message_and_drop_count - drop_count);
 }
 
+TEST_F(MultiSinkTest, MultipleProducersMultipleReaders) {
+  const uint32_t log_count = 100;
+  const uint32_t drop_count = 7;
+  const uint32_t expected_message_and_drop_count = 2 * log_count + drop_count;
+  const auto message_stack = MessagePool::Instance().GetMessages(log_count);
+
+  // Start reader threads.
+  LogPopReaderThread reader_thread_core1(multisink_,
+                                         expected_message_and_drop_count);
+  Thread reader_thread1(test::MultiSinkTestThreadOptions(),
+                        reader_thread_core1);
+  LogPeekAndCommitReaderThread reader_thread_core2(
+      multisink_, expected_message_and_drop_count);
+  Thread reader_thread2(test::MultiSinkTestThreadOptions(),
+                        reader_thread_core2);
+  // Start producer threads.
+  LogProducerThread producer_thread_core1(multisink_, message_stack);
+  Thread producer_thread1(test::MultiSinkTestThreadOptions(),
+                          producer_thread_core1);
+  LogProducerThread producer_thread_core2(multisink_, message_stack);
+  Thread producer_thread2(test::MultiSinkTestThreadOptions(),
+                          producer_thread_core2);
+
+  // Wait for producer threads to end.
+  producer_thread1.join();
+  producer_thread2.join();
+  multisink_.HandleDropped(drop_count);
+  reader_thread1.join();
+  reader_thread2.join();
+
+  // Each producer's buffer holds all of its messages, so none are dropped.
+  EXPECT_EQ(reader_thread_core1.drop_count(), drop_count);
+  EXPECT_EQ(reader_thread_core2.drop_count(), drop_count);
+  EXPECT_EQ(reader_thread_core1.received_messages().size(),
+            expected_message_and_drop_count - drop_count);
+  EXPECT_EQ(reader_thread_core2.received_messages().size(),
+            expected_message_and_drop_count - drop_count);
+}
+
 TEST_F(MultiSinkTest, OverflowMultisink) {
   // Expect the multisink to overflow and readers to not fail when poping, or
   // peeking and commiting entries.
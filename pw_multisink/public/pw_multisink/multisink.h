@@ -13,6 +13,8 @@
 // the License.
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <limits>
 #include <mutex>
 
@@ -41,6 +43,8 @@ class MultiSink {
   // entry sequence information for clients when popping.
   class Drain {
    public:
+    class PeekedEntries;
+
     // Holds the context for a peeked entry, tha the user may pass to `PopEntry`
     // to advance the drain.
     class PeekedEntry {
@@ -51,6 +55,7 @@ class MultiSink {
      private:
       friend MultiSink;
       friend MultiSink::Drain;
+      friend PeekedEntries;
 
       constexpr PeekedEntry(ConstByteSpan entry, uint32_t sequence_id)
           : entry_(entry), sequence_id_(sequence_id) {}
@@ -61,6 +66,90 @@ class MultiSink {
       const uint32_t sequence_id_;
     };
 
+    // Holds a batch of consecutive entries copied out of the multisink by
+    // `PeekEntries`. Iterating over the batch yields a PeekedEntry for each
+    // entry, oldest first. The user may pass `back()`, or any entry before it,
+    // to `PopEntries` to advance the drain past the entries handled.
+    class PeekedEntries {
+     public:
+      class iterator {
+       public:
+        constexpr iterator() : entries_(nullptr), offset_(0) {}
+
+        PeekedEntry operator*() const { return entries_->Read(offset_); }
+
+        iterator& operator++() {
+          offset_ = entries_->NextOffset(offset_);
+          return *this;
+        }
+        iterator operator++(int) {
+          iterator original = *this;
+          ++*this;
+          return original;
+        }
+
+        constexpr bool operator==(const iterator& rhs) const {
+          return offset_ == rhs.offset_;
+        }
+        constexpr bool operator!=(const iterator& rhs) const {
+          return offset_ != rhs.offset_;
+        }
+
+       private:
+        friend PeekedEntries;
+
+        constexpr iterator(const PeekedEntries& entries, size_t offset)
+            : entries_(&entries), offset_(offset) {}
+
+        const PeekedEntries* entries_;
+        size_t offset_;
+      };
+
+      iterator begin() const { return iterator(*this, 0); }
+      iterator end() const { return iterator(*this, entries_.size()); }
+
+      // Returns the newest entry in the batch.
+      //
+      // Precondition: The batch must not be empty.
+      PeekedEntry back() const { return Read(back_offset_); }
+
+      // Returns the number of entries in the batch.
+      size_t size() const { return size_; }
+      bool empty() const { return size_ == 0; }
+
+     private:
+      friend MultiSink;
+
+      constexpr PeekedEntries(ConstByteSpan entries,
+                              size_t size,
+                              size_t back_offset)
+          : entries_(entries),
+            size_(size),
+            back_offset_(back_offset),
+            prefixed_(true),
+            sequence_id_(0) {}
+
+      // A batch of one entry that only fit in the buffer without its prefix.
+      constexpr PeekedEntries(ConstByteSpan entry, uint32_t sequence_id)
+          : entries_(entry),
+            size_(1),
+            back_offset_(0),
+            prefixed_(false),
+            sequence_id_(sequence_id) {}
+
+      // Entries are stored as they are in the multisink's ring buffer, each
+      // prefixed by its varint-encoded sequence ID and size. These read the
+      // entry at `offset` and find the offset of the entry after it.
+      PeekedEntry Read(size_t offset) const;
+      size_t NextOffset(size_t offset) const;
+
+      ConstByteSpan entries_;
+      size_t size_;
+      size_t back_offset_;
+      bool prefixed_;
+      uint32_t sequence_id_;
+    };
+
     constexpr Drain()
         : last_handled_sequence_id_(0),
           last_peek_sequence_id_(0),
@@ -198,6 +287,39 @@ class MultiSink {
                                   uint32_t& ingress_drop_count_out)
         PW_LOCKS_EXCLUDED(multisink_->lock_);
 
+    // Copies as many of the next available entries as fit in the provided
+    // buffer with a single acquisition of the multisink's lock, without moving
+    // the drain forward. Entries are copied until one does not fit or there is
+    // a gap in the sequence of entries, so that the drop counts, which follow
+    // the same logic as `PeekEntry`, all precede the first entry of the batch.
+    // The user must call `PopEntries` once the peeked entries are handled.
+    //
+    // Precondition: the buffer data must not be corrupt, otherwise there will
+    // be a crash.
+    //
+    // Return values:
+    // OK - At least one entry was successfully read from the multisink.
+    // OUT_OF_RANGE - No entries were available.
+    // FAILED_PRECONDITION - The drain must be attached to a sink.
+    // RESOURCE_EXHAUSTED - The provided buffer was not large enough to store
+    // the next available entry, which was discarded.
+    Result<PeekedEntries> PeekEntries(ByteSpan buffer,
+                                      uint32_t& drain_drop_count_out,
+                                      uint32_t& ingress_drop_count_out)
+        PW_LOCKS_EXCLUDED(multisink_->lock_);
+
+    // Removes the previously peeked entries up to and including `last_entry`
+    // from the multisink with a single acquisition of the multisink's lock.
+    //
+    // Precondition: the buffer data must not be corrupt, otherwise there will
+    // be a crash.
+    //
+    // Return values:
+    // OK - the entries were removed from the multisink successfully.
+    // FAILED_PRECONDITION - The drain must be attached to a sink.
+    Status PopEntries(const PeekedEntry& last_entry)
+        PW_LOCKS_EXCLUDED(multisink_->lock_);
+
     // Drains are not copyable or movable.
     Drain(const Drain&) = delete;
     Drain& operator=(const Drain&) = delete;
@@ -239,6 +361,70 @@ class MultiSink {
     MultiSink* multisink_;
   };
 
+  // A producer that stages entries in its own buffer, attached via
+  // AttachProducer. Entries are copied into the producer's buffer without
+  // taking the multisink's lock, and later merged into the multisink by
+  // whichever producer finds no merge in progress. Each thread that writes to
+  // the multisink should use its own Producer, so that threads do not contend
+  // on the multisink's lock for every entry.
+  //
+  // Sequence IDs are assigned when staged entries are merged, so entries from
+  // one producer stay in order, and entries from different producers are
+  // interleaved in the order they are merged. Entries that do not fit in the
+  // producer's buffer are reported to drains as ingress drops.
+  class Producer : public IntrusiveList<Producer>::Item {
+   public:
+    explicit constexpr Producer(ByteSpan buffer)
+        : buffer_(buffer),
+          read_offset_(0),
+          write_offset_(0),
+          staged_drops_(0),
+          multisink_(nullptr) {}
+
+    // Producers are not copyable or movable.
+    Producer(const Producer&) = delete;
+    Producer& operator=(const Producer&) = delete;
+    Producer(Producer&&) = delete;
+    Producer& operator=(Producer&&) = delete;
+
+    // Stages an entry and merges staged entries into the multisink, unless
+    // another producer is already merging, in which case that producer merges
+    // this entry before it finishes. The entry is dropped if the producer's
+    // buffer is full.
+    //
+    // Precondition: The producer must be attached to a multisink, and must not
+    // be used by more than one thread at a time.
+    void HandleEntry(ConstByteSpan entry);
+
+    // Notifies the multisink of messages dropped before ingress, as
+    // MultiSink::HandleDropped does.
+    //
+    // Precondition: The producer must be attached to a multisink.
+    void HandleDropped(uint32_t drop_count = 1);
+
+   private:
+    friend MultiSink;
+
+    // Staged entries are prefixed with their size. An entry is never split
+    // across the end of the buffer; kWrapMarker in place of a size indicates
+    // that the next entry is at the start of the buffer.
+    using EntrySize = uint32_t;
+    static constexpr EntrySize kWrapMarker =
+        std::numeric_limits<EntrySize>::max();
+
+    // Copies an entry into the buffer. Returns false if it does not fit.
+    bool Stage(ConstByteSpan entry);
+
+    // Offsets in buffer_ of the next entry to merge and the next entry to
+    // stage. Only the producer's thread advances write_offset_, and only a
+    // thread holding the multisink's lock advances read_offset_.
+    ByteSpan buffer_;
+    std::atomic<size_t> read_offset_;
+    std::atomic<size_t> write_offset_;
+    std::atomic<uint32_t> staged_drops_;
+    MultiSink* multisink_;
+  };
+
   // A pure-virtual listener of a MultiSink, attached via AttachListener.
   // MultiSink's invoke listeners when new data arrives, allowing them to
   // schedule the draining of messages out of the MultiSink.
@@ -354,7 +540,8 @@ class MultiSink {
 #endif
         ring_buffer_(true),
         sequence_id_(0),
-        total_ingress_drops_(0) {
+        total_ingress_drops_(0),
+        pending_merges_(0) {
     PW_ASSERT(ring_buffer_.SetBuffer(buffer).ok());
     AttachDrain(oldest_entry_drain_);
   }
@@ -391,6 +578,19 @@ class MultiSink {
   // Precondition: The drain must be attached to this multisink.
   void DetachDrain(Drain& drain) PW_LOCKS_EXCLUDED(lock_);
 
+  // Attaches a producer to the multisink. Producers may not be attached to
+  // more than one multisink at a time.
+  //
+  // Precondition: The producer must not be attached to a multisink.
+  void AttachProducer(Producer& producer) PW_LOCKS_EXCLUDED(lock_);
+
+  // Merges any entries staged by the producer and detaches it from the
+  // multisink.
+  //
+  // Precondition: The producer must be attached to this multisink, and must not
+  // be in use by another thread.
+  void DetachProducer(Producer& producer) PW_LOCKS_EXCLUDED(lock_);
+
   // Attach a listener to the multisink. The listener will be notified
   // immediately when attached, to allow late drain users to consume existing
   // entries. If draining in response to the notification, ensure that the drain
@@ -444,6 +644,20 @@ class MultiSink {
   Status PopEntry(Drain& drain, const Drain::PeekedEntry& entry)
       PW_LOCKS_EXCLUDED(lock_);
 
+  // Removes the previously peeked entries up to and including `last_entry`
+  // from the front of the multisink.
+  Status PopEntries(Drain& drain, const Drain::PeekedEntry& last_entry)
+      PW_LOCKS_EXCLUDED(lock_);
+
+  // Copies the next consecutive entries that fit in `buffer` from the provided
+  // drain, without removing them. Drop counts are computed as in
+  // PeekOrPopEntry, for the first entry of the batch.
+  Result<Drain::PeekedEntries> PeekEntries(Drain& drain,
+                                           ByteSpan buffer,
+                                           uint32_t& drain_drop_count_out,
+                                           uint32_t& ingress_drop_count_out)
+      PW_LOCKS_EXCLUDED(lock_);
+
   // Gets a copy of the entry from the provided drain and unpacks sequence ID
   // information. The entry is removed from the multisink when `request` is set
   // to `Request::kPop`. Drains use this API to strip away sequence ID
@@ -469,15 +683,38 @@ class MultiSink {
       PW_LOCKS_EXCLUDED(lock_);
 
  private:
+  // Computes the drops a drain has not yet handled before the entry with
+  // `entry_sequence_id`, or before the next entry if `entry_available` is
+  // false, and marks ingress drops as handled.
+  void ComputeDropCounts(Drain& drain,
+                         uint32_t entry_sequence_id,
+                         bool entry_available,
+                         uint32_t& drain_drop_count_out,
+                         uint32_t& ingress_drop_count_out)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
   // Notifies attached listeners of new entries or an updated drop count.
   void NotifyListeners() PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
+  // Merges staged entries from all producers, unless another thread is already
+  // doing so. Called by producers after staging an entry or a drop.
+  void MergeStagedEntries() PW_LOCKS_EXCLUDED(lock_);
+
+  // Moves the entries and drops staged by one producer into the ring buffer.
+  void MergeProducer(Producer& producer) PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
   LockType lock_;
   IntrusiveList<Listener> listeners_ PW_GUARDED_BY(lock_);
+  IntrusiveList<Producer> producers_ PW_GUARDED_BY(lock_);
   ring_buffer::PrefixedEntryRingBufferMulti ring_buffer_ PW_GUARDED_BY(lock_);
   Drain oldest_entry_drain_ PW_GUARDED_BY(lock_);
   uint32_t sequence_id_ PW_GUARDED_BY(lock_);
   uint32_t total_ingress_drops_ PW_GUARDED_BY(lock_);
+
+  // The number of times producers have staged entries or drops that were not
+  // yet merged. The producer that increments it from zero merges until it
+  // returns to zero.
+  std::atomic<uint32_t> pending_merges_;
 };
 
 }  // namespace multisink
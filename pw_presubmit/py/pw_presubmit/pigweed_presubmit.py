@@ -209,6 +209,7 @@ def _gn_platform_build_check_targets() -> Sequence[str]:
     # TODO: b/269354373 - clang is not supported on windows yet
     if sys.platform != 'win32':
         build_targets.append('host_clang_debug_dynamic_allocation')
+        build_targets.append('host_clang_debug_rpc_channel_locks')
 
     return build_targets
 
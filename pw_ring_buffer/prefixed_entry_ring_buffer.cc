@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <limits>
 #include <optional>
 #include <utility>
 
@@ -30,9 +31,25 @@ namespace ring_buffer {
 using std::byte;
 using Reader = PrefixedEntryRingBufferMulti::Reader;
 using ReadOutput = PrefixedEntryRingBuffer::ReadOutput;
+using Reservation = PrefixedEntryRingBufferMulti::Reservation;
+
+namespace {
+
+// Encodes value as a varint that fills all of output, padding it with
+// continuation bytes if needed. The padded varint decodes to the same value.
+void EncodePaddedVarint(uint32_t value, span<byte> output) {
+  for (size_t i = 0; i + 1 < output.size(); ++i) {
+    output[i] = static_cast<byte>((value & 0x7fu) | 0x80u);
+    value >>= 7;
+  }
+  output.back() = static_cast<byte>(value);
+}
+
+}  // namespace
 
 void PrefixedEntryRingBufferMulti::Clear() {
   write_idx_ = 0;
+  reserved_bytes_ = 0;
   for (Reader& reader : readers_) {
     reader.read_idx_ = 0;
     reader.entry_count_ = 0;
@@ -111,7 +128,7 @@ Status PrefixedEntryRingBufferMulti::InternalPushBack(
     span<const byte> data,
     uint32_t user_preamble_data,
     bool pop_front_if_needed) {
-  if (buffer_ == nullptr) {
+  if (buffer_ == nullptr || reserved_bytes_ != 0) {
     return Status::FailedPrecondition();
   }
 
@@ -128,6 +145,89 @@ Status PrefixedEntryRingBufferMulti::InternalPushBack(
                                span(preamble_buf).subspan(user_preamble_bytes));
   size_t total_write_bytes =
       user_preamble_bytes + length_bytes + data.size_bytes();
+  PW_TRY(InternalMakeSpace(total_write_bytes, pop_front_if_needed));
+
+  // Write the new entry into the ring buffer.
+  RawWrite(span(preamble_buf, user_preamble_bytes + length_bytes));
+  RawWrite(data);
+
+  // Update all readers of the new count.
+  for (Reader& reader : readers_) {
+    reader.entry_count_++;
+  }
+  return OkStatus();
+}
+
+Result<Reservation> PrefixedEntryRingBufferMulti::InternalReserve(
+    size_t max_size_bytes,
+    uint32_t user_preamble_data,
+    bool pop_front_if_needed) {
+  if (buffer_ == nullptr || reserved_bytes_ != 0) {
+    return Status::FailedPrecondition();
+  }
+  if (max_size_bytes == 0) {
+    return Status::InvalidArgument();
+  }
+  if (max_size_bytes > std::numeric_limits<uint32_t>::max()) {
+    return Status::OutOfRange();
+  }
+
+  // The preamble is written on Commit(), once the entry size is known. Its
+  // size varint is sized for the reserved size.
+  size_t preamble_bytes = varint::EncodedSize(max_size_bytes);
+  if (user_preamble_) {
+    preamble_bytes += varint::EncodedSize(user_preamble_data);
+  }
+  PW_TRY(InternalMakeSpace(preamble_bytes + max_size_bytes,
+                           pop_front_if_needed));
+
+  reserved_bytes_ = max_size_bytes;
+  reserved_user_preamble_ = user_preamble_data;
+
+  // Hand out the data region following the preamble, split in two if it wraps.
+  size_t data_idx = IncrementIndex(write_idx_, preamble_bytes);
+  size_t bytes_until_wrap = buffer_bytes_ - data_idx;
+  size_t first_bytes = std::min(max_size_bytes, bytes_until_wrap);
+  return Reservation{
+      .first = span(buffer_ + data_idx, first_bytes),
+      .second = span(buffer_, max_size_bytes - first_bytes),
+  };
+}
+
+Status PrefixedEntryRingBufferMulti::Commit(size_t size_bytes) {
+  if (reserved_bytes_ == 0) {
+    return Status::FailedPrecondition();
+  }
+  if (size_bytes > reserved_bytes_) {
+    return Status::OutOfRange();
+  }
+
+  // The data is already in place following the preamble, so only the preamble
+  // is written. Its size varint must keep the width it was reserved with.
+  byte preamble_buf[varint::kMaxVarint32SizeBytes * 2];
+  size_t user_preamble_bytes = 0;
+  if (user_preamble_) {
+    user_preamble_bytes =
+        varint::Encode<uint32_t>(reserved_user_preamble_, preamble_buf);
+  }
+  size_t length_bytes = varint::EncodedSize(reserved_bytes_);
+  EncodePaddedVarint(
+      static_cast<uint32_t>(size_bytes),
+      span(preamble_buf).subspan(user_preamble_bytes, length_bytes));
+
+  RawWrite(span(preamble_buf, user_preamble_bytes + length_bytes));
+  write_idx_ = IncrementIndex(write_idx_, size_bytes);
+  reserved_bytes_ = 0;
+
+  // Update all readers of the new count.
+  for (Reader& reader : readers_) {
+    reader.entry_count_++;
+  }
+  return OkStatus();
+}
+
+Status PrefixedEntryRingBufferMulti::InternalMakeSpace(
+    size_t total_write_bytes, bool pop_front_if_needed) {
   if (buffer_bytes_ < total_write_bytes) {
     return Status::OutOfRange();
   }
@@ -142,15 +242,6 @@ Status PrefixedEntryRingBufferMulti::InternalPushBack(
     // TryPushBack() case: don't evict items.
     return Status::ResourceExhausted();
   }
-
-  // Write the new entry into the ring buffer.
-  RawWrite(span(preamble_buf, user_preamble_bytes + length_bytes));
-  RawWrite(data);
-
-  // Update all readers of the new count.
-  for (Reader& reader : readers_) {
-    reader.entry_count_++;
-  }
   return OkStatus();
 }
 
@@ -197,6 +288,38 @@ Status PrefixedEntryRingBufferMulti::InternalPeekFrontWithPreamble(
   return InternalRead(reader, std::move(output), true);
 }
 
+Status PrefixedEntryRingBufferMulti::InternalPeekEntriesWithPreamble(
+    const Reader& reader,
+    span<byte> data,
+    size_t& entries_read_out,
+    size_t& bytes_read_out) const {
+  entries_read_out = 0;
+  bytes_read_out = 0;
+  if (buffer_ == nullptr) {
+    return Status::FailedPrecondition();
+  }
+  if (reader.entry_count_ == 0) {
+    return Status::OutOfRange();
+  }
+
+  // Copy whole entries, each including its preamble, until the next one does
+  // not fit.
+  size_t read_idx = reader.read_idx_;
+  while (entries_read_out < reader.entry_count_) {
+    Result<EntryInfo> info = RawFrontEntryInfo(read_idx);
+    PW_CHECK_OK(info.status());
+    const size_t entry_bytes = info->preamble_bytes + info->data_bytes;
+    if (entry_bytes > data.size_bytes() - bytes_read_out) {
+      break;
+    }
+    RawRead(data.data() + bytes_read_out, read_idx, entry_bytes);
+    read_idx = IncrementIndex(read_idx, entry_bytes);
+    bytes_read_out += entry_bytes;
+    entries_read_out += 1;
+  }
+  return entries_read_out == 0 ? Status::ResourceExhausted() : OkStatus();
+}
+
 Status PrefixedEntryRingBufferMulti::InternalPeekFrontPreamble(
     const Reader& reader, uint32_t& user_preamble_out) const {
   if (reader.entry_count_ == 0) {
@@ -278,7 +401,7 @@ const Reader& PrefixedEntryRingBufferMulti::GetSlowestReader() const {
 }
 
 Status PrefixedEntryRingBufferMulti::Dering() {
-  if (buffer_ == nullptr || readers_.empty()) {
+  if (buffer_ == nullptr || readers_.empty() || reserved_bytes_ != 0) {
     return Status::FailedPrecondition();
   }
 
@@ -0,0 +1,85 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures writing entries that are produced by an encoder, either by encoding
+// into a temporary buffer and passing it to PushBack(), which copies it into
+// the ring buffer, or by encoding directly into a region from Reserve().
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_assert/check.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_preprocessor/compiler.h"
+#include "pw_ring_buffer/prefixed_entry_ring_buffer.h"
+#include "pw_span/span.h"
+
+namespace pw::ring_buffer {
+namespace {
+
+constexpr size_t kEntriesPerIteration = 64;
+
+std::array<std::byte, 4096> ring_buffer_storage;
+
+// Stands in for an encoder writing an entry of output.size() bytes. Not inlined
+// so that both tests run the same encoding code.
+PW_NO_INLINE void Encode(span<std::byte> output, uint32_t seed) {
+  for (std::byte& b : output) {
+    b = static_cast<std::byte>(seed++);
+  }
+}
+
+template <size_t kEntrySize>
+void PushBackTest(perf_test::State& state) {
+  PrefixedEntryRingBufferMulti ring;
+  PW_CHECK_OK(ring.SetBuffer(ring_buffer_storage));
+  uint32_t seed = 0;
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < kEntriesPerIteration; ++i) {
+      std::array<std::byte, kEntrySize> entry;
+      Encode(entry, seed++);
+      PW_CHECK_OK(ring.PushBack(entry));
+    }
+  }
+}
+
+template <size_t kEntrySize>
+void ReserveCommitTest(perf_test::State& state) {
+  PrefixedEntryRingBufferMulti ring;
+  PW_CHECK_OK(ring.SetBuffer(ring_buffer_storage));
+  uint32_t seed = 0;
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < kEntriesPerIteration; ++i) {
+      Result<PrefixedEntryRingBufferMulti::Reservation> reservation =
+          ring.Reserve(kEntrySize);
+      PW_CHECK_OK(reservation.status());
+      Encode(reservation->first, seed);
+      Encode(reservation->second,
+             seed + static_cast<uint32_t>(reservation->first.size()));
+      seed++;
+      PW_CHECK_OK(ring.Commit(kEntrySize));
+    }
+  }
+}
+
+PW_PERF_TEST(PushBack16Bytes, PushBackTest<16>);
+PW_PERF_TEST(ReserveCommit16Bytes, ReserveCommitTest<16>);
+PW_PERF_TEST(PushBack64Bytes, PushBackTest<64>);
+PW_PERF_TEST(ReserveCommit64Bytes, ReserveCommitTest<64>);
+PW_PERF_TEST(PushBack256Bytes, PushBackTest<256>);
+PW_PERF_TEST(ReserveCommit256Bytes, ReserveCommitTest<256>);
+
+}  // namespace
+}  // namespace pw::ring_buffer
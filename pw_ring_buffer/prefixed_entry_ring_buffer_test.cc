@@ -14,6 +14,7 @@
 
 #include "pw_ring_buffer/prefixed_entry_ring_buffer.h"
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -737,6 +738,283 @@ TEST(PrefixedEntryRingBuffer, EntriesSizeWhenBufferFull) {
   EXPECT_EQ(ring.EntriesSize(), ring.TotalSizeBytes());
 }
 
+TEST(PrefixedEntryRingBuffer, PeekEntriesWithPreamble) {
+  PrefixedEntryRingBuffer ring(true);
+  byte test_buffer[single_entry_test_buffer_size];
+  EXPECT_EQ(ring.SetBuffer(test_buffer), OkStatus());
+
+  byte entries[single_entry_test_buffer_size];
+  size_t entry_count = 0;
+  size_t bytes_read = 0;
+  EXPECT_EQ(ring.PeekEntriesWithPreamble(entries, entry_count, bytes_read),
+            Status::OutOfRange());
+
+  // Wrap the buffer so that the peeked entries span its end.
+  constexpr size_t kDataSize = sizeof(single_entry_data) - 1;
+  const span<const byte> data(single_entry_data, kDataSize);
+  for (uint32_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(ring.PushBack(data, i), OkStatus());
+  }
+  EXPECT_EQ(ring.PopFront(), OkStatus());
+  EXPECT_EQ(ring.PopFront(), OkStatus());
+  for (uint32_t i = 3; i < 5; ++i) {
+    EXPECT_EQ(ring.PushBack(data, i), OkStatus());
+  }
+  ASSERT_EQ(ring.EntryCount(), 3u);
+
+  // Entries that do not fit are left out.
+  ASSERT_EQ(ring.PeekEntriesWithPreamble(
+                span(entries, 2 * single_entry_total_size + 1),
+                entry_count,
+                bytes_read),
+            OkStatus());
+  EXPECT_EQ(entry_count, 2u);
+  EXPECT_EQ(bytes_read, 2 * single_entry_total_size);
+
+  ASSERT_EQ(ring.PeekEntriesWithPreamble(entries, entry_count, bytes_read),
+            OkStatus());
+  ASSERT_EQ(entry_count, 3u);
+  ASSERT_EQ(bytes_read, 3 * single_entry_total_size);
+  for (size_t i = 0; i < entry_count; ++i) {
+    const byte* entry = entries + i * single_entry_total_size;
+    EXPECT_EQ(entry[0], byte(2 + i));
+    EXPECT_EQ(entry[1], byte(kDataSize));
+    EXPECT_EQ(std::memcmp(entry + 2, single_entry_data, kDataSize), 0);
+  }
+
+  // Peeking does not remove entries.
+  EXPECT_EQ(ring.EntryCount(), 3u);
+
+  EXPECT_EQ(ring.PeekEntriesWithPreamble(
+                span(entries, single_entry_total_size - 1),
+                entry_count,
+                bytes_read),
+            Status::ResourceExhausted());
+  EXPECT_EQ(entry_count, 0u);
+  EXPECT_EQ(bytes_read, 0u);
+}
+
+// Writes `data` into a reservation, splitting it across both parts.
+void WriteReservation(const PrefixedEntryRingBufferMulti::Reservation& res,
+                      span<const byte> data) {
+  PW_CHECK_UINT_LE(data.size(), res.size_bytes());
+  size_t first_bytes = std::min(data.size(), res.first.size());
+  std::memcpy(res.first.data(), data.data(), first_bytes);
+  std::memcpy(
+      res.second.data(), data.data() + first_bytes, data.size() - first_bytes);
+}
+
+TEST(PrefixedEntryRingBuffer, ReserveCommit) {
+  PrefixedEntryRingBuffer ring;
+  byte test_buffer[kTestBufferSize];
+  EXPECT_EQ(ring.SetBuffer(test_buffer), OkStatus());
+
+  Result<PrefixedEntryRingBuffer::Reservation> reservation =
+      ring.Reserve(sizeof(single_entry_data));
+  ASSERT_EQ(reservation.status(), OkStatus());
+  EXPECT_EQ(reservation->size_bytes(), sizeof(single_entry_data));
+  EXPECT_TRUE(reservation->second.empty());
+  WriteReservation(*reservation, single_entry_data);
+
+  // The entry is not visible to readers until it is committed.
+  EXPECT_EQ(ring.EntryCount(), 0u);
+  EXPECT_EQ(ring.Commit(sizeof(single_entry_data)), OkStatus());
+  EXPECT_EQ(ring.EntryCount(), 1u);
+
+  byte entry_out[sizeof(single_entry_data)];
+  size_t read_size = 0;
+  EXPECT_EQ(ring.PeekFront(entry_out, &read_size), OkStatus());
+  ASSERT_EQ(read_size, sizeof(single_entry_data));
+  EXPECT_EQ(std::memcmp(entry_out, single_entry_data, read_size), 0);
+
+  // A committed entry is stored the same way as a pushed entry.
+  EXPECT_EQ(ring.FrontEntryTotalSizeBytes(), single_entry_total_size);
+  EXPECT_EQ(ring.TotalUsedBytes(), single_entry_total_size);
+}
+
+TEST(PrefixedEntryRingBuffer, ReserveCommitSmallerThanReserved) {
+  PrefixedEntryRingBuffer ring;
+  byte test_buffer[kTestBufferSize];
+  EXPECT_EQ(ring.SetBuffer(test_buffer), OkStatus());
+
+  // Reserve enough to need a two byte size varint, then commit less than 128
+  // bytes, which would normally take one byte.
+  constexpr size_t kReservedSize = 150;
+  static_assert(kReservedSize < kTestBufferSize);
+  Result<PrefixedEntryRingBuffer::Reservation> reservation =
+      ring.Reserve(kReservedSize);
+  ASSERT_EQ(reservation.status(), OkStatus());
+  WriteReservation(*reservation, single_entry_data);
+  EXPECT_EQ(ring.Commit(sizeof(single_entry_data)), OkStatus());
+
+  // The size varint keeps its reserved width and the rest of the reservation
+  // is released.
+  EXPECT_EQ(ring.FrontEntryDataSizeBytes(), sizeof(single_entry_data));
+  EXPECT_EQ(ring.FrontEntryTotalSizeBytes(), sizeof(single_entry_data) + 2);
+  EXPECT_EQ(ring.TotalUsedBytes(), sizeof(single_entry_data) + 2);
+
+  // Entries pushed after the committed entry follow it directly.
+  EXPECT_EQ(ring.PushBack(single_entry_data), OkStatus());
+  EXPECT_EQ(ring.EntryCount(), 2u);
+  for (size_t i = 0; i < 2; ++i) {
+    byte entry_out[sizeof(single_entry_data)];
+    size_t read_size = 0;
+    EXPECT_EQ(ring.PeekFront(entry_out, &read_size), OkStatus());
+    ASSERT_EQ(read_size, sizeof(single_entry_data));
+    EXPECT_EQ(std::memcmp(entry_out, single_entry_data, read_size), 0);
+    EXPECT_EQ(ring.PopFront(), OkStatus());
+  }
+}
+
+TEST(PrefixedEntryRingBuffer, ReserveCommitEmpty) {
+  PrefixedEntryRingBuffer ring;
+  byte test_buffer[kTestBufferSize];
+  EXPECT_EQ(ring.SetBuffer(test_buffer), OkStatus());
+
+  ASSERT_EQ(ring.Reserve(4).status(), OkStatus());
+  EXPECT_EQ(ring.Commit(0), OkStatus());
+  EXPECT_EQ(ring.EntryCount(), 1u);
+  EXPECT_EQ(ring.FrontEntryDataSizeBytes(), 0u);
+}
+
+void ReserveCommitWrapTest(bool user_data) {
+  PrefixedEntryRingBuffer ring(user_data);
+  byte test_buffer[single_entry_test_buffer_size];
+  EXPECT_EQ(ring.SetBuffer(test_buffer), OkStatus());
+
+  // Vary the entry size so that the reserved region starts at, and wraps
+  // around, every position of the buffer.
+  byte data[sizeof(single_entry_data)];
+  for (size_t i = 0; i < kSingleEntryCycles; ++i) {
+    const size_t data_size = 1 + i % sizeof(data);
+    const uint32_t user_preamble = static_cast<uint32_t>(i * 37);
+    for (size_t j = 0; j < data_size; ++j) {
+      data[j] = static_cast<byte>(i + j);
+    }
+
+    Result<PrefixedEntryRingBuffer::Reservation> reservation =
+        ring.Reserve(sizeof(data), user_preamble);
+    ASSERT_EQ(reservation.status(), OkStatus());
+    ASSERT_EQ(reservation->size_bytes(), sizeof(data));
+    WriteReservation(*reservation, span(data, data_size));
+    ASSERT_EQ(ring.Commit(data_size), OkStatus());
+
+    byte entry_out[sizeof(data)];
+    uint32_t user_preamble_out = 0;
+    size_t read_size = 0;
+    ASSERT_EQ(ring.EntryCount(), 1u);
+    ASSERT_EQ(
+        ring.PeekFrontWithPreamble(entry_out, user_preamble_out, read_size),
+        OkStatus());
+    ASSERT_EQ(read_size, data_size);
+    EXPECT_EQ(std::memcmp(entry_out, data, data_size), 0);
+    if (user_data) {
+      EXPECT_EQ(user_preamble_out, user_preamble);
+    }
+    ASSERT_EQ(ring.PopFront(), OkStatus());
+  }
+}
+
+TEST(PrefixedEntryRingBuffer, ReserveCommitWrapNoUserData) {
+  ReserveCommitWrapTest(false);
+}
+
+TEST(PrefixedEntryRingBuffer, ReserveCommitWrapYesUserData) {
+  ReserveCommitWrapTest(true);
+}
+
+TEST(PrefixedEntryRingBuffer, ReserveSplitsWrappedRegion) {
+  PrefixedEntryRingBuffer ring;
+  byte test_buffer[single_entry_test_buffer_size];
+  EXPECT_EQ(ring.SetBuffer(test_buffer), OkStatus());
+
+  // Move the write index so that the next entry's data wraps.
+  constexpr size_t kEntriesBeforeWrap = 3;
+  for (size_t i = 0; i < kEntriesBeforeWrap; ++i) {
+    EXPECT_EQ(ring.PushBack(single_entry_data), OkStatus());
+    EXPECT_EQ(ring.PopFront(), OkStatus());
+  }
+
+  Result<PrefixedEntryRingBuffer::Reservation> reservation =
+      ring.Reserve(sizeof(single_entry_data));
+  ASSERT_EQ(reservation.status(), OkStatus());
+  const size_t write_idx = kEntriesBeforeWrap * single_entry_total_size;
+  const size_t first_bytes = single_entry_test_buffer_size - write_idx - 1;
+  ASSERT_LT(first_bytes, sizeof(single_entry_data));
+  EXPECT_EQ(reservation->first.size(), first_bytes);
+  EXPECT_EQ(reservation->first.data(),
+            test_buffer + write_idx + 1);
+  EXPECT_EQ(reservation->second.size(),
+            sizeof(single_entry_data) - first_bytes);
+  EXPECT_EQ(reservation->second.data(), test_buffer);
+
+  WriteReservation(*reservation, single_entry_data);
+  EXPECT_EQ(ring.Commit(sizeof(single_entry_data)), OkStatus());
+
+  byte entry_out[sizeof(single_entry_data)];
+  size_t read_size = 0;
+  EXPECT_EQ(ring.PeekFront(entry_out, &read_size), OkStatus());
+  ASSERT_EQ(read_size, sizeof(single_entry_data));
+  EXPECT_EQ(std::memcmp(entry_out, single_entry_data, read_size), 0);
+}
+
+TEST(PrefixedEntryRingBuffer, ReserveEvictsOldEntries) {
+  PrefixedEntryRingBuffer ring;
+  byte test_buffer[single_entry_test_buffer_size];
+  EXPECT_EQ(ring.SetBuffer(test_buffer), OkStatus());
+
+  while (ring.TryPushBack(single_entry_data).ok()) {
+  }
+  const size_t full_count = ring.EntryCount();
+
+  EXPECT_EQ(ring.TryReserve(sizeof(single_entry_data)).status(),
+            Status::ResourceExhausted());
+  EXPECT_EQ(ring.EntryCount(), full_count);
+
+  ASSERT_EQ(ring.Reserve(sizeof(single_entry_data)).status(), OkStatus());
+  EXPECT_EQ(ring.EntryCount(), full_count - 1);
+  EXPECT_EQ(ring.Commit(sizeof(single_entry_data)), OkStatus());
+  EXPECT_EQ(ring.EntryCount(), full_count);
+}
+
+TEST(PrefixedEntryRingBuffer, ReserveErrors) {
+  PrefixedEntryRingBuffer ring;
+  EXPECT_EQ(ring.Reserve(1).status(), Status::FailedPrecondition());
+
+  byte test_buffer[kTestBufferSize];
+  EXPECT_EQ(ring.SetBuffer(test_buffer), OkStatus());
+  EXPECT_EQ(ring.Reserve(0).status(), Status::InvalidArgument());
+  EXPECT_EQ(ring.Reserve(kTestBufferSize).status(), Status::OutOfRange());
+  EXPECT_EQ(ring.Commit(0), Status::FailedPrecondition());
+
+  // Writes other than Commit() are rejected while a reservation is
+  // outstanding.
+  ASSERT_EQ(ring.Reserve(8).status(), OkStatus());
+  EXPECT_EQ(ring.Reserve(8).status(), Status::FailedPrecondition());
+  EXPECT_EQ(ring.PushBack(single_entry_data), Status::FailedPrecondition());
+  EXPECT_EQ(ring.TryPushBack(single_entry_data), Status::FailedPrecondition());
+  EXPECT_EQ(ring.Dering(), Status::FailedPrecondition());
+
+  // Committing more than was reserved keeps the reservation.
+  EXPECT_EQ(ring.Commit(9), Status::OutOfRange());
+  EXPECT_EQ(ring.Commit(8), OkStatus());
+  EXPECT_EQ(ring.EntryCount(), 1u);
+
+  // A canceled reservation does not add an entry.
+  ASSERT_EQ(ring.Reserve(8).status(), OkStatus());
+  ring.CancelReservation();
+  EXPECT_EQ(ring.Commit(8), Status::FailedPrecondition());
+  EXPECT_EQ(ring.EntryCount(), 1u);
+  EXPECT_EQ(ring.PushBack(single_entry_data), OkStatus());
+  EXPECT_EQ(ring.EntryCount(), 2u);
+
+  // Clearing the buffer cancels the reservation.
+  ASSERT_EQ(ring.Reserve(8).status(), OkStatus());
+  ring.Clear();
+  EXPECT_EQ(ring.Commit(8), Status::FailedPrecondition());
+  EXPECT_EQ(ring.PushBack(single_entry_data), OkStatus());
+}
+
 TEST(PrefixedEntryRingBufferMulti, TryPushBack) {
   PrefixedEntryRingBufferMulti ring;
   byte test_buffer[kTestBufferSize];
@@ -911,6 +1189,41 @@ TEST(PrefixedEntryRingBufferMulti, PushBack) {
   EXPECT_EQ(fast_reader.EntryCount(), total_items - 1);
 }
 
+TEST(PrefixedEntryRingBufferMulti, ReserveCommit) {
+  PrefixedEntryRingBufferMulti ring;
+  byte test_buffer[kTestBufferSize];
+  EXPECT_EQ(ring.SetBuffer(test_buffer), OkStatus());
+
+  PrefixedEntryRingBufferMulti::Reader fast_reader;
+  PrefixedEntryRingBufferMulti::Reader slow_reader;
+  EXPECT_EQ(ring.AttachReader(fast_reader), OkStatus());
+  EXPECT_EQ(ring.AttachReader(slow_reader), OkStatus());
+
+  EXPECT_EQ(ring.PushBack(single_entry_data), OkStatus());
+
+  // Readers can pop entries while a reservation is outstanding.
+  Result<PrefixedEntryRingBufferMulti::Reservation> reservation =
+      ring.Reserve(sizeof(single_entry_data));
+  ASSERT_EQ(reservation.status(), OkStatus());
+  EXPECT_EQ(fast_reader.PopFront(), OkStatus());
+  WriteReservation(*reservation, single_entry_data);
+  EXPECT_EQ(ring.Commit(sizeof(single_entry_data)), OkStatus());
+
+  EXPECT_EQ(fast_reader.EntryCount(), 1u);
+  EXPECT_EQ(slow_reader.EntryCount(), 2u);
+
+  // Iterating from the slowest reader finds both entries.
+  size_t entries = 0;
+  for (const Entry& entry : ring) {
+    ASSERT_EQ(entry.buffer.size(), sizeof(single_entry_data));
+    EXPECT_EQ(std::memcmp(
+                  entry.buffer.data(), single_entry_data, entry.buffer.size()),
+              0);
+    entries++;
+  }
+  EXPECT_EQ(entries, 2u);
+}
+
 TEST(PrefixedEntryRingBufferMulti, ReaderAddRemove) {
   PrefixedEntryRingBufferMulti ring;
   byte test_buffer[kTestBufferSize];
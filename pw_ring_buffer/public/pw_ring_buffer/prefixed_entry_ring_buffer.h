@@ -124,6 +124,27 @@ class PrefixedEntryRingBufferMulti {
       return buffer_->InternalPeekFrontWithPreamble(*this, std::move(output));
     }
 
+    // Same as PeekFrontWithPreamble, but reads as many whole entries from the
+    // front as fit in the destination span, starting with the oldest. The
+    // number of entries and bytes read are written to entries_read_out and
+    // bytes_read_out.
+    //
+    // Precondition: the buffer data must not be corrupt, otherwise there will
+    // be a crash.
+    //
+    // Return values:
+    // OK - At least one entry was successfully read from the ring buffer.
+    // FAILED_PRECONDITION - Buffer not initialized.
+    // OUT_OF_RANGE - No entries in ring buffer to read.
+    // RESOURCE_EXHAUSTED - Destination data span was smaller than the oldest
+    // entry. No entries were read.
+    Status PeekEntriesWithPreamble(span<std::byte> data,
+                                   size_t& entries_read_out,
+                                   size_t& bytes_read_out) const {
+      return buffer_->InternalPeekEntriesWithPreamble(
+          *this, data, entries_read_out, bytes_read_out);
+    }
+
     // Pop and discard the oldest stored data chunk of data from the ring
     // buffer.
     //
@@ -192,6 +213,17 @@ class PrefixedEntryRingBufferMulti {
     uint32_t preamble;
   };
 
+  // A region of the ring buffer reserved by Reserve() or TryReserve() for the
+  // data of a new entry. If the region wraps around the end of the buffer, it
+  // is split in two and `second` holds the wrapped part; otherwise `second` is
+  // empty.
+  struct Reservation {
+    span<std::byte> first;
+    span<std::byte> second;
+
+    size_t size_bytes() const { return first.size() + second.size(); }
+  };
+
   // An iterator that can be used to walk through all entries from a given
   // Reader position, without mutating the underlying buffer. This is useful in
   // crash contexts where all available entries in the buffer must be acquired,
@@ -382,6 +414,8 @@ class PrefixedEntryRingBufferMulti {
       : buffer_(nullptr),
         buffer_bytes_(0),
         write_idx_(0),
+        reserved_bytes_(0),
+        reserved_user_preamble_(0),
         user_preamble_(user_preamble) {}
 
   // Set the raw buffer to be used by the ring buffer.
@@ -480,6 +514,62 @@ class PrefixedEntryRingBufferMulti {
     return TryPushBack(data, static_cast<uint32_t>(user_preamble_data));
   }
 
+  // Reserve space for an entry of up to max_size_bytes of data, which the
+  // caller writes in place before calling Commit(). This lets an encoder
+  // serialize an entry directly into the ring buffer rather than into a
+  // temporary buffer that PushBack() then copies. If available space is less
+  // than the reserved size, silently pop and discard oldest stored data chunks
+  // until space is available.
+  //
+  // Preamble argument is the same as for PushBack().
+  //
+  // Only one reservation may be outstanding at a time. Until it is committed
+  // or canceled, PushBack(), TryPushBack() and Dering() fail with
+  // FAILED_PRECONDITION. Readers may continue to peek and pop entries.
+  //
+  // Return values:
+  // OK - Space successfully reserved in the ring buffer.
+  // INVALID_ARGUMENT - max_size_bytes is zero.
+  // FAILED_PRECONDITION - Buffer not initialized, or a reservation is already
+  // outstanding.
+  // OUT_OF_RANGE - Size of the entry is greater than buffer size.
+  Result<Reservation> Reserve(size_t max_size_bytes,
+                              uint32_t user_preamble_data = 0) {
+    return InternalReserve(max_size_bytes, user_preamble_data, true);
+  }
+
+  // Reserve space for an entry of up to max_size_bytes of data if there is
+  // space available. See Reserve().
+  //
+  // Return values:
+  // OK - Space successfully reserved in the ring buffer.
+  // INVALID_ARGUMENT - max_size_bytes is zero.
+  // FAILED_PRECONDITION - Buffer not initialized, or a reservation is already
+  // outstanding.
+  // OUT_OF_RANGE - Size of the entry is greater than buffer size.
+  // RESOURCE_EXHAUSTED - The ring buffer doesn't have space for the entry
+  // without popping off existing elements.
+  Result<Reservation> TryReserve(size_t max_size_bytes,
+                                 uint32_t user_preamble_data = 0) {
+    return InternalReserve(max_size_bytes, user_preamble_data, false);
+  }
+
+  // Add the outstanding reservation to the ring buffer as an entry holding the
+  // first size_bytes of reserved data. The rest of the reservation is released.
+  // If size_bytes is smaller than the reserved size, the entry's size varint is
+  // padded to the width used for the reserved size.
+  //
+  // Return values:
+  // OK - Entry successfully written to the ring buffer.
+  // FAILED_PRECONDITION - No reservation is outstanding.
+  // OUT_OF_RANGE - size_bytes is greater than the reserved size. The
+  // reservation remains outstanding.
+  Status Commit(size_t size_bytes);
+
+  // Release the outstanding reservation without adding an entry. Entries that
+  // were discarded to make space for the reservation are not restored.
+  void CancelReservation() { reserved_bytes_ = 0; }
+
   // Get the size in bytes of all the current entries in the ring buffer,
   // including preamble and data chunk.
   size_t TotalUsedBytes() const { return buffer_bytes_ - RawAvailableBytes(); }
@@ -526,6 +616,10 @@ class PrefixedEntryRingBufferMulti {
                                        size_t* bytes_read_out) const;
   Status InternalPeekFrontWithPreamble(const Reader& reader,
                                        ReadOutput&& output) const;
+  Status InternalPeekEntriesWithPreamble(const Reader& reader,
+                                         span<std::byte> data,
+                                         size_t& entries_read_out,
+                                         size_t& bytes_read_out) const;
 
   // Pop and discard the oldest stored data chunk of data from the ring buffer.
   //
@@ -574,6 +668,21 @@ class PrefixedEntryRingBufferMulti {
                           uint32_t user_preamble_data,
                           bool pop_front_if_needed);
 
+  // Reserve implementation, which optionally discards front elements to fit
+  // the reserved entry.
+  Result<Reservation> InternalReserve(size_t max_size_bytes,
+                                      uint32_t user_preamble_data,
+                                      bool pop_front_if_needed);
+
+  // Ensure there is space for total_write_bytes, optionally discarding front
+  // elements.
+  //
+  // Return values:
+  // OK - There is space for the bytes.
+  // OUT_OF_RANGE - total_write_bytes is greater than buffer size.
+  // RESOURCE_EXHAUSTED - Not enough space and pop_front_if_needed is false.
+  Status InternalMakeSpace(size_t total_write_bytes, bool pop_front_if_needed);
+
   // Internal function to pop all of the slowest readers. This function may pop
   // multiple readers if multiple are slow.
   //
@@ -628,6 +737,12 @@ class PrefixedEntryRingBufferMulti {
   size_t buffer_bytes_;
 
   size_t write_idx_;
+
+  // Data size and user preamble of the outstanding reservation. No
+  // reservation is outstanding if reserved_bytes_ is zero.
+  size_t reserved_bytes_;
+  uint32_t reserved_user_preamble_;
+
   const bool user_preamble_;
 
   // List of attached readers.
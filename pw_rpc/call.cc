@@ -130,7 +130,7 @@ void Call::DestroyClientCall() {
 void Call::WaitForCallbacksToComplete() {
   do {
     int iterations = 0;
-    while (CallbacksAreRunning()) {
+    while (CallbacksAreRunning() || SendsInProgress()) {
       PW_RPC_CHECK_FOR_DEADLOCK("destroy", *this);
       YieldRpcLock();
     }
@@ -159,16 +159,16 @@ void Call::MoveFrom(Call& other) {
 
   properties_ = other.properties_;
 
-  // callbacks_executing_ is not moved since it is associated with the object in
-  // memory, not the call.
+  // callbacks_executing_ and sends_in_progress_ are not moved since they are
+  // associated with the object in memory, not the call.
 
   on_error_ = std::move(other.on_error_);
   on_next_ = std::move(other.on_next_);
 
   if (other.active_locked()) {
-    // Mark the other call inactive, unregister it, and register this one.
-    other.MarkClosed();
+    // Unregister the other call, mark it inactive, and register this one.
     endpoint().UnregisterCall(other);
+    other.MarkClosed();
     endpoint().RegisterUniqueCall(*this);
   }
 }
@@ -182,6 +182,13 @@ void Call::WaitUntilReadyForMove(Call& destination, Call& source) {
       YieldRpcLock();
     }
 
+    // Packets being sent for either call refer to the call objects, which must
+    // not change until the sends complete.
+    while (source.SendsInProgress() || destination.SendsInProgress()) {
+      PW_RPC_CHECK_FOR_DEADLOCK("move", source);
+      YieldRpcLock();
+    }
+
     // At this point, no callbacks are running in the source call. If cleanup
     // is required for the destination call, perform it and retry since
     // cleanup releases and reacquires the RPC lock.
@@ -223,7 +230,16 @@ Status Call::SendPacket(PacketType type, ConstByteSpan payload, Status status) {
     encoding_buffer.ReleaseIfAllocated();
     return Status::Unavailable();
   }
+#if PW_RPC_CHANNEL_LOCKS
+  // The RPC lock is released while sending, so pin this object until the send
+  // completes.
+  sends_in_progress_ += 1;
+  const Status send_status = channel->Send(MakePacket(type, payload, status));
+  sends_in_progress_ -= 1;
+  return send_status;
+#else
   return channel->Send(MakePacket(type, payload, status));
+#endif  // PW_RPC_CHANNEL_LOCKS
 }
 
 Status Call::CloseAndSendResponseCallbackLocked(
@@ -243,22 +259,78 @@ Status Call::TryCloseAndSendResponseCallbackLocked(
 Status Call::CloseAndSendFinalPacketLocked(PacketType type,
                                            ConstByteSpan response,
                                            Status status) {
+#if PW_RPC_CHANNEL_LOCKS
+  return CloseThenSendFinalPacketLocked(
+      type, response, status, /*reopen_on_failure=*/false);
+#else
   const Status send_status = SendPacket(type, response, status);
   UnregisterAndMarkClosed();
   return send_status;
+#endif  // PW_RPC_CHANNEL_LOCKS
 }
 
 Status Call::TryCloseAndSendFinalPacketLocked(PacketType type,
                                               ConstByteSpan response,
                                               Status status) {
+#if PW_RPC_CHANNEL_LOCKS
+  return CloseThenSendFinalPacketLocked(
+      type, response, status, /*reopen_on_failure=*/true);
+#else
   const Status send_status = SendPacket(type, response, status);
   // Only close the call if the final packet gets sent out successfully.
   if (send_status.ok()) {
     UnregisterAndMarkClosed();
   }
   return send_status;
+#endif  // PW_RPC_CHANNEL_LOCKS
 }
 
+#if PW_RPC_CHANNEL_LOCKS
+
+Status Call::CloseThenSendFinalPacketLocked(PacketType type,
+                                            ConstByteSpan response,
+                                            Status status,
+                                            bool reopen_on_failure) {
+  if (!active_locked()) {
+    encoding_buffer.ReleaseIfAllocated();
+    return Status::FailedPrecondition();
+  }
+
+  ChannelBase* channel = endpoint_->GetInternalChannel(channel_id_);
+  if (channel == nullptr) {
+    encoding_buffer.ReleaseIfAllocated();
+    if (!reopen_on_failure) {
+      UnregisterAndMarkClosed();
+    }
+    return Status::Unavailable();
+  }
+
+  // The RPC lock is released while the packet is sent. Close the call first so
+  // that other threads cannot write to or finish it, and incoming packets
+  // cannot close it, once its final packet is queued.
+  const Packet packet = MakePacket(type, response, status);
+  const uint8_t state = state_;
+  UnregisterAndMarkClosed();
+
+  sends_in_progress_ += 1;
+  const Status send_status = channel->Send(packet);
+  sends_in_progress_ -= 1;
+
+  if (send_status.ok() || !reopen_on_failure ||
+      endpoint_->GetInternalChannel(packet.channel_id()) == nullptr ||
+      endpoint_->FindCall(packet) != nullptr) {
+    return send_status;
+  }
+
+  channel_id_ = packet.channel_id();
+  id_ = packet.call_id();
+  state_ = state;
+  endpoint().RegisterUniqueCall(*this);
+  return send_status;
+}
+
+#endif  // PW_RPC_CHANNEL_LOCKS
+
 Status Call::WriteLocked(ConstByteSpan payload) {
   return SendPacket(properties_.call_type() == kServerCall
                         ? PacketType::SERVER_STREAM
@@ -266,6 +338,33 @@ Status Call::WriteLocked(ConstByteSpan payload) {
                     payload);
 }
 
+Status Call::WriteHeaderLocked(
+    size_t payload_size,
+    const Function<Status(ChannelOutput&, ConstByteSpan)>& send_packet) {
+  if (!active_locked()) {
+    return Status::FailedPrecondition();
+  }
+
+  ChannelBase* channel = endpoint_->GetInternalChannel(channel_id_);
+  if (channel == nullptr) {
+    return Status::Unavailable();
+  }
+
+  const Packet header = MakePacket(properties_.call_type() == kServerCall
+                                       ? PacketType::SERVER_STREAM
+                                       : PacketType::CLIENT_STREAM,
+                                   {});
+#if PW_RPC_CHANNEL_LOCKS
+  sends_in_progress_ += 1;
+  const Status send_status =
+      channel->SendHeader(header, payload_size, send_packet);
+  sends_in_progress_ -= 1;
+  return send_status;
+#else
+  return channel->SendHeader(header, payload_size, send_packet);
+#endif  // PW_RPC_CHANNEL_LOCKS
+}
+
 Status Call::WriteCallbackLocked(
     const Function<StatusWithSize(ByteSpan)>& callback) {
   PW_TRY_ASSIGN(ConstByteSpan payload, EncodeCallbackToPayloadBuffer(callback));
@@ -0,0 +1,169 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_rpc/internal/call_index.h"
+
+#include <algorithm>
+
+#include "pw_rpc/internal/call.h"
+
+namespace pw::rpc::internal {
+namespace {
+
+constexpr bool IsOpenCallId(uint32_t call_id) {
+  return call_id == kOpenCallId || call_id == kLegacyOpenCallId;
+}
+
+// Whether the bucket is cyclically within the range (first, last].
+constexpr bool InProbeRange(size_t bucket, size_t first, size_t last) {
+  return first <= last ? (first < bucket && bucket <= last)
+                       : (first < bucket || bucket <= last);
+}
+
+}  // namespace
+
+void CallIndex::Reset(span<Call*> buckets, IntrusiveList<Call>& calls) {
+  buckets_ = buckets;
+  Rebuild(calls);
+}
+
+void CallIndex::Rebuild(IntrusiveList<Call>& calls) {
+  std::fill(buckets_.begin(), buckets_.end(), nullptr);
+  count_ = 0;
+  calls_ = 0;
+  open_calls_ = 0;
+  valid_ = !buckets_.empty();
+
+  for (Call& call : calls) {
+    Add(call);
+  }
+}
+
+void CallIndex::Add(Call& call) {
+  if (buckets_.empty()) {
+    return;
+  }
+
+  calls_ += 1;
+
+  if (IsOpenCallId(call.id())) {
+    open_calls_ += 1;
+  } else if (valid_) {
+    valid_ = Insert(call);
+  }
+}
+
+void CallIndex::Remove(const Call& call) {
+  if (buckets_.empty()) {
+    return;
+  }
+
+  calls_ -= 1;
+
+  if (IsOpenCallId(call.id())) {
+    open_calls_ -= 1;
+    return;
+  }
+
+  if (!valid_) {
+    return;
+  }
+
+  for (size_t bucket = HomeBucket(call); buckets_[bucket] != nullptr;
+       bucket = Next(bucket)) {
+    if (buckets_[bucket] == &call) {
+      Erase(bucket);
+      return;
+    }
+  }
+}
+
+Call* CallIndex::Find(uint32_t channel_id,
+                      uint32_t service_id,
+                      uint32_t method_id,
+                      uint32_t call_id) const {
+  for (size_t bucket = HomeBucket(channel_id, service_id, method_id, call_id);
+       ;
+       bucket = Next(bucket)) {
+    Call* const call = buckets_[bucket];
+    if (call == nullptr ||
+        (call->id() == call_id && call->method_id() == method_id &&
+         call->service_id() == service_id &&
+         call->channel_id_locked() == channel_id)) {
+      return call;
+    }
+  }
+}
+
+size_t CallIndex::HomeBucket(uint32_t channel_id,
+                             uint32_t service_id,
+                             uint32_t method_id,
+                             uint32_t call_id) const {
+  // Service and method IDs are already hashes. Call IDs are assigned
+  // sequentially, so they are mixed in last to spread consecutive calls to the
+  // same method across consecutive buckets.
+  constexpr uint32_t kMultiplier = 65599;
+  uint32_t hash = channel_id;
+  hash = hash * kMultiplier + service_id;
+  hash = hash * kMultiplier + method_id;
+  hash = hash * kMultiplier + call_id;
+  return hash % buckets_.size();
+}
+
+size_t CallIndex::HomeBucket(const Call& call) const {
+  return HomeBucket(
+      call.channel_id_locked(), call.service_id(), call.method_id(), call.id());
+}
+
+bool CallIndex::Insert(Call& call) {
+  // Always leave at least one empty bucket so that lookups terminate.
+  if (count_ + 1 >= buckets_.size()) {
+    return false;
+  }
+
+  size_t bucket = HomeBucket(call);
+
+  while (buckets_[bucket] != nullptr) {
+    const Call& other = *buckets_[bucket];
+    if (other.id() == call.id() && other.method_id() == call.method_id() &&
+        other.service_id() == call.service_id() &&
+        other.channel_id_locked() == call.channel_id_locked()) {
+      return false;  // Duplicate keys are resolved by the call list.
+    }
+    bucket = Next(bucket);
+  }
+
+  buckets_[bucket] = &call;
+  count_ += 1;
+  return true;
+}
+
+void CallIndex::Erase(size_t bucket) {
+  size_t hole = bucket;
+
+  for (size_t next = Next(hole); buckets_[next] != nullptr;
+       next = Next(next)) {
+    // Move the entry into the hole unless its home bucket lies between the
+    // hole and its current position, in which case it is already reachable.
+    if (!InProbeRange(HomeBucket(*buckets_[next]), hole, next)) {
+      buckets_[hole] = buckets_[next];
+      hole = next;
+    }
+  }
+
+  buckets_[hole] = nullptr;
+  count_ -= 1;
+}
+
+}  // namespace pw::rpc::internal
@@ -18,11 +18,14 @@
 #include "pw_rpc/channel.h"
 // clang-format on
 
+#include <array>
+
 #include "pw_assert/check.h"
 #include "pw_bytes/span.h"
 #include "pw_log/log.h"
 #include "pw_protobuf/decoder.h"
 #include "pw_protobuf/find.h"
+#include "pw_rpc/internal/channel_send_lock.h"
 #include "pw_rpc/internal/config.h"
 #include "pw_rpc/internal/encoding_buffer.h"
 #include "pw_rpc/internal/packet.pwpb.h"
@@ -32,6 +35,63 @@ using pw::rpc::internal::pwpb::RpcPacket::Fields;
 namespace pw::rpc {
 namespace internal {
 
+#if PW_RPC_CHANNEL_LOCKS
+
+ChannelSendLock& ChannelSendLock::ForChannel(uint32_t channel_id) {
+  static ChannelSendLock locks[PW_RPC_CHANNEL_LOCK_SHARDS];
+  return locks[channel_id % PW_RPC_CHANNEL_LOCK_SHARDS];
+}
+
+void ChannelSendLock::Release(Sender& sender) {
+  PW_DCHECK(&senders_.front() == &sender);
+  senders_.pop_front();
+  if (!senders_.empty()) {
+    senders_.front().ready_.release();
+  }
+}
+
+bool ChannelSendLock::HasSenders(uint32_t channel_id) const {
+  for (const Sender& sender : senders_) {
+    if (sender.channel_id_ == channel_id) {
+      return true;
+    }
+  }
+  return false;
+}
+
+namespace {
+
+// ChannelOutput::Send() requires the RPC lock for static analysis, but with
+// channel locks it is called with the channel's send lock held instead.
+Status SendWithoutRpcLock(ChannelOutput& output, ConstByteSpan packet)
+    PW_NO_LOCK_SAFETY_ANALYSIS {
+  return output.Send(packet);
+}
+
+// Waits for the channel's send lock, then invokes send with the RPC lock
+// released. Reacquires the RPC lock before returning.
+template <typename SendFunction>
+Status SendWithChannelLock(uint32_t channel_id, SendFunction&& send)
+    PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+  ChannelSendLock& send_lock = ChannelSendLock::ForChannel(channel_id);
+  ChannelSendLock::Sender sender(channel_id);
+  const bool acquired = send_lock.Enqueue(sender);
+
+  rpc_lock().unlock();
+  if (!acquired) {
+    sender.Wait();
+  }
+  const Status sent = send();
+  rpc_lock().lock();
+
+  send_lock.Release(sender);
+  return sent;
+}
+
+}  // namespace
+
+#endif  // PW_RPC_CHANNEL_LOCKS
+
 Status OverwriteChannelId(ByteSpan rpc_packet, uint32_t channel_id_under_128) {
   Result<ConstByteSpan> raw_field =
       protobuf::FindRaw(rpc_packet, Fields::kChannelId);
@@ -70,12 +130,58 @@ Status ChannelBase::Send(const Packet& packet) {
   }
 
   PW_CHECK_NOTNULL(output_);
-  Status sent = output_->Send(encoded.value());
+#if PW_RPC_CHANNEL_LOCKS
+  // Take the encoded packet out of the shared encoding buffer and send it with
+  // the RPC lock released. This channel object may be moved while the lock is
+  // released, so its members are copied first.
+  ChannelOutput& output = *output_;
+  const size_t encoded_size = encoded.value().size();
+  const auto packet_buffer = encoding_buffer.Take();
+
+  const Status sent = SendWithChannelLock(id(), [&] {
+    return SendWithoutRpcLock(output, span(packet_buffer).first(encoded_size));
+  });
+#else
+  const Status sent = output_->Send(encoded.value());
   encoding_buffer.Release();
+#endif  // PW_RPC_CHANNEL_LOCKS
+
+  return CheckSendStatus(packet, sent);
+}
+
+Status ChannelBase::SendHeader(
+    const Packet& packet,
+    size_t payload_size,
+    const Function<Status(ChannelOutput&, ConstByteSpan)>& send_packet) {
+  std::array<std::byte, Packet::kMinEncodedSizeWithoutPayload> header_buffer;
+  Result<ConstByteSpan> header =
+      packet.EncodeHeader(header_buffer, payload_size);
+
+  if (!header.ok()) {
+    PW_LOG_ERROR(
+        "Failed to encode RPC packet type %u header for channel %u, status %u",
+        static_cast<unsigned>(packet.type()),
+        static_cast<unsigned>(id()),
+        header.status().code());
+    return Status::Internal();
+  }
+
+  PW_CHECK_NOTNULL(output_);
+#if PW_RPC_CHANNEL_LOCKS
+  ChannelOutput& output = *output_;
+  const Status sent = SendWithChannelLock(
+      id(), [&] { return send_packet(output, header.value()); });
+#else
+  const Status sent = send_packet(*output_, header.value());
+#endif  // PW_RPC_CHANNEL_LOCKS
+
+  return CheckSendStatus(packet, sent);
+}
 
+Status ChannelBase::CheckSendStatus(const Packet& packet, Status sent) {
   if (!sent.ok()) {
     PW_LOG_DEBUG("Channel %u failed to send packet with status %u",
-                 static_cast<unsigned>(id()),
+                 static_cast<unsigned>(packet.channel_id()),
                  sent.code());
 
     return Status::Unknown();
@@ -0,0 +1,105 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures streaming from multiple threads on separate channels. With
+// PW_RPC_CHANNEL_LOCKS, the threads' sends overlap, so 8 threads should take
+// about as long as 1; with the global lock, they take about 8 times as long.
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_perf_test/perf_test.h"
+#include "pw_rpc/raw/server_reader_writer.h"
+#include "pw_rpc/server.h"
+#include "pw_rpc_test_protos/test.raw_rpc.pb.h"
+#include "pw_thread/sleep.h"
+#include "pw_thread/thread.h"
+#include "pw_thread_stl/options.h"
+
+namespace pw::rpc {
+namespace {
+
+using namespace std::chrono_literals;
+
+using test::pw_rpc::raw::TestService;
+
+constexpr size_t kMaxThreads = 8;
+constexpr uint32_t kPacketsPerThread = 10;
+
+class TestServiceImpl final : public TestService::Service<TestServiceImpl> {
+ public:
+  static void TestUnaryRpc(ConstByteSpan, RawUnaryResponder&) {}
+  void TestAnotherUnaryRpc(ConstByteSpan, RawUnaryResponder&) {}
+  void TestServerStreamRpc(ConstByteSpan, RawServerWriter&) {}
+  void TestClientStreamRpc(RawServerReader&) {}
+  void TestBidirectionalStreamRpc(RawServerReaderWriter&) {}
+};
+
+// Simulates a slow transport by sleeping in Send().
+class SlowChannelOutput : public ChannelOutput {
+ public:
+  constexpr SlowChannelOutput() : ChannelOutput("slow") {}
+
+  Status Send(span<const std::byte>) override {
+    this_thread::sleep_for(100us);
+    return OkStatus();
+  }
+};
+
+// Streams kPacketsPerThread packets on each of thread_count channels, one
+// thread per channel. Each iteration includes starting and joining the threads.
+void StreamFromThreadsTest(perf_test::State& state, size_t thread_count) {
+  std::array<SlowChannelOutput, kMaxThreads> outputs;
+  std::array<Channel, kMaxThreads> channels;
+  TestServiceImpl service;
+  Server server(channels);
+  server.RegisterService(service);
+
+  std::array<RawServerWriter, kMaxThreads> writers;
+  for (size_t i = 0; i < thread_count; ++i) {
+    const uint32_t channel_id = static_cast<uint32_t>(i + 1);
+    server.OpenChannel(channel_id, outputs[i]).IgnoreError();
+    writers[i] = RawServerWriter::Open<TestService::TestServerStreamRpc>(
+        server, channel_id, service);
+  }
+
+  std::array<Thread, kMaxThreads> threads;
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < thread_count; ++i) {
+      threads[i] = Thread(thread::stl::Options(), [&writer = writers[i]] {
+        for (uint32_t value = 0; value < kPacketsPerThread; ++value) {
+          writer.Write(as_bytes(span(&value, 1))).IgnoreError();
+        }
+      });
+    }
+    for (size_t i = 0; i < thread_count; ++i) {
+      threads[i].join();
+    }
+  }
+
+  for (size_t i = 0; i < thread_count; ++i) {
+    writers[i].Finish().IgnoreError();
+    server.CloseChannel(static_cast<uint32_t>(i + 1)).IgnoreError();
+  }
+  server.UnregisterService(service);
+}
+
+PW_PERF_TEST(StreamFrom1Thread, StreamFromThreadsTest, 1);
+PW_PERF_TEST(StreamFrom4Threads, StreamFromThreadsTest, 4);
+PW_PERF_TEST(StreamFrom8Threads, StreamFromThreadsTest, 8);
+
+}  // namespace
+}  // namespace pw::rpc
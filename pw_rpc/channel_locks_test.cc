@@ -0,0 +1,263 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Tests sending from multiple threads. With PW_RPC_CHANNEL_LOCKS, sends on
+// different channels proceed in parallel; with the default global lock, they
+// are serialized. See channel_locks_perf_test.cc for throughput measurements.
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#include "pw_chrono/system_clock.h"
+#include "pw_rpc/internal/config.h"
+#include "pw_rpc/internal/packet.h"
+#include "pw_rpc/raw/server_reader_writer.h"
+#include "pw_rpc/server.h"
+#include "pw_rpc_test_protos/test.raw_rpc.pb.h"
+#include "pw_sync/binary_semaphore.h"
+#include "pw_thread/sleep.h"
+#include "pw_thread/thread.h"
+#include "pw_thread_stl/options.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::rpc {
+namespace {
+
+using namespace std::chrono_literals;
+
+using internal::Packet;
+using internal::pwpb::PacketType;
+using test::pw_rpc::raw::TestService;
+
+constexpr size_t kMaxThreads = 8;
+constexpr uint32_t kPacketsPerThread = 20;
+
+class TestServiceImpl final : public TestService::Service<TestServiceImpl> {
+ public:
+  static void TestUnaryRpc(ConstByteSpan, RawUnaryResponder&) {}
+  void TestAnotherUnaryRpc(ConstByteSpan, RawUnaryResponder&) {}
+  void TestServerStreamRpc(ConstByteSpan, RawServerWriter&) {}
+  void TestClientStreamRpc(RawServerReader&) {}
+  void TestBidirectionalStreamRpc(RawServerReaderWriter&) {}
+};
+
+// Simulates a slow transport by sleeping in Send(). Checks that the stream
+// payloads, which are consecutive uint32_t values, arrive in order.
+class SlowChannelOutput : public ChannelOutput {
+ public:
+  explicit SlowChannelOutput(chrono::SystemClock::duration send_duration = {})
+      : ChannelOutput("slow"), send_duration_(send_duration) {}
+
+  Status Send(ConstByteSpan buffer) override {
+    // Sends on a channel are serialized, so no additional locking is needed.
+    Result<Packet> packet = Packet::FromBuffer(buffer);
+    if (packet.ok() && packet->type() == PacketType::SERVER_STREAM &&
+        packet->payload().size() == sizeof(uint32_t)) {
+      uint32_t value;
+      std::memcpy(&value, packet->payload().data(), sizeof(value));
+      in_order_ = in_order_ && value == stream_packets_;
+      stream_packets_ += 1;
+    }
+    if (send_duration_ > chrono::SystemClock::duration::zero()) {
+      this_thread::sleep_for(send_duration_);
+    }
+    return OkStatus();
+  }
+
+  uint32_t stream_packets() const { return stream_packets_; }
+  bool in_order() const { return in_order_; }
+
+ private:
+  const chrono::SystemClock::duration send_duration_;
+  uint32_t stream_packets_ = 0;
+  bool in_order_ = true;
+};
+
+class ChannelLocksTest : public ::testing::Test {
+ protected:
+  ChannelLocksTest() : server_(channels_) { server_.RegisterService(service_); }
+
+  RawServerWriter OpenWriter(uint32_t channel_id, ChannelOutput& output) {
+    EXPECT_EQ(OkStatus(), server_.OpenChannel(channel_id, output));
+    return RawServerWriter::Open<TestService::TestServerStreamRpc>(
+        server_, channel_id, service_);
+  }
+
+  // Streams kPacketsPerThread packets on each of thread_count channels, one
+  // thread per channel.
+  void StreamFromThreads(size_t thread_count) {
+    std::array<SlowChannelOutput, kMaxThreads> outputs{
+        SlowChannelOutput(1ms), SlowChannelOutput(1ms), SlowChannelOutput(1ms),
+        SlowChannelOutput(1ms), SlowChannelOutput(1ms), SlowChannelOutput(1ms),
+        SlowChannelOutput(1ms), SlowChannelOutput(1ms)};
+    std::array<RawServerWriter, kMaxThreads> writers;
+    std::array<Thread, kMaxThreads> threads;
+
+    for (size_t i = 0; i < thread_count; ++i) {
+      writers[i] = OpenWriter(static_cast<uint32_t>(i + 1), outputs[i]);
+    }
+
+    for (size_t i = 0; i < thread_count; ++i) {
+      threads[i] = Thread(thread::stl::Options(), [&writer = writers[i]] {
+        for (uint32_t value = 0; value < kPacketsPerThread; ++value) {
+          EXPECT_EQ(OkStatus(), writer.Write(as_bytes(span(&value, 1))));
+        }
+      });
+    }
+    for (size_t i = 0; i < thread_count; ++i) {
+      threads[i].join();
+    }
+
+    for (size_t i = 0; i < thread_count; ++i) {
+      EXPECT_EQ(outputs[i].stream_packets(), kPacketsPerThread);
+      EXPECT_TRUE(outputs[i].in_order());
+      EXPECT_EQ(OkStatus(), writers[i].Finish());
+      EXPECT_EQ(OkStatus(),
+                server_.CloseChannel(static_cast<uint32_t>(i + 1)));
+    }
+  }
+
+  std::array<Channel, kMaxThreads> channels_;
+  TestServiceImpl service_;
+  Server server_;
+};
+
+TEST_F(ChannelLocksTest, PacketsOnEachChannelAreSentInOrder) {
+  StreamFromThreads(kMaxThreads);
+}
+
+// Counts final packets and checks that no stream packet follows one. Sleeps in
+// Send() to widen the window in which other threads race the send.
+class FinalPacketOutput : public ChannelOutput {
+ public:
+  FinalPacketOutput() : ChannelOutput("final") {}
+
+  Status Send(ConstByteSpan buffer) override {
+    Result<Packet> packet = Packet::FromBuffer(buffer);
+    if (packet.ok()) {
+      if (packet->type() == PacketType::RESPONSE) {
+        responses_ += 1;
+      } else if (packet->type() == PacketType::SERVER_STREAM &&
+                 responses_ != 0u) {
+        stream_after_response_ = true;
+      }
+    }
+    this_thread::sleep_for(50us);
+    return OkStatus();
+  }
+
+  uint32_t responses() const { return responses_; }
+  bool stream_after_response() const { return stream_after_response_; }
+
+ private:
+  uint32_t responses_ = 0;
+  bool stream_after_response_ = false;
+};
+
+constexpr int kRaceIterations = 100;
+
+TEST_F(ChannelLocksTest, FinishRacingWriteSendsOneFinalPacket) {
+  for (int i = 0; i < kRaceIterations; ++i) {
+    FinalPacketOutput output;
+    RawServerWriter writer = OpenWriter(1, output);
+
+    Thread thread(thread::stl::Options(), [&writer] {
+      while (writer.Write(ConstByteSpan()).ok()) {
+      }
+    });
+    EXPECT_EQ(OkStatus(), writer.Finish());
+    thread.join();
+
+    EXPECT_EQ(output.responses(), 1u);
+    EXPECT_FALSE(output.stream_after_response());
+    EXPECT_EQ(OkStatus(), server_.CloseChannel(1));
+  }
+}
+
+TEST_F(ChannelLocksTest, FinishRacingFinishSendsOneFinalPacket) {
+  for (int i = 0; i < kRaceIterations; ++i) {
+    FinalPacketOutput output;
+    RawServerWriter writer = OpenWriter(1, output);
+
+    // Thread functions only hold one pointer, so pass the writer and result
+    // together.
+    struct {
+      RawServerWriter& writer;
+      Status status;
+    } other{writer, OkStatus()};
+    Thread thread(thread::stl::Options(),
+                  [&other] { other.status = other.writer.Finish(); });
+    const Status status = writer.Finish();
+    thread.join();
+
+    EXPECT_NE(status.ok(), other.status.ok());
+    EXPECT_EQ(output.responses(), 1u);
+    EXPECT_EQ(OkStatus(), server_.CloseChannel(1));
+  }
+}
+
+#if PW_RPC_CHANNEL_LOCKS
+
+// Blocks in the first call to Send() until released.
+class BlockingChannelOutput : public ChannelOutput {
+ public:
+  BlockingChannelOutput() : ChannelOutput("blocking") {}
+
+  Status Send(ConstByteSpan) override {
+    if (!blocked_) {
+      blocked_ = true;
+      entered_.release();
+      proceed_.acquire();
+    }
+    return OkStatus();
+  }
+
+  sync::BinarySemaphore entered_;
+  sync::BinarySemaphore proceed_;
+
+ private:
+  bool blocked_ = false;
+};
+
+TEST_F(ChannelLocksTest, BlockedChannelDoesNotBlockOtherChannels) {
+  BlockingChannelOutput blocked_output;
+  SlowChannelOutput other_output;
+
+  RawServerWriter blocked = OpenWriter(1, blocked_output);
+  RawServerWriter other = OpenWriter(2, other_output);
+
+  Thread thread(thread::stl::Options(), [&blocked] {
+    EXPECT_EQ(OkStatus(), blocked.Write(ConstByteSpan()));
+  });
+
+  // Wait until the thread is inside ChannelOutput::Send(), then send on a
+  // different channel. This would deadlock if the sends shared a lock.
+  blocked_output.entered_.acquire();
+  const uint32_t value = 0;
+  EXPECT_EQ(OkStatus(), other.Write(as_bytes(span(&value, 1))));
+  EXPECT_EQ(other_output.stream_packets(), 1u);
+
+  blocked_output.proceed_.release();
+  thread.join();
+
+  EXPECT_EQ(OkStatus(), blocked.Finish());
+  EXPECT_EQ(OkStatus(), other.Finish());
+}
+
+#endif  // PW_RPC_CHANNEL_LOCKS
+
+}  // namespace
+}  // namespace pw::rpc
@@ -36,7 +36,7 @@ Status Client::ProcessPacket(ConstByteSpan data) {
 
   // Find an existing call for this RPC, if any.
   internal::rpc_lock().lock();
-  IntrusiveList<internal::Call>::iterator call = FindCall(packet);
+  internal::Call* call = FindCall(packet);
 
   internal::ChannelBase* channel = GetInternalChannel(packet.channel_id());
 
@@ -47,7 +47,7 @@ Status Client::ProcessPacket(ConstByteSpan data) {
     return Status::Unavailable();
   }
 
-  if (call == calls_end()) {
+  if (call == nullptr) {
     // The call for the packet does not exist. If the packet is a server stream
     // message, notify the server so that it can kill the stream. Otherwise,
     // silently drop the packet (as it would terminate the RPC anyway).
@@ -93,6 +93,14 @@ Status Client::ProcessPacket(ConstByteSpan data) {
         // Report the error to the server so it can abort the RPC.
         channel->Send(Packet::ClientError(packet, Status::InvalidArgument()))
             .IgnoreError();  // Errors are logged in Channel::Send.
+#if PW_RPC_CHANNEL_LOCKS
+        // The RPC lock was released while sending, so find the call again.
+        call = FindCall(packet);
+        if (call == nullptr) {
+          internal::rpc_lock().unlock();
+          break;
+        }
+#endif  // PW_RPC_CHANNEL_LOCKS
         call->HandleError(Status::InvalidArgument());
         PW_LOG_DEBUG("Received SERVER_STREAM for RPC without a server stream");
       }
@@ -19,6 +19,7 @@
 // clang-format on
 
 #include "pw_log/log.h"
+#include "pw_rpc/internal/channel_send_lock.h"
 #include "pw_rpc/internal/lock.h"
 
 #if PW_RPC_YIELD_MODE == PW_RPC_YIELD_MODE_BUSY_LOOP
@@ -118,6 +119,29 @@ void Endpoint::RegisterCall(Call& new_call) {
 
   // Register the new call.
   calls_.push_front(new_call);
+  call_index_.Add(new_call);
+}
+
+Call* Endpoint::FindCall(const Packet& packet) {
+  // Packets with an open call ID match any call, so they are matched in list
+  // order. Calls with an open call ID are not indexed, so they can only be
+  // found by scanning the list.
+  if (call_index_.valid() && packet.call_id() != kOpenCallId &&
+      packet.call_id() != kLegacyOpenCallId) {
+    Call* call = call_index_.Find(packet.channel_id(),
+                                  packet.service_id(),
+                                  packet.method_id(),
+                                  packet.call_id());
+    if (call != nullptr || !call_index_.has_open_calls()) {
+      return call;
+    }
+  }
+
+  auto call = std::get<1>(FindIteratorsForCall(packet.channel_id(),
+                                               packet.service_id(),
+                                               packet.method_id(),
+                                               packet.call_id()));
+  return call != calls_.end() ? &(*call) : nullptr;
 }
 
 std::tuple<IntrusiveList<Call>::iterator, IntrusiveList<Call>::iterator>
@@ -142,7 +166,9 @@ Endpoint::FindIteratorsForCall(uint32_t channel_id,
         // kLegacyOpenCallId is used for compatibility with old servers
         // which do not specify a Call ID but expect to be able to send
         // unrequested responses.
+        call_index_.Remove(*call);
         call->set_id(call_id);
+        call_index_.Add(*call);
         break;
       }
     }
@@ -163,6 +189,15 @@ Status Endpoint::CloseChannel(uint32_t channel_id) {
   }
   static_cast<internal::ChannelBase*>(channel)->Close();
 
+#if PW_RPC_CHANNEL_LOCKS
+  // Wait for packets that are being sent with the RPC lock released, since the
+  // channel's output may be destroyed once CloseChannel returns.
+  const ChannelSendLock& send_lock = ChannelSendLock::ForChannel(channel_id);
+  while (send_lock.HasSenders(channel_id)) {
+    YieldRpcLock();
+  }
+#endif  // PW_RPC_CHANNEL_LOCKS
+
   // Close pending calls on the channel that's going away.
   AbortCalls(AbortIdType::kChannel, channel_id);
 
@@ -220,6 +255,8 @@ void Endpoint::RemoveAllCalls() {
     calls_.front().CloseFromDeletedEndpoint();
     calls_.pop_front();
   }
+  call_index_.Reset({}, calls_);
+
   while (!to_cleanup_.empty()) {
     to_cleanup_.front().CloseFromDeletedEndpoint();
     to_cleanup_.pop_front();
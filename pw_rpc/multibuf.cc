@@ -0,0 +1,98 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_rpc/multibuf.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "pw_assert/assert.h"
+#include "pw_rpc/internal/call.h"
+#include "pw_rpc/internal/endpoint.h"
+
+namespace pw::rpc {
+namespace internal {
+
+// Friend of Call, which may access its private Writer base and send methods.
+class MultiBufWriter {
+ public:
+  static Status Write(Writer& writer, multibuf::MultiBuf&& payload)
+      PW_LOCKS_EXCLUDED(rpc_lock()) {
+    Call& call = static_cast<Call&>(writer);
+    RpcLockGuard lock;
+
+    if (!call.active_locked()) {
+      return Status::FailedPrecondition();
+    }
+
+    ChannelBase* channel =
+        call.endpoint().GetInternalChannel(call.channel_id_locked());
+    if (channel == nullptr) {
+      return Status::Unavailable();
+    }
+
+    if (channel->multibuf_output() == nullptr || !HasHeadroom(payload)) {
+      return call.WriteCallbackLocked([&payload](ByteSpan buffer) {
+        if (buffer.size() < payload.size()) {
+          return StatusWithSize::ResourceExhausted();
+        }
+        return payload.CopyTo(buffer);
+      });
+    }
+
+    const size_t payload_size = payload.size();
+    return call.WriteHeaderLocked(
+        payload_size, [&payload](ChannelOutput& output, ConstByteSpan header) {
+          return SendWithHeader(output, header, std::move(payload));
+        });
+  }
+
+ private:
+  // True if the payload's first chunk, which may be empty, is preceded by
+  // enough reserved space for any packet header.
+  static bool HasHeadroom(multibuf::MultiBuf& payload) {
+    if (payload.empty()) {
+      return false;
+    }
+    multibuf::Chunk& first = payload.Chunks().front();
+    if (!first.ClaimPrefix(MultiBufChannelOutput::kPacketHeaderSizeBytes)) {
+      return false;
+    }
+    first.DiscardPrefix(MultiBufChannelOutput::kPacketHeaderSizeBytes);
+    return true;
+  }
+
+  // Copies the header into the payload's headroom and passes the packet to the
+  // output. Called with either the RPC lock or the channel's send lock held.
+  static Status SendWithHeader(ChannelOutput& output,
+                               ConstByteSpan header,
+                               multibuf::MultiBuf&& payload)
+      PW_NO_LOCK_SAFETY_ANALYSIS {
+    multibuf::Chunk& first = payload.Chunks().front();
+    const bool claimed = first.ClaimPrefix(header.size());
+    PW_DASSERT(claimed);
+    static_cast<void>(claimed);
+    std::copy(header.begin(), header.end(), first.begin());
+    return output.AsMultiBufChannelOutput()->SendMultiBuf(std::move(payload));
+  }
+};
+
+}  // namespace internal
+
+Status WriteMultiBuf(Writer& writer, multibuf::MultiBuf&& payload) {
+  multibuf::MultiBuf packet = std::move(payload);
+  return internal::MultiBufWriter::Write(writer, std::move(packet));
+}
+
+}  // namespace pw::rpc
@@ -0,0 +1,277 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_rpc/multibuf.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+
+#include "pw_assert/assert.h"
+#include "pw_log/log.h"
+#include "pw_multibuf/simple_allocator_for_test.h"
+#include "pw_rpc/internal/packet.h"
+#include "pw_rpc/raw/server_reader_writer.h"
+#include "pw_rpc/server.h"
+#include "pw_rpc_test_protos/test.raw_rpc.pb.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::rpc {
+namespace {
+
+using internal::Packet;
+using internal::pwpb::PacketType;
+using test::pw_rpc::raw::TestService;
+
+constexpr uint32_t kChannelId = 1;
+constexpr size_t kPayloadSize = 256;
+
+class TestServiceImpl final
+    : public TestService::Service<TestServiceImpl> {
+ public:
+  static void TestUnaryRpc(ConstByteSpan, RawUnaryResponder&) {}
+  void TestAnotherUnaryRpc(ConstByteSpan, RawUnaryResponder&) {}
+  void TestServerStreamRpc(ConstByteSpan, RawServerWriter&) {}
+  void TestClientStreamRpc(RawServerReader&) {}
+  void TestBidirectionalStreamRpc(RawServerReaderWriter&) {}
+};
+
+// Keeps the last packet sent, and counts how many packets were sent as
+// MultiBufs and as contiguous buffers.
+class TestMultiBufOutput : public MultiBufChannelOutput {
+ public:
+  TestMultiBufOutput() : MultiBufChannelOutput("multibuf") {}
+
+  Status Send(ConstByteSpan buffer) override {
+    buffer_sends_ += 1;
+    last_packet_.reset();
+    last_packet_size_ = buffer.size();
+    std::copy(buffer.begin(), buffer.end(), last_packet_copy_.begin());
+    return OkStatus();
+  }
+
+  Status SendMultiBuf(multibuf::MultiBuf&& packet) override {
+    multibuf_sends_ += 1;
+    last_packet_ = std::move(packet);
+    return status_;
+  }
+
+  // Returns the last packet sent, which must be contiguous.
+  ConstByteSpan last_packet() const {
+    if (last_packet_.has_value()) {
+      std::optional<ConstByteSpan> packet = last_packet_->ContiguousSpan();
+      PW_ASSERT(packet.has_value());
+      return *packet;
+    }
+    return span(last_packet_copy_).first(last_packet_size_);
+  }
+
+  int buffer_sends() const { return buffer_sends_; }
+  int multibuf_sends() const { return multibuf_sends_; }
+
+  void set_status(Status status) { status_ = status; }
+
+ private:
+  std::optional<multibuf::MultiBuf> last_packet_;
+  std::array<std::byte, 512> last_packet_copy_;
+  size_t last_packet_size_ = 0;
+  int buffer_sends_ = 0;
+  int multibuf_sends_ = 0;
+  Status status_;
+};
+
+// Copies packets sent with ChannelOutput::Send.
+class TestBufferOutput : public ChannelOutput {
+ public:
+  TestBufferOutput() : ChannelOutput("buffer") {}
+
+  Status Send(ConstByteSpan buffer) override {
+    sends_ += 1;
+    last_packet_size_ = buffer.size();
+    std::copy(buffer.begin(), buffer.end(), last_packet_.begin());
+    return OkStatus();
+  }
+
+  ConstByteSpan last_packet() const {
+    return span(last_packet_).first(last_packet_size_);
+  }
+  int sends() const { return sends_; }
+
+ private:
+  std::array<std::byte, 512> last_packet_;
+  size_t last_packet_size_ = 0;
+  int sends_ = 0;
+};
+
+class MultiBufTest : public ::testing::Test {
+ protected:
+  MultiBufTest() : server_(channels_) { server_.RegisterService(service_); }
+
+  RawServerWriter OpenWriter(ChannelOutput& output) {
+    EXPECT_EQ(OkStatus(), server_.OpenChannel(kChannelId, output));
+    return RawServerWriter::Open<TestService::TestServerStreamRpc>(
+        server_, kChannelId, service_);
+  }
+
+  // Allocates a payload with headroom for the packet header and fills it with
+  // a counting pattern.
+  multibuf::MultiBuf AllocatePayload(size_t headroom) {
+    std::optional<multibuf::MultiBuf> buffer =
+        allocator_.AllocateContiguous(headroom + kPayloadSize);
+    PW_ASSERT(buffer.has_value());
+    multibuf::Chunk& chunk = buffer->Chunks().front();
+    chunk.DiscardPrefix(headroom);
+    for (size_t i = 0; i < kPayloadSize; ++i) {
+      chunk[i] = static_cast<std::byte>(i);
+    }
+    return *std::move(buffer);
+  }
+
+  static void ExpectPayload(ConstByteSpan packet_data) {
+    Result<Packet> packet = Packet::FromBuffer(packet_data);
+    ASSERT_EQ(OkStatus(), packet.status());
+    EXPECT_EQ(PacketType::SERVER_STREAM, packet->type());
+    EXPECT_EQ(kChannelId, packet->channel_id());
+    ASSERT_EQ(kPayloadSize, packet->payload().size());
+    for (size_t i = 0; i < kPayloadSize; ++i) {
+      EXPECT_EQ(static_cast<std::byte>(i), packet->payload()[i]);
+    }
+  }
+
+  multibuf::test::SimpleAllocatorForTest<2048> allocator_;
+  std::array<Channel, 1> channels_;
+  TestServiceImpl service_;
+  Server server_;
+};
+
+TEST_F(MultiBufTest, WithHeadroom_SendsPayloadWithoutCopying) {
+  TestMultiBufOutput output;
+  RawServerWriter writer = OpenWriter(output);
+
+  multibuf::MultiBuf payload =
+      AllocatePayload(MultiBufChannelOutput::kPacketHeaderSizeBytes);
+  const std::byte* payload_data = payload.Chunks().front().data();
+
+  EXPECT_EQ(OkStatus(), WriteMultiBuf(writer.as_writer(), std::move(payload)));
+  EXPECT_EQ(1, output.multibuf_sends());
+  EXPECT_EQ(0, output.buffer_sends());
+  ExpectPayload(output.last_packet());
+
+  // The payload was sent from the buffer in which it was written.
+  Result<Packet> packet = Packet::FromBuffer(output.last_packet());
+  ASSERT_EQ(OkStatus(), packet.status());
+  EXPECT_EQ(payload_data, packet->payload().data());
+
+  EXPECT_EQ(OkStatus(), writer.Finish());
+}
+
+TEST_F(MultiBufTest, WithoutHeadroom_CopiesPayload) {
+  TestMultiBufOutput output;
+  RawServerWriter writer = OpenWriter(output);
+
+  EXPECT_EQ(OkStatus(), WriteMultiBuf(writer.as_writer(), AllocatePayload(0)));
+  EXPECT_EQ(0, output.multibuf_sends());
+  EXPECT_EQ(1, output.buffer_sends());
+  ExpectPayload(output.last_packet());
+
+  EXPECT_EQ(OkStatus(), writer.Finish());
+}
+
+TEST_F(MultiBufTest, ChannelOutput_CopiesPayload) {
+  TestBufferOutput output;
+  RawServerWriter writer = OpenWriter(output);
+
+  EXPECT_EQ(OkStatus(),
+            WriteMultiBuf(writer.as_writer(),
+                          AllocatePayload(
+                              MultiBufChannelOutput::kPacketHeaderSizeBytes)));
+  EXPECT_EQ(1, output.sends());
+  ExpectPayload(output.last_packet());
+
+  EXPECT_EQ(OkStatus(), writer.Finish());
+}
+
+TEST_F(MultiBufTest, EmptyPayload) {
+  TestMultiBufOutput output;
+  RawServerWriter writer = OpenWriter(output);
+
+  EXPECT_EQ(OkStatus(),
+            WriteMultiBuf(writer.as_writer(), multibuf::MultiBuf()));
+  EXPECT_EQ(1, output.buffer_sends());
+
+  Result<Packet> packet = Packet::FromBuffer(output.last_packet());
+  ASSERT_EQ(OkStatus(), packet.status());
+  EXPECT_EQ(PacketType::SERVER_STREAM, packet->type());
+  EXPECT_TRUE(packet->payload().empty());
+
+  EXPECT_EQ(OkStatus(), writer.Finish());
+}
+
+TEST_F(MultiBufTest, InactiveCall_FailsAndReleasesPayload) {
+  RawServerWriter writer;
+  EXPECT_EQ(Status::FailedPrecondition(),
+            WriteMultiBuf(writer.as_writer(),
+                          AllocatePayload(
+                              MultiBufChannelOutput::kPacketHeaderSizeBytes)));
+
+  // The payload was released, so its memory can be allocated again.
+  EXPECT_TRUE(allocator_.AllocateContiguous(2048).has_value());
+}
+
+TEST_F(MultiBufTest, OutputError_ReturnsUnknown) {
+  TestMultiBufOutput output;
+  RawServerWriter writer = OpenWriter(output);
+  output.set_status(Status::Unavailable());
+
+  EXPECT_EQ(Status::Unknown(),
+            WriteMultiBuf(writer.as_writer(),
+                          AllocatePayload(
+                              MultiBufChannelOutput::kPacketHeaderSizeBytes)));
+  EXPECT_EQ(1, output.multibuf_sends());
+}
+
+// Counts the bytes written into buffers other than the payload's own buffer for
+// each packet sent.
+TEST_F(MultiBufTest, BytesCopiedPerPacket) {
+  TestMultiBufOutput output;
+  RawServerWriter writer = OpenWriter(output);
+
+  // Writer::Write copies the payload into the encoding buffer along with the
+  // header.
+  std::array<std::byte, kPayloadSize> contiguous_payload{};
+  ASSERT_EQ(OkStatus(), writer.Write(contiguous_payload));
+  const size_t copied_by_write = output.last_packet().size();
+
+  // WriteMultiBuf only writes the header, into the payload's headroom.
+  multibuf::MultiBuf payload =
+      AllocatePayload(MultiBufChannelOutput::kPacketHeaderSizeBytes);
+  ASSERT_EQ(OkStatus(), WriteMultiBuf(writer.as_writer(), std::move(payload)));
+  const size_t copied_by_write_multibuf =
+      output.last_packet().size() - kPayloadSize;
+
+  PW_LOG_INFO("Bytes copied for a %u-byte payload: Write %u, WriteMultiBuf %u",
+              static_cast<unsigned>(kPayloadSize),
+              static_cast<unsigned>(copied_by_write),
+              static_cast<unsigned>(copied_by_write_multibuf));
+
+  EXPECT_GE(copied_by_write, kPayloadSize);
+  EXPECT_LE(copied_by_write_multibuf,
+            MultiBufChannelOutput::kPacketHeaderSizeBytes);
+
+  EXPECT_EQ(OkStatus(), writer.Finish());
+}
+
+}  // namespace
+}  // namespace pw::rpc
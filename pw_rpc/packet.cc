@@ -14,8 +14,12 @@
 
 #include "pw_rpc/internal/packet.h"
 
+#include "pw_assert/assert.h"
 #include "pw_log/log.h"
 #include "pw_protobuf/decoder.h"
+#include "pw_protobuf/wire_format.h"
+#include "pw_status/try.h"
+#include "pw_varint/varint.h"
 
 namespace pw::rpc::internal {
 
@@ -112,6 +116,28 @@ Result<ConstByteSpan> Packet::Encode(ByteSpan buffer) const {
   return rpc_packet.status();
 }
 
+Result<ConstByteSpan> Packet::EncodeHeader(ByteSpan buffer,
+                                           size_t payload_size) const {
+  PW_DASSERT(payload_.empty());
+  PW_TRY_ASSIGN(const ConstByteSpan fields, Encode(buffer));
+  if (payload_size == 0u) {
+    return fields;
+  }
+
+  size_t size = fields.size();
+  const size_t key_size = varint::Encode(
+      static_cast<uint32_t>(protobuf::FieldKey(
+          static_cast<uint32_t>(RpcPacket::Fields::kPayload),
+          protobuf::WireType::kDelimited)),
+      buffer.subspan(size));
+  size += key_size;
+  const size_t length_size = varint::Encode(payload_size, buffer.subspan(size));
+  if (key_size == 0u || length_size == 0u) {
+    return Status::ResourceExhausted();
+  }
+  return buffer.first(size + length_size);
+}
+
 size_t Packet::MinEncodedSizeBytes() const {
   size_t reserved_size = 0;
 
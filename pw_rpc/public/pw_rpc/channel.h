@@ -19,6 +19,7 @@
 
 #include "pw_assert/assert.h"
 #include "pw_bytes/span.h"
+#include "pw_function/function.h"
 #include "pw_result/result.h"
 #include "pw_rpc/internal/config.h"
 #include "pw_rpc/internal/lock.h"
@@ -27,6 +28,9 @@
 #include "pw_status/status.h"
 
 namespace pw::rpc {
+
+class MultiBufChannelOutput;  // Defined in pw_rpc/multibuf.h
+
 namespace internal {
 namespace test {
 
@@ -127,7 +131,8 @@ class ChannelOutput {
   //
   // The RPC system’s internal lock is held while this function is called. Avoid
   // long-running operations, since these will delay any other users of the RPC
-  // system.
+  // system. If PW_RPC_CHANNEL_LOCKS is enabled, the channel's send lock is held
+  // instead, which only delays sends on channels that share the lock.
   //
   // !!! DANGER !!!
   //
@@ -143,6 +148,11 @@ class ChannelOutput {
   virtual Status Send(span<const std::byte> buffer)
       PW_EXCLUSIVE_LOCKS_REQUIRED(internal::rpc_lock()) = 0;
 
+  // Returns this output as a MultiBufChannelOutput if it can send packets
+  // without copying their payloads (see pw_rpc/multibuf.h), or nullptr if it
+  // cannot.
+  virtual MultiBufChannelOutput* AsMultiBufChannelOutput() { return nullptr; }
+
  private:
   const char* name_;
 };
@@ -212,8 +222,32 @@ class ChannelBase {
 
   // Invokes ChannelOutput::Send and returns its status. Any non-OK status
   // indicates that the Channel is permanently closed.
+  //
+  // If PW_RPC_CHANNEL_LOCKS is enabled, the RPC lock is released while the
+  // packet is sent, so state guarded by it may change and this ChannelBase may
+  // move before Send returns.
   Status Send(const Packet& packet) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
 
+  // Sends a packet whose payload is not in a contiguous buffer. Encodes the
+  // header of the packet, which must have an empty payload, for a
+  // payload_size-byte payload. Then, invokes send_packet with the channel's
+  // output and the header. send_packet must send the header immediately
+  // followed by the payload and return the output's status.
+  //
+  // send_packet is subject to the same restrictions as ChannelOutput::Send.
+  Status SendHeader(
+      const Packet& packet,
+      size_t payload_size,
+      const Function<Status(ChannelOutput&, ConstByteSpan)>& send_packet)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+
+  // Returns the channel's output as a MultiBufChannelOutput, or nullptr if the
+  // channel is closed or its output cannot send MultiBufs.
+  MultiBufChannelOutput* multibuf_output()
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+    return output_ == nullptr ? nullptr : output_->AsMultiBufChannelOutput();
+  }
+
   constexpr void Close() {
     PW_ASSERT(id_ != kUnassignedChannelId);
     id_ = kUnassignedChannelId;
@@ -225,6 +259,9 @@ class ChannelBase {
       : id_(id), output_(output) {}
 
  private:
+  // Logs a failed send and converts its status to UNKNOWN.
+  static Status CheckSendStatus(const Packet& packet, Status sent);
+
   uint32_t id_;
   ChannelOutput* output_;
 };
@@ -273,6 +310,8 @@ class Channel : public internal::ChannelBase {
   // Hide internal-only methods defined in the internal::ChannelBase.
   using internal::ChannelBase::Close;
   using internal::ChannelBase::Send;
+  using internal::ChannelBase::SendHeader;
+  using internal::ChannelBase::multibuf_output;
 };
 
 }  // namespace pw::rpc
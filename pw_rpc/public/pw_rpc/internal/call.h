@@ -300,8 +300,10 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
   // is closed.
   void SendInitialClientRequest(ConstByteSpan payload)
       PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+    // The call may have been closed by another thread if the RPC lock was
+    // released while sending (PW_RPC_CHANNEL_LOCKS).
     if (const Status status = SendPacket(pwpb::PacketType::REQUEST, payload);
-        !status.ok()) {
+        !status.ok() && active_locked()) {
       CloseAndMarkForCleanup(status);
     }
   }
@@ -544,6 +546,7 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
 
  private:
   friend class rpc::Writer;
+  friend class MultiBufWriter;
 
   enum State : uint8_t {
     kActive = 0b001,
@@ -598,6 +601,17 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
                     Status status = OkStatus())
       PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
 
+  // Sends a stream packet with a payload_size-byte payload that is not in a
+  // contiguous buffer. send_packet is invoked with the channel output and the
+  // encoded packet header, and must send the header followed by the payload.
+  // See ChannelBase::SendHeader.
+  //
+  // Returns FAILED_PRECONDITION if the call is not active().
+  Status WriteHeaderLocked(
+      size_t payload_size,
+      const Function<Status(ChannelOutput&, ConstByteSpan)>& send_packet)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+
   Status CloseAndSendFinalPacketLocked(pwpb::PacketType type,
                                        ConstByteSpan response,
                                        Status status)
@@ -608,10 +622,32 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
                                           Status status)
       PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
 
+#if PW_RPC_CHANNEL_LOCKS
+  // Closes and unregisters the call, then sends its final packet with the RPC
+  // lock released. If reopen_on_failure is true and the send fails, the call is
+  // registered again, unless its channel was closed or another call with its
+  // IDs was registered during the send.
+  Status CloseThenSendFinalPacketLocked(pwpb::PacketType type,
+                                        ConstByteSpan response,
+                                        Status status,
+                                        bool reopen_on_failure)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+#endif  // PW_RPC_CHANNEL_LOCKS
+
   bool CallbacksAreRunning() const PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
     return callbacks_executing_ != 0u;
   }
 
+  // True if a packet for this call is being sent with the RPC lock released.
+  // This is only possible if PW_RPC_CHANNEL_LOCKS is enabled.
+  bool SendsInProgress() const PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+#if PW_RPC_CHANNEL_LOCKS
+    return sends_in_progress_ != 0u;
+#else
+    return false;
+#endif  // PW_RPC_CHANNEL_LOCKS
+  }
+
   // Waits for callbacks to complete so that a call object can be destroyed.
   void WaitForCallbacksToComplete() PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
 
@@ -636,6 +672,12 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
   // call to be destroyed.
   uint8_t callbacks_executing_ PW_GUARDED_BY(rpc_lock());
 
+#if PW_RPC_CHANNEL_LOCKS
+  // Tracks how many threads are sending packets for this call with the RPC
+  // lock released. Must be 0 for the call to be destroyed or moved.
+  uint8_t sends_in_progress_ PW_GUARDED_BY(rpc_lock()) = 0;
+#endif  // PW_RPC_CHANNEL_LOCKS
+
   CallProperties properties_ PW_GUARDED_BY(rpc_lock());
 
   // Called when the RPC is terminated due to an error.
@@ -0,0 +1,115 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_containers/intrusive_list.h"
+#include "pw_rpc/internal/lock.h"
+#include "pw_span/span.h"
+#include "pw_sync/lock_annotations.h"
+
+namespace pw::rpc::internal {
+
+class Call;
+
+// Open-addressed hash table that maps (channel, service, method, call ID)
+// tuples to active calls. The bucket storage is provided by the user through
+// Endpoint::EnableCallIndex.
+//
+// Calls with an open call ID (kOpenCallId or kLegacyOpenCallId) may match
+// packets with any call ID, so they are counted but not stored in the table.
+//
+// The index is only used while it holds every active call. If a call cannot be
+// added because the table is full or another call has the same key, the index
+// is marked invalid and the endpoint falls back to scanning its call list. The
+// index is rebuilt once enough calls have finished for it to be half empty.
+//
+// Calls are located by key when they are removed, so Remove() must be called
+// before a call's channel or call ID changes.
+class CallIndex {
+ public:
+  constexpr CallIndex()
+      : buckets_(), count_(0), calls_(0), open_calls_(0), valid_(false) {}
+
+  CallIndex(const CallIndex&) = delete;
+  CallIndex& operator=(const CallIndex&) = delete;
+
+  // Whether the index holds every active call and may be used for lookups.
+  bool valid() const { return valid_; }
+
+  // Whether any active calls have an open call ID. These calls are not in the
+  // table and must be found by scanning the call list.
+  bool has_open_calls() const { return open_calls_ != 0u; }
+
+  // Replaces the bucket storage and indexes the provided calls. An empty span
+  // disables the index.
+  void Reset(span<Call*> buckets, IntrusiveList<Call>& calls)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+
+  // Clears the table and indexes the provided calls.
+  void Rebuild(IntrusiveList<Call>& calls)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+
+  // Adds a newly registered call. Invalidates the index on failure.
+  void Add(Call& call) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+
+  // Removes a call that is about to be unregistered.
+  void Remove(const Call& call) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+
+  // Rebuilds an invalid index if the remaining calls fit comfortably. Called
+  // after calls are removed from the call list.
+  void RebuildIfSparse(IntrusiveList<Call>& calls)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+    if (!valid_ && !buckets_.empty() && calls_ * 2 < buckets_.size()) {
+      Rebuild(calls);
+    }
+  }
+
+  // Returns the call with the provided key, or nullptr if there is none. Calls
+  // with open call IDs are never returned. Must only be called if valid() is
+  // true and call_id is not an open call ID.
+  Call* Find(uint32_t channel_id,
+             uint32_t service_id,
+             uint32_t method_id,
+             uint32_t call_id) const PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+
+ private:
+  size_t HomeBucket(uint32_t channel_id,
+                    uint32_t service_id,
+                    uint32_t method_id,
+                    uint32_t call_id) const;
+
+  size_t HomeBucket(const Call& call) const
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+
+  size_t Next(size_t bucket) const {
+    return bucket + 1 == buckets_.size() ? 0 : bucket + 1;
+  }
+
+  bool Insert(Call& call) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+
+  // Clears a bucket, shifting later entries in its probe sequence back so that
+  // lookups do not need tombstones.
+  void Erase(size_t bucket) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+
+  span<Call*> buckets_;
+  size_t count_;       // Calls stored in the table.
+  size_t calls_;       // All active calls, including open calls.
+  size_t open_calls_;  // Active calls with an open call ID.
+  bool valid_;
+};
+
+}  // namespace pw::rpc::internal
@@ -0,0 +1,86 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include "pw_rpc/internal/config.h"
+
+#if PW_RPC_CHANNEL_LOCKS
+
+#include <cstdint>
+
+#include "pw_containers/intrusive_list.h"
+#include "pw_rpc/internal/lock.h"
+#include "pw_sync/thread_notification.h"  // nogncheck
+
+namespace pw::rpc::internal {
+
+// Serializes ChannelOutput::Send() calls for the channels in one shard while
+// the RPC lock is released.
+//
+// Lock hierarchy: a ChannelSendLock is only acquired or released while holding
+// rpc_lock(), but it is held WITHOUT rpc_lock() while the packet is sent. A
+// thread never blocks on a ChannelSendLock while it holds rpc_lock(), and never
+// acquires a second ChannelSendLock.
+//
+// Senders are queued in FIFO order, so packets on a channel are sent in the
+// order in which their senders held rpc_lock(). The sender at the front of the
+// queue owns the lock.
+class ChannelSendLock {
+ public:
+  class Sender : public IntrusiveList<Sender>::Item {
+   public:
+    explicit Sender(uint32_t channel_id) : channel_id_(channel_id) {}
+
+    // Blocks until this sender owns the lock. Must NOT be called with the RPC
+    // lock held.
+    void Wait() PW_LOCKS_EXCLUDED(rpc_lock()) { ready_.acquire(); }
+
+   private:
+    friend class ChannelSendLock;
+
+    uint32_t channel_id_;
+    sync::ThreadNotification ready_;
+  };
+
+  constexpr ChannelSendLock() = default;
+
+  ChannelSendLock(const ChannelSendLock&) = delete;
+  ChannelSendLock& operator=(const ChannelSendLock&) = delete;
+
+  // Returns the lock for the shard that contains the channel.
+  static ChannelSendLock& ForChannel(uint32_t channel_id);
+
+  // Queues the sender. Returns true if the sender owns the lock immediately;
+  // otherwise, the sender must release rpc_lock() and Wait().
+  bool Enqueue(Sender& sender) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+    const bool acquired = senders_.empty();
+    senders_.push_back(sender);
+    return acquired;
+  }
+
+  // Releases the lock, which must be owned by the sender, and hands it to the
+  // next queued sender, if any.
+  void Release(Sender& sender) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+
+  // True if any send on the channel is queued or in progress.
+  bool HasSenders(uint32_t channel_id) const
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+
+ private:
+  IntrusiveList<Sender> senders_ PW_GUARDED_BY(rpc_lock());
+};
+
+}  // namespace pw::rpc::internal
+
+#endif  // PW_RPC_CHANNEL_LOCKS
@@ -249,6 +249,49 @@ static_assert(
 #define PW_RPC_ENCODING_BUFFER_SIZE_BYTES 512
 #endif  // PW_RPC_ENCODING_BUFFER_SIZE_BYTES
 
+/// Enables per-channel send locking. By default, the global RPC lock is held
+/// while a packet is passed to `ChannelOutput::Send()`, so only one thread can
+/// send at a time, regardless of channel. When `PW_RPC_CHANNEL_LOCKS` is
+/// enabled, each outgoing packet is encoded into its own buffer and the RPC
+/// lock is released while the packet is sent. Sends are instead serialized by
+/// one of @c_macro{PW_RPC_CHANNEL_LOCK_SHARDS} send locks, selected by channel
+/// ID, so threads that send on different channels do not wait on each other's
+/// `ChannelOutput`. Packets on a channel are still sent in order.
+///
+/// This mode requires @c_macro{PW_RPC_USE_GLOBAL_MUTEX} and
+/// @c_macro{PW_RPC_DYNAMIC_ALLOCATION}, and a backend for
+/// pw_sync:thread_notification.
+///
+/// Note: The dependencies of pw_rpc depend on the value of
+/// PW_RPC_CHANNEL_LOCKS. When building pw_rpc with Bazel, you should NOT set
+/// this module config value directly. Instead, tell the build system which
+/// value you wish to select by adding one of the following constraint_values to
+/// the target platform:
+///
+///   - `@pigweed//pw_rpc:channel_locks_false` (the default)
+///   - `@pigweed//pw_rpc:channel_locks_true`
+#ifndef PW_RPC_CHANNEL_LOCKS
+#define PW_RPC_CHANNEL_LOCKS 0
+#endif  // PW_RPC_CHANNEL_LOCKS
+
+#if PW_RPC_CHANNEL_LOCKS
+static_assert(PW_RPC_USE_GLOBAL_MUTEX == 1,
+              "PW_RPC_CHANNEL_LOCKS requires PW_RPC_USE_GLOBAL_MUTEX");
+static_assert(PW_RPC_DYNAMIC_ALLOCATION == 1,
+              "PW_RPC_CHANNEL_LOCKS requires PW_RPC_DYNAMIC_ALLOCATION, since "
+              "each in-flight packet needs its own encoding buffer");
+#endif  // PW_RPC_CHANNEL_LOCKS
+
+/// If @c_macro{PW_RPC_CHANNEL_LOCKS} is enabled, the number of channel send
+/// locks. Channels whose IDs are equal modulo this value share a lock. Each
+/// lock is an intrusive list head, so more shards cost little memory.
+#ifndef PW_RPC_CHANNEL_LOCK_SHARDS
+#define PW_RPC_CHANNEL_LOCK_SHARDS 8
+#endif  // PW_RPC_CHANNEL_LOCK_SHARDS
+
+static_assert(PW_RPC_CHANNEL_LOCK_SHARDS > 0,
+              "PW_RPC_CHANNEL_LOCK_SHARDS must be at least 1");
+
 /// The log level to use for this module. Logs below this level are omitted.
 #ifndef PW_RPC_CONFIG_LOG_LEVEL
 #define PW_RPC_CONFIG_LOG_LEVEL PW_LOG_LEVEL_INFO
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <array>
+#include <utility>
 
 #include "pw_assert/assert.h"
 #include "pw_bytes/span.h"
@@ -95,6 +96,16 @@ class DynamicEncodingBuffer {
     }
   }
 
+  // Transfers ownership of the packet buffer, which MUST have been allocated
+  // previously, to the caller. The buffer may then be used after the RPC lock
+  // is released.
+  PW_RPC_DYNAMIC_CONTAINER(std::byte) Take() {
+    PW_DASSERT(!buffer_.empty());
+    PW_RPC_DYNAMIC_CONTAINER(std::byte) buffer = std::move(buffer_);
+    buffer_.clear();
+    return buffer;
+  }
+
  private:
   void Allocate(size_t payload_size) {
     const size_t buffer_size =
@@ -20,6 +20,7 @@
 #include "pw_result/result.h"
 #include "pw_rpc/channel.h"
 #include "pw_rpc/internal/call.h"
+#include "pw_rpc/internal/call_index.h"
 #include "pw_rpc/internal/channel_list.h"
 #include "pw_rpc/internal/lock.h"
 #include "pw_rpc/internal/packet.h"
@@ -67,6 +68,25 @@ class Endpoint {
   // called with the ABORTED status.
   Status CloseChannel(uint32_t channel_id) PW_LOCKS_EXCLUDED(rpc_lock());
 
+  // Enables constant-time call lookup for incoming packets.
+  //
+  // By default, the endpoint finds the call for each stream, error, or response
+  // packet by scanning its list of active calls. With the index enabled, calls
+  // are also stored in an open-addressed hash table that uses the provided
+  // buckets. The table should have at least twice as many buckets as the
+  // expected number of concurrent calls. While the table is full, the endpoint
+  // falls back to scanning the list.
+  //
+  // Packets with an open call ID, and packets that may match a call with an
+  // open call ID, are still matched by scanning the list.
+  //
+  // The buckets must outlive the endpoint or a later call with an empty span,
+  // which disables the index.
+  void EnableCallIndex(span<Call*> buckets) PW_LOCKS_EXCLUDED(rpc_lock()) {
+    RpcLockGuard lock;
+    call_index_.Reset(buckets, calls_);
+  }
+
   // Internal functions, hidden by the Client and Server classes
 
   // Returns the number calls in the RPC calls list.
@@ -125,20 +145,8 @@ class Endpoint {
       PW_LOCKS_EXCLUDED(rpc_lock());
 
   // Finds a call object for an ongoing call associated with this packet, if
-  // any. The iterator will be calls_end() if no match was found.
-  IntrusiveList<Call>::iterator FindCall(const Packet& packet)
-      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
-    return std::get<1>(FindIteratorsForCall(packet.channel_id(),
-                                            packet.service_id(),
-                                            packet.method_id(),
-                                            packet.call_id()));
-  }
-
-  // Used to check if a call iterator is valid or not.
-  IntrusiveList<Call>::const_iterator calls_end() const
-      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
-    return calls_.end();
-  }
+  // any. Returns nullptr if no match was found.
+  Call* FindCall(const Packet& packet) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
 
   // Aborts calls associated with a particular service. Calls to
   // AbortCallsForService() must be followed by a call to CleanUpCalls().
@@ -153,8 +161,10 @@ class Endpoint {
   // This method is protected so it can be exposed in tests.
   void CloseCallAndMarkForCleanup(Call& call, Status error)
       PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+    call_index_.Remove(call);
     call.CloseAndMarkForCleanupFromEndpoint(error);
     calls_.remove(call);
+    call_index_.RebuildIfSparse(calls_);
     to_cleanup_.push_front(call);
   }
 
@@ -165,8 +175,10 @@ class Endpoint {
       IntrusiveList<Call>::iterator call_iterator,
       Status error) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
     Call& call = *call_iterator;
+    call_index_.Remove(call);
     call.CloseAndMarkForCleanupFromEndpoint(error);
     auto next = calls_.erase_after(before_call);
+    call_index_.RebuildIfSparse(calls_);
     to_cleanup_.push_front(call);
     return next;
   }
@@ -207,6 +219,7 @@ class Endpoint {
   // for existing calls.
   void RegisterUniqueCall(Call& call) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
     calls_.push_front(call);
+    call_index_.Add(call);
   }
 
   void CleanUpCall(Call& call) PW_UNLOCK_FUNCTION(rpc_lock()) {
@@ -215,11 +228,14 @@ class Endpoint {
     call.CleanUpFromEndpoint();
   }
 
-  // Removes the provided call from the call registry.
+  // Removes the provided call from the call registry. Must be called before
+  // the call is marked closed, since the call index locates calls by their IDs.
   void UnregisterCall(const Call& call)
       PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+    call_index_.Remove(call);
     bool closed_call_was_in_list = calls_.remove(call);
     PW_DASSERT(closed_call_was_in_list);
+    call_index_.RebuildIfSparse(calls_);
   }
 
   std::tuple<IntrusiveList<Call>::iterator, IntrusiveList<Call>::iterator>
@@ -255,6 +271,9 @@ class Endpoint {
   // this list when they start and removed from it when they finish.
   IntrusiveList<Call> calls_ PW_GUARDED_BY(rpc_lock());
 
+  // Optional hash index of calls_, enabled with EnableCallIndex().
+  CallIndex call_index_ PW_GUARDED_BY(rpc_lock());
+
   // List of all inactive calls that need to have their on_error callbacks
   // called. Calling on_error requires releasing the RPC lock, so calls are
   // added to this list in situations where releasing the mutex could be
@@ -110,6 +110,15 @@ class Packet {
   // Encodes the packet into its wire format. Returns the encoded size.
   Result<ConstByteSpan> Encode(ByteSpan buffer) const;
 
+  // Encodes every field of the packet except the payload bytes, which are sent
+  // separately. The payload field's key and length prefix are encoded last, so
+  // the payload_size bytes of payload must immediately follow the header. The
+  // packet's own payload must be empty.
+  //
+  // The header is at most kMinEncodedSizeWithoutPayload bytes.
+  Result<ConstByteSpan> EncodeHeader(ByteSpan buffer,
+                                     size_t payload_size) const;
+
   // Determines the space required to encode the packet proto fields for a
   // response, excluding the payload. This may be used to split the buffer into
   // reserved space and available space for the payload.
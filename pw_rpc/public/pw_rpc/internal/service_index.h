@@ -0,0 +1,77 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_containers/intrusive_list.h"
+#include "pw_span/span.h"
+
+namespace pw::rpc {
+
+class Service;
+
+namespace internal {
+
+// Open-addressed hash table that maps service IDs to registered services. The
+// bucket storage is provided by the user through Server::EnableServiceIndex.
+//
+// The index is only used while it holds every registered service. If a service
+// cannot be added because the table is full or another service has the same
+// ID, the index is marked invalid and the server falls back to scanning its
+// service list. The index is rebuilt whenever services are unregistered.
+class ServiceIndex {
+ public:
+  constexpr ServiceIndex() : buckets_(), count_(0), valid_(false) {}
+
+  ServiceIndex(const ServiceIndex&) = delete;
+  ServiceIndex& operator=(const ServiceIndex&) = delete;
+
+  // Whether the index holds every registered service and may be used for
+  // lookups.
+  bool valid() const { return valid_; }
+
+  // Replaces the bucket storage and indexes the provided services. An empty
+  // span disables the index.
+  void Reset(span<Service*> buckets, IntrusiveList<Service>& services);
+
+  // Clears the table and indexes the provided services.
+  void Rebuild(IntrusiveList<Service>& services);
+
+  // Adds a newly registered service. Invalidates the index on failure.
+  void Add(Service& service) {
+    if (valid_) {
+      valid_ = Insert(service);
+    }
+  }
+
+  // Returns the service with the provided ID, or nullptr if there is none.
+  // Must only be called if valid() is true.
+  Service* Find(uint32_t service_id) const;
+
+ private:
+  size_t HomeBucket(uint32_t service_id) const {
+    return service_id % buckets_.size();
+  }
+
+  bool Insert(Service& service);
+
+  span<Service*> buckets_;
+  size_t count_;
+  bool valid_;
+};
+
+}  // namespace internal
+}  // namespace pw::rpc
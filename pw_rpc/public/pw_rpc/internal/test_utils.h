@@ -35,7 +35,6 @@ namespace pw::rpc::internal {
 // Version of the Server with extra methods exposed for testing.
 class TestServer : public Server {
  public:
-  using Server::calls_end;
   using Server::CloseCallAndMarkForCleanup;
   using Server::FindCall;
 };
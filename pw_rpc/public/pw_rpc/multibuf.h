@@ -0,0 +1,87 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+
+#include "pw_multibuf/multibuf.h"
+#include "pw_rpc/channel.h"
+#include "pw_rpc/internal/lock.h"
+#include "pw_rpc/internal/packet.h"
+#include "pw_rpc/writer.h"
+#include "pw_status/status.h"
+
+namespace pw::rpc {
+
+/// A `ChannelOutput` that can take ownership of packets stored in a
+/// `pw::multibuf::MultiBuf`.
+///
+/// Payloads written with `WriteMultiBuf` are not copied into the RPC encoding
+/// buffer when sent through a `MultiBufChannelOutput`. Instead, the packet
+/// header is encoded into headroom reserved in front of the payload's first
+/// chunk, and the resulting `MultiBuf` is passed to `SendMultiBuf`.
+///
+/// Packets sent with `Call::Write` and other APIs are still encoded into the
+/// encoding buffer and passed to `Send`.
+class MultiBufChannelOutput : public ChannelOutput {
+ public:
+  /// Headroom to reserve in front of a payload so its packet header can be
+  /// encoded in place, e.g. with `Chunk::DiscardPrefix`.
+  static constexpr size_t kPacketHeaderSizeBytes =
+      internal::Packet::kMinEncodedSizeWithoutPayload;
+
+  /// Sends an encoded RPC packet, taking ownership of it.
+  ///
+  /// This function is subject to the same restrictions as
+  /// `ChannelOutput::Send`.
+  virtual Status SendMultiBuf(multibuf::MultiBuf&& packet)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(internal::rpc_lock()) = 0;
+
+  MultiBufChannelOutput* AsMultiBufChannelOutput() final { return this; }
+
+ protected:
+  constexpr MultiBufChannelOutput(const char* name) : ChannelOutput(name) {}
+};
+
+/// Sends a server or client stream packet with a payload stored in a
+/// `MultiBuf`.
+///
+/// If the channel's output is a `MultiBufChannelOutput` and the payload's
+/// first chunk has at least `MultiBufChannelOutput::kPacketHeaderSizeBytes` of
+/// headroom, the header is encoded into the headroom and the payload is sent
+/// without being copied. Otherwise, the payload is copied into the encoding
+/// buffer and sent with `ChannelOutput::Send`, like `Writer::Write`.
+///
+/// The payload is consumed, whether or not the write succeeds.
+///
+/// @returns @rst
+///
+/// .. pw-status-codes::
+///
+///    OK: The packet was sent.
+///
+///    FAILED_PRECONDITION: The call is not active.
+///
+///    UNAVAILABLE: The call's channel is not open.
+///
+///    RESOURCE_EXHAUSTED: The payload does not fit in the encoding buffer and
+///    could not be sent without copying it.
+///
+///    UNKNOWN: The channel output failed to send the packet.
+///
+/// @endrst
+Status WriteMultiBuf(Writer& writer, multibuf::MultiBuf&& payload)
+    PW_LOCKS_EXCLUDED(internal::rpc_lock());
+
+}  // namespace pw::rpc
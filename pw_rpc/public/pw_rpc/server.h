@@ -25,6 +25,7 @@
 #include "pw_rpc/internal/method.h"
 #include "pw_rpc/internal/method_info.h"
 #include "pw_rpc/internal/server_call.h"
+#include "pw_rpc/internal/service_index.h"
 #include "pw_rpc/service.h"
 #include "pw_span/span.h"
 #include "pw_status/status.h"
@@ -54,11 +55,28 @@ class Server : public internal::Endpoint {
   void RegisterService(Service& service, OtherServices&... services)
       PW_LOCKS_EXCLUDED(internal::rpc_lock()) {
     internal::RpcLockGuard lock;
-    services_.push_front(service);  // Register the first service
+    RegisterServiceLocked(service);  // Register the first service
 
     // Register any additional services by expanding the parameter pack. This
     // is a fold expression of the comma operator.
-    (services_.push_front(services), ...);
+    (RegisterServiceLocked(services), ...);
+  }
+
+  // Enables constant-time service lookup for incoming packets.
+  //
+  // By default, the server finds the service for each packet by scanning its
+  // list of registered services. With the index enabled, services are stored
+  // in an open-addressed hash table that uses the provided buckets. The table
+  // should have at least twice as many buckets as there are registered
+  // services. If a service does not fit, or two services share an ID, the
+  // server falls back to scanning the list until services are unregistered.
+  //
+  // The buckets must outlive the server or a later call with an empty span,
+  // which disables the index.
+  void EnableServiceIndex(span<Service*> buckets)
+      PW_LOCKS_EXCLUDED(internal::rpc_lock()) {
+    internal::RpcLockGuard lock;
+    service_index_.Reset(buckets, services_);
   }
 
   // Returns whether a service is registered.
@@ -83,6 +101,7 @@ class Server : public internal::Endpoint {
       PW_LOCKS_EXCLUDED(internal::rpc_lock()) {
     internal::rpc_lock().lock();
     UnregisterServiceLocked(service, static_cast<Service&>(services)...);
+    service_index_.Rebuild(services_);
     CleanUpCalls();
   }
 
@@ -189,13 +208,19 @@ class Server : public internal::Endpoint {
 
   void HandleCompletionRequest(const internal::Packet& packet,
                                internal::ChannelBase& channel,
-                               IntrusiveList<internal::Call>::iterator call)
-      const PW_UNLOCK_FUNCTION(internal::rpc_lock());
+                               internal::Call* call) const
+      PW_UNLOCK_FUNCTION(internal::rpc_lock());
 
   void HandleClientStreamPacket(const internal::Packet& packet,
                                 internal::ChannelBase& channel,
-                                IntrusiveList<internal::Call>::iterator call)
-      const PW_UNLOCK_FUNCTION(internal::rpc_lock());
+                                internal::Call* call) const
+      PW_UNLOCK_FUNCTION(internal::rpc_lock());
+
+  void RegisterServiceLocked(Service& service)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(internal::rpc_lock()) {
+    services_.push_front(service);
+    service_index_.Add(service);
+  }
 
   template <typename... OtherServices>
   void UnregisterServiceLocked(Service& service, OtherServices&... services)
@@ -217,6 +242,7 @@ class Server : public internal::Endpoint {
   using Endpoint::GetInternalChannel;
 
   IntrusiveList<Service> services_ PW_GUARDED_BY(internal::rpc_lock());
+  internal::ServiceIndex service_index_ PW_GUARDED_BY(internal::rpc_lock());
 };
 
 }  // namespace pw::rpc
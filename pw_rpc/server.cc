@@ -84,14 +84,14 @@ Status Server::ProcessPacket(internal::Packet packet) {
     return OkStatus();
   }
 
-  IntrusiveList<internal::Call>::iterator call = FindCall(packet);
+  internal::Call* call = FindCall(packet);
 
   switch (packet.type()) {
     case PacketType::CLIENT_STREAM:
       HandleClientStreamPacket(packet, *channel, call);
       break;
     case PacketType::CLIENT_ERROR:
-      if (call != calls_end()) {
+      if (call != nullptr) {
         PW_LOG_DEBUG("Server call %u for %u:%08x/%08x terminated with error %s",
                      static_cast<unsigned>(packet.call_id()),
                      static_cast<unsigned>(packet.channel_id()),
@@ -127,22 +127,31 @@ std::tuple<Service*, const internal::Method*> Server::FindMethod(
 
 std::tuple<Service*, const internal::Method*> Server::FindMethodLocked(
     uint32_t service_id, uint32_t method_id) {
-  auto service = std::find_if(services_.begin(), services_.end(), [&](auto& s) {
-    return internal::UnwrapServiceId(s.service_id()) == service_id;
-  });
+  Service* service = nullptr;
+
+  if (service_index_.valid()) {
+    service = service_index_.Find(service_id);
+  } else {
+    auto it = std::find_if(services_.begin(), services_.end(), [&](auto& s) {
+      return internal::UnwrapServiceId(s.service_id()) == service_id;
+    });
+    if (it != services_.end()) {
+      service = &(*it);
+    }
+  }
 
-  if (service == services_.end()) {
+  if (service == nullptr) {
     return {};
   }
 
-  return {&(*service), service->FindMethod(method_id)};
+  return {service, service->FindMethod(method_id)};
 }
 
 void Server::HandleCompletionRequest(
     const internal::Packet& packet,
     internal::ChannelBase& channel,
-    IntrusiveList<internal::Call>::iterator call) const {
-  if (call == calls_end()) {
+    internal::Call* call) const {
+  if (call == nullptr) {
     channel.Send(Packet::ServerError(packet, Status::FailedPrecondition()))
         .IgnoreError();  // Errors are logged in Channel::Send.
     internal::rpc_lock().unlock();
@@ -170,8 +179,8 @@ void Server::HandleCompletionRequest(
 void Server::HandleClientStreamPacket(
     const internal::Packet& packet,
     internal::ChannelBase& channel,
-    IntrusiveList<internal::Call>::iterator call) const {
-  if (call == calls_end()) {
+    internal::Call* call) const {
+  if (call == nullptr) {
     channel.Send(Packet::ServerError(packet, Status::FailedPrecondition()))
         .IgnoreError();  // Errors are logged in Channel::Send.
     internal::rpc_lock().unlock();
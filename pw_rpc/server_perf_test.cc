@@ -0,0 +1,193 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+
+#include "pw_perf_test/perf_test.h"
+#include "pw_rpc/internal/packet.h"
+#include "pw_rpc/server.h"
+#include "pw_rpc/service.h"
+#include "pw_rpc_private/fake_server_reader_writer.h"
+#include "pw_rpc_private/test_method.h"
+#include "pw_span/span.h"
+
+namespace pw::rpc {
+
+class ServerTestHelper {
+ public:
+  static std::tuple<Service*, const internal::Method*> FindMethod(
+      Server& server, uint32_t service_id, uint32_t method_id) {
+    return server.FindMethod(service_id, method_id);
+  }
+};
+
+namespace {
+
+using internal::Packet;
+using internal::TestMethod;
+using internal::TestMethodUnion;
+using internal::pwpb::PacketType;
+using internal::test::FakeServerReaderWriter;
+
+constexpr uint32_t kMethodId = 200;
+
+// Service IDs are hashes of the service name, so spread the IDs out.
+constexpr uint32_t ServiceIdForIndex(size_t index) {
+  return static_cast<uint32_t>((index + 1) * 0x9E3779B9u);
+}
+
+class LookupService : public Service {
+ public:
+  constexpr LookupService(uint32_t id)
+      : Service(id, methods_), methods_{TestMethod(100), TestMethod(200)} {}
+
+ private:
+  std::array<TestMethodUnion, 2> methods_;
+};
+
+template <size_t... kIndices>
+std::array<LookupService, sizeof...(kIndices)> MakeServices(
+    std::index_sequence<kIndices...>) {
+  return {LookupService(ServiceIdForIndex(kIndices))...};
+}
+
+auto services_1 = MakeServices(std::make_index_sequence<1>());
+auto services_10 = MakeServices(std::make_index_sequence<10>());
+auto services_100 = MakeServices(std::make_index_sequence<100>());
+
+// Looks up a method of the first service registered. Services are stored in
+// reverse registration order, so this is the slowest lookup without the index.
+void FindMethodTest(perf_test::State& state,
+                    span<LookupService> services,
+                    bool indexed) {
+  std::array<Service*, 256> buckets{};
+  std::array<Channel, 1> channels{};
+  Server server(channels);
+  for (LookupService& service : services) {
+    server.RegisterService(service);
+  }
+  if (indexed) {
+    server.EnableServiceIndex(buckets);
+  }
+
+  const uint32_t service_id = ServiceIdForIndex(0);
+  while (state.KeepRunning()) {
+    std::ignore = ServerTestHelper::FindMethod(server, service_id, kMethodId);
+  }
+
+  for (LookupService& service : services) {
+    server.UnregisterService(service);
+  }
+}
+
+PW_PERF_TEST(FindMethodList1Service, FindMethodTest, services_1, false);
+PW_PERF_TEST(FindMethodIndexed1Service, FindMethodTest, services_1, true);
+PW_PERF_TEST(FindMethodList10Services, FindMethodTest, services_10, false);
+PW_PERF_TEST(FindMethodIndexed10Services, FindMethodTest, services_10, true);
+PW_PERF_TEST(FindMethodList100Services, FindMethodTest, services_100, false);
+PW_PERF_TEST(FindMethodIndexed100Services,
+             FindMethodTest,
+             services_100,
+             true);
+
+class DiscardingOutput : public ChannelOutput {
+ public:
+  constexpr DiscardingOutput() : ChannelOutput("discard") {}
+
+  Status Send(span<const std::byte>) override { return OkStatus(); }
+};
+
+constexpr uint32_t kStreamServiceId = 42;
+constexpr uint32_t kStreamMethodId = 100;
+constexpr size_t kMaxCalls = 1000;
+
+class StreamService : public Service {
+ public:
+  constexpr StreamService()
+      : Service(kStreamServiceId, methods_),
+        methods_{TestMethod(kStreamMethodId,
+                            MethodType::kBidirectionalStreaming)} {}
+
+  const internal::Method& method() const { return methods_[0].method(); }
+
+ private:
+  std::array<TestMethodUnion, 1> methods_;
+};
+
+DiscardingOutput discarding_output;
+StreamService stream_service;
+std::array<FakeServerReaderWriter, kMaxCalls> stream_calls;
+std::array<internal::Call*, 2 * kMaxCalls> call_buckets{};
+
+// Dispatches a client stream packet to the oldest of `call_count` concurrent
+// calls. Calls are stored in reverse start order, so this is the slowest
+// lookup without the call index.
+void DispatchClientStreamTest(perf_test::State& state,
+                              size_t call_count,
+                              bool indexed) {
+  std::array<Channel, 1> channels{Channel::Create<1>(&discarding_output)};
+  Server server(channels);
+  server.RegisterService(stream_service);
+  if (indexed) {
+    server.EnableCallIndex(call_buckets);
+  }
+
+  for (size_t i = 0; i < call_count; ++i) {
+    internal::rpc_lock().lock();
+    FakeServerReaderWriter call(
+        internal::CallContext(server,
+                              1,
+                              stream_service,
+                              stream_service.method(),
+                              static_cast<uint32_t>(i + 1))
+            .ClaimLocked());
+    internal::rpc_lock().unlock();
+    stream_calls[i] = std::move(call);
+  }
+
+  std::byte packet_buffer[32];
+  const Result<ConstByteSpan> packet = Packet(PacketType::CLIENT_STREAM,
+                                              1,
+                                              kStreamServiceId,
+                                              kStreamMethodId,
+                                              /*call_id=*/1,
+                                              {})
+                                           .Encode(packet_buffer);
+
+  while (state.KeepRunning()) {
+    server.ProcessPacket(*packet).IgnoreError();
+  }
+
+  for (size_t i = 0; i < call_count; ++i) {
+    stream_calls[i].Finish().IgnoreError();
+  }
+  server.EnableCallIndex({});
+  server.UnregisterService(stream_service);
+}
+
+PW_PERF_TEST(DispatchList1Call, DispatchClientStreamTest, 1, false);
+PW_PERF_TEST(DispatchIndexed1Call, DispatchClientStreamTest, 1, true);
+PW_PERF_TEST(DispatchList10Calls, DispatchClientStreamTest, 10, false);
+PW_PERF_TEST(DispatchIndexed10Calls, DispatchClientStreamTest, 10, true);
+PW_PERF_TEST(DispatchList100Calls, DispatchClientStreamTest, 100, false);
+PW_PERF_TEST(DispatchIndexed100Calls, DispatchClientStreamTest, 100, true);
+PW_PERF_TEST(DispatchList1000Calls, DispatchClientStreamTest, 1000, false);
+PW_PERF_TEST(DispatchIndexed1000Calls, DispatchClientStreamTest, 1000, true);
+
+}  // namespace
+}  // namespace pw::rpc
@@ -35,6 +35,11 @@ class ServerTestHelper {
       Server& server, uint32_t service_id, uint32_t method_id) {
     return server.FindMethod(service_id, method_id);
   }
+
+  static bool ServiceIndexValid(Server& server) {
+    internal::RpcLockGuard lock;
+    return server.service_index_.valid();
+  }
 };
 
 namespace {
@@ -457,6 +462,118 @@ TEST_F(BasicServer, FindMethod_NotFound) {
   }
 }
 
+TEST_F(BasicServer, ServiceIndex_FindsRegisteredServices) {
+  std::array<Service*, 8> buckets{};
+  server_.EnableServiceIndex(buckets);
+  ASSERT_TRUE(ServerTestHelper::ServiceIndexValid(server_));
+
+  auto [service_1, method_1] = ServerTestHelper::FindMethod(server_, 1, 100);
+  EXPECT_EQ(service_1, &service_1_);
+  EXPECT_NE(method_1, nullptr);
+
+  auto [service_42, method_42] = ServerTestHelper::FindMethod(server_, 42, 200);
+  EXPECT_EQ(service_42, &service_42_);
+  EXPECT_NE(method_42, nullptr);
+
+  auto [missing, missing_method] =
+      ServerTestHelper::FindMethod(server_, 2, 100);
+  EXPECT_EQ(missing, nullptr);
+  EXPECT_EQ(missing_method, nullptr);
+}
+
+TEST_F(BasicServer, ServiceIndex_CollidingIds) {
+  std::array<Service*, 8> buckets{};
+  server_.EnableServiceIndex(buckets);
+
+  // 1, 9, 17, and 25 share a home bucket with 8 buckets.
+  TestService service_9(9);
+  TestService service_17(17);
+  server_.RegisterService(service_9, service_17);
+  ASSERT_TRUE(ServerTestHelper::ServiceIndexValid(server_));
+
+  EXPECT_EQ(std::get<Service*>(ServerTestHelper::FindMethod(server_, 1, 100)),
+            &service_1_);
+  EXPECT_EQ(std::get<Service*>(ServerTestHelper::FindMethod(server_, 9, 100)),
+            &service_9);
+  EXPECT_EQ(std::get<Service*>(ServerTestHelper::FindMethod(server_, 17, 100)),
+            &service_17);
+  EXPECT_EQ(std::get<Service*>(ServerTestHelper::FindMethod(server_, 25, 100)),
+            nullptr);
+
+  // Removing a service from the middle of a probe sequence rebuilds the index.
+  server_.UnregisterService(service_9);
+  ASSERT_TRUE(ServerTestHelper::ServiceIndexValid(server_));
+  EXPECT_EQ(std::get<Service*>(ServerTestHelper::FindMethod(server_, 9, 100)),
+            nullptr);
+  EXPECT_EQ(std::get<Service*>(ServerTestHelper::FindMethod(server_, 17, 100)),
+            &service_17);
+}
+
+TEST_F(BasicServer, ServiceIndex_FullFallsBackToList) {
+  // Four buckets hold at most three services.
+  std::array<Service*, 4> buckets{};
+  server_.EnableServiceIndex(buckets);
+  ASSERT_TRUE(ServerTestHelper::ServiceIndexValid(server_));
+
+  TestService service_5(5);
+  server_.RegisterService(service_5);
+  EXPECT_FALSE(ServerTestHelper::ServiceIndexValid(server_));
+  EXPECT_EQ(std::get<Service*>(ServerTestHelper::FindMethod(server_, 5, 100)),
+            &service_5);
+  EXPECT_EQ(std::get<Service*>(ServerTestHelper::FindMethod(server_, 42, 100)),
+            &service_42_);
+
+  server_.UnregisterService(service_5);
+  EXPECT_TRUE(ServerTestHelper::ServiceIndexValid(server_));
+  EXPECT_EQ(std::get<Service*>(ServerTestHelper::FindMethod(server_, 5, 100)),
+            nullptr);
+}
+
+TEST_F(BasicServer, ServiceIndex_DuplicateIdFallsBackToList) {
+  std::array<Service*, 16> buckets{};
+  server_.EnableServiceIndex(buckets);
+
+  TestService duplicate_42(42);
+  server_.RegisterService(duplicate_42);
+  EXPECT_FALSE(ServerTestHelper::ServiceIndexValid(server_));
+
+  // The most recently registered service wins, as without the index.
+  EXPECT_EQ(std::get<Service*>(ServerTestHelper::FindMethod(server_, 42, 100)),
+            &duplicate_42);
+
+  server_.UnregisterService(duplicate_42);
+  EXPECT_TRUE(ServerTestHelper::ServiceIndexValid(server_));
+  EXPECT_EQ(std::get<Service*>(ServerTestHelper::FindMethod(server_, 42, 100)),
+            &service_42_);
+}
+
+TEST_F(BasicServer, ServiceIndex_ProcessPacket) {
+  std::array<Service*, 8> buckets{};
+  server_.EnableServiceIndex(buckets);
+
+  EXPECT_EQ(OkStatus(),
+            server_.ProcessPacket(
+                EncodePacket(PacketType::REQUEST, 1, 42, 100)));
+  EXPECT_EQ(service_42_.method(100).last_channel_id(), 1u);
+
+  EXPECT_EQ(OkStatus(),
+            server_.ProcessPacket(
+                EncodePacket(PacketType::REQUEST, 1, 43, 27)));
+  const Packet& packet =
+      static_cast<internal::test::FakeChannelOutput&>(output_).last_packet();
+  EXPECT_EQ(packet.type(), PacketType::SERVER_ERROR);
+  EXPECT_EQ(packet.status(), Status::NotFound());
+}
+
+TEST_F(BasicServer, ServiceIndex_Disable) {
+  std::array<Service*, 8> buckets{};
+  server_.EnableServiceIndex(buckets);
+  server_.EnableServiceIndex({});
+  EXPECT_FALSE(ServerTestHelper::ServiceIndexValid(server_));
+  EXPECT_EQ(std::get<Service*>(ServerTestHelper::FindMethod(server_, 42, 100)),
+            &service_42_);
+}
+
 class BidiMethod : public BasicServer {
  protected:
   BidiMethod() {
@@ -767,6 +884,152 @@ TEST_F(BidiMethod, ClientRequestedCompletion_ErrorWhenAlreadyClosed) {
   EXPECT_EQ(packet.status(), Status::FailedPrecondition());
 }
 
+class IndexedBidiMethod : public BidiMethod {
+ protected:
+  IndexedBidiMethod() { server_.EnableCallIndex(call_buckets_); }
+
+  // The responders outlive the buckets, so disable the index first.
+  ~IndexedBidiMethod() override { server_.EnableCallIndex({}); }
+
+  internal::test::FakeServerReaderWriter MakeResponder(uint32_t call_id) {
+    internal::RpcLockGuard lock;
+    return internal::test::FakeServerReaderWriter(
+        internal::CallContext(server_,
+                              channels_[0].id(),
+                              service_42_,
+                              service_42_.method(100),
+                              call_id)
+            .ClaimLocked());
+  }
+
+  std::array<internal::Call*, 8> call_buckets_{};
+};
+
+TEST_F(IndexedBidiMethod, ClientStream_CallsCallback) {
+  ConstByteSpan data = as_bytes(span("?"));
+  responder_.set_on_next([&data](ConstByteSpan payload) { data = payload; });
+
+  ASSERT_EQ(OkStatus(),
+            server_.ProcessPacket(
+                PacketForRpc(PacketType::CLIENT_STREAM, {}, "hello")));
+
+  EXPECT_EQ(output_.total_packets(), 0u);
+  EXPECT_STREQ(span_as_cstr(data), "hello");
+}
+
+TEST_F(IndexedBidiMethod, ClientStream_EachCallGetsItsPackets) {
+  constexpr uint32_t kSecondCallId = 1625;
+  internal::test::FakeServerReaderWriter responder_2 =
+      MakeResponder(kSecondCallId);
+
+  ConstByteSpan data_1 = as_bytes(span("data_1_unset"));
+  responder_.set_on_next(
+      [&data_1](ConstByteSpan payload) { data_1 = payload; });
+
+  ConstByteSpan data_2 = as_bytes(span("data_2_unset"));
+  responder_2.set_on_next(
+      [&data_2](ConstByteSpan payload) { data_2 = payload; });
+
+  EXPECT_EQ(
+      OkStatus(),
+      server_.ProcessPacket(PacketForRpc(
+          PacketType::CLIENT_STREAM, OkStatus(), "hello_2", kSecondCallId)));
+  EXPECT_STREQ(span_as_cstr(data_2), "hello_2");
+
+  // Cancelling one call leaves the other reachable.
+  EXPECT_EQ(OkStatus(), server_.ProcessPacket(EncodeCancel()));
+  EXPECT_FALSE(responder_.active());
+  EXPECT_TRUE(responder_2.active());
+
+  EXPECT_EQ(
+      OkStatus(),
+      server_.ProcessPacket(PacketForRpc(
+          PacketType::CLIENT_STREAM, OkStatus(), "again_2", kSecondCallId)));
+  EXPECT_STREQ(span_as_cstr(data_2), "again_2");
+  EXPECT_STREQ(span_as_cstr(data_1), "data_1_unset");
+}
+
+TEST_F(IndexedBidiMethod, ClientStream_ClosedCallNotFound) {
+  ASSERT_EQ(OkStatus(), server_.ProcessPacket(EncodeCancel()));
+  ASSERT_FALSE(responder_.active());
+
+  ASSERT_EQ(OkStatus(),
+            server_.ProcessPacket(
+                PacketForRpc(PacketType::CLIENT_STREAM, {}, "hello")));
+
+  ASSERT_EQ(output_.total_packets(), 1u);
+  const Packet& packet =
+      static_cast<internal::test::FakeChannelOutput&>(output_).last_packet();
+  EXPECT_EQ(packet.type(), PacketType::SERVER_ERROR);
+  EXPECT_EQ(packet.status(), Status::FailedPrecondition());
+}
+
+TEST_F(IndexedBidiMethod, ClientStream_OpenIdCallAdoptsCallId) {
+  constexpr uint32_t kSecondCallId = 1625;
+  responder_ = MakeResponder(internal::kOpenCallId);
+  const size_t packets_before = output_.total_packets();
+
+  int received = 0;
+  responder_.set_on_next([&received](ConstByteSpan) { received += 1; });
+
+  ASSERT_EQ(OkStatus(),
+            server_.ProcessPacket(PacketForRpc(
+                PacketType::CLIENT_STREAM, {}, "hello", kSecondCallId)));
+  EXPECT_EQ(received, 1);
+
+  // The adopted ID is now indexed, so later packets find the call.
+  ASSERT_EQ(OkStatus(),
+            server_.ProcessPacket(PacketForRpc(
+                PacketType::CLIENT_STREAM, {}, "again", kSecondCallId)));
+  EXPECT_EQ(received, 2);
+  EXPECT_EQ(output_.total_packets(), packets_before);
+
+  // Other call IDs no longer match the call.
+  ASSERT_EQ(OkStatus(),
+            server_.ProcessPacket(PacketForRpc(
+                PacketType::CLIENT_STREAM, {}, "other", kSecondCallId + 1)));
+  EXPECT_EQ(received, 2);
+  EXPECT_EQ(output_.total_packets(), packets_before + 1);
+}
+
+TEST_F(IndexedBidiMethod, ClientStream_FullIndexFallsBackToList) {
+  int received = 0;
+  responder_.set_on_next([&received](ConstByteSpan) { received += 1; });
+
+  // Eight buckets hold at most seven calls.
+  std::array<internal::test::FakeServerReaderWriter, 8> others = {
+      MakeResponder(2),
+      MakeResponder(3),
+      MakeResponder(4),
+      MakeResponder(5),
+      MakeResponder(6),
+      MakeResponder(7),
+      MakeResponder(8),
+      MakeResponder(9),
+  };
+
+  int other_received = 0;
+  others.back().set_on_next(
+      [&other_received](ConstByteSpan) { other_received += 1; });
+
+  ASSERT_EQ(OkStatus(),
+            server_.ProcessPacket(
+                PacketForRpc(PacketType::CLIENT_STREAM, {}, "last", 9)));
+  EXPECT_EQ(other_received, 1);
+
+  // The index is rebuilt once the other calls finish.
+  for (uint32_t call_id = 2; call_id <= 9; ++call_id) {
+    ASSERT_EQ(OkStatus(),
+              server_.ProcessPacket(EncodeCancel(1, 42, 100, call_id)));
+  }
+
+  ASSERT_EQ(OkStatus(),
+            server_.ProcessPacket(
+                PacketForRpc(PacketType::CLIENT_STREAM, {}, "hello")));
+  EXPECT_EQ(received, 1);
+  EXPECT_EQ(output_.total_packets(), 0u);
+}
+
 class ServerStreamingMethod : public BasicServer {
  protected:
   ServerStreamingMethod() {
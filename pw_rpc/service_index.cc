@@ -0,0 +1,71 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_rpc/internal/service_index.h"
+
+#include <algorithm>
+
+#include "pw_rpc/service.h"
+
+namespace pw::rpc::internal {
+
+void ServiceIndex::Reset(span<Service*> buckets,
+                         IntrusiveList<Service>& services) {
+  buckets_ = buckets;
+  Rebuild(services);
+}
+
+void ServiceIndex::Rebuild(IntrusiveList<Service>& services) {
+  std::fill(buckets_.begin(), buckets_.end(), nullptr);
+  count_ = 0;
+  valid_ = !buckets_.empty();
+
+  for (Service& service : services) {
+    Add(service);
+  }
+}
+
+bool ServiceIndex::Insert(Service& service) {
+  // Always leave at least one empty bucket so that lookups terminate.
+  if (count_ + 1 >= buckets_.size()) {
+    return false;
+  }
+
+  const uint32_t service_id = UnwrapServiceId(service.service_id());
+  size_t bucket = HomeBucket(service_id);
+
+  while (buckets_[bucket] != nullptr) {
+    if (UnwrapServiceId(buckets_[bucket]->service_id()) == service_id) {
+      return false;  // Duplicate IDs are resolved by the service list.
+    }
+    bucket = (bucket + 1) % buckets_.size();
+  }
+
+  buckets_[bucket] = &service;
+  count_ += 1;
+  return true;
+}
+
+Service* ServiceIndex::Find(uint32_t service_id) const {
+  for (size_t bucket = HomeBucket(service_id);; /* no condition */) {
+    Service* const service = buckets_[bucket];
+    if (service == nullptr ||
+        UnwrapServiceId(service->service_id()) == service_id) {
+      return service;
+    }
+    bucket = (bucket + 1) % buckets_.size();
+  }
+}
+
+}  // namespace pw::rpc::internal
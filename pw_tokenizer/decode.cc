@@ -17,7 +17,9 @@
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <charconv>
 #include <cstring>
+#include <limits>
 #include <string>
 
 #include "pw_varint/varint.h"
@@ -91,6 +93,86 @@ std::string ErrorMessage(ArgStatus status,
   return result;
 }
 
+// True if the conversion specifier is %d, %i, or %u with no flags, width, or
+// precision, and a length that std::to_chars formats the same as snprintf.
+bool IsPlainDecimal(std::string_view spec) {
+  const char conversion = spec.back();
+  if (conversion != 'd' && conversion != 'i' && conversion != 'u') {
+    return false;
+  }
+  const std::string_view length = spec.substr(1, spec.size() - 2);
+  return length.empty() || length == "l" || length == "ll" || length == "j" ||
+         length == "z" || length == "t";
+}
+
+// Writes formatted text to a fixed buffer, like snprintf. Once the buffer is
+// full, further text is dropped, but decoding continues so that decoding
+// errors are still detected.
+class OutputBuffer {
+ public:
+  constexpr OutputBuffer(span<char> output) : output_(output), size_(0) {}
+
+  void Append(const char* text, size_t size) {
+    if (truncated_ || output_.empty()) {
+      truncated_ = true;
+      return;
+    }
+    const size_t available = output_.size() - size_ - 1;
+    if (size > available) {
+      size = available;
+      truncated_ = true;
+    }
+    std::memcpy(output_.data() + size_, text, size);
+    size_ += size;
+  }
+
+  template <typename T>
+  void AppendDecimal(T value) {
+    std::array<char, std::numeric_limits<T>::digits10 + 3> digits;
+    const auto result =
+        std::to_chars(digits.data(), digits.data() + digits.size(), value);
+    Append(digits.data(), static_cast<size_t>(result.ptr - digits.data()));
+  }
+
+  // Formats a value with snprintf. Returns false if snprintf failed.
+  template <typename T>
+  bool Printf(const char* format, T value) {
+    if (truncated_ || output_.empty()) {
+      truncated_ = true;
+      return true;
+    }
+    const size_t available = output_.size() - size_;
+    PW_MODIFY_DIAGNOSTICS_PUSH();
+    PW_MODIFY_DIAGNOSTIC(ignored, "-Wformat-nonliteral");
+    const int result =
+        std::snprintf(output_.data() + size_, available, format, value);
+    PW_MODIFY_DIAGNOSTICS_POP();
+    if (result < 0) {
+      return false;
+    }
+    if (static_cast<size_t>(result) >= available) {
+      size_ = output_.size() - 1;
+      truncated_ = true;
+    } else {
+      size_ += static_cast<size_t>(result);
+    }
+    return true;
+  }
+
+  StatusWithSize Finish() {
+    if (!output_.empty()) {
+      output_[size_] = '\0';
+    }
+    return truncated_ ? StatusWithSize::ResourceExhausted(size_)
+                      : StatusWithSize(size_);
+  }
+
+ private:
+  span<char> output_;
+  size_t size_;
+  bool truncated_ = false;
+};
+
 }  // namespace
 
 DecodedArg::DecodedArg(ArgStatus error,
@@ -338,6 +420,45 @@ FormatString::FormatString(const char* format) {
     segments_.emplace_back(
         std::string_view(text_start, static_cast<size_t>(format - text_start)));
   }
+
+  Compile();
+}
+
+void FormatString::Compile() {
+  for (const StringSegment& segment : segments_) {
+    const std::string_view text = segment.type_ == StringSegment::kPercent
+                                      ? std::string_view("%")
+                                      : std::string_view(segment.text_);
+
+    if (segment.is_literal()) {
+      // Extend the previous literal, if any.
+      if (!program_.empty() &&
+          program_.back().type == StringSegment::kLiteral) {
+        program_text_.append(text);
+        program_.back().text_size += static_cast<uint32_t>(text.size());
+        continue;
+      }
+      program_.push_back({StringSegment::kLiteral,
+                          segment.local_size_,
+                          true,
+                          static_cast<uint32_t>(program_text_.size()),
+                          static_cast<uint32_t>(text.size())});
+      program_text_.append(text);
+      continue;
+    }
+
+    const bool plain = segment.type_ == StringSegment::kString
+                           ? text == "%s"
+                           : segment.type_ != StringSegment::kFloatingPoint &&
+                                 IsPlainDecimal(text);
+    program_.push_back({segment.type_,
+                        segment.local_size_,
+                        plain,
+                        static_cast<uint32_t>(program_text_.size()),
+                        static_cast<uint32_t>(text.size())});
+    program_text_.append(text);
+    program_text_.push_back('\0');
+  }
 }
 
 DecodedFormatString FormatString::Format(span<const uint8_t> arguments) const {
@@ -361,4 +482,119 @@ DecodedFormatString FormatString::Format(span<const uint8_t> arguments) const {
   return DecodedFormatString(std::move(results), arguments.size());
 }
 
+StatusWithSize FormatString::FormatTo(span<const uint8_t> arguments,
+                                      span<char> output) const {
+  OutputBuffer buffer(output);
+
+  for (const Instruction& instruction : program_) {
+    const char* text = InstructionText(instruction);
+
+    switch (instruction.type) {
+      case StringSegment::kLiteral:
+      case StringSegment::kPercent:
+        buffer.Append(text, instruction.text_size);
+        break;
+      case StringSegment::kString: {
+        if (arguments.empty()) {
+          return StatusWithSize::DataLoss();
+        }
+        const bool truncated = (arguments[0] & 0x80u) != 0u;
+        const size_t size = arguments[0] & 0x7Fu;
+        if (arguments.size() - 1 < size) {
+          return StatusWithSize::DataLoss();
+        }
+        const char* value = reinterpret_cast<const char*>(&arguments[1]);
+        arguments = arguments.subspan(1 + size);
+
+        constexpr std::string_view kTruncated = "[...]";
+        if (instruction.plain) {
+          // As with snprintf, the string ends at a null character, which also
+          // hides the truncation marker.
+          const char* end =
+              static_cast<const char*>(std::memchr(value, '\0', size));
+          if (end != nullptr) {
+            buffer.Append(value, static_cast<size_t>(end - value));
+          } else {
+            buffer.Append(value, size);
+            if (truncated) {
+              buffer.Append(kTruncated.data(), kTruncated.size());
+            }
+          }
+          break;
+        }
+
+        // snprintf needs a null-terminated string, as in DecodeString().
+        std::array<char, 0x7F + kTruncated.size() + 1> string;
+        std::memcpy(string.data(), value, size);
+        size_t string_size = size;
+        if (truncated) {
+          std::memcpy(string.data() + string_size,
+                      kTruncated.data(),
+                      kTruncated.size());
+          string_size += kTruncated.size();
+        }
+        string[string_size] = '\0';
+        if (!buffer.Printf(text, string.data())) {
+          return StatusWithSize::DataLoss();
+        }
+        break;
+      }
+      case StringSegment::kSignedInt:
+      case StringSegment::kUnsigned32:
+      case StringSegment::kUnsigned64: {
+        int64_t value;
+        const size_t bytes =
+            arguments.empty() ? 0 : varint::Decode(as_bytes(arguments), &value);
+        if (bytes == 0u) {
+          return StatusWithSize::DataLoss();
+        }
+        arguments = arguments.subspan(bytes);
+
+        // Match the conversions in DecodeInteger().
+        if (instruction.type == StringSegment::kUnsigned32) {
+          value &= 0xFFFFFFFFu;
+        }
+        const bool is_32_bit = instruction.local_size == StringSegment::k32Bit;
+        if (!instruction.plain) {
+          const bool printed =
+              is_32_bit ? buffer.Printf(text, static_cast<uint32_t>(value))
+                        : buffer.Printf(text, value);
+          if (!printed) {
+            return StatusWithSize::DataLoss();
+          }
+        } else if (instruction.type == StringSegment::kSignedInt) {
+          if (is_32_bit) {
+            buffer.AppendDecimal(
+                static_cast<int32_t>(static_cast<uint32_t>(value)));
+          } else {
+            buffer.AppendDecimal(value);
+          }
+        } else if (is_32_bit) {
+          buffer.AppendDecimal(static_cast<uint32_t>(value));
+        } else {
+          buffer.AppendDecimal(static_cast<uint64_t>(value));
+        }
+        break;
+      }
+      case StringSegment::kFloatingPoint: {
+        float value;
+        if (arguments.size() < sizeof(value)) {
+          return StatusWithSize::DataLoss();
+        }
+        std::memcpy(&value, arguments.data(), sizeof(value));
+        arguments = arguments.subspan(sizeof(value));
+        if (!buffer.Printf(text, value)) {
+          return StatusWithSize::DataLoss();
+        }
+        break;
+      }
+    }
+  }
+
+  if (!arguments.empty()) {
+    return StatusWithSize::DataLoss();
+  }
+  return buffer.Finish();
+}
+
 }  // namespace pw::tokenizer
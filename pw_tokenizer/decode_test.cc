@@ -77,6 +77,62 @@ TEST(TokenizedStringDecode, TokenizedStringDecodingTestCases) {
   }
 }
 
+TEST(TokenizedStringDecode, FormatTo_MatchesFormat) {
+  const auto& test_data = test::tokenized_string_decoding::kTestData;
+
+  for (const auto& [format, expected, args] : test_data) {
+    if (!FormatIsSupported(format)) {
+      continue;
+    }
+    const FormatString format_string(format);
+    const DecodedFormatString decoded = format_string.Format(args);
+
+    char buffer[256];
+    const StatusWithSize result = format_string.FormatTo(args, buffer);
+    if (decoded.ok()) {
+      ASSERT_EQ(result.status(), OkStatus()) << format;
+      EXPECT_EQ(std::string_view(buffer, result.size()), decoded.value());
+      EXPECT_EQ(buffer[result.size()], '\0');
+    } else {
+      EXPECT_EQ(result.status(), Status::DataLoss()) << format;
+    }
+  }
+}
+
+TEST(TokenizedStringDecode, FormatTo_Truncation_NotAnError) {
+  char buffer[32];
+  const StatusWithSize result = kTwoArgs.FormatTo("\6\x89musketeer", buffer);
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(std::string_view(buffer, result.size()), "The 3 musketeer[...]");
+}
+
+TEST(TokenizedStringDecode, FormatTo_BufferTooSmall_IsTruncated) {
+  char buffer[8];
+  const StatusWithSize result = kTwoArgs.FormatTo("\6\x09musketeer", buffer);
+  EXPECT_EQ(result.status(), Status::ResourceExhausted());
+  EXPECT_EQ(result.size(), sizeof(buffer) - 1);
+  EXPECT_STREQ(buffer, "The 3 m");
+
+  EXPECT_EQ(kTwoArgs.FormatTo("\6\x09musketeer", span<char>()).status(),
+            Status::ResourceExhausted());
+}
+
+TEST(TokenizedStringDecode, FormatTo_BufferTooSmallAndDecodingError) {
+  char buffer[4];
+  EXPECT_EQ(kTwoArgs.FormatTo("\6\x0amusketeer", buffer).status(),
+            Status::DataLoss());
+}
+
+TEST(TokenizedStringDecode, FormatTo_DecodingErrors) {
+  char buffer[32];
+  EXPECT_EQ(kTwoArgs.FormatTo("\6\x0amusketeer", buffer).status(),
+            Status::DataLoss());
+  EXPECT_EQ(kTwoArgs.FormatTo("\x80", buffer).status(), Status::DataLoss());
+  EXPECT_EQ(kTwoArgs.FormatTo("", buffer).status(), Status::DataLoss());
+  EXPECT_EQ(kOneArg.FormatTo("\5helloworld", buffer).status(),
+            Status::DataLoss());
+}
+
 TEST(TokenizedStringDecode, FullyDecodeInput_ZeroRemainingBytes) {
   auto result = kOneArg.Format("\5hello");
   EXPECT_EQ(result.value(), "Hello hello");
@@ -282,7 +282,9 @@ class NestedMessageDetokenizer {
   }
 
   void DetokenizeOnce(uint32_t token) {
-    if (auto result = detokenizer_.DatabaseLookup(token, domain());
+    std::vector<TokenizedStringEntry> indexed_entries;
+    if (auto result =
+            detokenizer_.DatabaseLookup(token, domain(), indexed_entries);
         result.size() == 1) {
       std::string replacement =
           result.front().first.Format(span<const uint8_t>()).value();
@@ -404,6 +406,17 @@ void AddEntryIfUnique(std::vector<TokenizedStringEntry>& entries,
                        TokenDatabase::kDateRemovedNever);
 }
 
+// Domains are compared with whitespace removed.
+std::string CanonicalDomain(std::string_view domain) {
+  std::string canonical_domain;
+  for (char ch : domain) {
+    if (!std::isspace(ch)) {
+      canonical_domain.push_back(ch);
+    }
+  }
+  return canonical_domain;
+}
+
 }  // namespace
 
 DetokenizedString::DetokenizedString(
@@ -494,6 +507,16 @@ Result<Detokenizer> Detokenizer::FromElfFile(stream::SeekableReader& stream) {
   return Detokenizer::FromElfSection(section_data);
 }
 
+Result<Detokenizer> Detokenizer::FromIndexedDatabase(
+    const TokenDatabase& database) {
+  if (!database.ok() || !database.indexed()) {
+    return Status::InvalidArgument();
+  }
+  Detokenizer detokenizer{DomainTokenEntriesMap()};
+  detokenizer.indexed_database_ = database;
+  return detokenizer;
+}
+
 Result<Detokenizer> Detokenizer::FromCsv(std::string_view csv) {
   std::vector<std::vector<std::string>> parsed_csv = ParseCsv(csv);
   DomainTokenEntriesMap database;
@@ -600,7 +623,8 @@ DetokenizedString Detokenizer::Detokenize(const span<const std::byte>& encoded,
   uint32_t token = bytes::ReadInOrder<uint32_t>(
       endian::little, encoded.data(), encoded.size());
 
-  const auto result = DatabaseLookup(token, domain);
+  std::vector<TokenizedStringEntry> indexed_entries;
+  const auto result = DatabaseLookup(token, domain, indexed_entries);
 
   return DetokenizedString(*this,
                            recursion,
@@ -611,6 +635,56 @@ DetokenizedString Detokenizer::Detokenize(const span<const std::byte>& encoded,
                                : encoded.subspan(sizeof(token)));
 }
 
+StatusWithSize Detokenizer::DetokenizeTo(const span<const std::byte>& encoded,
+                                         span<char> output,
+                                         std::string_view domain) const {
+  if (!output.empty()) {
+    output[0] = '\0';
+  }
+  if (encoded.empty()) {
+    return StatusWithSize::NotFound();
+  }
+
+  const uint32_t token = bytes::ReadInOrder<uint32_t>(
+      endian::little, encoded.data(), encoded.size());
+  std::vector<TokenizedStringEntry> indexed_entries;
+  const span<const TokenizedStringEntry> entries =
+      DatabaseLookup(token, domain, indexed_entries);
+  if (entries.empty()) {
+    return StatusWithSize::NotFound();
+  }
+
+  // Without collisions, the compiled format string is written directly.
+  if (entries.size() == 1u) {
+    span<const std::byte> arguments;
+    if (encoded.size() >= sizeof(token)) {
+      arguments = encoded.subspan(sizeof(token));
+    }
+    const StatusWithSize result = entries[0].first.FormatTo(
+        span(reinterpret_cast<const uint8_t*>(arguments.data()),
+             arguments.size()),
+        output);
+    if (!result.IsDataLoss()) {
+      return result;
+    }
+  }
+
+  // Decode every match to find the best one, as Detokenize() does.
+  const DetokenizedString result = Detokenize(encoded, domain);
+  const std::string& best_string = result.BestString();
+  if (output.empty()) {
+    return StatusWithSize::ResourceExhausted();
+  }
+  const size_t size = std::min(best_string.size(), output.size() - 1);
+  std::memcpy(output.data(), best_string.data(), size);
+  output[size] = '\0';
+
+  if (size < best_string.size()) {
+    return StatusWithSize::ResourceExhausted(size);
+  }
+  return result.ok() ? StatusWithSize(size) : StatusWithSize::DataLoss(size);
+}
+
 DetokenizedString Detokenizer::DetokenizeBase64Message(
     std::string_view text) const {
   std::string buffer(text);
@@ -620,14 +694,7 @@ DetokenizedString Detokenizer::DetokenizeBase64Message(
 
 span<const TokenizedStringEntry> Detokenizer::DatabaseLookup(
     uint32_t token, std::string_view domain) const {
-  std::string canonical_domain;
-  for (char ch : domain) {
-    if (!std::isspace(ch)) {
-      canonical_domain.push_back(ch);
-    }
-  }
-
-  auto domain_it = database_.find(canonical_domain);
+  auto domain_it = database_.find(CanonicalDomain(domain));
   if (domain_it == database_.end()) {
     return span<TokenizedStringEntry>();
   }
@@ -639,6 +706,25 @@ span<const TokenizedStringEntry> Detokenizer::DatabaseLookup(
   return span(token_it->second);
 }
 
+span<const TokenizedStringEntry> Detokenizer::DatabaseLookup(
+    uint32_t token,
+    std::string_view domain,
+    std::vector<TokenizedStringEntry>& indexed_entries) const {
+  indexed_entries.clear();
+  if (!indexed_database_.ok()) {
+    return DatabaseLookup(token, domain);
+  }
+
+  // Indexed databases only contain the default domain.
+  if (CanonicalDomain(domain) != CanonicalDomain(kDefaultDomain)) {
+    return span<TokenizedStringEntry>();
+  }
+  for (const auto& entry : indexed_database_.Find(token)) {
+    indexed_entries.emplace_back(entry.string, entry.date_removed);
+  }
+  return span(indexed_entries);
+}
+
 std::string Detokenizer::DetokenizeTextRecursive(std::string_view text,
                                                  unsigned max_passes) const {
   NestedMessageDetokenizer detokenizer(*this);
@@ -13,6 +13,8 @@
 // the License.
 
 #include <array>
+#include <string>
+#include <string_view>
 
 #include "pw_assert/check.h"
 #include "pw_bytes/array.h"
@@ -121,5 +123,102 @@ PW_PERF_TEST(DetokenizeText_TwoMessages,
              "What the $qqqqqvwB, $Dg8AAQQEdGhlbQ==",
              "What the ~!, Now there are 2 of them!");
 
+// A database and messages typical of device logs: mostly short messages with
+// zero to two integer or string arguments.
+constexpr char kLogData[] =
+    "TOKENS\0\0"
+    "\x08\x00\x00\x00"
+    "\0\0\0\0"
+    "\x00\x00\x00\x10----"
+    "\x01\x00\x00\x10----"
+    "\x02\x00\x00\x10----"
+    "\x03\x00\x00\x10----"
+    "\x04\x00\x00\x10----"
+    "\x05\x00\x00\x10----"
+    "\x06\x00\x00\x10----"
+    "\x07\x00\x00\x10----"
+    "Boot complete\0"
+    "Battery voltage %u mV\0"
+    "Connected to %s on channel %d\0"
+    "Sensor %s read 0x%08x\0"
+    "Flash write took %d ms, %u bytes\0"
+    "Task %s stack usage %d%%\0"
+    "Dropped %d packets from %s\0"
+    "Temperature: %.1f C";
+constexpr TokenDatabase kLogDatabase = TokenDatabase::Create<kLogData>();
+
+constexpr auto kBootComplete = bytes::String("\x00\x00\x00\x10");
+constexpr auto kBatteryVoltage = bytes::String("\x01\x00\x00\x10\xe8\x39");
+constexpr auto kConnected =
+    bytes::String("\x02\x00\x00\x10\x05wlan0\x16");
+constexpr auto kSensorRead =
+    bytes::String("\x03\x00\x00\x10\x03imu\xde\xfb\x05");
+constexpr auto kFlashWrite = bytes::String("\x04\x00\x00\x10\x18\x80\x40");
+constexpr auto kStackUsage = bytes::String("\x05\x00\x00\x10\x03net\xae\x01");
+constexpr auto kDropped = bytes::String("\x06\x00\x00\x10\x06\x05uart1");
+constexpr auto kTemperature =
+    bytes::String("\x07\x00\x00\x10\x00\x00\xac\x41");
+
+constexpr std::array<span<const std::byte>, 8> kLogMix = {
+    kBootComplete,
+    kBatteryVoltage,
+    kConnected,
+    kSensorRead,
+    kFlashWrite,
+    kStackUsage,
+    kDropped,
+    kTemperature,
+};
+
+constexpr std::array<std::string_view, 8> kLogMixExpected = {
+    "Boot complete",
+    "Battery voltage 3700 mV",
+    "Connected to wlan0 on channel 11",
+    "Sensor imu read 0x0000beef",
+    "Flash write took 12 ms, 4096 bytes",
+    "Task net stack usage 87%",
+    "Dropped 3 packets from uart1",
+    "Temperature: 21.5 C",
+};
+
+// Detokenizes each message in the log mix to a std::string.
+void DetokenizeLogMix(perf_test::State& state) {
+  Detokenizer detokenizer(kLogDatabase);
+  std::array<std::string, kLogMix.size()> results;
+
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < kLogMix.size(); ++i) {
+      results[i] = detokenizer.Detokenize(kLogMix[i]).BestString();
+    }
+  }
+
+  for (size_t i = 0; i < kLogMix.size(); ++i) {
+    PW_CHECK(results[i] == kLogMixExpected[i]);
+  }
+}
+
+PW_PERF_TEST(Detokenize_LogMix, DetokenizeLogMix);
+
+// Detokenizes each message in the log mix to a fixed buffer.
+void DetokenizeToLogMix(perf_test::State& state) {
+  Detokenizer detokenizer(kLogDatabase);
+  std::array<char, 256> buffer;
+
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < kLogMix.size(); ++i) {
+      detokenizer.DetokenizeTo(kLogMix[i], buffer).IgnoreError();
+    }
+  }
+
+  for (size_t i = 0; i < kLogMix.size(); ++i) {
+    const StatusWithSize result = detokenizer.DetokenizeTo(kLogMix[i], buffer);
+    PW_CHECK_OK(result.status());
+    PW_CHECK(std::string_view(buffer.data(), result.size()) ==
+             kLogMixExpected[i]);
+  }
+}
+
+PW_PERF_TEST(DetokenizeTo_LogMix, DetokenizeToLogMix);
+
 }  // namespace
 }  // namespace pw::tokenizer
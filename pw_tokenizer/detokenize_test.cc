@@ -16,6 +16,7 @@
 
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "pw_stream/memory_stream.h"
 #include "pw_tokenizer/base64.h"
@@ -346,6 +347,140 @@ TEST_F(DetokenizeWithArgs, Successful) {
   }
 }
 
+TEST_F(DetokenizeWithArgs, DetokenizeTo_Successful) {
+  for (const auto& [data, expected] : TestCases(
+           Case{"\0\0\0\0"sv, ""},
+           Case{"\x0A\x0B\x0C\x0D\5force\4Luke"sv, "Use the force, Luke."},
+           Case{"\x0E\x0F\x00\x01\4\4them"sv, "Now there are 2 of them!"},
+           Case{"\x0E\x0F\x00\x01\x80\x01\4them"sv,
+                "Now there are 64 of them!"},
+           Case{"\xAA\xAA\xAA\xAA\xfc\x01"sv, "~!"},
+           Case{"\xCC\xCC\xCC\xCC\xfe\xff\x07"sv, "65535!"},
+           Case{"\xDD\xDD\xDD\xDD\xfe\xff\xff\xff\x1f"sv, "4294967295!"},
+           Case{"\xEE\xEE\xEE\xEE\xfe\xff\xff\xff\x1f"sv, "4294967295!"})) {
+    char buffer[64];
+    const StatusWithSize result =
+        detok_.DetokenizeTo(as_bytes(span(data)), buffer);
+    ASSERT_EQ(result.status(), OkStatus());
+    EXPECT_EQ(std::string_view(buffer, result.size()), expected);
+    EXPECT_EQ(buffer[result.size()], '\0');
+  }
+}
+
+TEST_F(DetokenizeWithArgs, DetokenizeTo_NoMatches) {
+  char buffer[16] = "unchanged";
+  EXPECT_EQ(
+      detok_.DetokenizeTo(as_bytes(span("\x23\xab\xc9\x87"sv)), buffer)
+          .status(),
+      Status::NotFound());
+  EXPECT_STREQ(buffer, "");
+  EXPECT_EQ(detok_.DetokenizeTo(span<const std::byte>(), buffer).status(),
+            Status::NotFound());
+}
+
+TEST_F(DetokenizeWithArgs, DetokenizeTo_BufferTooSmall) {
+  char buffer[8];
+  const StatusWithSize result = detok_.DetokenizeTo(
+      as_bytes(span("\x0A\x0B\x0C\x0D\5force\4Luke"sv)), buffer);
+  EXPECT_EQ(result.status(), Status::ResourceExhausted());
+  EXPECT_EQ(result.size(), 7u);
+  EXPECT_STREQ(buffer, "Use the");
+}
+
+TEST_F(DetokenizeWithArgs, DetokenizeTo_DecodingError_WritesBestString) {
+  char buffer[64];
+  const StatusWithSize result = detok_.DetokenizeTo(
+      as_bytes(span("\x0E\x0F\x00\x01\xFF"sv)), buffer);
+  EXPECT_EQ(result.status(), Status::DataLoss());
+  EXPECT_EQ(std::string_view(buffer, result.size()), "Now there are %d of %s!");
+}
+
+// Binary format token database with a string index at offset 78 (0x4E).
+constexpr char kIndexedData[] =
+    "TOKENS\0\0"
+    "\x04\x00\x00\x00"
+    "\x4E\0\0\0"
+    "\x01\x00\x00\x00----"
+    "\x02\x00\x00\x00----"
+    "\x03\x00\x00\x00----"
+    "\x03\x00\x00\x00----"
+    "One\0"
+    "%d of %s!\0"
+    "Short %s\0"
+    "Int %d\0"
+    "\x00\0\0\0\x04\0\0\0\x0E\0\0\0\x17\0\0\0";
+
+constexpr TokenDatabase kIndexedDatabase =
+    TokenDatabase::Create<kIndexedData>();
+
+class DetokenizeIndexed : public ::testing::Test {
+ protected:
+  DetokenizeIndexed()
+      : detok_(Detokenizer::FromIndexedDatabase(kIndexedDatabase).value()) {}
+
+  Detokenizer detok_;
+};
+
+TEST_F(DetokenizeIndexed, RequiresIndex) {
+  EXPECT_EQ(Detokenizer::FromIndexedDatabase(
+                TokenDatabase::Create<kTestDatabase>())
+                .status(),
+            Status::InvalidArgument());
+  EXPECT_EQ(Detokenizer::FromIndexedDatabase(TokenDatabase()).status(),
+            Status::InvalidArgument());
+}
+
+TEST_F(DetokenizeIndexed, DoesNotLoadDatabase) {
+  EXPECT_TRUE(detok_.database().empty());
+}
+
+TEST_F(DetokenizeIndexed, Detokenize) {
+  EXPECT_EQ(detok_.Detokenize("\1\0\0\0"sv).BestString(), "One");
+  EXPECT_EQ(detok_.Detokenize("\2\0\0\0\x04\x04them"sv).BestString(),
+            "2 of them!");
+  EXPECT_EQ(detok_.Detokenize("\3\0\0\0\x02"sv).BestString(), "Int 1");
+  EXPECT_EQ(detok_.Detokenize("\4\0\0\0"sv).BestString(), "");
+}
+
+TEST_F(DetokenizeIndexed, DetokenizeTo) {
+  char buffer[32];
+  StatusWithSize result =
+      detok_.DetokenizeTo(as_bytes(span("\2\0\0\0\x04\x04them"sv)), buffer);
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(std::string_view(buffer, result.size()), "2 of them!");
+
+  result = detok_.DetokenizeTo(as_bytes(span("\3\0\0\0\x02"sv)), buffer);
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(std::string_view(buffer, result.size()), "Int 1");
+
+  EXPECT_EQ(detok_.DetokenizeTo(as_bytes(span("\4\0\0\0"sv)), buffer).status(),
+            Status::NotFound());
+}
+
+TEST_F(DetokenizeIndexed, OnlyDefaultDomain) {
+  EXPECT_EQ(detok_.Detokenize("\1\0\0\0"sv, " ").BestString(), "One");
+  EXPECT_EQ(detok_.Detokenize("\1\0\0\0"sv, "other").BestString(), "");
+}
+
+TEST_F(DetokenizeIndexed, DatabaseLookup_ReplacesEntries) {
+  std::vector<TokenizedStringEntry> entries;
+  span<const TokenizedStringEntry> result =
+      detok_.DatabaseLookup(1, "", entries);
+  ASSERT_EQ(result.size(), 1u);
+  EXPECT_EQ(result[0].first, FormatString("One"));
+
+  result = detok_.DatabaseLookup(3, "", entries);
+  ASSERT_EQ(result.size(), 2u);
+  EXPECT_EQ(result[0].first, FormatString("Short %s"));
+  EXPECT_EQ(result[1].first, FormatString("Int %d"));
+
+  EXPECT_TRUE(detok_.DatabaseLookup(4, "", entries).empty());
+}
+
+TEST_F(DetokenizeIndexed, DetokenizeText) {
+  EXPECT_EQ(detok_.DetokenizeText("Say $AQAAAA=="), "Say One");
+}
+
 constexpr const char kCsvCollisons[] =
     "1,, D1,crocodile!\n"
     "1,, D1,alligator!\n"
@@ -627,6 +762,22 @@ TEST_F(DetokenizeWithCollisions, Collision_NotOkIfMultipleSuccessfulDecodes) {
   EXPECT_EQ(result.BestString(), "This string is present");
 }
 
+TEST_F(DetokenizeWithCollisions, DetokenizeTo_ResolvesCollisions) {
+  constexpr std::string_view kOneSuccess =
+      "\0\0\0\0\x07"
+      "1234567"sv;
+  char buffer[64];
+  StatusWithSize result =
+      detok_.DetokenizeTo(as_bytes(span(kOneSuccess)), buffer);
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(std::string_view(buffer, result.size()), "One arg 1234567");
+
+  // Two entries decode successfully, so the result is ambiguous.
+  result = detok_.DetokenizeTo(as_bytes(span("\0\0\0\0"sv)), buffer);
+  EXPECT_EQ(result.status(), Status::DataLoss());
+  EXPECT_EQ(std::string_view(buffer, result.size()), "This string is present");
+}
+
 TEST_F(DetokenizeWithCollisions, Collision_PreferDecodingAllBytes) {
   for (auto [data, expected] :
        TestCases(Case{"\0\0\0\0\x80\x80\x80\x80\x00"sv, "Two args [...] 0"},
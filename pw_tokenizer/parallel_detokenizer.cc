@@ -0,0 +1,228 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_tokenizer/parallel_detokenizer.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "pw_bytes/span.h"
+#include "pw_result/result.h"
+#include "pw_span/span.h"
+#include "pw_status/try.h"
+
+namespace pw::tokenizer {
+namespace {
+
+// Minimum number of bytes to request from the input at a time.
+constexpr size_t kReadSizeBytes = 4096;
+
+// Reads the input in chunks that end at a newline.
+class ChunkReader {
+ public:
+  ChunkReader(stream::Reader& input, size_t chunk_size_bytes)
+      : input_(input), chunk_size_bytes_(chunk_size_bytes) {}
+
+  // Reads the next chunk. Returns OUT_OF_RANGE when the input is exhausted.
+  Status Next(std::string& chunk) {
+    chunk = std::move(remainder_);
+    remainder_.clear();
+
+    // Bytes before this offset are known not to contain a newline.
+    size_t searched = 0;
+
+    while (true) {
+      if (chunk.size() >= chunk_size_bytes_) {
+        const size_t newline =
+            std::string_view(chunk).substr(searched).rfind('\n');
+        if (newline != std::string_view::npos) {
+          remainder_.assign(chunk, searched + newline + 1);
+          chunk.resize(searched + newline + 1);
+          return OkStatus();
+        }
+        searched = chunk.size();
+      }
+
+      if (end_of_input_) {
+        return chunk.empty() ? Status::OutOfRange() : OkStatus();
+      }
+
+      const size_t size = chunk.size();
+      const size_t read_size =
+          std::max(kReadSizeBytes,
+                   chunk_size_bytes_ > size ? chunk_size_bytes_ - size : 0);
+      chunk.resize(size + read_size);
+      const Result<ByteSpan> read =
+          input_.Read(as_writable_bytes(span(chunk.data() + size, read_size)));
+      chunk.resize(size + (read.ok() ? read->size() : 0));
+
+      if (read.status().IsOutOfRange()) {
+        end_of_input_ = true;
+      } else if (!read.ok()) {
+        return read.status();
+      }
+    }
+  }
+
+ private:
+  stream::Reader& input_;
+  const size_t chunk_size_bytes_;
+  std::string remainder_;
+  bool end_of_input_ = false;
+};
+
+// Detokenizes chunks on worker threads. Chunks are submitted and collected in
+// order. Each occupies one of a fixed number of slots until it is collected.
+class ChunkPipeline {
+ public:
+  ChunkPipeline(const Detokenizer& detokenizer, size_t threads)
+      : detokenizer_(detokenizer), slots_(2 * threads) {
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+      workers_.emplace_back([this] { Work(); });
+    }
+  }
+
+  ~ChunkPipeline() {
+    {
+      std::lock_guard lock(mutex_);
+      stopping_ = true;
+    }
+    work_available_.notify_all();
+    for (std::thread& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  // Submitted and collected are only modified by the thread that owns the
+  // pipeline, so they may be read without the lock on that thread.
+  bool full() const { return submitted_ - collected_ == slots_.size(); }
+  bool empty() const { return submitted_ == collected_; }
+
+  // Queues a chunk to detokenize. The pipeline must not be full.
+  void Submit(std::string&& chunk) {
+    {
+      std::lock_guard lock(mutex_);
+      Slot& slot = slots_[submitted_ % slots_.size()];
+      slot.text = std::move(chunk);
+      slot.done = false;
+      submitted_ += 1;
+    }
+    work_available_.notify_one();
+  }
+
+  // Waits for the oldest chunk to be detokenized and moves it to `text`. The
+  // pipeline must not be empty.
+  void Collect(std::string& text) {
+    std::unique_lock lock(mutex_);
+    Slot& slot = slots_[collected_ % slots_.size()];
+    chunk_done_.wait(lock, [&slot] { return slot.done; });
+    text = std::move(slot.text);
+    collected_ += 1;
+  }
+
+ private:
+  struct Slot {
+    std::string text;
+    bool done = false;
+  };
+
+  void Work() {
+    std::unique_lock lock(mutex_);
+    while (true) {
+      work_available_.wait(
+          lock, [this] { return stopping_ || started_ < submitted_; });
+      if (stopping_) {
+        return;
+      }
+
+      Slot& slot = slots_[started_ % slots_.size()];
+      started_ += 1;
+      const std::string input = std::move(slot.text);
+
+      lock.unlock();
+      std::string output = detokenizer_.DetokenizeText(input);
+      lock.lock();
+
+      slot.text = std::move(output);
+      slot.done = true;
+      chunk_done_.notify_one();
+    }
+  }
+
+  const Detokenizer& detokenizer_;
+
+  std::mutex mutex_;
+  std::condition_variable work_available_;
+  std::condition_variable chunk_done_;
+
+  std::vector<Slot> slots_;
+  size_t submitted_ = 0;
+  size_t started_ = 0;
+  size_t collected_ = 0;
+  bool stopping_ = false;
+
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace
+
+Status ParallelDetokenizer::DetokenizeText(stream::Reader& input,
+                                           stream::Writer& output) const {
+  ChunkReader reader(input, chunk_size_bytes_);
+  std::string chunk;
+
+  if (threads_ == 0u) {
+    while (true) {
+      const Status status = reader.Next(chunk);
+      if (status.IsOutOfRange()) {
+        return OkStatus();
+      }
+      PW_TRY(status);
+      const std::string text = detokenizer_.DetokenizeText(chunk);
+      PW_TRY(output.Write(as_bytes(span(text))));
+    }
+  }
+
+  ChunkPipeline pipeline(detokenizer_, threads_);
+  bool end_of_input = false;
+
+  while (true) {
+    // Keep every slot busy, then write the oldest chunk when it is ready.
+    if (!end_of_input && !pipeline.full()) {
+      const Status status = reader.Next(chunk);
+      if (status.IsOutOfRange()) {
+        end_of_input = true;
+        continue;
+      }
+      PW_TRY(status);
+      pipeline.Submit(std::move(chunk));
+      continue;
+    }
+
+    if (pipeline.empty()) {
+      return OkStatus();
+    }
+    pipeline.Collect(chunk);
+    PW_TRY(output.Write(as_bytes(span(chunk))));
+  }
+}
+
+}  // namespace pw::tokenizer
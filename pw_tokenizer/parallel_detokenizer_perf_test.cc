@@ -0,0 +1,114 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures the time to detokenize kMessages lines of Base64-encoded logs with
+// ParallelDetokenizer, with varying numbers of worker threads. Each test also
+// logs its throughput in messages per second.
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "pw_bytes/span.h"
+#include "pw_log/log.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_span/span.h"
+#include "pw_stream/memory_stream.h"
+#include "pw_stream/null_stream.h"
+#include "pw_tokenizer/parallel_detokenizer.h"
+
+namespace pw::tokenizer {
+namespace {
+
+constexpr size_t kMessages = 20000;
+
+constexpr char kLogData[] =
+    "TOKENS\0\0"
+    "\x08\x00\x00\x00"
+    "\0\0\0\0"
+    "\x00\x00\x00\x10----"
+    "\x01\x00\x00\x10----"
+    "\x02\x00\x00\x10----"
+    "\x03\x00\x00\x10----"
+    "\x04\x00\x00\x10----"
+    "\x05\x00\x00\x10----"
+    "\x06\x00\x00\x10----"
+    "\x07\x00\x00\x10----"
+    "Boot complete\0"
+    "Battery voltage %u mV\0"
+    "Connected to %s on channel %d\0"
+    "Sensor %s read 0x%08x\0"
+    "Flash write took %d ms, %u bytes\0"
+    "Task %s stack usage %d%%\0"
+    "Dropped %d packets from %s\0"
+    "Temperature: %.1f C";
+constexpr TokenDatabase kLogDatabase = TokenDatabase::Create<kLogData>();
+
+// The messages from detokenize_perf_test, Base64-encoded.
+constexpr std::array<std::string_view, 8> kLogMix = {
+    "$AAAAEA==",
+    "$AQAAEOg5",
+    "$AgAAEAV3bGFuMBY=",
+    "$AwAAEANpbXXe+wU=",
+    "$BAAAEBiAQA==",
+    "$BQAAEANuZXSuAQ==",
+    "$BgAAEAYFdWFydDE=",
+    "$BwAAEAAArEE=",
+};
+
+// Log lines with a timestamp, level, and tokenized message.
+const std::string& LogArchive() {
+  static const std::string archive = [] {
+    std::string text;
+    for (size_t i = 0; i < kMessages; ++i) {
+      text += "20250101 12:00:" + std::to_string(i % 60) + " INF ";
+      text += kLogMix[i % kLogMix.size()];
+      text += '\n';
+    }
+    return text;
+  }();
+  return archive;
+}
+
+void DetokenizeArchive(perf_test::State& state, size_t threads) {
+  Detokenizer detokenizer(kLogDatabase);
+  ParallelDetokenizer parallel(detokenizer, threads);
+  const std::string& archive = LogArchive();
+
+  size_t iterations = 0;
+  const auto start = std::chrono::steady_clock::now();
+  while (state.KeepRunning()) {
+    stream::MemoryReader reader(as_bytes(span(archive)));
+    parallel.DetokenizeText(reader, stream::NullStream::Instance())
+        .IgnoreError();
+    iterations += 1;
+  }
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  PW_LOG_INFO("Worker threads: %u, messages/s: %.0f",
+              static_cast<unsigned>(threads),
+              static_cast<double>(iterations * kMessages) / elapsed.count());
+}
+
+PW_PERF_TEST(DetokenizeArchive_CallingThread, DetokenizeArchive, 0);
+PW_PERF_TEST(DetokenizeArchive_1Thread, DetokenizeArchive, 1);
+PW_PERF_TEST(DetokenizeArchive_2Threads, DetokenizeArchive, 2);
+PW_PERF_TEST(DetokenizeArchive_4Threads, DetokenizeArchive, 4);
+PW_PERF_TEST(DetokenizeArchive_8Threads, DetokenizeArchive, 8);
+
+}  // namespace
+}  // namespace pw::tokenizer
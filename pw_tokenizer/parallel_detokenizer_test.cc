@@ -0,0 +1,117 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_tokenizer/parallel_detokenizer.h"
+
+#include <string>
+#include <string_view>
+
+#include "pw_bytes/span.h"
+#include "pw_stream/memory_stream.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::tokenizer {
+namespace {
+
+constexpr char kTestDatabase[] =
+    "TOKENS\0\0"
+    "\x02\x00\x00\x00"
+    "\0\0\0\0"
+    "\x01\x00\x00\x00----"
+    "\x02\x00\x00\x00----"
+    "One\0"
+    "Two %d";
+
+constexpr TokenDatabase kDatabase = TokenDatabase::Create<kTestDatabase>();
+
+// "One" and "Two 7"
+constexpr std::string_view kOne = "$AQAAAA==";
+constexpr std::string_view kTwo = "$AgAAAA4=";
+
+class ParallelDetokenizerTest : public ::testing::Test {
+ protected:
+  ParallelDetokenizerTest() : detokenizer_(kDatabase) {
+    for (int i = 0; i < 1000; ++i) {
+      const std::string number = std::to_string(i);
+      input_ += number + ": " + std::string(kOne) + ' ' + std::string(kTwo);
+      input_ += '\n';
+      expected_ += number + ": One Two 7\n";
+    }
+  }
+
+  // Detokenizes input_ with the given options and checks the output.
+  void ExpectDetokenizes(std::string_view input,
+                         std::string_view expected,
+                         size_t threads,
+                         size_t chunk_size_bytes) {
+    stream::MemoryReader reader(as_bytes(span(input)));
+    stream::MemoryWriterBuffer<32 * 1024> writer;
+
+    ParallelDetokenizer parallel(detokenizer_, threads, chunk_size_bytes);
+    ASSERT_EQ(parallel.DetokenizeText(reader, writer), OkStatus());
+    EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(writer.data()),
+                               writer.bytes_written()),
+              expected);
+  }
+
+  Detokenizer detokenizer_;
+  std::string input_;
+  std::string expected_;
+};
+
+TEST_F(ParallelDetokenizerTest, CallingThread) {
+  ExpectDetokenizes(input_, expected_, 0, 64);
+}
+
+TEST_F(ParallelDetokenizerTest, OneThread) {
+  ExpectDetokenizes(input_, expected_, 1, 64);
+}
+
+TEST_F(ParallelDetokenizerTest, ManyThreads_PreservesOrder) {
+  ExpectDetokenizes(input_, expected_, 4, 1);
+  ExpectDetokenizes(input_, expected_, 4, 64);
+  ExpectDetokenizes(input_, expected_, 8, 1024);
+}
+
+TEST_F(ParallelDetokenizerTest, SingleChunk) {
+  ExpectDetokenizes(input_, expected_, 4, input_.size() * 2);
+}
+
+TEST_F(ParallelDetokenizerTest, LineLongerThanChunk) {
+  const std::string input = "a long line with $AQAAAA== in it\nshort\n";
+  ExpectDetokenizes(input, "a long line with One in it\nshort\n", 2, 4);
+}
+
+TEST_F(ParallelDetokenizerTest, NoTrailingNewline) {
+  ExpectDetokenizes("$AQAAAA==\n$AgAAAA4=", "One\nTwo 7", 2, 1);
+}
+
+TEST_F(ParallelDetokenizerTest, EmptyInput) {
+  ExpectDetokenizes("", "", 0, 64);
+  ExpectDetokenizes("", "", 2, 64);
+}
+
+TEST_F(ParallelDetokenizerTest, WriteError) {
+  for (size_t threads : {0, 2}) {
+    stream::MemoryReader reader(as_bytes(span(input_)));
+    stream::MemoryWriterBuffer<100> writer;
+
+    ParallelDetokenizer parallel(detokenizer_, threads, 64);
+    EXPECT_EQ(parallel.DetokenizeText(reader, writer),
+              Status::ResourceExhausted());
+  }
+}
+
+}  // namespace
+}  // namespace pw::tokenizer
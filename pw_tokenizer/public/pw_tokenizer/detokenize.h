@@ -33,6 +33,7 @@
 
 #include "pw_result/result.h"
 #include "pw_span/span.h"
+#include "pw_status/status_with_size.h"
 #include "pw_stream/stream.h"
 #include "pw_tokenizer/internal/decode.h"
 #include "pw_tokenizer/token_database.h"
@@ -100,7 +101,8 @@ class DetokenizedString {
 };
 
 /// Decodes and detokenizes from a token database. This class builds a hash
-/// table of tokens to give `O(1)` token lookups.
+/// table of tokens to give `O(1)` token lookups. Alternately, it can search an
+/// indexed binary database in place; see `FromIndexedDatabase`.
 class Detokenizer {
  public:
   /// Constructs a detokenizer from a `TokenDatabase`. The `TokenDatabase` is
@@ -128,6 +130,27 @@ class Detokenizer {
   /// Constructs a detokenizer from a CSV database.
   static Result<Detokenizer> FromCsv(std::string_view csv);
 
+  /// Constructs a detokenizer that searches a binary database with a string
+  /// index in place, rather than loading it into a hash table. Construction is
+  /// `O(1)` and lookups are `O(log n)`, which suits large databases that are
+  /// memory mapped from a file. The database's memory must outlive the
+  /// `Detokenizer`. All entries belong to the default domain.
+  ///
+  /// Format strings are parsed for each lookup instead of once, so
+  /// `DetokenizeTo` allocates when used with an indexed database.
+  ///
+  /// @returns @rst
+  ///
+  /// .. pw-status-codes::
+  ///
+  ///    OK: The detokenizer was created.
+  ///
+  ///    INVALID_ARGUMENT: The database is invalid or does not have a string
+  ///    index.
+  ///
+  /// @endrst
+  static Result<Detokenizer> FromIndexedDatabase(const TokenDatabase& database);
+
   /// Decodes and detokenizes the binary encoded message. Returns a
   /// `DetokenizedString` that stores all possible detokenized string results.
   DetokenizedString Detokenize(const span<const std::byte>& encoded,
@@ -155,6 +178,33 @@ class Detokenizer {
                       domain);
   }
 
+  /// Decodes and detokenizes the binary encoded message directly into
+  /// `output`, producing the same text as `Detokenize(...).BestString()`.
+  ///
+  /// Each format string is compiled when the database is loaded. If the token
+  /// has one database entry and its arguments decode, the message is written
+  /// without allocating. Otherwise, this falls back to `Detokenize`.
+  ///
+  /// @returns @rst
+  ///
+  /// .. pw-status-codes::
+  ///
+  ///    OK: Returns the number of characters written, excluding the null
+  ///    terminator. The output is always null-terminated unless it is empty.
+  ///
+  ///    NOT_FOUND: The message has no token, or the token is not in the
+  ///    database. Nothing is written.
+  ///
+  ///    DATA_LOSS: The message did not decode successfully, or more than one
+  ///    entry decoded successfully. The best match is written.
+  ///
+  ///    RESOURCE_EXHAUSTED: The output was too small and was truncated.
+  ///
+  /// @endrst
+  StatusWithSize DetokenizeTo(const span<const std::byte>& encoded,
+                              span<char> output,
+                              std::string_view domain = kDefaultDomain) const;
+
   /// Decodes and detokenizes the binary encoded message. Returns a
   /// `DetokenizedString` that stores all possible detokenized string results.
   DetokenizedString RecursiveDetokenize(
@@ -219,11 +269,24 @@ class Detokenizer {
   std::string DecodeOptionallyTokenizedData(
       const span<const std::byte>& optionally_tokenized_data);
 
+  /// Returns the hash table of entries. This is empty for a detokenizer
+  /// created with `FromIndexedDatabase`.
   const DomainTokenEntriesMap& database() const { return database_; }
 
+  /// Looks up the entries for a token in the hash table. Returns no entries
+  /// for a detokenizer created with `FromIndexedDatabase`.
   span<const TokenizedStringEntry> DatabaseLookup(
       uint32_t token, std::string_view domain) const;
 
+  /// Looks up the entries for a token. If the detokenizer searches an indexed
+  /// database, the entries are parsed into `indexed_entries`, which backs the
+  /// returned span. `indexed_entries` is cleared first, so the span is
+  /// invalidated by the next call that passes the same vector.
+  span<const TokenizedStringEntry> DatabaseLookup(
+      uint32_t token,
+      std::string_view domain,
+      std::vector<TokenizedStringEntry>& indexed_entries) const;
+
  private:
   // 4 passes supports detokenizing two layers of nested messages with tokenized
   // domains (e.g. ${${bar}#ab12cd34}#00000012), without allowing a hypothetical
@@ -240,6 +303,9 @@ class Detokenizer {
                                bool recursion) const;
 
   DomainTokenEntriesMap database_;
+
+  // Searched in place instead of database_, if set.
+  TokenDatabase indexed_database_;
 };
 
 /// @}
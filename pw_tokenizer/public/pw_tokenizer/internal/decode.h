@@ -27,6 +27,7 @@
 
 #include "pw_preprocessor/compiler.h"
 #include "pw_span/span.h"
+#include "pw_status/status_with_size.h"
 
 // Decoding errors are marked with prefix and suffix so that they stand out from
 // the rest of the decoded strings. These macros are used to build decoding
@@ -142,6 +143,9 @@ class StringSegment {
 
   const std::string& text() const { return text_; }
 
+  // True if this segment is literal text or %%, which decode to fixed text.
+  bool is_literal() const { return type_ == kLiteral || type_ == kPercent; }
+
   friend bool operator==(const StringSegment& lhs, const StringSegment& rhs) {
     return lhs.type_ == rhs.type_ && lhs.local_size_ == rhs.local_size_ &&
            lhs.text_ == rhs.text_;
@@ -186,6 +190,8 @@ class StringSegment {
 
   DecodedArg DecodeFloatingPoint(const span<const uint8_t>& arguments) const;
 
+  friend class FormatString;
+
   std::string text_;
   Type type_;
   ArgSize local_size_;  // Arg size to use for snprintf on this machine.
@@ -246,6 +252,25 @@ class FormatString {
                        arguments.size()));
   }
 
+  // Formats this format string according to the provided encoded arguments
+  // directly into `output`, without allocating. The output is null-terminated,
+  // unless it is empty. This produces the same text as Format().value().
+  //
+  // Returns:
+  //   OK - All arguments decoded and the text was written to the output.
+  //   RESOURCE_EXHAUSTED - The arguments decoded, but the text was truncated.
+  //   DATA_LOSS - An argument failed to decode or arguments remained. The
+  //       output is unspecified; use Format() to get the decoding errors.
+  StatusWithSize FormatTo(span<const uint8_t> arguments,
+                          span<char> output) const;
+
+  StatusWithSize FormatTo(std::string_view arguments,
+                          span<char> output) const {
+    return FormatTo(span(reinterpret_cast<const uint8_t*>(arguments.data()),
+                         arguments.size()),
+                    output);
+  }
+
   friend bool operator==(const FormatString& lhs, const FormatString& rhs) {
     return lhs.segments_ == rhs.segments_;
   }
@@ -255,7 +280,28 @@ class FormatString {
   }
 
  private:
+  // The segments compiled into a compact program for FormatTo(). Adjacent
+  // literals and %% are merged into one instruction. Conversion specifiers are
+  // stored null-terminated so they can be passed to snprintf directly.
+  struct Instruction {
+    StringSegment::Type type;
+    StringSegment::ArgSize local_size;
+    // True for %s and for %d, %i, and %u without flags, width, precision, or
+    // h or hh lengths, which are formatted without snprintf.
+    bool plain;
+    uint32_t text_offset;  // Offset of the instruction's text in program_text_.
+    uint32_t text_size;
+  };
+
+  void Compile();
+
+  const char* InstructionText(const Instruction& instruction) const {
+    return program_text_.c_str() + instruction.text_offset;
+  }
+
   std::vector<StringSegment> segments_;
+  std::vector<Instruction> program_;
+  std::string program_text_;
 };
 
 PW_MODIFY_DIAGNOSTICS_PUSH();
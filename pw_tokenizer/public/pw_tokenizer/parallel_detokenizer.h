@@ -0,0 +1,77 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+
+#include "pw_status/status.h"
+#include "pw_stream/stream.h"
+#include "pw_tokenizer/detokenize.h"
+
+namespace pw::tokenizer {
+
+/// @ingroup pw_tokenizer_detokenize
+///
+/// Detokenizes large amounts of text, such as log archives, with multiple
+/// threads.
+///
+/// The input is split into chunks at newlines, so tokenized messages must not
+/// span lines. Worker threads detokenize the chunks with
+/// `Detokenizer::DetokenizeText`, while the calling thread reads the input and
+/// writes the results in their original order.
+///
+/// This class uses `std::thread`, so it is only available on hosts.
+class ParallelDetokenizer {
+ public:
+  /// The default number of bytes read for each chunk given to a thread.
+  static constexpr size_t kDefaultChunkSizeBytes = 64 * 1024;
+
+  /// @param detokenizer The detokenizer to use, which must outlive the
+  ///     `ParallelDetokenizer`.
+  /// @param threads The number of worker threads. If 0, chunks are
+  ///     detokenized on the calling thread.
+  /// @param chunk_size_bytes The number of bytes to read for each chunk.
+  ///     Once this many bytes are read, the chunk ends at the last newline in
+  ///     them, so it may be shorter than this. If they contain no newline, the
+  ///     chunk ends at the next newline or at the end of the input.
+  ParallelDetokenizer(const Detokenizer& detokenizer,
+                      size_t threads,
+                      size_t chunk_size_bytes = kDefaultChunkSizeBytes)
+      : detokenizer_(detokenizer),
+        threads_(threads),
+        chunk_size_bytes_(chunk_size_bytes) {}
+
+  /// Reads text from `input` until it is exhausted and writes it to `output`
+  /// with its tokenized messages decoded. Threads are started for each call
+  /// and stopped before it returns.
+  ///
+  /// @returns @rst
+  ///
+  /// .. pw-status-codes::
+  ///
+  ///    OK: All of the input was detokenized and written.
+  ///
+  ///    Other: Reading from ``input`` or writing to ``output`` failed with
+  ///    this status. Output up to the failed chunk was written.
+  ///
+  /// @endrst
+  Status DetokenizeText(stream::Reader& input, stream::Writer& output) const;
+
+ private:
+  const Detokenizer& detokenizer_;
+  size_t threads_;
+  size_t chunk_size_bytes_;
+};
+
+}  // namespace pw::tokenizer
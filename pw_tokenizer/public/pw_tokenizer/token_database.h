@@ -51,7 +51,7 @@ namespace pw::tokenizer {
 ///        0     6  Magic number (``TOKENS``)
 ///        6     2  Version (``00 00``)
 ///        8     4  Entry count
-///       12     4  Reserved
+///       12     4  String index offset (0 if none)
 ///   ======  ====  =========================
 ///
 ///   ======  ====  ==================================
@@ -69,9 +69,18 @@ namespace pw::tokenizer {
 /// Entries are sorted by token. A string table with a null-terminated string
 /// for each entry in order follows the entries.
 ///
-/// Entries are accessed by iterating over the database. A O(n) `Find` function
-/// is also provided. In typical use, a `TokenDatabase` is preprocessed by a
-/// `pw::tokenizer::Detokenizer` into a `std::unordered_map`.
+/// Optionally, a string index follows the string table. The index has a 4-byte
+/// offset for each entry, which is the position of the entry's string relative
+/// to the start of the string table. The header stores the offset of the index
+/// from the start of the database. Databases with an index are otherwise
+/// identical, so they can be read by tools that do not support the index.
+///
+/// Entries are accessed by iterating over the database. A `Find` function is
+/// also provided, which is `O(log n)` if the database has an index and `O(n)`
+/// otherwise. In typical use, a `TokenDatabase` is preprocessed by a
+/// `pw::tokenizer::Detokenizer` into a `std::unordered_map`. An indexed
+/// database can instead be searched in place, for example after memory mapping
+/// the database file.
 class TokenDatabase {
  private:
   // Internal struct that describes how the underlying binary token database
@@ -219,9 +228,17 @@ class TokenDatabase {
   /// the magic number (`TOKENS`), version (which must be `0`), and that there
   /// is is one string for each entry in the database. A database with extra
   /// strings or other trailing data is considered valid.
+  ///
+  /// For a database with a string index, the strings are counted only up to
+  /// the index. This also checks that the index is within the data, that the
+  /// entries are sorted by token, and that each index offset is the start of a
+  /// string in the string table.
   template <typename ByteArray>
   static constexpr bool IsValid(const ByteArray& bytes) {
-    return HasValidHeader(bytes) && EachEntryHasAString(bytes);
+    if (!HasValidHeader(bytes) || !EachEntryHasAString(bytes)) {
+      return false;
+    }
+    return ReadIndexOffset(std::data(bytes)) == 0u || HasValidIndex(bytes);
   }
 
   /// Creates a `TokenDatabase` and checks if the provided data is valid at
@@ -243,6 +260,12 @@ class TokenDatabase {
     static_assert(EachEntryHasAString<decltype(kDatabaseBytes)>(kDatabaseBytes),
                   "The database must have at least one string for each entry.");
 
+    static_assert(ReadIndexOffset(std::data(kDatabaseBytes)) == 0u ||
+                      HasValidIndex<decltype(kDatabaseBytes)>(kDatabaseBytes),
+                  "The string index must fit within the database, the "
+                  "entries must be sorted, and each index offset must be the "
+                  "start of a string.");
+
     return TokenDatabase(std::data(kDatabaseBytes));
   }
 
@@ -260,9 +283,13 @@ class TokenDatabase {
                : TokenDatabase();  // Invalid database.
   }
   /// Creates a database with no data. `ok()` returns false.
-  constexpr TokenDatabase() : begin_{.data = nullptr}, end_{.data = nullptr} {}
+  constexpr TokenDatabase()
+      : begin_{.data = nullptr},
+        end_{.data = nullptr},
+        index_{.data = nullptr} {}
 
-  /// Returns all entries associated with this token. This is `O(n)`.
+  /// Returns all entries associated with this token. This is `O(log n)` if the
+  /// database has a string index and `O(n)` otherwise.
   Entries Find(uint32_t token) const;
 
   /// Returns the total number of entries (unique token-string pairs).
@@ -274,6 +301,10 @@ class TokenDatabase {
   /// be empty, but it has an intact header and a string for each entry.
   constexpr bool ok() const { return begin_.data != nullptr; }
 
+  /// True if the database has a string index, which allows looking up entries
+  /// without reading the entire string table.
+  constexpr bool indexed() const { return index_.data != nullptr; }
+
   /// Returns an iterator for the first token entry.
   constexpr iterator begin() const { return iterator(begin_.data, end_.data); }
 
@@ -285,7 +316,7 @@ class TokenDatabase {
     std::array<char, 6> magic;
     uint16_t version;
     uint32_t entry_count;
-    uint32_t reserved;
+    uint32_t index_offset;
   };
 
   static_assert(sizeof(Header) == 2 * sizeof(RawEntry));
@@ -317,11 +348,17 @@ class TokenDatabase {
       return false;
     }
 
+    // The string table ends at the index, if there is one.
+    size_type table_end = ReadIndexOffset(std::data(bytes));
+    if (table_end == 0u || table_end > std::size(bytes)) {
+      table_end = std::size(bytes);
+    }
+
     // Count the strings in the string table.
     size_type string_count = 0;
     for (auto i =
              std::begin(bytes) + static_cast<ptrdiff_t>(StringTable(entries));
-         i < std::end(bytes);
+         i < std::begin(bytes) + static_cast<ptrdiff_t>(table_end);
          ++i) {
       string_count += (*i == '\0') ? 1 : 0;
     }
@@ -338,6 +375,53 @@ class TokenDatabase {
     return ReadUint32(bytes);
   }
 
+  // Reads the string index offset from a database header, or 0 if there is no
+  // index.
+  template <typename T>
+  static constexpr uint32_t ReadIndexOffset(const T* header_bytes) {
+    return ReadUint32(header_bytes + offsetof(Header, index_offset));
+  }
+
+  // Checks that the string index fits after the string table and that the
+  // string table ends with a null terminator. Find() binary searches the
+  // entries and iterates from an indexed string, so the entries must be sorted
+  // by token, and the offsets must increase and each start a string.
+  template <typename ByteArray>
+  static constexpr bool HasValidIndex(const ByteArray& bytes) {
+    const size_type entries = ReadEntryCount(std::data(bytes));
+    const size_type index = ReadIndexOffset(std::data(bytes));
+    if (index <= StringTable(entries) || index > std::size(bytes) ||
+        (std::size(bytes) - index) / sizeof(uint32_t) < entries ||
+        bytes[index - 1] != '\0') {
+      return false;
+    }
+
+    const auto* data = std::data(bytes);
+    const size_type strings = StringTable(entries);
+    for (size_type i = 0; i < entries; ++i) {
+      const size_type offset = ReadUint32(data + index + i * sizeof(uint32_t));
+      if (i == 0u) {
+        if (offset != 0u) {
+          return false;
+        }
+        continue;
+      }
+
+      const size_type previous_offset =
+          ReadUint32(data + index + (i - 1) * sizeof(uint32_t));
+      if (offset <= previous_offset || offset >= index - strings ||
+          bytes[strings + offset - 1] != '\0') {
+        return false;
+      }
+
+      const auto* entry = data + sizeof(Header) + i * sizeof(RawEntry);
+      if (ReadUint32(entry) < ReadUint32(entry - sizeof(RawEntry))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   // Calculates the offset of the string table.
   static constexpr size_type StringTable(size_type entries) {
     return sizeof(Header) + entries * sizeof(RawEntry);
@@ -351,7 +435,10 @@ class TokenDatabase {
   template <typename Byte>
   constexpr TokenDatabase(const Byte bytes[])
       : TokenDatabase(bytes + sizeof(Header),
-                      bytes + StringTable(ReadEntryCount(bytes))) {
+                      bytes + StringTable(ReadEntryCount(bytes)),
+                      ReadIndexOffset(bytes) == 0u
+                          ? nullptr
+                          : bytes + ReadIndexOffset(bytes)) {
     static_assert(sizeof(Byte) == 1u);
   }
 
@@ -359,22 +446,35 @@ class TokenDatabase {
   // use unions. Instead of using a reinterpret_cast to change the byte pointer
   // to a RawEntry pointer, have a separate overload for each byte pointer type
   // and store them in a union.
-  constexpr TokenDatabase(const char* begin, const char* end)
-      : begin_{.data = begin}, end_{.data = end} {}
-
-  constexpr TokenDatabase(const unsigned char* begin, const unsigned char* end)
-      : begin_{.unsigned_data = begin}, end_{.unsigned_data = end} {}
-
-  constexpr TokenDatabase(const signed char* begin, const signed char* end)
-      : begin_{.signed_data = begin}, end_{.signed_data = end} {}
+  constexpr TokenDatabase(const char* begin,
+                          const char* end,
+                          const char* index)
+      : begin_{.data = begin}, end_{.data = end}, index_{.data = index} {}
+
+  constexpr TokenDatabase(const unsigned char* begin,
+                          const unsigned char* end,
+                          const unsigned char* index)
+      : begin_{.unsigned_data = begin},
+        end_{.unsigned_data = end},
+        index_{.unsigned_data = index} {}
+
+  constexpr TokenDatabase(const signed char* begin,
+                          const signed char* end,
+                          const signed char* index)
+      : begin_{.signed_data = begin},
+        end_{.signed_data = end},
+        index_{.signed_data = index} {}
+
+  // Looks up an entry's string with the string index.
+  const char* IndexedString(size_type entry) const;
 
   // Store the beginning and end pointers as a union to avoid breaking constexpr
-  // rules for reinterpret_cast.
+  // rules for reinterpret_cast. The index is null if the database has none.
   union {
     const char* data;
     const unsigned char* unsigned_data;
     const signed char* signed_data;
-  } begin_, end_;
+  } begin_, end_, index_;
 };
 
 }  // namespace pw::tokenizer
@@ -320,6 +320,8 @@ def _handle_create(
             tokens.write_csv(db, fd)
         elif output_type == 'binary':
             tokens.write_binary(db, fd)
+        elif output_type == 'binary-indexed':
+            tokens.write_binary(db, fd, indexed=True)
         else:
             raise ValueError(f'Unknown database type "{output_type}"')
 
@@ -566,7 +568,7 @@ def _parse_args() -> tuple[Callable[..., None], argparse.Namespace]:
         '-t',
         '--type',
         dest='output_type',
-        choices=('csv', 'binary', 'directory'),
+        choices=('csv', 'binary', 'binary-indexed', 'directory'),
         default='csv',
         help='Which type of database to create. (default: csv)',
     )
@@ -551,8 +551,9 @@ class _BinaryFileFormat(NamedTuple):
     """Attributes of the binary token database file format."""
 
     magic: bytes = b'TOKENS\0\0'
-    header: struct.Struct = struct.Struct('<8sI4x')
+    header: struct.Struct = struct.Struct('<8sII')
     entry: struct.Struct = struct.Struct('<IBBH')
+    string_offset: struct.Struct = struct.Struct('<I')
 
 
 BINARY_FORMAT = _BinaryFileFormat()
@@ -598,7 +599,7 @@ def _check_that_file_is_csv_database(path: Path) -> None:
 
 def parse_binary(fd: BinaryIO) -> Iterable[TokenizedStringEntry]:
     """Parses TokenizedStringEntries from a binary token database file."""
-    magic, entry_count = BINARY_FORMAT.header.unpack(
+    magic, entry_count, _ = BINARY_FORMAT.header.unpack(
         fd.read(BINARY_FORMAT.header.size)
     )
 
@@ -638,13 +639,30 @@ def parse_binary(fd: BinaryIO) -> Iterable[TokenizedStringEntry]:
         yield TokenizedStringEntry(token, string, DEFAULT_DOMAIN, removed)
 
 
-def write_binary(database: Database, fd: BinaryIO) -> None:
-    """Writes the database as packed binary to the provided binary file."""
-    entries = sorted(database.entries())
+def binary_database_is_indexed(fd: BinaryIO) -> bool:
+    """True if the binary token database has a string index."""
+    fd.seek(0)
+    header = fd.read(BINARY_FORMAT.header.size)
+    fd.seek(0)
+    if len(header) != BINARY_FORMAT.header.size:
+        return False
+    return BINARY_FORMAT.header.unpack(header)[2] != 0
+
 
-    fd.write(BINARY_FORMAT.header.pack(BINARY_FORMAT.magic, len(entries)))
+def write_binary(
+    database: Database, fd: BinaryIO, *, indexed: bool = False
+) -> None:
+    """Writes the database as packed binary to the provided binary file.
+
+    If indexed is True, a table with the offset of each entry's string follows
+    the string table, so that entries can be looked up without reading every
+    string. The header stores the offset of the index.
+    """
+    entries = sorted(database.entries())
 
     string_table = bytearray()
+    string_offsets = bytearray()
+    raw_entries = bytearray()
 
     for entry in entries:
         if entry.date_removed:
@@ -659,16 +677,29 @@ def write_binary(database: Database, fd: BinaryIO) -> None:
             removed_month = 0xFF
             removed_year = 0xFFFF
 
+        string_offsets += BINARY_FORMAT.string_offset.pack(len(string_table))
         string_table += entry.string.encode()
         string_table.append(0)
 
-        fd.write(
-            BINARY_FORMAT.entry.pack(
-                entry.token, removed_day, removed_month, removed_year
-            )
+        raw_entries += BINARY_FORMAT.entry.pack(
+            entry.token, removed_day, removed_month, removed_year
+        )
+
+    index_offset = 0
+    if indexed:
+        index_offset = (
+            BINARY_FORMAT.header.size + len(raw_entries) + len(string_table)
         )
 
+    fd.write(
+        BINARY_FORMAT.header.pack(
+            BINARY_FORMAT.magic, len(entries), index_offset
+        )
+    )
+    fd.write(raw_entries)
     fd.write(string_table)
+    if indexed:
+        fd.write(string_offsets)
 
 
 class DatabaseFile(Database):
@@ -716,13 +747,14 @@ class DatabaseFile(Database):
 
 class _BinaryDatabase(DatabaseFile):
     def __init__(self, path: Path, fd: BinaryIO) -> None:
+        self._indexed = binary_database_is_indexed(fd)
         super().__init__(path, parse_binary(fd))
 
     def write_to_file(self, *, rewrite: bool = False) -> None:
         """Exports in the binary format to the original path."""
         del rewrite  # Binary databases are always rewritten
         with self.path.open('wb') as fd:
-            write_binary(self, fd)
+            write_binary(self, fd, indexed=self._indexed)
 
     def add_and_discard_temporary(
         self, entries: Iterable[TokenizedStringEntry], commit: str
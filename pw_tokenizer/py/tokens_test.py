@@ -751,6 +751,40 @@ class TokenDatabaseTest(unittest.TestCase):
 
         self.assertEqual(str(db), CSV_DATABASE)
 
+    def test_binary_format_write_indexed(self) -> None:
+        db = read_db_from_csv(CSV_DATABASE)
+
+        with io.BytesIO() as fd:
+            tokens.write_binary(db, fd, indexed=True)
+            binary_db = fd.getvalue()
+
+        # The index follows the unindexed database; only the header differs.
+        index_offset = len(BINARY_DATABASE)
+        self.assertEqual(
+            binary_db[16:index_offset], BINARY_DATABASE[16:index_offset]
+        )
+        self.assertEqual(binary_db[12:16], index_offset.to_bytes(4, 'little'))
+
+        string_table = 16 + 8 * len(db)
+        entries = sorted(db.entries())
+        for i, entry in enumerate(entries):
+            offset = int.from_bytes(
+                binary_db[index_offset + 4 * i : index_offset + 4 * i + 4],
+                'little',
+            )
+            start = string_table + offset
+            end = binary_db.index(b'\0', start)
+            self.assertEqual(binary_db[start:end].decode(), entry.string)
+
+        with io.BytesIO(binary_db) as fd:
+            self.assertTrue(tokens.binary_database_is_indexed(fd))
+            self.assertEqual(
+                str(tokens.Database(tokens.parse_binary(fd))), CSV_DATABASE
+            )
+
+        with io.BytesIO(BINARY_DATABASE) as fd:
+            self.assertFalse(tokens.binary_database_is_indexed(fd))
+
 
 class TestDatabaseFile(unittest.TestCase):
     """Tests the DatabaseFile class."""
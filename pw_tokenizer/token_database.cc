@@ -25,6 +25,35 @@ TokenDatabase::Entry TokenDatabase::Entries::operator[](size_t index) const {
 }
 
 TokenDatabase::Entries TokenDatabase::Find(const uint32_t token) const {
+  if (indexed()) {
+    // Binary search for the range of entries with this token.
+    const auto token_at = [this](size_type entry) {
+      return ReadUint32(begin_.data + entry * sizeof(RawEntry));
+    };
+    size_type low = 0;
+    size_type high = size();
+    while (low < high) {
+      const size_type middle = low + (high - low) / 2;
+      if (token_at(middle) < token) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+
+    size_type last = low;
+    while (last < size() && token_at(last) == token) {
+      ++last;
+    }
+
+    if (low == last) {
+      return Entries(end(), end());
+    }
+    return Entries(iterator(begin_.data + low * sizeof(RawEntry),
+                            IndexedString(low)),
+                   iterator(begin_.data + last * sizeof(RawEntry)));
+  }
+
   iterator first = begin();
   while (first != end() && token > first->token) {
     ++first;
@@ -38,4 +67,9 @@ TokenDatabase::Entries TokenDatabase::Find(const uint32_t token) const {
   return Entries(first, last);
 }
 
+const char* TokenDatabase::IndexedString(size_type entry) const {
+  // IsValid() checked that the offset is within the string table.
+  return end_.data + ReadUint32(index_.data + entry * sizeof(uint32_t));
+}
+
 }  // namespace pw::tokenizer
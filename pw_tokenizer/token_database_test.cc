@@ -14,6 +14,7 @@
 
 #include "pw_tokenizer/token_database.h"
 
+#include <array>
 #include <cstring>
 #include <string>
 #include <string_view>
@@ -259,6 +260,126 @@ TEST(TokenDatabase, MultipleEntriesWithSameToken) {
   }
 }
 
+// The string index starts at offset 77 (0x4D), after the string table.
+constexpr char kIndexedData[] =
+    "TOKENS\0\0\x05\0\0\0\x4D\0\0\0"
+    "\x01\0\0\0date"
+    "\x01\0\0\0date"
+    "\x02\0\0\0date"
+    "\x05\0\0\0date"
+    "\xFF\0\0\0date"
+    "one\0uno\0two\0five\0max\0"
+    "\x00\0\0\0\x04\0\0\0\x08\0\0\0\x0C\0\0\0\x11\0\0\0";
+
+constexpr TokenDatabase kIndexed = TokenDatabase::Create<kIndexedData>();
+static_assert(kIndexed.size() == 5u);
+static_assert(kIndexed.indexed());
+static_assert(!kBasicDatabase.indexed());
+
+TEST(TokenDatabase, Indexed_Find) {
+  TokenDatabase::Entries match = kIndexed.Find(1);
+  ASSERT_EQ(match.size(), 2u);
+  EXPECT_STREQ(match[0].string, "one");
+  EXPECT_STREQ(match[1].string, "uno");
+  for (const auto& entry : match) {
+    EXPECT_EQ(entry.token, 1u);
+  }
+
+  ASSERT_EQ(kIndexed.Find(2).size(), 1u);
+  EXPECT_STREQ(kIndexed.Find(2)[0].string, "two");
+  ASSERT_EQ(kIndexed.Find(5).size(), 1u);
+  EXPECT_STREQ(kIndexed.Find(5)[0].string, "five");
+  ASSERT_EQ(kIndexed.Find(0xFF).size(), 1u);
+  EXPECT_STREQ(kIndexed.Find(0xFF)[0].string, "max");
+}
+
+TEST(TokenDatabase, Indexed_NonPresent) {
+  EXPECT_TRUE(kIndexed.Find(0).empty());
+  EXPECT_TRUE(kIndexed.Find(3).empty());
+  EXPECT_TRUE(kIndexed.Find(0x100).empty());
+  EXPECT_TRUE(kIndexed.Find(0xFFFFFFFFu).empty());
+}
+
+TEST(TokenDatabase, Indexed_TokenLargerThanAllEntries) {
+  // Copy without the trailing null so the index ends at the end of the data.
+  std::array<char, sizeof(kIndexedData) - 1> data;
+  std::memcpy(data.data(), kIndexedData, data.size());
+
+  const TokenDatabase db = TokenDatabase::Create(data);
+  ASSERT_TRUE(db.indexed());
+  EXPECT_TRUE(db.Find(0x100).empty());
+  EXPECT_TRUE(db.Find(0xFFFFFFFFu).empty());
+}
+
+// An empty string table (one null byte) followed by an empty index.
+constexpr char kIndexedEmptyData[] = "TOKENS\0\0\0\0\0\0\x11\0\0\0";
+
+TEST(TokenDatabase, Indexed_Empty) {
+  constexpr TokenDatabase empty_db =
+      TokenDatabase::Create<kIndexedEmptyData>();
+  static_assert(empty_db.size() == 0u);
+  static_assert(empty_db.indexed());
+
+  EXPECT_TRUE(empty_db.Find(0).empty());
+  EXPECT_TRUE(empty_db.Find(123).empty());
+  EXPECT_TRUE(empty_db.Find(0xFFFFFFFFu).empty());
+}
+
+TEST(TokenDatabase, Indexed_Iterator) {
+  constexpr const char* kStrings[] = {"one", "uno", "two", "five", "max"};
+  size_t i = 0;
+  for (const auto& entry : kIndexed) {
+    ASSERT_LT(i, 5u);
+    EXPECT_STREQ(entry.string, kStrings[i++]);
+  }
+  EXPECT_EQ(i, 5u);
+}
+
+TEST(TokenDatabase, Indexed_InvalidIndex) {
+  char data[sizeof(kIndexedData)];
+  std::memcpy(data, kIndexedData, sizeof(data));
+  EXPECT_TRUE(TokenDatabase::IsValid(data));
+
+  data[12] = 0x38;  // The index overlaps the entries.
+  EXPECT_FALSE(TokenDatabase::IsValid(data));
+
+  data[12] = 0x50;  // The index extends past the end of the data.
+  EXPECT_FALSE(TokenDatabase::IsValid(data));
+
+  data[12] = 0x4C;  // The string table does not end with a null terminator.
+  EXPECT_FALSE(TokenDatabase::IsValid(data));
+}
+
+TEST(TokenDatabase, Indexed_InvalidStringOffsets) {
+  constexpr size_t kEntry2Offset = 0x4D + 2 * sizeof(uint32_t);
+  char data[sizeof(kIndexedData)];
+  std::memcpy(data, kIndexedData, sizeof(data));
+
+  data[kEntry2Offset] = 21;  // The offset is outside of the string table.
+  EXPECT_FALSE(TokenDatabase::IsValid(data));
+  EXPECT_FALSE(TokenDatabase::Create(data).ok());
+
+  data[kEntry2Offset] = 9;  // The offset is not the start of a string.
+  EXPECT_FALSE(TokenDatabase::IsValid(data));
+
+  data[kEntry2Offset] = 4;  // The offset repeats the previous entry's.
+  EXPECT_FALSE(TokenDatabase::IsValid(data));
+
+  data[kEntry2Offset] = 8;
+  EXPECT_TRUE(TokenDatabase::IsValid(data));
+
+  data[0x4D] = 4;  // The first entry's string is not the first string.
+  EXPECT_FALSE(TokenDatabase::IsValid(data));
+}
+
+TEST(TokenDatabase, Indexed_UnsortedEntries) {
+  char data[sizeof(kIndexedData)];
+  std::memcpy(data, kIndexedData, sizeof(data));
+
+  data[16 + 2 * 8] = 0x06;  // Entry 2's token is larger than entry 3's.
+  EXPECT_FALSE(TokenDatabase::IsValid(data));
+}
+
 TEST(TokenDatabase, Empty) {
   constexpr TokenDatabase empty_db = TokenDatabase::Create<kEmptyData>();
   static_assert(empty_db.size() == 0u);
@@ -0,0 +1,104 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// This test is built with per_thread_buffers_test_config.h, which enables
+// PW_TRACE_CONFIG_PER_THREAD_BUFFERS.
+
+// clang-format off
+#define PW_TRACE_MODULE_NAME "TST"
+
+#include "pw_trace/trace.h"
+#include "pw_trace_tokenized/trace_callback.h"
+#include "pw_trace_tokenized/trace_tokenized.h"
+// clang-format on
+
+#include <array>
+#include <cstddef>
+#include <thread>
+
+#include "pw_unit_test/framework.h"
+
+static_assert(PW_TRACE_CONFIG_PER_THREAD_BUFFERS);
+
+namespace {
+
+constexpr size_t kThreadCount = 4 * PW_TRACE_CONFIG_MAX_THREAD_BUFFERS + 4;
+
+// Counts the events sent to a sink. Sinks are only called while draining, which
+// holds PW_TRACE_LOCK, so the count needs no other synchronization.
+class PerThreadBuffersTest : public ::testing::Test {
+ protected:
+  PerThreadBuffersTest() {
+    PW_TRACE_SET_ENABLED(true);
+    pw::trace::GetTokenizedTracer().DrainThreadBuffers();
+    EXPECT_EQ(pw::OkStatus(),
+              pw::trace::GetCallbacks().RegisterSink(
+                  [](void*, size_t) {},
+                  [](void*, const void*, size_t) {},
+                  [](void* user_data) {
+                    ++static_cast<PerThreadBuffersTest*>(user_data)->events_;
+                  },
+                  this,
+                  &sink_handle_));
+  }
+
+  ~PerThreadBuffersTest() override {
+    EXPECT_EQ(pw::OkStatus(),
+              pw::trace::GetCallbacks().UnregisterSink(sink_handle_));
+    PW_TRACE_SET_ENABLED(false);
+  }
+
+  size_t Drain() {
+    pw::trace::GetTokenizedTracer().DrainThreadBuffers();
+    return events_;
+  }
+
+ private:
+  pw::trace::Callbacks::SinkHandle sink_handle_;
+  size_t events_ = 0;
+};
+
+TEST_F(PerThreadBuffersTest, SingleThread) {
+  PW_TRACE_INSTANT("one");
+  PW_TRACE_INSTANT("two");
+  EXPECT_EQ(Drain(), 2u);
+}
+
+TEST_F(PerThreadBuffersTest, SequentialThreads_ReuseBuffersWithoutDrain) {
+  for (size_t i = 0; i < kThreadCount; ++i) {
+    std::thread([] { PW_TRACE_INSTANT("event"); }).join();
+  }
+  EXPECT_EQ(Drain(), kThreadCount);
+}
+
+TEST_F(PerThreadBuffersTest, ConcurrentThreads) {
+  // Each thread's events fit in its buffer, so none are dropped even if
+  // another thread holds the lock whenever this one tries to drain.
+  constexpr size_t kEventsPerThread = PW_TRACE_CONFIG_THREAD_BUFFER_SIZE_EVENTS;
+
+  std::array<std::thread, PW_TRACE_CONFIG_MAX_THREAD_BUFFERS> threads;
+  for (std::thread& thread : threads) {
+    thread = std::thread([] {
+      for (size_t i = 0; i < kEventsPerThread; ++i) {
+        PW_TRACE_INSTANT("event");
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(Drain(), threads.size() * kEventsPerThread);
+}
+
+}  // namespace
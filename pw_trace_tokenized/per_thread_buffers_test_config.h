@@ -0,0 +1,43 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+//==============================================================================
+//
+
+#pragma once
+
+// pw_trace_tokenized config overrides for per_thread_buffers_test, which builds
+// the tracer with per-thread buffers. That mode requires real lock hooks, so
+// they are backed by a std::mutex.
+
+#ifdef __cplusplus
+
+#include <mutex>
+
+namespace pw::trace::test {
+
+inline std::mutex trace_lock;
+
+}  // namespace pw::trace::test
+
+#define PW_TRACE_CONFIG_PER_THREAD_BUFFERS 1
+
+// Fewer buffers than the number of threads the test starts, so buffers must be
+// handed from exited threads to new ones.
+#define PW_TRACE_CONFIG_MAX_THREAD_BUFFERS 4
+
+#define PW_TRACE_LOCK() ::pw::trace::test::trace_lock.lock()
+#define PW_TRACE_TRY_LOCK() ::pw::trace::test::trace_lock.try_lock()
+#define PW_TRACE_UNLOCK() ::pw::trace::test::trace_lock.unlock()
+
+#endif  // __cplusplus
@@ -0,0 +1,483 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_trace_tokenized/perfetto_exporter.h"
+
+#include <string>
+#include <vector>
+
+#include "pw_bytes/endian.h"
+#include "pw_protobuf/encoder.h"
+#include "pw_result/result.h"
+#include "pw_span/span.h"
+#include "pw_status/try.h"
+#include "pw_varint/varint.h"
+
+namespace pw::trace {
+namespace {
+
+// Field numbers and values from the Perfetto trace protos
+// (protos/perfetto/trace/trace.proto and the messages it includes). Only the
+// fields used by the exporter are listed.
+namespace trace_proto {
+constexpr uint32_t kPacket = 1;
+}  // namespace trace_proto
+
+namespace trace_packet {
+constexpr uint32_t kTimestamp = 8;
+constexpr uint32_t kTrustedPacketSequenceId = 10;
+constexpr uint32_t kTrackEvent = 11;
+constexpr uint32_t kSequenceFlags = 13;
+constexpr uint32_t kTrackDescriptor = 60;
+
+constexpr uint32_t kSeqIncrementalStateCleared = 1;
+}  // namespace trace_packet
+
+namespace track_descriptor {
+constexpr uint32_t kUuid = 1;
+constexpr uint32_t kName = 2;
+constexpr uint32_t kProcess = 3;
+constexpr uint32_t kParentUuid = 5;
+constexpr uint32_t kCounter = 8;
+}  // namespace track_descriptor
+
+namespace process_descriptor {
+constexpr uint32_t kPid = 1;
+constexpr uint32_t kProcessName = 6;
+}  // namespace process_descriptor
+
+namespace track_event {
+constexpr uint32_t kDebugAnnotations = 4;
+constexpr uint32_t kType = 9;
+constexpr uint32_t kTrackUuid = 11;
+constexpr uint32_t kCategories = 22;
+constexpr uint32_t kName = 23;
+constexpr uint32_t kCounterValue = 30;
+
+constexpr uint32_t kTypeSliceBegin = 1;
+constexpr uint32_t kTypeSliceEnd = 2;
+constexpr uint32_t kTypeInstant = 3;
+constexpr uint32_t kTypeCounter = 4;
+}  // namespace track_event
+
+namespace debug_annotation {
+constexpr uint32_t kUintValue = 3;
+constexpr uint32_t kStringValue = 6;
+constexpr uint32_t kName = 10;
+}  // namespace debug_annotation
+
+// All packets are written to one sequence.
+constexpr uint32_t kSequenceId = 1;
+
+// Data formats with special meanings, from the pw_trace facade.
+constexpr std::string_view kArgLabel = "@pw_arg_label";
+constexpr std::string_view kArgGroup = "@pw_arg_group";
+constexpr std::string_view kArgCounter = "@pw_arg_counter";
+
+// Returns the next field of a token string and removes it from the string.
+std::string_view NextField(std::string_view& fields) {
+  const size_t end = fields.find('|');
+  const std::string_view field = fields.substr(0, end);
+  fields.remove_prefix(end == std::string_view::npos ? fields.size()
+                                                     : end + 1);
+  return field;
+}
+
+std::string_view AsString(ConstByteSpan data) {
+  return std::string_view(reinterpret_cast<const char*>(data.data()),
+                          data.size());
+}
+
+Status WriteDebugAnnotation(protobuf::StreamEncoder& event,
+                            std::string_view name,
+                            uint64_t value) {
+  protobuf::StreamEncoder annotation =
+      event.GetNestedEncoder(track_event::kDebugAnnotations);
+  annotation.WriteString(debug_annotation::kName, name).IgnoreError();
+  return annotation.WriteUint64(debug_annotation::kUintValue, value);
+}
+
+// Writes the data as a hex string, like the Python trace tool.
+Status WriteDebugAnnotation(protobuf::StreamEncoder& event,
+                            std::string_view name,
+                            ConstByteSpan data) {
+  constexpr char kHexDigits[] = "0123456789abcdef";
+  std::string hex;
+  hex.reserve(2 * data.size());
+  for (std::byte byte : data) {
+    hex.push_back(kHexDigits[static_cast<uint8_t>(byte) >> 4]);
+    hex.push_back(kHexDigits[static_cast<uint8_t>(byte) & 0xf]);
+  }
+
+  protobuf::StreamEncoder annotation =
+      event.GetNestedEncoder(track_event::kDebugAnnotations);
+  annotation.WriteString(debug_annotation::kName, name).IgnoreError();
+  return annotation.WriteString(debug_annotation::kStringValue, hex);
+}
+
+// Events which cannot be converted are skipped when converting many events.
+bool IsSkippable(Status status) {
+  return status.IsNotFound() || status.IsDataLoss() ||
+         status.IsInvalidArgument();
+}
+
+}  // namespace
+
+PerfettoExporter::PerfettoExporter(const tokenizer::Detokenizer& detokenizer,
+                                   stream::Writer& output,
+                                   const Options& options)
+    : detokenizer_(detokenizer), output_(output), options_(options) {}
+
+Status PerfettoExporter::AddEvent(ConstByteSpan event) {
+  const Status status = ConvertEvent(event);
+  if (status.ok()) {
+    events_converted_ += 1;
+  } else if (IsSkippable(status)) {
+    events_skipped_ += 1;
+  }
+  return status;
+}
+
+Status PerfettoExporter::AddSizePrefixedEvents(stream::Reader& input) {
+  std::array<std::byte, 255> event_buffer;
+
+  while (true) {
+    std::byte size;
+    const Result<ByteSpan> size_read = input.Read(span(&size, 1));
+    if (size_read.status().IsOutOfRange()) {
+      return OkStatus();
+    }
+    PW_TRY(size_read.status());
+
+    const Result<ByteSpan> event = input.ReadExact(
+        span(event_buffer).first(static_cast<size_t>(size)));
+    if (event.status().IsOutOfRange()) {
+      return Status::DataLoss();
+    }
+    PW_TRY(event.status());
+
+    if (const Status status = AddEvent(*event);
+        !status.ok() && !IsSkippable(status)) {
+      return status;
+    }
+  }
+}
+
+Status PerfettoExporter::AddEvents(
+    ring_buffer::PrefixedEntryRingBuffer& buffer) {
+  auto it = buffer.begin();
+  for (; it != buffer.end(); ++it) {
+    if (const Status status = AddEvent(it->buffer);
+        !status.ok() && !IsSkippable(status)) {
+      return status;
+    }
+  }
+  return it.status();
+}
+
+Status PerfettoExporter::ConvertEvent(ConstByteSpan event) {
+  // Encoded events are the token, the time delta, the trace ID if the event
+  // has one, and then the data.
+  if (event.size() < sizeof(uint32_t)) {
+    return Status::DataLoss();
+  }
+  const uint32_t token =
+      bytes::ReadInOrder<uint32_t>(endian::little, event.data());
+  event = event.subspan(sizeof(token));
+
+  uint64_t delta;
+  size_t bytes = varint::Decode(event, &delta);
+  if (bytes == 0u) {
+    return Status::DataLoss();
+  }
+  event = event.subspan(bytes);
+  ticks_ += delta;
+
+  const TokenInfo* info = Lookup(token);
+  if (info == nullptr) {
+    return Status::NotFound();
+  }
+
+  // Async events always have a trace ID. Other events have one if the platform
+  // includes it for them, which is only detectable if they have no data.
+  const bool is_async = info->type == EventType::kAsyncStart ||
+                        info->type == EventType::kAsyncStep ||
+                        info->type == EventType::kAsyncEnd;
+  uint64_t trace_id = 0;
+  if (is_async || (!info->has_data && !event.empty())) {
+    bytes = varint::Decode(event, &trace_id);
+    if (bytes == 0u) {
+      return Status::DataLoss();
+    }
+    event = event.subspan(bytes);
+  }
+  const ConstByteSpan data = info->has_data ? event : ConstByteSpan();
+
+  std::string_view name = info->label;
+  std::string_view group = info->group;
+  bool is_counter = false;
+  bool data_handled = false;
+  if (info->has_data) {
+    data_handled = true;
+    if (info->data_format == kArgLabel) {
+      name = AsString(data);
+    } else if (info->data_format == kArgGroup) {
+      group = AsString(data);
+    } else if (info->data_format == kArgCounter) {
+      is_counter = true;
+    } else {
+      data_handled = false;
+    }
+  }
+
+  TrackKind kind;
+  std::string_view track_name;
+  uint32_t type;
+  switch (info->type) {
+    case EventType::kInstant:
+      kind = TrackKind::kProcess;
+      type = track_event::kTypeInstant;
+      break;
+    case EventType::kInstantGroup:
+      kind = TrackKind::kThread;
+      track_name = group;
+      type = track_event::kTypeInstant;
+      break;
+    case EventType::kDurationStart:
+    case EventType::kDurationEnd:
+      kind = TrackKind::kThread;
+      track_name = info->label;
+      type = info->type == EventType::kDurationStart
+                 ? track_event::kTypeSliceBegin
+                 : track_event::kTypeSliceEnd;
+      break;
+    case EventType::kDurationGroupStart:
+    case EventType::kDurationGroupEnd:
+      kind = TrackKind::kThread;
+      track_name = group;
+      type = info->type == EventType::kDurationGroupStart
+                 ? track_event::kTypeSliceBegin
+                 : track_event::kTypeSliceEnd;
+      break;
+    case EventType::kAsyncStart:
+    case EventType::kAsyncStep:
+    case EventType::kAsyncEnd:
+      kind = TrackKind::kAsync;
+      track_name = group;
+      if (info->type == EventType::kAsyncStart) {
+        type = track_event::kTypeSliceBegin;
+      } else if (info->type == EventType::kAsyncEnd) {
+        type = track_event::kTypeSliceEnd;
+      } else {
+        type = track_event::kTypeInstant;
+      }
+      break;
+    case EventType::kInvalid:
+    default:
+      return Status::InvalidArgument();
+  }
+
+  if (is_counter) {
+    kind = TrackKind::kCounter;
+    track_name = name;
+    type = track_event::kTypeCounter;
+  }
+
+  PW_TRY_ASSIGN(
+      const uint64_t track_uuid,
+      GetTrack(kind, info->module, track_name, is_async ? trace_id : 0));
+
+  protobuf::MemoryEncoder packet(packet_buffer_);
+  StartPacket(packet);
+  packet.WriteUint64(trace_packet::kTimestamp, TimestampNs()).IgnoreError();
+  {
+    protobuf::StreamEncoder track_event =
+        packet.GetNestedEncoder(trace_packet::kTrackEvent);
+    track_event.WriteUint32(track_event::kType, type).IgnoreError();
+    track_event.WriteUint64(track_event::kTrackUuid, track_uuid).IgnoreError();
+    if (type != track_event::kTypeSliceEnd) {
+      track_event.WriteString(track_event::kName, name).IgnoreError();
+    }
+    track_event.WriteString(track_event::kCategories, info->module)
+        .IgnoreError();
+    if (is_counter) {
+      // Counter values are little-endian integers of up to 8 bytes.
+      const uint64_t value = bytes::ReadInOrder<uint64_t>(
+          endian::little, data.data(), data.size());
+      track_event
+          .WriteInt64(track_event::kCounterValue, static_cast<int64_t>(value))
+          .IgnoreError();
+    }
+    if (is_async) {
+      WriteDebugAnnotation(track_event, "id", trace_id).IgnoreError();
+    }
+    if (info->has_data && !data_handled) {
+      WriteDebugAnnotation(track_event, "data", data).IgnoreError();
+    }
+  }
+  if (!packet.status().ok()) {
+    return Status::InvalidArgument();  // The strings do not fit in a packet.
+  }
+  return WritePacket(packet);
+}
+
+const PerfettoExporter::TokenInfo* PerfettoExporter::Lookup(uint32_t token) {
+  auto [it, inserted] = tokens_.try_emplace(token);
+  TokenInfo& info = it->second;
+  if (!inserted) {
+    return &info;
+  }
+
+  // Holds the entries parsed from an indexed database. Results are cached in
+  // tokens_, so each token is only looked up once.
+  std::vector<tokenizer::TokenizedStringEntry> indexed_entries;
+  span<const tokenizer::TokenizedStringEntry> entries =
+      detokenizer_.DatabaseLookup(token, "trace", indexed_entries);
+  if (entries.empty()) {
+    entries = detokenizer_.DatabaseLookup(token, "", indexed_entries);
+  }
+  if (entries.empty()) {
+    tokens_.erase(it);
+    return nullptr;
+  }
+
+  // Formatting with no arguments recovers the original string.
+  info.text = entries.front().first.Format(span<const uint8_t>()).value();
+
+  // "event_type|flags|module|group|label|<optional data format>"
+  std::string_view fields = info.text;
+  const std::string_view type = NextField(fields);
+  NextField(fields);  // Flags are not used.
+  info.module = NextField(fields);
+  info.group = NextField(fields);
+  info.label = NextField(fields);
+  info.has_data = !fields.empty();
+  info.data_format = fields;
+
+  static constexpr std::pair<std::string_view, EventType> kTypes[] = {
+      {"PW_TRACE_EVENT_TYPE_INSTANT", EventType::kInstant},
+      {"PW_TRACE_EVENT_TYPE_INSTANT_GROUP", EventType::kInstantGroup},
+      {"PW_TRACE_EVENT_TYPE_ASYNC_START", EventType::kAsyncStart},
+      {"PW_TRACE_EVENT_TYPE_ASYNC_STEP", EventType::kAsyncStep},
+      {"PW_TRACE_EVENT_TYPE_ASYNC_END", EventType::kAsyncEnd},
+      {"PW_TRACE_EVENT_TYPE_DURATION_START", EventType::kDurationStart},
+      {"PW_TRACE_EVENT_TYPE_DURATION_END", EventType::kDurationEnd},
+      {"PW_TRACE_EVENT_TYPE_DURATION_GROUP_START",
+       EventType::kDurationGroupStart},
+      {"PW_TRACE_EVENT_TYPE_DURATION_GROUP_END", EventType::kDurationGroupEnd},
+  };
+  for (const auto& [type_name, event_type] : kTypes) {
+    if (type == type_name) {
+      info.type = event_type;
+    }
+  }
+  return &info;
+}
+
+Result<uint64_t> PerfettoExporter::GetTrack(TrackKind kind,
+                                            std::string_view module,
+                                            std::string_view name,
+                                            uint64_t trace_id) {
+  // Every track belongs to the process track for its module.
+  track_key_.assign(1, static_cast<char>(TrackKind::kProcess));
+  track_key_.append(module);
+  auto [process, new_process] = tracks_.try_emplace(track_key_, 0);
+  if (new_process) {
+    process->second = next_track_uuid_++;
+    PW_TRY(WriteTrackDescriptor(
+        process->second, 0, TrackKind::kProcess, module));
+  }
+  if (kind == TrackKind::kProcess) {
+    return process->second;
+  }
+
+  track_key_[0] = static_cast<char>(kind);
+  track_key_.push_back('\0');
+  track_key_.append(name);
+  track_key_.push_back('\0');
+  track_key_.append(reinterpret_cast<const char*>(&trace_id),
+                    sizeof(trace_id));
+  auto [track, new_track] = tracks_.try_emplace(track_key_, 0);
+  if (new_track) {
+    track->second = next_track_uuid_++;
+    PW_TRY(WriteTrackDescriptor(track->second, process->second, kind, name));
+  }
+  return track->second;
+}
+
+Status PerfettoExporter::WriteTrackDescriptor(uint64_t uuid,
+                                              uint64_t parent_uuid,
+                                              TrackKind kind,
+                                              std::string_view name) {
+  protobuf::MemoryEncoder packet(packet_buffer_);
+  StartPacket(packet);
+  {
+    protobuf::StreamEncoder track =
+        packet.GetNestedEncoder(trace_packet::kTrackDescriptor);
+    track.WriteUint64(track_descriptor::kUuid, uuid).IgnoreError();
+    if (parent_uuid != 0u) {
+      track.WriteUint64(track_descriptor::kParentUuid, parent_uuid)
+          .IgnoreError();
+    }
+    track.WriteString(track_descriptor::kName, name).IgnoreError();
+
+    if (kind == TrackKind::kProcess) {
+      // Perfetto requires a pid for process tracks, so use the track's UUID.
+      protobuf::StreamEncoder process =
+          track.GetNestedEncoder(track_descriptor::kProcess);
+      process
+          .WriteInt32(process_descriptor::kPid, static_cast<int32_t>(uuid))
+          .IgnoreError();
+      process.WriteString(process_descriptor::kProcessName, name)
+          .IgnoreError();
+    } else if (kind == TrackKind::kCounter) {
+      // An empty CounterDescriptor marks the track as a counter track.
+      protobuf::StreamEncoder counter =
+          track.GetNestedEncoder(track_descriptor::kCounter);
+    }
+  }
+  if (!packet.status().ok()) {
+    return Status::InvalidArgument();
+  }
+  return WritePacket(packet);
+}
+
+void PerfettoExporter::StartPacket(protobuf::StreamEncoder& packet) {
+  packet.WriteUint32(trace_packet::kTrustedPacketSequenceId, kSequenceId)
+      .IgnoreError();
+  if (first_packet_) {
+    first_packet_ = false;
+    packet
+        .WriteUint32(trace_packet::kSequenceFlags,
+                     trace_packet::kSeqIncrementalStateCleared)
+        .IgnoreError();
+  }
+}
+
+Status PerfettoExporter::WritePacket(const protobuf::MemoryEncoder& packet) {
+  // Each packet is a field of the top-level Trace message, so packets can be
+  // appended to the output without buffering the whole trace.
+  protobuf::StreamEncoder trace(output_, ByteSpan());
+  return trace.WriteBytes(trace_proto::kPacket,
+                          ConstByteSpan(packet.data(), packet.size()));
+}
+
+uint64_t PerfettoExporter::TimestampNs() const {
+  constexpr uint64_t kNanosecondsPerSecond = 1'000'000'000;
+  const uint64_t rate = options_.ticks_per_second;
+  return options_.time_offset_ns + ticks_ / rate * kNanosecondsPerSecond +
+         ticks_ % rate * kNanosecondsPerSecond / rate;
+}
+
+}  // namespace pw::trace
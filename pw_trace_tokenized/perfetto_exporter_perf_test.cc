@@ -0,0 +1,106 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures the time to convert a size-prefixed trace file of kEvents events to
+// Perfetto with PerfettoExporter. The test also logs its throughput in events
+// per second.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "pw_bytes/span.h"
+#include "pw_log/log.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_stream/memory_stream.h"
+#include "pw_stream/null_stream.h"
+#include "pw_tokenizer/token_database.h"
+#include "pw_trace_tokenized/perfetto_exporter.h"
+#include "pw_varint/varint.h"
+
+namespace pw::trace {
+namespace {
+
+constexpr size_t kEvents = 20000;
+
+constexpr char kTraceData[] =
+    "TOKENS\0\0"
+    "\x04\x00\x00\x00"
+    "\0\0\0\0"
+    "\x01\x00\x00\x00----"
+    "\x02\x00\x00\x00----"
+    "\x03\x00\x00\x00----"
+    "\x04\x00\x00\x00----"
+    "PW_TRACE_EVENT_TYPE_DURATION_START|0|app||Process\0"
+    "PW_TRACE_EVENT_TYPE_DURATION_END|0|app||Process\0"
+    "PW_TRACE_EVENT_TYPE_INSTANT|0|app||Tick\0"
+    "PW_TRACE_EVENT_TYPE_INSTANT|0|app||Queue|@pw_arg_counter";
+constexpr tokenizer::TokenDatabase kTraceDatabase =
+    tokenizer::TokenDatabase::Create<kTraceData>();
+
+void AppendEvent(std::vector<std::byte>& file,
+                 uint32_t token,
+                 ConstByteSpan data = {}) {
+  std::byte event[sizeof(token) + varint::kMaxVarint64SizeBytes + 4];
+  std::memcpy(event, &token, sizeof(token));
+  size_t size = sizeof(token);
+  size += varint::Encode(7u, span(event).subspan(size));
+  std::memcpy(event + size, data.data(), data.size());
+  size += data.size();
+
+  file.push_back(static_cast<std::byte>(size));
+  file.insert(file.end(), event, event + size);
+}
+
+// A repeating mix of duration, instant, and counter events.
+const std::vector<std::byte>& TraceFile() {
+  static const std::vector<std::byte> file = [] {
+    std::vector<std::byte> data;
+    for (size_t i = 0; i < kEvents; i += 4) {
+      const uint32_t queue_depth = static_cast<uint32_t>(i % 32);
+      AppendEvent(data, 1);
+      AppendEvent(data, 3);
+      AppendEvent(data, 4, as_bytes(span(&queue_depth, 1)));
+      AppendEvent(data, 2);
+    }
+    return data;
+  }();
+  return file;
+}
+
+void ConvertTraceFile(perf_test::State& state) {
+  tokenizer::Detokenizer detokenizer(kTraceDatabase);
+  const std::vector<std::byte>& file = TraceFile();
+
+  size_t iterations = 0;
+  const auto start = std::chrono::steady_clock::now();
+  while (state.KeepRunning()) {
+    PerfettoExporter exporter(detokenizer, stream::NullStream::Instance());
+    stream::MemoryReader reader(file);
+    exporter.AddSizePrefixedEvents(reader).IgnoreError();
+    iterations += 1;
+  }
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  PW_LOG_INFO("Events/s: %.0f",
+              static_cast<double>(iterations * kEvents) / elapsed.count());
+}
+
+PW_PERF_TEST(ConvertTraceFile, ConvertTraceFile);
+
+}  // namespace
+}  // namespace pw::trace
@@ -0,0 +1,491 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_trace_tokenized/perfetto_exporter.h"
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "pw_bytes/span.h"
+#include "pw_protobuf/decoder.h"
+#include "pw_ring_buffer/prefixed_entry_ring_buffer.h"
+#include "pw_stream/memory_stream.h"
+#include "pw_tokenizer/token_database.h"
+#include "pw_unit_test/framework.h"
+#include "pw_varint/varint.h"
+
+namespace pw::trace {
+namespace {
+
+constexpr char kCsv[] =
+    "01,          ,trace,PW_TRACE_EVENT_TYPE_INSTANT|0|mod||Boot\n"
+    "02,          ,trace,PW_TRACE_EVENT_TYPE_DURATION_START|0|mod||Work\n"
+    "03,          ,trace,PW_TRACE_EVENT_TYPE_DURATION_END|0|mod||Work\n"
+    "04,          ,trace,PW_TRACE_EVENT_TYPE_DURATION_GROUP_START|0|mod|grp|A\n"
+    "05,          ,trace,PW_TRACE_EVENT_TYPE_ASYNC_START|0|net|rx|Packet\n"
+    "06,          ,trace,PW_TRACE_EVENT_TYPE_ASYNC_END|0|net|rx|Packet\n"
+    "07,          ,trace,"
+    "PW_TRACE_EVENT_TYPE_INSTANT|0|mod||Battery|@pw_arg_counter\n"
+    "08,          ,trace,"
+    "PW_TRACE_EVENT_TYPE_INSTANT|0|mod||Blob|@pw_py_struct_fmt:H\n"
+    "09,          ,trace,PW_TRACE_EVENT_TYPE_INSTANT|0|mod||Arg|@pw_arg_label\n"
+    "0a,          ,trace,Not a trace string\n"
+    "0b,          ,,PW_TRACE_EVENT_TYPE_INSTANT|0|old||Legacy\n";
+
+// The Perfetto fields checked by these tests.
+struct Packet {
+  uint64_t timestamp = 0;
+
+  // TrackDescriptor
+  bool is_track = false;
+  uint64_t uuid = 0;
+  uint64_t parent_uuid = 0;
+  bool is_process = false;
+  bool is_counter = false;
+
+  // TrackEvent
+  uint32_t type = 0;
+  uint64_t track_uuid = 0;
+  std::string category;
+  int64_t counter_value = 0;
+  std::string annotation_name;
+  std::string annotation_string;
+  uint64_t annotation_uint = 0;
+
+  std::string name;
+};
+
+std::string ToString(std::string_view value) { return std::string(value); }
+
+void ParseAnnotation(ConstByteSpan bytes, Packet& packet) {
+  protobuf::Decoder decoder(bytes);
+  while (decoder.Next().ok()) {
+    std::string_view value;
+    switch (decoder.FieldNumber()) {
+      case 10:
+        ASSERT_EQ(decoder.ReadString(&value), OkStatus());
+        packet.annotation_name = ToString(value);
+        break;
+      case 6:
+        ASSERT_EQ(decoder.ReadString(&value), OkStatus());
+        packet.annotation_string = ToString(value);
+        break;
+      case 3:
+        ASSERT_EQ(decoder.ReadUint64(&packet.annotation_uint), OkStatus());
+        break;
+    }
+  }
+}
+
+void ParseTrackEvent(ConstByteSpan bytes, Packet& packet) {
+  protobuf::Decoder decoder(bytes);
+  while (decoder.Next().ok()) {
+    std::string_view value;
+    ConstByteSpan nested;
+    switch (decoder.FieldNumber()) {
+      case 9:
+        ASSERT_EQ(decoder.ReadUint32(&packet.type), OkStatus());
+        break;
+      case 11:
+        ASSERT_EQ(decoder.ReadUint64(&packet.track_uuid), OkStatus());
+        break;
+      case 22:
+        ASSERT_EQ(decoder.ReadString(&value), OkStatus());
+        packet.category = ToString(value);
+        break;
+      case 23:
+        ASSERT_EQ(decoder.ReadString(&value), OkStatus());
+        packet.name = ToString(value);
+        break;
+      case 30:
+        ASSERT_EQ(decoder.ReadInt64(&packet.counter_value), OkStatus());
+        break;
+      case 4:
+        ASSERT_EQ(decoder.ReadBytes(&nested), OkStatus());
+        ParseAnnotation(nested, packet);
+        break;
+    }
+  }
+}
+
+void ParseTrackDescriptor(ConstByteSpan bytes, Packet& packet) {
+  packet.is_track = true;
+  protobuf::Decoder decoder(bytes);
+  while (decoder.Next().ok()) {
+    std::string_view value;
+    switch (decoder.FieldNumber()) {
+      case 1:
+        ASSERT_EQ(decoder.ReadUint64(&packet.uuid), OkStatus());
+        break;
+      case 2:
+        ASSERT_EQ(decoder.ReadString(&value), OkStatus());
+        packet.name = ToString(value);
+        break;
+      case 3:
+        packet.is_process = true;
+        break;
+      case 5:
+        ASSERT_EQ(decoder.ReadUint64(&packet.parent_uuid), OkStatus());
+        break;
+      case 8:
+        packet.is_counter = true;
+        break;
+    }
+  }
+}
+
+// Parses a Perfetto Trace message into its packets.
+std::vector<Packet> Parse(ConstByteSpan trace) {
+  std::vector<Packet> packets;
+  protobuf::Decoder decoder(trace);
+  while (decoder.Next().ok()) {
+    EXPECT_EQ(decoder.FieldNumber(), 1u);
+    ConstByteSpan packet_bytes;
+    EXPECT_EQ(decoder.ReadBytes(&packet_bytes), OkStatus());
+
+    Packet& packet = packets.emplace_back();
+    protobuf::Decoder packet_decoder(packet_bytes);
+    uint32_t sequence_id = 0;
+    while (packet_decoder.Next().ok()) {
+      ConstByteSpan nested;
+      switch (packet_decoder.FieldNumber()) {
+        case 8:
+          EXPECT_EQ(packet_decoder.ReadUint64(&packet.timestamp), OkStatus());
+          break;
+        case 10:
+          EXPECT_EQ(packet_decoder.ReadUint32(&sequence_id), OkStatus());
+          break;
+        case 11:
+          EXPECT_EQ(packet_decoder.ReadBytes(&nested), OkStatus());
+          ParseTrackEvent(nested, packet);
+          break;
+        case 60:
+          EXPECT_EQ(packet_decoder.ReadBytes(&nested), OkStatus());
+          ParseTrackDescriptor(nested, packet);
+          break;
+      }
+    }
+    EXPECT_EQ(sequence_id, 1u);
+  }
+  return packets;
+}
+
+// Encodes a trace event the way the tokenized tracer does.
+std::vector<std::byte> Event(uint32_t token,
+                             uint64_t delta,
+                             std::optional<uint64_t> trace_id = std::nullopt,
+                             std::string_view data = "") {
+  std::vector<std::byte> event(sizeof(token) +
+                               2 * varint::kMaxVarint64SizeBytes + data.size());
+  std::memcpy(event.data(), &token, sizeof(token));
+  size_t size = sizeof(token);
+  size += varint::Encode(delta, span(event).subspan(size));
+  if (trace_id.has_value()) {
+    size += varint::Encode(*trace_id, span(event).subspan(size));
+  }
+  std::memcpy(event.data() + size, data.data(), data.size());
+  event.resize(size + data.size());
+  return event;
+}
+
+constexpr uint32_t kInstant = 3;
+constexpr uint32_t kSliceBegin = 1;
+constexpr uint32_t kSliceEnd = 2;
+constexpr uint32_t kCounter = 4;
+
+class PerfettoExporterTest : public ::testing::Test {
+ protected:
+  PerfettoExporterTest()
+      : detokenizer_(Detokenizer()), exporter_(detokenizer_, output_) {}
+
+  static tokenizer::Detokenizer Detokenizer() {
+    Result<tokenizer::Detokenizer> detokenizer =
+        tokenizer::Detokenizer::FromCsv(kCsv);
+    PW_ASSERT(detokenizer.ok());
+    return std::move(*detokenizer);
+  }
+
+  Status Add(const std::vector<std::byte>& event) {
+    return exporter_.AddEvent(event);
+  }
+
+  std::vector<Packet> Packets() const {
+    return Parse(ConstByteSpan(output_.data(), output_.bytes_written()));
+  }
+
+  tokenizer::Detokenizer detokenizer_;
+  stream::MemoryWriterBuffer<4096> output_;
+  PerfettoExporter exporter_;
+};
+
+TEST_F(PerfettoExporterTest, Instant) {
+  ASSERT_EQ(Add(Event(1, 0)), OkStatus());
+
+  const std::vector<Packet> packets = Packets();
+  ASSERT_EQ(packets.size(), 2u);
+
+  EXPECT_TRUE(packets[0].is_track);
+  EXPECT_TRUE(packets[0].is_process);
+  EXPECT_EQ(packets[0].uuid, 1u);
+  EXPECT_EQ(packets[0].parent_uuid, 0u);
+  EXPECT_EQ(packets[0].name, "mod");
+
+  EXPECT_FALSE(packets[1].is_track);
+  EXPECT_EQ(packets[1].timestamp, 0u);
+  EXPECT_EQ(packets[1].type, kInstant);
+  EXPECT_EQ(packets[1].track_uuid, 1u);
+  EXPECT_EQ(packets[1].name, "Boot");
+  EXPECT_EQ(packets[1].category, "mod");
+  EXPECT_EQ(exporter_.events_converted(), 1u);
+}
+
+TEST_F(PerfettoExporterTest, Duration_SharesTrack) {
+  ASSERT_EQ(Add(Event(2, 5)), OkStatus());
+  ASSERT_EQ(Add(Event(3, 20)), OkStatus());
+
+  const std::vector<Packet> packets = Packets();
+  ASSERT_EQ(packets.size(), 4u);  // Process, thread, begin, end
+
+  EXPECT_TRUE(packets[1].is_track);
+  EXPECT_FALSE(packets[1].is_process);
+  EXPECT_EQ(packets[1].uuid, 2u);
+  EXPECT_EQ(packets[1].parent_uuid, 1u);
+  EXPECT_EQ(packets[1].name, "Work");
+
+  EXPECT_EQ(packets[2].type, kSliceBegin);
+  EXPECT_EQ(packets[2].track_uuid, 2u);
+  EXPECT_EQ(packets[2].name, "Work");
+  EXPECT_EQ(packets[2].timestamp, 5'000'000u);  // 1000 ticks per second
+
+  EXPECT_EQ(packets[3].type, kSliceEnd);
+  EXPECT_EQ(packets[3].track_uuid, 2u);
+  EXPECT_EQ(packets[3].timestamp, 25'000'000u);
+}
+
+TEST_F(PerfettoExporterTest, DurationGroup_GroupTrack) {
+  ASSERT_EQ(Add(Event(4, 0)), OkStatus());
+
+  const std::vector<Packet> packets = Packets();
+  ASSERT_EQ(packets.size(), 3u);
+  EXPECT_EQ(packets[1].name, "grp");
+  EXPECT_EQ(packets[2].name, "A");
+  EXPECT_EQ(packets[2].track_uuid, packets[1].uuid);
+}
+
+TEST_F(PerfettoExporterTest, Async_TrackPerTraceId) {
+  ASSERT_EQ(Add(Event(5, 0, 100)), OkStatus());
+  ASSERT_EQ(Add(Event(5, 1, 200)), OkStatus());
+  ASSERT_EQ(Add(Event(6, 1, 100)), OkStatus());
+
+  const std::vector<Packet> packets = Packets();
+  ASSERT_EQ(packets.size(), 6u);
+  EXPECT_EQ(packets[0].name, "net");
+
+  EXPECT_EQ(packets[1].name, "rx");
+  EXPECT_EQ(packets[2].type, kSliceBegin);
+  EXPECT_EQ(packets[2].track_uuid, packets[1].uuid);
+  EXPECT_EQ(packets[2].annotation_name, "id");
+  EXPECT_EQ(packets[2].annotation_uint, 100u);
+
+  EXPECT_EQ(packets[3].name, "rx");
+  EXPECT_NE(packets[3].uuid, packets[1].uuid);
+  EXPECT_EQ(packets[4].track_uuid, packets[3].uuid);
+  EXPECT_EQ(packets[4].annotation_uint, 200u);
+
+  EXPECT_EQ(packets[5].type, kSliceEnd);
+  EXPECT_EQ(packets[5].track_uuid, packets[1].uuid);
+}
+
+TEST_F(PerfettoExporterTest, Counter) {
+  ASSERT_EQ(Add(Event(7, 0, std::nullopt, std::string_view("\x2c\x01", 2))),
+            OkStatus());
+
+  const std::vector<Packet> packets = Packets();
+  ASSERT_EQ(packets.size(), 3u);
+  EXPECT_TRUE(packets[1].is_counter);
+  EXPECT_EQ(packets[1].name, "Battery");
+  EXPECT_EQ(packets[2].type, kCounter);
+  EXPECT_EQ(packets[2].counter_value, 300);
+}
+
+TEST_F(PerfettoExporterTest, Data_HexAnnotation) {
+  ASSERT_EQ(Add(Event(8, 0, std::nullopt, std::string_view("\xab\x01", 2))),
+            OkStatus());
+
+  const std::vector<Packet> packets = Packets();
+  ASSERT_EQ(packets.size(), 2u);
+  EXPECT_EQ(packets[1].annotation_name, "data");
+  EXPECT_EQ(packets[1].annotation_string, "ab01");
+}
+
+TEST_F(PerfettoExporterTest, ArgLabel_SetsName) {
+  ASSERT_EQ(Add(Event(9, 0, std::nullopt, "dynamic")), OkStatus());
+
+  const std::vector<Packet> packets = Packets();
+  ASSERT_EQ(packets.size(), 2u);
+  EXPECT_EQ(packets[1].name, "dynamic");
+  EXPECT_TRUE(packets[1].annotation_name.empty());
+}
+
+TEST_F(PerfettoExporterTest, PlatformTraceId_Ignored) {
+  // Platforms may add trace IDs to non-async events.
+  ASSERT_EQ(Add(Event(1, 0, 1234)), OkStatus());
+
+  const std::vector<Packet> packets = Packets();
+  ASSERT_EQ(packets.size(), 2u);
+  EXPECT_EQ(packets[1].name, "Boot");
+}
+
+TEST_F(PerfettoExporterTest, DefaultDomain) {
+  ASSERT_EQ(Add(Event(0xb, 0)), OkStatus());
+
+  const std::vector<Packet> packets = Packets();
+  ASSERT_EQ(packets.size(), 2u);
+  EXPECT_EQ(packets[0].name, "old");
+  EXPECT_EQ(packets[1].name, "Legacy");
+}
+
+TEST_F(PerfettoExporterTest, UnknownToken_TimeCounted) {
+  EXPECT_EQ(Add(Event(0x1234, 7)), Status::NotFound());
+  ASSERT_EQ(Add(Event(1, 3)), OkStatus());
+
+  const std::vector<Packet> packets = Packets();
+  ASSERT_EQ(packets.size(), 2u);
+  EXPECT_EQ(packets[1].timestamp, 10'000'000u);
+  EXPECT_EQ(exporter_.events_converted(), 1u);
+  EXPECT_EQ(exporter_.events_skipped(), 1u);
+}
+
+// Binary token database with tokens 1 and 2 and a string index at offset 119
+// (0x77). Indexed databases only have the default domain.
+constexpr char kIndexedData[] =
+    "TOKENS\0\0\x02\0\0\0\x77\0\0\0"
+    "\x01\0\0\0\xff\xff\xff\xff"
+    "\x02\0\0\0\xff\xff\xff\xff"
+    "PW_TRACE_EVENT_TYPE_INSTANT|0|mod||Boot\0"
+    "PW_TRACE_EVENT_TYPE_DURATION_START|0|mod||Work\0"
+    "\x00\0\0\0\x28\0\0\0";
+
+constexpr tokenizer::TokenDatabase kIndexedDatabase =
+    tokenizer::TokenDatabase::Create<kIndexedData>();
+
+TEST(PerfettoExporterIndexedTest, LooksUpEachToken) {
+  const tokenizer::Detokenizer detokenizer =
+      tokenizer::Detokenizer::FromIndexedDatabase(kIndexedDatabase).value();
+  stream::MemoryWriterBuffer<1024> output;
+  PerfettoExporter exporter(detokenizer, output);
+
+  ASSERT_EQ(exporter.AddEvent(Event(1, 0)), OkStatus());
+  ASSERT_EQ(exporter.AddEvent(Event(2, 5)), OkStatus());
+  EXPECT_EQ(exporter.AddEvent(Event(3, 0)), Status::NotFound());
+
+  const std::vector<Packet> packets =
+      Parse(ConstByteSpan(output.data(), output.bytes_written()));
+  ASSERT_EQ(packets.size(), 4u);  // Process, instant, thread, begin
+  EXPECT_EQ(packets[1].type, kInstant);
+  EXPECT_EQ(packets[1].name, "Boot");
+  EXPECT_EQ(packets[2].name, "Work");
+  EXPECT_EQ(packets[3].type, kSliceBegin);
+  EXPECT_EQ(packets[3].name, "Work");
+  EXPECT_EQ(exporter.events_converted(), 2u);
+  EXPECT_EQ(exporter.events_skipped(), 1u);
+}
+
+TEST_F(PerfettoExporterTest, InvalidEvents) {
+  EXPECT_EQ(Add(Event(0xa, 0)), Status::InvalidArgument());
+  EXPECT_EQ(exporter_.AddEvent(as_bytes(span("\1\0", 2))), Status::DataLoss());
+  EXPECT_EQ(exporter_.AddEvent(as_bytes(span("\1\0\0\0\x80", 5))),
+            Status::DataLoss());
+  EXPECT_EQ(Add(Event(5, 0)), Status::DataLoss());  // Missing trace ID
+  EXPECT_EQ(exporter_.events_skipped(), 4u);
+  EXPECT_EQ(output_.bytes_written(), 0u);
+}
+
+TEST_F(PerfettoExporterTest, Options) {
+  stream::MemoryWriterBuffer<256> output;
+  PerfettoExporter exporter(
+      detokenizer_,
+      output,
+      {.ticks_per_second = 3, .time_offset_ns = 1'000'000'000'000});
+  ASSERT_EQ(exporter.AddEvent(Event(1, 4)), OkStatus());
+
+  const std::vector<Packet> packets =
+      Parse(ConstByteSpan(output.data(), output.bytes_written()));
+  ASSERT_EQ(packets.size(), 2u);
+  EXPECT_EQ(packets[1].timestamp, 1'001'333'333'333u);
+}
+
+std::vector<std::byte> SizePrefixed(
+    const std::vector<std::vector<std::byte>>& events) {
+  std::vector<std::byte> data;
+  for (const std::vector<std::byte>& event : events) {
+    data.push_back(static_cast<std::byte>(event.size()));
+    data.insert(data.end(), event.begin(), event.end());
+  }
+  return data;
+}
+
+TEST_F(PerfettoExporterTest, AddSizePrefixedEvents) {
+  const std::vector<std::byte> file =
+      SizePrefixed({Event(2, 1), Event(0x1234, 1), Event(3, 1)});
+  stream::MemoryReader reader(file);
+
+  ASSERT_EQ(exporter_.AddSizePrefixedEvents(reader), OkStatus());
+  EXPECT_EQ(exporter_.events_converted(), 2u);
+  EXPECT_EQ(exporter_.events_skipped(), 1u);
+
+  const std::vector<Packet> packets = Packets();
+  ASSERT_EQ(packets.size(), 4u);
+  EXPECT_EQ(packets[3].type, kSliceEnd);
+  EXPECT_EQ(packets[3].timestamp, 3'000'000u);
+}
+
+TEST_F(PerfettoExporterTest, AddSizePrefixedEvents_Truncated) {
+  std::vector<std::byte> file = SizePrefixed({Event(1, 0), Event(1, 1)});
+  file.pop_back();
+  stream::MemoryReader reader(file);
+
+  EXPECT_EQ(exporter_.AddSizePrefixedEvents(reader), Status::DataLoss());
+  EXPECT_EQ(exporter_.events_converted(), 1u);
+}
+
+TEST_F(PerfettoExporterTest, AddSizePrefixedEvents_WriteError) {
+  const std::vector<std::byte> file = SizePrefixed({Event(1, 0), Event(1, 0)});
+  stream::MemoryReader reader(file);
+  stream::MemoryWriterBuffer<16> output;
+  PerfettoExporter exporter(detokenizer_, output);
+
+  EXPECT_EQ(exporter.AddSizePrefixedEvents(reader),
+            Status::ResourceExhausted());
+}
+
+TEST_F(PerfettoExporterTest, AddEvents_RingBuffer) {
+  std::array<std::byte, 128> buffer;
+  ring_buffer::PrefixedEntryRingBuffer ring_buffer;
+  ASSERT_EQ(ring_buffer.SetBuffer(buffer), OkStatus());
+  ASSERT_EQ(ring_buffer.PushBack(Event(2, 1)), OkStatus());
+  ASSERT_EQ(ring_buffer.PushBack(Event(3, 1)), OkStatus());
+
+  ASSERT_EQ(exporter_.AddEvents(ring_buffer), OkStatus());
+  EXPECT_EQ(exporter_.events_converted(), 2u);
+  EXPECT_EQ(ring_buffer.EntryCount(), 2u);
+  EXPECT_EQ(Packets().size(), 4u);
+}
+
+}  // namespace
+}  // namespace pw::trace
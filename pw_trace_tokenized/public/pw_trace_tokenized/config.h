@@ -79,6 +79,16 @@ static_assert(
 
 // --- Config options for locks ---
 
+// Per-thread buffers are drained by whichever thread takes PW_TRACE_TRY_LOCK,
+// so the lock hooks must be provided when PW_TRACE_CONFIG_PER_THREAD_BUFFERS is
+// enabled. The default no-op hooks would let two threads drain at once.
+#if defined(PW_TRACE_CONFIG_PER_THREAD_BUFFERS) &&             \
+    PW_TRACE_CONFIG_PER_THREAD_BUFFERS &&                      \
+    (!defined(PW_TRACE_LOCK) || !defined(PW_TRACE_TRY_LOCK) || \
+     !defined(PW_TRACE_UNLOCK))
+#error PW_TRACE_CONFIG_PER_THREAD_BUFFERS requires PW_TRACE_LOCK, PW_TRACE_TRY_LOCK, and PW_TRACE_UNLOCK.
+#endif  // PW_TRACE_CONFIG_PER_THREAD_BUFFERS
+
 // PW_TRACE_LOCK  Is is also called when registering and unregistering callbacks
 // and sinks.
 #ifndef PW_TRACE_LOCK
@@ -112,6 +122,35 @@ static_assert(
 #define PW_TRACE_QUEUE_UNLOCK()
 #endif  // PW_TRACE_QUEUE_UNLOCK
 
+// --- Config options for per-thread buffers ---
+
+// PW_TRACE_CONFIG_PER_THREAD_BUFFERS enables per-thread event buffers. Instead
+// of locking the shared queue, each thread writes its events to its own buffer
+// without locking, and events are only encoded and sent to the sinks when the
+// buffers are drained with pw::trace::TokenizedTracer::DrainThreadBuffers().
+// Events from all threads are merged in timestamp order. This requires
+// thread_local and std::atomic, so it is intended for hosts and other
+// multi-core targets where the queue lock serializes the traced threads. The
+// PW_TRACE_LOCK, PW_TRACE_TRY_LOCK, and PW_TRACE_UNLOCK hooks must be defined
+// with a real lock in this mode.
+#ifndef PW_TRACE_CONFIG_PER_THREAD_BUFFERS
+#define PW_TRACE_CONFIG_PER_THREAD_BUFFERS 0
+#endif  // PW_TRACE_CONFIG_PER_THREAD_BUFFERS
+
+// PW_TRACE_CONFIG_MAX_THREAD_BUFFERS is the maximum number of threads which can
+// trace at once when per-thread buffers are enabled. Events from additional
+// threads are dropped. The buffer of a thread is reused after it exits.
+#ifndef PW_TRACE_CONFIG_MAX_THREAD_BUFFERS
+#define PW_TRACE_CONFIG_MAX_THREAD_BUFFERS 16
+#endif  // PW_TRACE_CONFIG_MAX_THREAD_BUFFERS
+
+// PW_TRACE_CONFIG_THREAD_BUFFER_SIZE_EVENTS is the number of events each
+// per-thread buffer holds. When a thread's buffer is half full, that thread
+// drains all buffers if it can take PW_TRACE_TRY_LOCK.
+#ifndef PW_TRACE_CONFIG_THREAD_BUFFER_SIZE_EVENTS
+#define PW_TRACE_CONFIG_THREAD_BUFFER_SIZE_EVENTS 256
+#endif  // PW_TRACE_CONFIG_THREAD_BUFFER_SIZE_EVENTS
+
 // --- Config options for optional trace buffer ---
 
 // PW_TRACE_BUFFER_SIZE_BYTES is the size in bytes of the optional trace buffer.
@@ -0,0 +1,204 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+//==============================================================================
+//
+// Per-thread trace event buffers, used by the tokenized tracer when
+// PW_TRACE_CONFIG_PER_THREAD_BUFFERS is enabled.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "pw_trace_tokenized/config.h"
+#include "pw_trace_tokenized/internal/trace_tokenized_internal.h"
+
+namespace pw {
+namespace trace {
+namespace internal {
+
+// Returns true if trace time a is before trace time b. This uses
+// PW_TRACE_GET_TIME_DELTA, so it handles time values which wrap.
+inline bool TraceTimeIsBefore(PW_TRACE_TIME_TYPE a, PW_TRACE_TIME_TYPE b) {
+  return PW_TRACE_GET_TIME_DELTA(b, a) > PW_TRACE_GET_TIME_DELTA(a, b);
+}
+
+// A single-producer, single-consumer ring of trace events. The thread which
+// owns the buffer pushes events without locking; the thread which drains the
+// tracer pops them.
+template <size_t kSize>
+class ThreadBuffer {
+ public:
+  struct Event {
+    PW_TRACE_TIME_TYPE time;
+    uint32_t trace_token;
+    uint32_t trace_id;
+    pw_trace_EventType event_type;
+    size_t data_size;
+    std::byte data_buffer[PW_TRACE_BUFFER_MAX_DATA_SIZE_BYTES];
+  };
+
+  // Called by the owning thread. Returns false if the buffer is full or the
+  // data is too large, in which case the event is dropped.
+  bool TryPush(PW_TRACE_TIME_TYPE time,
+               uint32_t trace_token,
+               pw_trace_EventType event_type,
+               uint32_t trace_id,
+               const void* data_buffer,
+               size_t data_size) {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == kSize ||
+        data_size > PW_TRACE_BUFFER_MAX_DATA_SIZE_BYTES) {
+      return false;
+    }
+    Event& event = events_[head % kSize];
+    event.time = time;
+    event.trace_token = trace_token;
+    event.trace_id = trace_id;
+    event.event_type = event_type;
+    event.data_size = data_size;
+    if (data_size != 0u) {
+      std::memcpy(event.data_buffer, data_buffer, data_size);
+    }
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Number of events currently in the buffer. Exact only when called by the
+  // owning thread or the draining thread while the other is idle.
+  size_t size() const {
+    return head_.load(std::memory_order_acquire) -
+           tail_.load(std::memory_order_acquire);
+  }
+
+  static constexpr size_t capacity() { return kSize; }
+
+ private:
+  template <size_t, size_t>
+  friend class ThreadBuffers;
+
+  enum State : uint8_t {
+    kFree,      // Not assigned to a thread.
+    kOwned,     // Assigned to a running thread.
+    kReleased,  // The owning thread exited, but events may remain.
+  };
+
+  std::array<Event, kSize> events_;
+  std::atomic<size_t> head_{0};  // Next write, only modified by the producer.
+  std::atomic<size_t> tail_{0};  // Next read, only modified by the consumer.
+  std::atomic<State> state_{kFree};
+};
+
+// A fixed set of ThreadBuffers. Threads acquire a buffer the first time they
+// trace and release it when they exit. Drain merges the events from every
+// buffer in timestamp order.
+//
+// Acquire and Release may be called from any thread. Drain and Clear must be
+// serialized by the caller.
+template <size_t kThreads, size_t kEventsPerThread>
+class ThreadBuffers {
+ public:
+  using Buffer = ThreadBuffer<kEventsPerThread>;
+  using Event = typename Buffer::Event;
+
+  // Assigns a buffer to the calling thread. Free buffers are preferred. If
+  // there are none, the buffer of an exited thread is taken over along with any
+  // events it has not drained yet; they are older than anything the calling
+  // thread pushes, so the buffer stays in timestamp order. Returns nullptr if
+  // all buffers are owned by running threads.
+  Buffer* Acquire() {
+    for (typename Buffer::State state : {Buffer::kFree, Buffer::kReleased}) {
+      for (Buffer& buffer : buffers_) {
+        typename Buffer::State expected = state;
+        if (buffer.state_.compare_exchange_strong(expected,
+                                                  Buffer::kOwned,
+                                                  std::memory_order_acquire,
+                                                  std::memory_order_relaxed)) {
+          return &buffer;
+        }
+      }
+    }
+    return nullptr;
+  }
+
+  // Called when the thread which owns the buffer exits. Buffered events are
+  // kept until they are drained or another thread acquires the buffer.
+  static void Release(Buffer& buffer) {
+    buffer.state_.store(Buffer::kReleased, std::memory_order_release);
+  }
+
+  // Passes every event that was in a buffer when Drain was called to
+  // handle_event, oldest first. Events pushed during the drain are left for
+  // the next call, so a busy thread cannot stall the drain.
+  template <typename Function>
+  void Drain(Function&& handle_event) {
+    std::array<size_t, kThreads> end;
+    for (size_t i = 0; i < kThreads; ++i) {
+      end[i] = buffers_[i].head_.load(std::memory_order_acquire);
+    }
+
+    while (true) {
+      Buffer* oldest = nullptr;
+      for (size_t i = 0; i < kThreads; ++i) {
+        Buffer& buffer = buffers_[i];
+        const size_t tail = buffer.tail_.load(std::memory_order_relaxed);
+        if (tail != end[i] &&
+            (oldest == nullptr || TraceTimeIsBefore(Front(buffer).time,
+                                                    Front(*oldest).time))) {
+          oldest = &buffer;
+        }
+      }
+      if (oldest == nullptr) {
+        break;
+      }
+      handle_event(static_cast<const Event&>(Front(*oldest)));
+      oldest->tail_.store(oldest->tail_.load(std::memory_order_relaxed) + 1,
+                          std::memory_order_release);
+    }
+
+    // Buffers of exited threads are free once they are empty. Acquire may
+    // take over a released buffer at any time, so only free it if it is
+    // still released.
+    for (Buffer& buffer : buffers_) {
+      typename Buffer::State expected = Buffer::kReleased;
+      if (buffer.state_.load(std::memory_order_acquire) == expected &&
+          buffer.size() == 0u) {
+        buffer.state_.compare_exchange_strong(expected,
+                                              Buffer::kFree,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Discards all buffered events.
+  void Clear() {
+    Drain([](const Event&) {});
+  }
+
+ private:
+  static Event& Front(Buffer& buffer) {
+    return buffer.events_[buffer.tail_.load(std::memory_order_relaxed) %
+                          kEventsPerThread];
+  }
+
+  std::array<Buffer, kThreads> buffers_;
+};
+
+}  // namespace internal
+}  // namespace trace
+}  // namespace pw
@@ -0,0 +1,180 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+//==============================================================================
+//
+// Converts tokenized trace data to the Perfetto trace format on the host.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "pw_bytes/span.h"
+#include "pw_protobuf/encoder.h"
+#include "pw_result/result.h"
+#include "pw_ring_buffer/prefixed_entry_ring_buffer.h"
+#include "pw_status/status.h"
+#include "pw_stream/stream.h"
+#include "pw_tokenizer/detokenize.h"
+
+namespace pw::trace {
+
+// Converts encoded tokenized trace events to a Perfetto protobuf trace, which
+// can be opened with https://ui.perfetto.dev. Events are written to the output
+// as they are converted, so memory use depends on the number of distinct
+// tracks and trace tokens, not the length of the trace.
+//
+// Events are mapped to tracks the same way as the Python trace_tokenized tool
+// maps them to chrome://tracing JSON:
+//
+//   - Each module is a process track, which holds its instant events.
+//   - Duration events are slices on a track named by their label, or by their
+//     group for group events.
+//   - Async events are slices on a track for each group and trace ID.
+//   - Events with "@pw_arg_counter" data are values on a counter track.
+//
+// Trace tokens are looked up in the "trace" domain, then in the default domain
+// for databases without domains.
+class PerfettoExporter {
+ public:
+  struct Options {
+    // The rate of the trace time source, pw_trace_GetTraceTimeTicksPerSecond().
+    uint32_t ticks_per_second = 1000;
+
+    // Timestamp of the first event, in nanoseconds.
+    uint64_t time_offset_ns = 0;
+  };
+
+  // The detokenizer must outlive the exporter.
+  PerfettoExporter(const tokenizer::Detokenizer& detokenizer,
+                   stream::Writer& output,
+                   const Options& options);
+
+  PerfettoExporter(const tokenizer::Detokenizer& detokenizer,
+                   stream::Writer& output)
+      : PerfettoExporter(detokenizer, output, Options()) {}
+
+  // Converts a single encoded trace event, as passed to a trace sink.
+  //
+  // Returns:
+  //   OK - The event was written to the output.
+  //   NOT_FOUND - The event's token is not in the database. The event's time
+  //       is still counted.
+  //   DATA_LOSS - The event is malformed.
+  //   INVALID_ARGUMENT - The token is not a trace token, or the event's
+  //       strings are too long to encode.
+  //   Other - Writing to the output failed with this status.
+  Status AddEvent(ConstByteSpan event);
+
+  // Converts all events from a stream in which each event is prefixed by a
+  // one-byte size, as written by pw::trace::TraceToFile. Events which cannot
+  // be converted are skipped and counted in events_skipped().
+  //
+  // Returns:
+  //   OK - The input was read until it was exhausted.
+  //   DATA_LOSS - The input ended within an event.
+  //   Other - Reading from the input or writing to the output failed.
+  Status AddSizePrefixedEvents(stream::Reader& input);
+
+  // Converts all events in a trace ring buffer, such as the buffer returned by
+  // pw::trace::GetBuffer(). The buffer's entries are not consumed. Events which
+  // cannot be converted are skipped and counted in events_skipped().
+  Status AddEvents(ring_buffer::PrefixedEntryRingBuffer& buffer);
+
+  // The number of events written to the output.
+  size_t events_converted() const { return events_converted_; }
+
+  // The number of events which could not be converted.
+  size_t events_skipped() const { return events_skipped_; }
+
+ private:
+  enum class EventType : uint8_t {
+    kInvalid,
+    kInstant,
+    kInstantGroup,
+    kAsyncStart,
+    kAsyncStep,
+    kAsyncEnd,
+    kDurationStart,
+    kDurationEnd,
+    kDurationGroupStart,
+    kDurationGroupEnd,
+  };
+
+  // The fields of a trace token's string:
+  // "event_type|flags|module|group|label|<optional data format>"
+  struct TokenInfo {
+    std::string text;
+    EventType type = EventType::kInvalid;
+    std::string_view module;
+    std::string_view group;
+    std::string_view label;
+    std::string_view data_format;
+    bool has_data = false;
+  };
+
+  enum class TrackKind : char {
+    kProcess = 'p',
+    kThread = 't',
+    kAsync = 'a',
+    kCounter = 'c',
+  };
+
+  // Sized for typical trace strings; events with longer strings fail with
+  // INVALID_ARGUMENT.
+  static constexpr size_t kMaxPacketSizeBytes = 1024;
+
+  Status ConvertEvent(ConstByteSpan event);
+
+  // Returns nullptr if the token is not in the database. Tokens which are not
+  // trace tokens have the type kInvalid.
+  const TokenInfo* Lookup(uint32_t token);
+
+  Result<uint64_t> GetTrack(TrackKind kind,
+                            std::string_view module,
+                            std::string_view name,
+                            uint64_t trace_id);
+
+  Status WriteTrackDescriptor(uint64_t uuid,
+                              uint64_t parent_uuid,
+                              TrackKind kind,
+                              std::string_view name);
+
+  void StartPacket(protobuf::StreamEncoder& packet);
+
+  Status WritePacket(const protobuf::MemoryEncoder& packet);
+
+  uint64_t TimestampNs() const;
+
+  const tokenizer::Detokenizer& detokenizer_;
+  stream::Writer& output_;
+  const Options options_;
+
+  uint64_t ticks_ = 0;
+  uint64_t next_track_uuid_ = 1;
+  bool first_packet_ = true;
+  size_t events_converted_ = 0;
+  size_t events_skipped_ = 0;
+
+  std::unordered_map<uint32_t, TokenInfo> tokens_;
+  std::unordered_map<std::string, uint64_t> tracks_;
+  std::string track_key_;
+  std::array<std::byte, kMaxPacketSizeBytes> packet_buffer_;
+};
+
+}  // namespace pw::trace
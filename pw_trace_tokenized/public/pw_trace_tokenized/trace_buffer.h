@@ -29,7 +29,8 @@ namespace trace {
 // in the buffer is lost.
 void ClearBuffer();
 
-// Get the ring buffer which contains the data.
+// Get the ring buffer which contains the data. If per-thread buffers are
+// enabled, their events are drained into the ring buffer first.
 pw::ring_buffer::PrefixedEntryRingBuffer* GetBuffer();
 
 // View underlying buffer trace_tokenized provided ring_buffer at time of
@@ -33,6 +33,10 @@
 #include "pw_trace_tokenized/config.h"
 #include "pw_trace_tokenized/internal/trace_tokenized_internal.h"
 
+#if defined(__cplusplus) && PW_TRACE_CONFIG_PER_THREAD_BUFFERS
+#include "pw_trace_tokenized/internal/thread_buffers.h"
+#endif  // defined(__cplusplus) && PW_TRACE_CONFIG_PER_THREAD_BUFFERS
+
 #ifdef __cplusplus
 namespace pw {
 namespace trace {
@@ -125,6 +129,7 @@ class TokenizedTracer {
   void Enable(bool enable) {
     if (enable != enabled_ && enable) {
       event_queue_.Clear();
+      DiscardThreadBuffers();
     }
     enabled_ = enable;
   }
@@ -138,6 +143,13 @@ class TokenizedTracer {
                         const void* data_buffer,
                         size_t data_size);
 
+  // When PW_TRACE_CONFIG_PER_THREAD_BUFFERS is enabled, encodes the events in
+  // every thread's buffer in timestamp order and sends them to the sinks. This
+  // should be called before reading trace data from a sink, such as the trace
+  // buffer. Takes PW_TRACE_LOCK. Does nothing if per-thread buffers are
+  // disabled.
+  void DrainThreadBuffers();
+
  private:
   using TraceQueue = internal::TraceQueue<PW_TRACE_QUEUE_SIZE_EVENTS>;
   PW_TRACE_TIME_TYPE last_trace_time_ = 0;
@@ -145,8 +157,30 @@ class TokenizedTracer {
   TraceQueue event_queue_;
   Callbacks& callbacks_;
 
+#if PW_TRACE_CONFIG_PER_THREAD_BUFFERS
+  using ThreadBuffers =
+      internal::ThreadBuffers<PW_TRACE_CONFIG_MAX_THREAD_BUFFERS,
+                              PW_TRACE_CONFIG_THREAD_BUFFER_SIZE_EVENTS>;
+  ThreadBuffers thread_buffers_;
+
+  void PushToThreadBuffer(uint32_t trace_token,
+                          EventType event_type,
+                          uint32_t trace_id,
+                          const void* data_buffer,
+                          size_t data_size);
+  void DrainThreadBuffersLocked();
+#endif  // PW_TRACE_CONFIG_PER_THREAD_BUFFERS
+
+  void DiscardThreadBuffers();
+
   void HandleNextItemInQueue(
       const volatile TraceQueue::QueueEventBlock* event_block);
+  void EncodeAndSendEvent(uint32_t trace_token,
+                          EventType event_type,
+                          uint32_t trace_id,
+                          PW_TRACE_TIME_TYPE trace_time,
+                          const std::byte* data_buffer,
+                          size_t data_size);
 };
 
 // Returns a reference of the global tokenized tracer
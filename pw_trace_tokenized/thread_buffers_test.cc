@@ -0,0 +1,223 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_trace_tokenized/internal/thread_buffers.h"
+
+#include <cstdint>
+#include <limits>
+
+#include "pw_containers/vector.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::trace::internal {
+namespace {
+
+using TestBuffers = ThreadBuffers<3, 4>;
+
+// Pushes an event with no data, using the time as the token.
+bool Push(TestBuffers::Buffer& buffer, PW_TRACE_TIME_TYPE time) {
+  return buffer.TryPush(time,
+                        static_cast<uint32_t>(time),
+                        PW_TRACE_EVENT_TYPE_INSTANT,
+                        0,
+                        nullptr,
+                        0);
+}
+
+// Drains the buffers and returns the tokens of the drained events.
+Vector<uint32_t, 16> DrainTokens(TestBuffers& buffers) {
+  Vector<uint32_t, 16> tokens;
+  buffers.Drain([&tokens](const TestBuffers::Event& event) {
+    tokens.push_back(event.trace_token);
+  });
+  return tokens;
+}
+
+TEST(ThreadBuffers, Drain_Empty) {
+  TestBuffers buffers;
+  EXPECT_TRUE(DrainTokens(buffers).empty());
+}
+
+TEST(ThreadBuffers, Drain_SingleBuffer) {
+  TestBuffers buffers;
+  TestBuffers::Buffer* buffer = buffers.Acquire();
+  ASSERT_NE(buffer, nullptr);
+
+  EXPECT_TRUE(Push(*buffer, 1));
+  EXPECT_TRUE(Push(*buffer, 2));
+  EXPECT_EQ(buffer->size(), 2u);
+
+  EXPECT_EQ(DrainTokens(buffers), (Vector<uint32_t, 16>{1, 2}));
+  EXPECT_EQ(buffer->size(), 0u);
+  EXPECT_TRUE(DrainTokens(buffers).empty());
+}
+
+TEST(ThreadBuffers, Drain_MergesByTime) {
+  TestBuffers buffers;
+  TestBuffers::Buffer* first = buffers.Acquire();
+  TestBuffers::Buffer* second = buffers.Acquire();
+  TestBuffers::Buffer* third = buffers.Acquire();
+  ASSERT_NE(third, nullptr);
+
+  Push(*first, 10);
+  Push(*first, 40);
+  Push(*second, 20);
+  Push(*second, 30);
+  Push(*second, 60);
+  Push(*third, 5);
+  Push(*third, 50);
+
+  EXPECT_EQ(DrainTokens(buffers),
+            (Vector<uint32_t, 16>{5, 10, 20, 30, 40, 50, 60}));
+}
+
+TEST(ThreadBuffers, Drain_TimeWraps) {
+  constexpr PW_TRACE_TIME_TYPE kMax =
+      std::numeric_limits<PW_TRACE_TIME_TYPE>::max();
+  TestBuffers buffers;
+  TestBuffers::Buffer* first = buffers.Acquire();
+  TestBuffers::Buffer* second = buffers.Acquire();
+  ASSERT_NE(second, nullptr);
+
+  Push(*first, kMax - 1);
+  Push(*first, 2);
+  Push(*second, kMax);
+  Push(*second, 1);
+
+  EXPECT_EQ(DrainTokens(buffers),
+            (Vector<uint32_t, 16>{static_cast<uint32_t>(kMax - 1),
+                                  static_cast<uint32_t>(kMax),
+                                  1,
+                                  2}));
+}
+
+TEST(ThreadBuffers, TryPush_DropsWhenFull) {
+  TestBuffers buffers;
+  TestBuffers::Buffer* buffer = buffers.Acquire();
+  ASSERT_NE(buffer, nullptr);
+
+  for (PW_TRACE_TIME_TYPE time = 1; time <= 4; ++time) {
+    EXPECT_TRUE(Push(*buffer, time));
+  }
+  EXPECT_FALSE(Push(*buffer, 5));
+
+  EXPECT_EQ(DrainTokens(buffers), (Vector<uint32_t, 16>{1, 2, 3, 4}));
+  EXPECT_TRUE(Push(*buffer, 6));
+}
+
+TEST(ThreadBuffers, TryPush_CopiesData) {
+  TestBuffers buffers;
+  TestBuffers::Buffer* buffer = buffers.Acquire();
+  ASSERT_NE(buffer, nullptr);
+
+  const uint8_t data[] = {1, 2, 3};
+  ASSERT_TRUE(buffer->TryPush(
+      1, 0x1234, PW_TRACE_EVENT_TYPE_DURATION_START, 7, data, sizeof(data)));
+
+  const uint8_t too_large[PW_TRACE_BUFFER_MAX_DATA_SIZE_BYTES + 1] = {};
+  EXPECT_FALSE(buffer->TryPush(2,
+                               0x1234,
+                               PW_TRACE_EVENT_TYPE_DURATION_START,
+                               7,
+                               too_large,
+                               sizeof(too_large)));
+
+  size_t count = 0;
+  buffers.Drain([&count](const TestBuffers::Event& event) {
+    count += 1;
+    EXPECT_EQ(event.trace_token, 0x1234u);
+    EXPECT_EQ(event.event_type, PW_TRACE_EVENT_TYPE_DURATION_START);
+    EXPECT_EQ(event.trace_id, 7u);
+    ASSERT_EQ(event.data_size, 3u);
+    EXPECT_EQ(event.data_buffer[2], std::byte{3});
+  });
+  EXPECT_EQ(count, 1u);
+}
+
+TEST(ThreadBuffers, Drain_LeavesEventsPushedDuringDrain) {
+  TestBuffers buffers;
+  TestBuffers::Buffer* buffer = buffers.Acquire();
+  ASSERT_NE(buffer, nullptr);
+
+  Push(*buffer, 1);
+  Vector<uint32_t, 16> tokens;
+  buffers.Drain([&](const TestBuffers::Event& event) {
+    tokens.push_back(event.trace_token);
+    Push(*buffer, 2);
+  });
+  EXPECT_EQ(tokens, (Vector<uint32_t, 16>{1}));
+  EXPECT_EQ(DrainTokens(buffers), (Vector<uint32_t, 16>{2}));
+}
+
+TEST(ThreadBuffers, Acquire_AllInUse) {
+  TestBuffers buffers;
+  EXPECT_NE(buffers.Acquire(), nullptr);
+  EXPECT_NE(buffers.Acquire(), nullptr);
+  EXPECT_NE(buffers.Acquire(), nullptr);
+  EXPECT_EQ(buffers.Acquire(), nullptr);
+}
+
+TEST(ThreadBuffers, Release_ReusedAfterDrain) {
+  TestBuffers buffers;
+  TestBuffers::Buffer* buffer = buffers.Acquire();
+  ASSERT_NE(buffers.Acquire(), nullptr);
+  ASSERT_NE(buffers.Acquire(), nullptr);
+
+  Push(*buffer, 1);
+  TestBuffers::Release(*buffer);
+  EXPECT_EQ(DrainTokens(buffers), (Vector<uint32_t, 16>{1}));
+  EXPECT_EQ(buffers.Acquire(), buffer);
+}
+
+TEST(ThreadBuffers, Release_ReusedBeforeDrain) {
+  TestBuffers buffers;
+  TestBuffers::Buffer* buffer = buffers.Acquire();
+  ASSERT_NE(buffers.Acquire(), nullptr);
+  ASSERT_NE(buffers.Acquire(), nullptr);
+
+  Push(*buffer, 1);
+  TestBuffers::Release(*buffer);
+  ASSERT_EQ(buffers.Acquire(), buffer);  // Keeps the undrained event.
+  EXPECT_EQ(buffers.Acquire(), nullptr);
+
+  Push(*buffer, 2);
+  EXPECT_EQ(DrainTokens(buffers), (Vector<uint32_t, 16>{1, 2}));
+}
+
+TEST(ThreadBuffers, Acquire_PrefersFreeBuffers) {
+  TestBuffers buffers;
+  TestBuffers::Buffer* buffer = buffers.Acquire();
+  ASSERT_NE(buffer, nullptr);
+
+  Push(*buffer, 1);
+  TestBuffers::Release(*buffer);
+  TestBuffers::Buffer* other = buffers.Acquire();
+  EXPECT_NE(other, nullptr);
+  EXPECT_NE(other, buffer);
+}
+
+TEST(ThreadBuffers, Clear) {
+  TestBuffers buffers;
+  TestBuffers::Buffer* buffer = buffers.Acquire();
+  ASSERT_NE(buffer, nullptr);
+
+  Push(*buffer, 1);
+  Push(*buffer, 2);
+  buffers.Clear();
+  EXPECT_EQ(buffer->size(), 0u);
+  EXPECT_TRUE(DrainTokens(buffers).empty());
+}
+
+}  // namespace
+}  // namespace pw::trace::internal
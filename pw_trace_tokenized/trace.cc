@@ -77,6 +77,13 @@ void TokenizedTracer::HandleTraceEvent(uint32_t trace_token,
     return;
   }
 
+#if PW_TRACE_CONFIG_PER_THREAD_BUFFERS
+  PushToThreadBuffer(event.trace_token,
+                     event.event_type,
+                     event.trace_id,
+                     event.data_buffer,
+                     event.data_size);
+#else
   // Create trace event
   PW_TRACE_QUEUE_LOCK();
   if (!event_queue_
@@ -103,6 +110,7 @@ void TokenizedTracer::HandleTraceEvent(uint32_t trace_token,
     }
     PW_TRACE_UNLOCK();
   }
+#endif  // PW_TRACE_CONFIG_PER_THREAD_BUFFERS
 
   // Disable after processing if an event callback had set the flag.
   if (PW_TRACE_EVENT_RETURN_FLAGS_DISABLE_AFTER_PROCESSING & ret_flags) {
@@ -110,16 +118,121 @@ void TokenizedTracer::HandleTraceEvent(uint32_t trace_token,
   }
 }
 
+#if PW_TRACE_CONFIG_PER_THREAD_BUFFERS
+
+namespace {
+
+using ThreadBuffers =
+    internal::ThreadBuffers<PW_TRACE_CONFIG_MAX_THREAD_BUFFERS,
+                            PW_TRACE_CONFIG_THREAD_BUFFER_SIZE_EVENTS>;
+
+// Holds the calling thread's buffer, which is released when the thread exits.
+class ThreadBufferHandle {
+ public:
+  ~ThreadBufferHandle() {
+    if (buffer_ != nullptr) {
+      ThreadBuffers::Release(*buffer_);
+    }
+  }
+
+  ThreadBuffers::Buffer* Get(ThreadBuffers& buffers) {
+    if (buffer_ == nullptr) {
+      buffer_ = buffers.Acquire();
+    }
+    return buffer_;
+  }
+
+ private:
+  ThreadBuffers::Buffer* buffer_ = nullptr;
+};
+
+thread_local ThreadBufferHandle current_thread_buffer;
+
+}  // namespace
+
+void TokenizedTracer::PushToThreadBuffer(uint32_t trace_token,
+                                         EventType event_type,
+                                         uint32_t trace_id,
+                                         const void* data_buffer,
+                                         size_t data_size) {
+  ThreadBuffers::Buffer* buffer = current_thread_buffer.Get(thread_buffers_);
+  if (buffer == nullptr) {
+    return;  // All buffers are in use, dropping sample.
+  }
+
+  // Sample is dropped if the buffer is full.
+  buffer->TryPush(pw_trace_GetTraceTime(),
+                  trace_token,
+                  event_type,
+                  trace_id,
+                  data_buffer,
+                  data_size);
+
+  // Drain before the buffer fills, unless another thread is already draining.
+  if (buffer->size() >= buffer->capacity() / 2 && PW_TRACE_TRY_LOCK()) {
+    DrainThreadBuffersLocked();
+    PW_TRACE_UNLOCK();
+  }
+}
+
+void TokenizedTracer::DrainThreadBuffersLocked() {
+  thread_buffers_.Drain([this](const ThreadBuffers::Event& event) {
+    // An event pushed while the previous drain ran may be slightly older than
+    // the last event that drain sent. Report it with a delta of 0.
+    PW_TRACE_TIME_TYPE trace_time = event.time;
+    if (last_trace_time_ != 0 &&
+        internal::TraceTimeIsBefore(trace_time, last_trace_time_)) {
+      trace_time = last_trace_time_;
+    }
+    EncodeAndSendEvent(event.trace_token,
+                       event.event_type,
+                       event.trace_id,
+                       trace_time,
+                       event.data_buffer,
+                       event.data_size);
+  });
+}
+
+void TokenizedTracer::DrainThreadBuffers() {
+  PW_TRACE_LOCK();
+  DrainThreadBuffersLocked();
+  PW_TRACE_UNLOCK();
+}
+
+void TokenizedTracer::DiscardThreadBuffers() {
+  // Enable may be called from an event callback while another thread drains,
+  // so only discard events if the buffers can be locked.
+  if (PW_TRACE_TRY_LOCK()) {
+    thread_buffers_.Clear();
+    PW_TRACE_UNLOCK();
+  }
+}
+
+#else
+
+void TokenizedTracer::DrainThreadBuffers() {}
+
+void TokenizedTracer::DiscardThreadBuffers() {}
+
+#endif  // PW_TRACE_CONFIG_PER_THREAD_BUFFERS
+
 void TokenizedTracer::HandleNextItemInQueue(
     const volatile TraceQueue::QueueEventBlock* event_block) {
   // Get next item in queue
-  uint32_t trace_token = event_block->trace_token;
-  EventType event_type = event_block->event_type;
-  uint32_t trace_id = event_block->trace_id;
-  const std::byte* data_buffer =
-      const_cast<const std::byte*>(event_block->data_buffer);
-  size_t data_size = event_block->data_size;
+  EncodeAndSendEvent(event_block->trace_token,
+                     event_block->event_type,
+                     event_block->trace_id,
+                     pw_trace_GetTraceTime(),
+                     const_cast<const std::byte*>(event_block->data_buffer),
+                     event_block->data_size);
+}
 
+void TokenizedTracer::EncodeAndSendEvent(uint32_t trace_token,
+                                         EventType event_type,
+                                         uint32_t trace_id,
+                                         PW_TRACE_TIME_TYPE trace_time,
+                                         const std::byte* data_buffer,
+                                         size_t data_size) {
   // Create header to store trace info
   static constexpr size_t kMaxHeaderSize =
       sizeof(trace_token) + pw::varint::kMaxVarint64SizeBytes +  // time
@@ -129,7 +242,6 @@ void TokenizedTracer::HandleNextItemInQueue(
   size_t header_size = sizeof(trace_token);
 
   // Compute delta of time elapsed since last trace entry.
-  PW_TRACE_TIME_TYPE trace_time = pw_trace_GetTraceTime();
   PW_TRACE_TIME_TYPE delta =
       (last_trace_time_ == 0)
           ? 0
@@ -147,10 +259,8 @@ void TokenizedTracer::HandleNextItemInQueue(
   }
 
   // Send encoded output to any registered trace sinks.
-  callbacks_.CallSinks(
-      span<const std::byte>(header, header_size),
-      span<const std::byte>(reinterpret_cast<const std::byte*>(data_buffer),
-                            data_size));
+  callbacks_.CallSinks(span<const std::byte>(header, header_size),
+                       span<const std::byte>(data_buffer, data_size));
 }
 
 pw_trace_TraceEventReturnFlags Callbacks::CallEventCallbacks(
@@ -95,10 +95,13 @@ TraceBuffer trace_buffer_instance(GetCallbacks());
 void ClearBuffer() { trace_buffer_instance.RingBuffer().Clear(); }
 
 pw::ring_buffer::PrefixedEntryRingBuffer* GetBuffer() {
+  // Move any events held in per-thread buffers into the ring buffer.
+  GetTokenizedTracer().DrainThreadBuffers();
   return &trace_buffer_instance.RingBuffer();
 }
 
 ConstByteSpan DeringAndViewRawBuffer() {
+  GetTokenizedTracer().DrainThreadBuffers();
   return trace_buffer_instance.DeringAndViewRawBuffer();
 }
 
@@ -0,0 +1,70 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures the overhead of tracing a small loop body. Comparing the traced
+// tests with Untraced gives the cost of a PW_TRACE_START/PW_TRACE_END pair with
+// the configured queue or per-thread buffers.
+
+// clang-format off
+#define PW_TRACE_MODULE_NAME "PERF"
+
+#include "pw_trace/trace.h"
+#include "pw_trace_tokenized/trace_tokenized.h"
+// clang-format on
+
+#include <cstdint>
+
+#include "pw_perf_test/perf_test.h"
+
+namespace pw::trace {
+namespace {
+
+constexpr uint32_t kIterations = 100;
+
+// Work that the compiler cannot optimize away.
+uint32_t Work(uint32_t value) {
+  volatile uint32_t result = value;
+  result = result * 31u + 7u;
+  return result;
+}
+
+void Untraced(perf_test::State& state) {
+  uint32_t value = 0;
+  while (state.KeepRunning()) {
+    for (uint32_t i = 0; i < kIterations; ++i) {
+      value = Work(value);
+    }
+  }
+}
+
+void Traced(perf_test::State& state, bool enabled) {
+  PW_TRACE_SET_ENABLED(enabled);
+  uint32_t value = 0;
+  while (state.KeepRunning()) {
+    for (uint32_t i = 0; i < kIterations; ++i) {
+      PW_TRACE_START("Work");
+      value = Work(value);
+      PW_TRACE_END("Work");
+    }
+  }
+  PW_TRACE_SET_ENABLED(false);
+  GetTokenizedTracer().DrainThreadBuffers();
+}
+
+PW_PERF_TEST(Untraced, Untraced);
+PW_PERF_TEST(TracedDisabled, Traced, false);
+PW_PERF_TEST(TracedEnabled, Traced, true);
+
+}  // namespace
+}  // namespace pw::trace